@@ -11,6 +11,8 @@
 
 #include "RNN_example.h"
 
+#include <chrono>
+
 template <typename T_ELEM>
 void
 RNNSample<T_ELEM>::setup(RNNSampleOptions &options) {
@@ -188,24 +190,36 @@ RNNSample<T_ELEM>::setup(RNNSampleOptions &options) {
     miniBatch    = options.miniBatch;
     dropout      = options.dropout;
     printWeights = options.printWeights;
+    refCheck     = options.refCheck;
 
     // Compute local parameters
     bidirectionalScale = (dirMode == CUDNN_BIDIRECTIONAL ? 2 : 1);
 
-    // Calculating total elements per each tensor
+    // Calculating total elements per each tensor. With the LSTM recurrent projection, the outputs and hidden
+    // states have projSize elements, and the cell states hiddenSize.
     inputTensorSize  = seqLength * miniBatch * inputSize;
-    outputTensorSize = seqLength * miniBatch * hiddenSize * bidirectionalScale;
-    hiddenTensorSize = numLayers * miniBatch * hiddenSize * bidirectionalScale;
+    outputTensorSize = seqLength * miniBatch * projSize * bidirectionalScale;
+    hiddenTensorSize = numLayers * miniBatch * projSize * bidirectionalScale;
+    cellTensorSize   = numLayers * miniBatch * hiddenSize * bidirectionalScale;
 
     // Dimensions for hidden state tensors
     dimHidden[0] = numLayers * bidirectionalScale;
     dimHidden[1] = miniBatch;
-    dimHidden[2] = hiddenSize;
+    dimHidden[2] = projSize;
 
     strideHidden[0] = dimHidden[1] * dimHidden[2];
     strideHidden[1] = dimHidden[2];
     strideHidden[2] = 1;
 
+    // Dimensions for cell state tensors
+    dimCell[0] = numLayers * bidirectionalScale;
+    dimCell[1] = miniBatch;
+    dimCell[2] = hiddenSize;
+
+    strideCell[0] = dimCell[1] * dimCell[2];
+    strideCell[1] = dimCell[2];
+    strideCell[2] = 1;
+
     // Compute number of linear layers
     numLinearLayers = 0;
     if (cellMode == CUDNN_RNN_RELU || cellMode == CUDNN_RNN_TANH) {
@@ -225,7 +239,8 @@ RNNSample<T_ELEM>::setup(RNNSampleOptions &options) {
         numLinearLayers * 2ull * bidirectionalScale * hiddenSize * hiddenSize * seqLength * miniBatch * numLayers;
 
     deviceMemoryAvailable  = getDeviceMemory();
-    totalMemoryConsumption = (2 * inputTensorSize + 2 * outputTensorSize + 8 * hiddenTensorSize) * sizeof(T_ELEM);
+    totalMemoryConsumption =
+        (2 * inputTensorSize + 2 * outputTensorSize + 4 * hiddenTensorSize + 4 * cellTensorSize) * sizeof(T_ELEM);
 
     // Check consistency of parameters
     if ((dataType == CUDNN_DATA_HALF && (mathPrecision != CUDNN_DATA_HALF && mathPrecision != CUDNN_DATA_FLOAT)) ||
@@ -256,6 +271,12 @@ RNNSample<T_ELEM>::setup(RNNSampleOptions &options) {
         exit(-1);
     }
 
+    if (refCheck && dropout != 0) {
+        printf("[ERROR] Inconsistent parameter: the reference check requires dropout to be 0!\n");
+        fflush(0);
+        exit(-1);
+    }
+
     printf("[INFO] RNN sample parameters:\n");
     printf("[INFO] RNN seqLength        = %5d\n", seqLength);
     printf("[INFO] RNN numLayers        = %5d\n", numLayers);
@@ -272,6 +293,7 @@ RNNSample<T_ELEM>::setup(RNNSampleOptions &options) {
     printf("[INFO] RNN mathType         = %5d (%s)\n", mathType, mathTypeEnumValue);
     printf("[INFO] RNN dataType         = %5d (%s)\n", dataType, dataTypeEnumValue);
     printf("[INFO] RNN dropout          = %5g\n", dropout);
+    printf("[INFO] RNN refCheck         = %5d\n", refCheck);
 }
 
 template <typename T_ELEM>
@@ -280,15 +302,29 @@ RNNSample<T_ELEM>::testgen() {
     // Initialise weights and inputs
     // We initialise to something simple.
     // Matrices are initialised to 1 / matrixSize, biases to 1, data is 1.
+    // For the reference check, all of them are random, so that every weight and gate is told apart: data and
+    // biases are uniform in [-1, 1], and matrices in [-1 / sqrt(cols), 1 / sqrt(cols)].
 
     // Initialize inputs
-    initGPUData<T_ELEM>((T_ELEM *)x, inputTensorSize, 1.0);
-    if (hx != NULL) initGPUData<T_ELEM>((T_ELEM *)hx, hiddenTensorSize, 1.0);
-    if (cx != NULL) initGPUData<T_ELEM>((T_ELEM *)cx, hiddenTensorSize, 1.0);
-
-    initGPUData<T_ELEM>((T_ELEM *)dy, outputTensorSize, 1.0);
-    if (dhy != NULL) initGPUData<T_ELEM>((T_ELEM *)dhy, hiddenTensorSize, 1.0);
-    if (dcy != NULL) initGPUData<T_ELEM>((T_ELEM *)dcy, hiddenTensorSize, 1.0);
+    if (refCheck) {
+        srand((unsigned)seed);
+
+        initGPUDataRandom<T_ELEM>((T_ELEM *)x, inputTensorSize, 1.0);
+        if (hx != NULL) initGPUDataRandom<T_ELEM>((T_ELEM *)hx, hiddenTensorSize, 1.0);
+        if (cx != NULL) initGPUDataRandom<T_ELEM>((T_ELEM *)cx, cellTensorSize, 1.0);
+
+        initGPUDataRandom<T_ELEM>((T_ELEM *)dy, outputTensorSize, 1.0);
+        if (dhy != NULL) initGPUDataRandom<T_ELEM>((T_ELEM *)dhy, hiddenTensorSize, 1.0);
+        if (dcy != NULL) initGPUDataRandom<T_ELEM>((T_ELEM *)dcy, cellTensorSize, 1.0);
+    } else {
+        initGPUData<T_ELEM>((T_ELEM *)x, inputTensorSize, 1.0);
+        if (hx != NULL) initGPUData<T_ELEM>((T_ELEM *)hx, hiddenTensorSize, 1.0);
+        if (cx != NULL) initGPUData<T_ELEM>((T_ELEM *)cx, cellTensorSize, 1.0);
+
+        initGPUData<T_ELEM>((T_ELEM *)dy, outputTensorSize, 1.0);
+        if (dhy != NULL) initGPUData<T_ELEM>((T_ELEM *)dhy, hiddenTensorSize, 1.0);
+        if (dcy != NULL) initGPUData<T_ELEM>((T_ELEM *)dcy, cellTensorSize, 1.0);
+    }
 
     // Initialize Weights
     cudnnTensorDescriptor_t wDesc;
@@ -297,8 +333,11 @@ RNNSample<T_ELEM>::testgen() {
     cudnnErrCheck(cudnnCreateTensorDescriptor(&wDesc));
     cudnnErrCheck(cudnnCreateTensorDescriptor(&bDesc));
 
+    // The LSTM recurrent projection, when enabled, is one more matrix with linLayerID 8
+    int numLinLayerIDs = numLinearLayers + (cellMode == CUDNN_LSTM && projSize < hiddenSize ? 1 : 0);
+
     for (int layer = 0; layer < numLayers * bidirectionalScale; layer++) {
-        for (int linLayerID = 0; linLayerID < numLinearLayers; linLayerID++) {
+        for (int linLayerID = 0; linLayerID < numLinLayerIDs; linLayerID++) {
             cudnnDataType_t dataTypeTemp;
             int nbDims = 0;
             int dim[3], stride[3];
@@ -318,7 +357,11 @@ RNNSample<T_ELEM>::testgen() {
 
             if (linLayerMat) {
                 cudnnErrCheck(cudnnGetTensorNdDescriptor(wDesc, 3, &dataTypeTemp, &nbDims, dim, stride));
-                initGPUData<T_ELEM>(linLayerMat, dim[0] * dim[1] * dim[2], 1.0 / (dim[0] * dim[1] * dim[2]));
+                if (refCheck) {
+                    initGPUDataRandom<T_ELEM>(linLayerMat, dim[0] * dim[1] * dim[2], 1.0 / sqrt((double)dim[2]));
+                } else {
+                    initGPUData<T_ELEM>(linLayerMat, dim[0] * dim[1] * dim[2], 1.0 / (dim[0] * dim[1] * dim[2]));
+                }
                 if (printWeights) {
                     printWeightAsMatrix<T_ELEM>(linLayerMat, dim[1], dim[2]);
                 }
@@ -326,7 +369,11 @@ RNNSample<T_ELEM>::testgen() {
 
             if (linLayerBias) {
                 cudnnErrCheck(cudnnGetTensorNdDescriptor(bDesc, 3, &dataTypeTemp, &nbDims, dim, stride));
-                initGPUData<T_ELEM>(linLayerBias, dim[0] * dim[1] * dim[2], 1.0);
+                if (refCheck) {
+                    initGPUDataRandom<T_ELEM>(linLayerBias, dim[0] * dim[1] * dim[2], 1.0);
+                } else {
+                    initGPUData<T_ELEM>(linLayerBias, dim[0] * dim[1] * dim[2], 1.0);
+                }
             }
         }
     }
@@ -336,8 +383,10 @@ RNNSample<T_ELEM>::testgen() {
 }
 
 template <typename T_ELEM>
-void
+int
 RNNSample<T_ELEM>::run() {
+    bool refCheckPassed = true;
+
     FILE *fp = NULL;
     fp       = fopen("result.txt", "w");
 
@@ -356,13 +405,13 @@ RNNSample<T_ELEM>::run() {
     cudaErrCheck(cudaMalloc((void **)&dy, outputTensorSize * sizeof(T_ELEM)));
 
     cudaErrCheck(cudaMalloc((void **)&hx, hiddenTensorSize * sizeof(T_ELEM)));
-    cudaErrCheck(cudaMalloc((void **)&cx, hiddenTensorSize * sizeof(T_ELEM)));
+    cudaErrCheck(cudaMalloc((void **)&cx, cellTensorSize * sizeof(T_ELEM)));
     cudaErrCheck(cudaMalloc((void **)&hy, hiddenTensorSize * sizeof(T_ELEM)));
-    cudaErrCheck(cudaMalloc((void **)&cy, hiddenTensorSize * sizeof(T_ELEM)));
+    cudaErrCheck(cudaMalloc((void **)&cy, cellTensorSize * sizeof(T_ELEM)));
     cudaErrCheck(cudaMalloc((void **)&dhx, hiddenTensorSize * sizeof(T_ELEM)));
-    cudaErrCheck(cudaMalloc((void **)&dcx, hiddenTensorSize * sizeof(T_ELEM)));
+    cudaErrCheck(cudaMalloc((void **)&dcx, cellTensorSize * sizeof(T_ELEM)));
     cudaErrCheck(cudaMalloc((void **)&dhy, hiddenTensorSize * sizeof(T_ELEM)));
-    cudaErrCheck(cudaMalloc((void **)&dcy, hiddenTensorSize * sizeof(T_ELEM)));
+    cudaErrCheck(cudaMalloc((void **)&dcy, cellTensorSize * sizeof(T_ELEM)));
 
     // Memory allocation for seqLengthArray on the host and device
     seqLengthArray = (int *)malloc(miniBatch * sizeof(int));
@@ -394,7 +443,7 @@ RNNSample<T_ELEM>::run() {
                                             CUDNN_RNN_DATA_LAYOUT_SEQ_MAJOR_PACKED,
                                             seqLength,
                                             miniBatch,
-                                            hiddenSize * bidirectionalScale,
+                                            projSize * bidirectionalScale,
                                             seqLengthArray,
                                             &paddingFill));
 
@@ -402,7 +451,7 @@ RNNSample<T_ELEM>::run() {
     cudnnErrCheck(cudnnCreateTensorDescriptor(&cDesc));
 
     cudnnErrCheck(cudnnSetTensorNdDescriptor(hDesc, dataType, 3, dimHidden, strideHidden));
-    cudnnErrCheck(cudnnSetTensorNdDescriptor(cDesc, dataType, 3, dimHidden, strideHidden));
+    cudnnErrCheck(cudnnSetTensorNdDescriptor(cDesc, dataType, 3, dimCell, strideCell));
 
     // Set up the dropout descriptor (needed for the RNN descriptor)
     cudnnErrCheck(cudnnCreateDropoutDescriptor(&dropoutDesc));
@@ -588,14 +637,14 @@ RNNSample<T_ELEM>::run() {
 
         testOutputy  = (T_ELEM *)malloc(outputTensorSize * sizeof(T_ELEM));
         testOutputhy = (T_ELEM *)malloc(hiddenTensorSize * sizeof(T_ELEM));
-        testOutputcy = (T_ELEM *)malloc(hiddenTensorSize * sizeof(T_ELEM));
+        testOutputcy = (T_ELEM *)malloc(cellTensorSize * sizeof(T_ELEM));
 
         cudaErrCheck(cudaMemcpy(testOutputy, y, outputTensorSize * sizeof(T_ELEM), cudaMemcpyDeviceToHost));
         if (hy != NULL) {
             cudaErrCheck(cudaMemcpy(testOutputhy, hy, hiddenTensorSize * sizeof(T_ELEM), cudaMemcpyDeviceToHost));
         }
         if (cy != NULL && cellMode == CUDNN_LSTM) {
-            cudaErrCheck(cudaMemcpy(testOutputcy, cy, hiddenTensorSize * sizeof(T_ELEM), cudaMemcpyDeviceToHost));
+            cudaErrCheck(cudaMemcpy(testOutputcy, cy, cellTensorSize * sizeof(T_ELEM), cudaMemcpyDeviceToHost));
         }
 
         double checksumy  = 0.f;
@@ -608,16 +657,18 @@ RNNSample<T_ELEM>::run() {
             double localSumc = 0;
 
             for (int j = 0; j < seqLength; j++) {
-                for (int i = 0; i < hiddenSize * bidirectionalScale; i++) {
-                    localSumi += (double)testOutputy[j * miniBatch * hiddenSize * bidirectionalScale +
-                                                     m * hiddenSize * bidirectionalScale + i];
+                for (int i = 0; i < projSize * bidirectionalScale; i++) {
+                    localSumi += (double)testOutputy[j * miniBatch * projSize * bidirectionalScale +
+                                                     m * projSize * bidirectionalScale + i];
                 }
             }
             for (int j = 0; j < numLayers * bidirectionalScale; j++) {
-                for (int i = 0; i < hiddenSize; i++) {
+                for (int i = 0; i < projSize; i++) {
                     if (hy != NULL) {
-                        localSumh += (double)testOutputhy[j * hiddenSize * miniBatch + m * hiddenSize + i];
+                        localSumh += (double)testOutputhy[j * projSize * miniBatch + m * projSize + i];
                     }
+                }
+                for (int i = 0; i < hiddenSize; i++) {
                     if ((cy != NULL) && (cellMode == CUDNN_LSTM)) {
                         localSumc += (double)testOutputcy[j * hiddenSize * miniBatch + m * hiddenSize + i];
                     }
@@ -650,14 +701,14 @@ RNNSample<T_ELEM>::run() {
 
         testOutputdx  = (T_ELEM *)malloc(inputTensorSize * sizeof(T_ELEM));
         testOutputdhx = (T_ELEM *)malloc(hiddenTensorSize * sizeof(T_ELEM));
-        testOutputdcx = (T_ELEM *)malloc(hiddenTensorSize * sizeof(T_ELEM));
+        testOutputdcx = (T_ELEM *)malloc(cellTensorSize * sizeof(T_ELEM));
 
         cudaErrCheck(cudaMemcpy(testOutputdx, dx, inputTensorSize * sizeof(T_ELEM), cudaMemcpyDeviceToHost));
         if (dhx != NULL) {
             cudaErrCheck(cudaMemcpy(testOutputdhx, dhx, hiddenTensorSize * sizeof(T_ELEM), cudaMemcpyDeviceToHost));
         }
         if ((dcx != NULL) && (cellMode == CUDNN_LSTM)) {
-            cudaErrCheck(cudaMemcpy(testOutputdcx, dcx, hiddenTensorSize * sizeof(T_ELEM), cudaMemcpyDeviceToHost));
+            cudaErrCheck(cudaMemcpy(testOutputdcx, dcx, cellTensorSize * sizeof(T_ELEM), cudaMemcpyDeviceToHost));
         }
 
         double checksumdx  = 0.f;
@@ -676,8 +727,10 @@ RNNSample<T_ELEM>::run() {
             }
 
             for (int j = 0; j < numLayers * bidirectionalScale; j++) {
+                for (int i = 0; i < projSize; i++) {
+                    localSumdhx += (double)testOutputdhx[j * projSize * miniBatch + m * projSize + i];
+                }
                 for (int i = 0; i < hiddenSize; i++) {
-                    localSumdhx += (double)testOutputdhx[j * hiddenSize * miniBatch + m * hiddenSize + i];
                     if (cellMode == CUDNN_LSTM) {
                         localSumdcx += (double)testOutputdcx[j * hiddenSize * miniBatch + m * hiddenSize + i];
                     }
@@ -721,6 +774,13 @@ RNNSample<T_ELEM>::run() {
         free(testOutputdw);
     }
 
+    // *********************************************************************************************************
+    // Check all results against the CPU reference.
+    // *********************************************************************************************************
+    if (refCheck) {
+        refCheckPassed = checkReference();
+    }
+
     // Free all previously allocated memory, destroy all created cudnn descriptors
     free(seqLengthArray);
 
@@ -756,14 +816,180 @@ RNNSample<T_ELEM>::run() {
 
     printf("Output saved to result.txt\n");
     fclose(fp);
+
+    return refCheckPassed ? 0 : 1;
 }
 
+// Copy one weight matrix and its bias from a weight space to the host. Matrices and biases that the RNN does not
+// have are left empty.
 template <typename T_ELEM>
-void
+static void
+getLinLayerParams(cudnnHandle_t handle,
+                  cudnnRNNDescriptor_t rnnDesc,
+                  int layer,
+                  size_t weightSpaceSize,
+                  void *weightSpace,
+                  int linLayerID,
+                  std::vector<double> &mat,
+                  int matDim[3],
+                  std::vector<double> &bias) {
+    cudnnTensorDescriptor_t wDesc;
+    cudnnTensorDescriptor_t bDesc;
+    cudnnDataType_t dataTypeTemp;
+    int nbDims = 0;
+    int dim[3], stride[3];
+    T_ELEM *linLayerMat  = NULL;
+    T_ELEM *linLayerBias = NULL;
+
+    cudnnErrCheck(cudnnCreateTensorDescriptor(&wDesc));
+    cudnnErrCheck(cudnnCreateTensorDescriptor(&bDesc));
+
+    cudnnErrCheck(cudnnGetRNNWeightParams(handle,
+                                          rnnDesc,
+                                          layer,
+                                          weightSpaceSize,
+                                          weightSpace,
+                                          linLayerID,
+                                          wDesc,
+                                          (void **)&linLayerMat,
+                                          bDesc,
+                                          (void **)&linLayerBias));
+
+    mat.clear();
+    bias.clear();
+    matDim[0] = matDim[1] = matDim[2] = 0;
+
+    if (linLayerMat) {
+        cudnnErrCheck(cudnnGetTensorNdDescriptor(wDesc, 3, &dataTypeTemp, &nbDims, matDim, stride));
+        mat = getGPUDataAsDouble<T_ELEM>(linLayerMat, matDim[0] * matDim[1] * matDim[2]);
+    }
+
+    if (linLayerBias) {
+        cudnnErrCheck(cudnnGetTensorNdDescriptor(bDesc, 3, &dataTypeTemp, &nbDims, dim, stride));
+        bias = getGPUDataAsDouble<T_ELEM>(linLayerBias, dim[0] * dim[1] * dim[2]);
+    }
+
+    cudnnDestroyTensorDescriptor(wDesc);
+    cudnnDestroyTensorDescriptor(bDesc);
+}
+
+template <typename T_ELEM>
+bool
+RNNSample<T_ELEM>::checkReference() {
+    // Tolerances of the comparison. The reference runs in double precision, so these only cover the rounding of
+    // the library, which is largest with FP16 storage or FP16 math.
+    double rtol = 1e-3, atol = 1e-3;
+    if (dataType == CUDNN_DATA_DOUBLE) {
+        rtol = atol = 1e-8;
+    } else if (dataType == CUDNN_DATA_HALF || mathPrecision == CUDNN_DATA_HALF || mathType != CUDNN_DEFAULT_MATH) {
+        rtol = atol = 2e-2;
+    }
+
+    bool lstm          = (cellMode == CUDNN_LSTM);
+    int numLinLayerIDs = numLinearLayers + (lstm && projSize < hiddenSize ? 1 : 0);
+
+    std::vector<double> mat, bias;
+    int matDim[3];
+
+    printf("\n[INFO] Checking results against the CPU reference\n");
+    fflush(0);
+
+    std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+
+    RNNRef ref(
+        cellMode, biasMode, dirMode, inputMode, inputSize, hiddenSize, projSize, numLayers, seqLength, miniBatch);
+
+    for (int layer = 0; layer < numLayers * bidirectionalScale; layer++) {
+        for (int linLayerID = 0; linLayerID < numLinLayerIDs; linLayerID++) {
+            getLinLayerParams<T_ELEM>(
+                cudnnHandle, rnnDesc, layer, weightSpaceSize, weightSpace, linLayerID, mat, matDim, bias);
+            ref.setLinLayer(layer,
+                            linLayerID,
+                            mat.empty() ? NULL : mat.data(),
+                            matDim[1],
+                            matDim[2],
+                            bias.empty() ? NULL : bias.data());
+        }
+    }
+
+    std::vector<double> yRef(outputTensorSize), hyRef(hiddenTensorSize), cyRef(cellTensorSize);
+    std::vector<double> dxRef(inputTensorSize), dhxRef(hiddenTensorSize), dcxRef(cellTensorSize);
+
+    ref.forward(getGPUDataAsDouble<T_ELEM>(x, inputTensorSize).data(),
+                getGPUDataAsDouble<T_ELEM>(hx, hiddenTensorSize).data(),
+                lstm ? getGPUDataAsDouble<T_ELEM>(cx, cellTensorSize).data() : NULL,
+                yRef.data(),
+                hyRef.data(),
+                cyRef.data());
+
+    ref.backward(getGPUDataAsDouble<T_ELEM>(dy, outputTensorSize).data(),
+                 getGPUDataAsDouble<T_ELEM>(dhy, hiddenTensorSize).data(),
+                 lstm ? getGPUDataAsDouble<T_ELEM>(dcy, cellTensorSize).data() : NULL,
+                 dxRef.data(),
+                 dhxRef.data(),
+                 dcxRef.data());
+
+    std::chrono::steady_clock::time_point stop = std::chrono::steady_clock::now();
+
+    printf("[INFO] Reference elapsed time: %g s\n", (std::chrono::duration<double>(stop - start)).count());
+
+    bool passed = true;
+
+    passed &= rnnRefCompare(
+        "y", getGPUDataAsDouble<T_ELEM>(y, outputTensorSize).data(), yRef.data(), yRef.size(), rtol, atol);
+    passed &= rnnRefCompare(
+        "hy", getGPUDataAsDouble<T_ELEM>(hy, hiddenTensorSize).data(), hyRef.data(), hyRef.size(), rtol, atol);
+    if (lstm) {
+        passed &= rnnRefCompare(
+            "cy", getGPUDataAsDouble<T_ELEM>(cy, cellTensorSize).data(), cyRef.data(), cyRef.size(), rtol, atol);
+    }
+
+    passed &= rnnRefCompare(
+        "dx", getGPUDataAsDouble<T_ELEM>(dx, inputTensorSize).data(), dxRef.data(), dxRef.size(), rtol, atol);
+    passed &= rnnRefCompare(
+        "dhx", getGPUDataAsDouble<T_ELEM>(dhx, hiddenTensorSize).data(), dhxRef.data(), dhxRef.size(), rtol, atol);
+    if (lstm) {
+        passed &= rnnRefCompare(
+            "dcx", getGPUDataAsDouble<T_ELEM>(dcx, cellTensorSize).data(), dcxRef.data(), dcxRef.size(), rtol, atol);
+    }
+
+    // Weight and bias gradients, gathered over all layers and linear layers
+    std::vector<double> dwRes, dwRef, dbRes, dbRef;
+
+    for (int layer = 0; layer < numLayers * bidirectionalScale; layer++) {
+        for (int linLayerID = 0; linLayerID < numLinLayerIDs; linLayerID++) {
+            getLinLayerParams<T_ELEM>(
+                cudnnHandle, rnnDesc, layer, weightSpaceSize, dweightSpace, linLayerID, mat, matDim, bias);
+
+            dwRes.insert(dwRes.end(), mat.begin(), mat.end());
+            dbRes.insert(dbRes.end(), bias.begin(), bias.end());
+            dwRef.resize(dwRes.size());
+            dbRef.resize(dbRes.size());
+
+            ref.getLinLayerGrad(layer,
+                                linLayerID,
+                                mat.empty() ? NULL : &dwRef[dwRef.size() - mat.size()],
+                                bias.empty() ? NULL : &dbRef[dbRef.size() - bias.size()]);
+        }
+    }
+
+    passed &= rnnRefCompare("dw", dwRes.data(), dwRef.data(), dwRef.size(), rtol, atol);
+    if (!dbRef.empty()) {
+        passed &= rnnRefCompare("db", dbRes.data(), dbRef.data(), dbRef.size(), rtol, atol);
+    }
+
+    printf("\n");
+    fflush(0);
+
+    return passed;
+}
+
+template <typename T_ELEM>
+int
 runRNNSample(RNNSampleOptions &options) {
     RNNSample<T_ELEM> sample;
     sample.setup(options);
-    sample.run();
+    return sample.run();
 }
 
 int
@@ -778,17 +1004,19 @@ main(int argc, char *argv[]) {
 
     parseRNNSampleParameters(argc, argv, &options);
 
+    int status = 0;
+
     switch (options.dataType) {
         case 0:
-            runRNNSample<half1>(options);
+            status = runRNNSample<half1>(options);
             break;
         case 1:
-            runRNNSample<float>(options);
+            status = runRNNSample<float>(options);
             break;
         case 2:
-            runRNNSample<double>(options);
+            status = runRNNSample<double>(options);
             break;
     }
 
-    return 0;
+    return status;
 }
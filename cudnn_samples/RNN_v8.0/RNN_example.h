@@ -11,8 +11,12 @@
 
 #include <cudnn.h>
 #include <cuda.h>
+#include <math.h>
 #include <stdio.h>
+#include <stdlib.h>
+#include <vector>
 #include "fp16_emu.h"
+#include "RNN_ref.h"
 
 #define COUNTOF(arr) int(sizeof(arr) / sizeof(arr[0]))
 
@@ -119,6 +123,34 @@ initGPUData(T_ELEM *data, int numElements, T_ELEM value) {
     initGPUData_ker<<<gridDim, blockDim>>>(data, numElements, value);
 }
 
+// Initialize GPU data to uniform random values in [-scale, scale], generated on the host with rand()
+template <typename T_ELEM>
+void
+initGPUDataRandom(T_ELEM *data, int numElements, double scale) {
+    std::vector<T_ELEM> host(numElements);
+
+    for (int i = 0; i < numElements; i++) {
+        host[i] = (T_ELEM)(scale * (2.0 * rand() / RAND_MAX - 1.0));
+    }
+
+    cudaErrCheck(cudaMemcpy(data, host.data(), numElements * sizeof(T_ELEM), cudaMemcpyHostToDevice));
+}
+
+// Copy GPU data to the host in double precision, for the CPU reference
+template <typename T_ELEM>
+std::vector<double>
+getGPUDataAsDouble(const void *data, int numElements) {
+    std::vector<T_ELEM> host(numElements);
+    std::vector<double> result(numElements);
+
+    cudaErrCheck(cudaMemcpy(host.data(), data, numElements * sizeof(T_ELEM), cudaMemcpyDeviceToHost));
+
+    for (int i = 0; i < numElements; i++) {
+        result[i] = (double)host[i];
+    }
+    return result;
+}
+
 struct RNNSampleOptions {
     int dataType;
     int seqLength;      // Specify sequence length
@@ -136,6 +168,7 @@ struct RNNSampleOptions {
     int mathType;       // Specify math type (default, tensor op math or tensor op math with conversion)
     float dropout;
     int printWeights;
+    int refCheck;       // Specify whether to check the results against the CPU reference
 
     RNNSampleOptions() { memset(this, 0, sizeof(*this)); };
 };
@@ -208,10 +241,16 @@ class RNNSample {
 
     double paddingFill;
 
+    int cellTensorSize;
+
     // Dimensions for hidden state tensors
     int dimHidden[3];
     int strideHidden[3];
 
+    // Dimensions for cell state tensors
+    int dimCell[3];
+    int strideCell[3];
+
     // Dropout descriptor parameters
     unsigned long long seed;
     size_t stateSize;
@@ -220,6 +259,7 @@ class RNNSample {
 
     // Profiling parameters
     int printWeights;
+    int refCheck;
     cudaEvent_t start;
     cudaEvent_t stop;
     float timeForward;
@@ -253,11 +293,14 @@ class RNNSample {
     void
     setup(RNNSampleOptions &options);
 
-    void
+    int
     run();
 
     void
     testgen();
+
+    bool
+    checkReference();
 };
 
 static char *
@@ -309,7 +352,11 @@ parseRNNSampleParameters(int argc, char **argv, RNNSampleOptions *options) {
          offsetof(RNNSampleOptions, mathType),
          "math type (0-default, 1-tensor op math, 2-tensor op math with conversion)"},
         {"dropout", "%g", offsetof(RNNSampleOptions, dropout), "dropout rate"},
-        {"printWeights", "%d", offsetof(RNNSampleOptions, printWeights), "Print weights"}};
+        {"printWeights", "%d", offsetof(RNNSampleOptions, printWeights), "Print weights"},
+        {"refCheck",
+         "%d",
+         offsetof(RNNSampleOptions, refCheck),
+         "check results against the CPU reference with random data (0-no, 1-yes)"}};
 
     if (argc == 1) {
         printf("This is the cuDNN RNN API sample.\n\n");
@@ -339,6 +386,7 @@ parseRNNSampleParameters(int argc, char **argv, RNNSampleOptions *options) {
         options->mathType      = 0;  // CUDNN_DEFAULT_MATH
         options->dropout       = 0.;
         options->printWeights  = 0;
+        options->refCheck      = 0;
     }
 
     while (argc > 1) {
@@ -0,0 +1,751 @@
+/**
+ * Copyright 2020 NVIDIA Corporation.  All rights reserved.
+ *
+ * Please refer to the NVIDIA end user license agreement (EULA) associated
+ * with this source code for terms and conditions that govern your use of
+ * this software. Any use, reproduction, disclosure, or distribution of
+ * this software and related documentation outside the terms of the EULA
+ * is strictly prohibited.
+ *
+ */
+
+#include "RNN_ref.h"
+
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+// Rows of a GEMM handled by one OpenMP task.
+#define REF_ROW_BLOCK 32
+
+// Tile sizes of the GEMM loops, which keep a KBLOCK x NBLOCK tile of B in the L2 cache.
+#define REF_GEMM_KBLOCK 256
+#define REF_GEMM_NBLOCK 256
+
+// Largest number of mismatches printed for one compared tensor.
+#define REF_MAX_REPORTED 10
+
+// B[n][m] = A[m][n]^T.
+static void
+transpose(int m, int n, const std::vector<double> &A, std::vector<double> &B) {
+    B.resize(A.size());
+    for (int i = 0; i < m; i++) {
+        for (int j = 0; j < n; j++) {
+            B[size_t(j) * m + i] = A[size_t(i) * n + j];
+        }
+    }
+}
+
+// C[m][n] += A[m][k] * B[k][n], where element (i, l) of A is A[i * ai + l * al].  Four rows of C are updated
+// together, so that every row of B loaded from the cache serves four unit stride axpy loops.  C never overlaps A
+// or B, so these loops are marked for vectorization, which then also takes place at -O2.
+static void
+gemm(int m, int n, size_t k, const double *A, size_t ai, size_t al, const double *B, int ldb, double *C, int ldc) {
+    for (size_t l0 = 0; l0 < k; l0 += REF_GEMM_KBLOCK) {
+        const size_t l1 = (k - l0 < REF_GEMM_KBLOCK ? k : l0 + REF_GEMM_KBLOCK);
+
+        for (int j0 = 0; j0 < n; j0 += REF_GEMM_NBLOCK) {
+            const int nj = (n - j0 < REF_GEMM_NBLOCK ? n - j0 : REF_GEMM_NBLOCK);
+
+            int i = 0;
+            for (; i + 4 <= m; i += 4) {
+                double *c0 = C + size_t(i) * ldc + j0;
+                double *c1 = c0 + ldc;
+                double *c2 = c1 + ldc;
+                double *c3 = c2 + ldc;
+                for (size_t l = l0; l < l1; l++) {
+                    const double *a = A + i * ai + l * al;
+                    const double a0 = a[0];
+                    const double a1 = a[ai];
+                    const double a2 = a[2 * ai];
+                    const double a3 = a[3 * ai];
+                    const double *b = B + l * ldb + j0;
+#pragma omp simd
+                    for (int j = 0; j < nj; j++) {
+                        c0[j] += a0 * b[j];
+                        c1[j] += a1 * b[j];
+                        c2[j] += a2 * b[j];
+                        c3[j] += a3 * b[j];
+                    }
+                }
+            }
+            for (; i < m; i++) {
+                double *c = C + size_t(i) * ldc + j0;
+                for (size_t l = l0; l < l1; l++) {
+                    const double a  = A[i * ai + l * al];
+                    const double *b = B + l * ldb + j0;
+#pragma omp simd
+                    for (int j = 0; j < nj; j++) {
+                        c[j] += a * b[j];
+                    }
+                }
+            }
+        }
+    }
+}
+
+// C[m][n] += A[m][k] * B[k][n].
+static void
+gemmNN(int m, int n, int k, const double *A, int lda, const double *B, int ldb, double *C, int ldc) {
+    gemm(m, n, k, A, lda, 1, B, ldb, C, ldc);
+}
+
+// C[m][n] += A[k][m]^T * B[k][n].
+static void
+gemmTN(int m, int n, size_t k, const double *A, int lda, const double *B, int ldb, double *C, int ldc) {
+    gemm(m, n, k, A, 1, lda, B, ldb, C, ldc);
+}
+
+static inline double
+sigmoid(double x) {
+    return 1.0 / (1.0 + exp(-x));
+}
+
+static void
+refError(const char *msg) {
+    fprintf(stderr, "ERROR: %s\n\n", msg);
+    exit(-1);
+}
+
+RNNRef::RNNRef(cudnnRNNMode_t cellMode,
+               cudnnRNNBiasMode_t biasMode,
+               cudnnDirectionMode_t dirMode,
+               cudnnRNNInputMode_t inputMode,
+               int inputSize,
+               int hiddenSize,
+               int projSize,
+               int numLayers,
+               int seqLength,
+               int miniBatch)
+    : cellMode(cellMode),
+      biasMode(biasMode),
+      inputMode(inputMode),
+      inputSize(inputSize),
+      hiddenSize(hiddenSize),
+      projSize(projSize),
+      numLayers(numLayers),
+      seqLength(seqLength),
+      miniBatch(miniBatch) {
+    dirs = (dirMode == CUDNN_BIDIRECTIONAL ? 2 : 1);
+
+    switch (cellMode) {
+        case CUDNN_RNN_RELU:
+        case CUDNN_RNN_TANH:
+            numGates = 1;
+            break;
+        case CUDNN_LSTM:
+            numGates = 4;
+            break;
+        case CUDNN_GRU:
+            numGates = 3;
+            break;
+        default:
+            refError("unsupported cell mode in the RNN reference");
+    }
+
+    if (cellMode != CUDNN_LSTM && projSize != hiddenSize) {
+        refError("the RNN reference requires projSize == hiddenSize for cells other than LSTM");
+    }
+    if (inputMode == CUDNN_SKIP_INPUT && inputSize != hiddenSize) {
+        refError("the RNN reference requires inputSize == hiddenSize with skip input");
+    }
+
+    const size_t GH = size_t(numGates) * hiddenSize;
+
+    weights.resize(numLayers * dirs);
+    grads.resize(numLayers * dirs);
+    states.resize(numLayers * dirs);
+
+    for (int pl = 0; pl < numLayers * dirs; pl++) {
+        const size_t inSize = layerInputSize(pl / dirs);
+
+        layerWeights &lw = weights[pl];
+        lw.hasW          = !(pl / dirs == 0 && inputMode == CUDNN_SKIP_INPUT);
+        lw.hasP          = false;
+        lw.W.assign(lw.hasW ? GH * inSize : 0, 0.0);
+        lw.R.assign(GH * projSize, 0.0);
+        lw.bW.assign(GH, 0.0);
+        lw.bR.assign(GH, 0.0);
+
+        grads[pl] = lw;
+    }
+
+    layerData.resize(numLayers + 1);
+}
+
+int
+RNNRef::numLinearLayers() const {
+    return 2 * numGates + (cellMode == CUDNN_LSTM ? 1 : 0);
+}
+
+int
+RNNRef::layerInputSize(int layer) const {
+    return layer == 0 ? inputSize : dirs * projSize;
+}
+
+void
+RNNRef::setLinLayer(int pseudoLayer, int linLayerID, const double *mat, int rows, int cols, const double *bias) {
+    layerWeights &lw = weights[pseudoLayer];
+    const int H      = hiddenSize;
+    const int inSize = layerInputSize(pseudoLayer / dirs);
+
+    if (linLayerID < numGates) {
+        if (mat == NULL) {
+            if (lw.hasW) {
+                refError("missing input weights in the RNN reference");
+            }
+        } else {
+            if (!lw.hasW || rows != H || cols != inSize) {
+                refError("unexpected dimensions of input weights in the RNN reference");
+            }
+            memcpy(&lw.W[size_t(linLayerID) * H * inSize], mat, size_t(H) * inSize * sizeof(double));
+        }
+        if (bias != NULL && biasMode != CUDNN_RNN_NO_BIAS && biasMode != CUDNN_RNN_SINGLE_REC_BIAS) {
+            memcpy(&lw.bW[size_t(linLayerID) * H], bias, H * sizeof(double));
+        }
+    } else if (linLayerID < 2 * numGates) {
+        const int gate = linLayerID - numGates;
+        if (mat == NULL || rows != H || cols != projSize) {
+            refError("unexpected dimensions of recurrent weights in the RNN reference");
+        }
+        memcpy(&lw.R[size_t(gate) * H * projSize], mat, size_t(H) * projSize * sizeof(double));
+        if (bias != NULL && biasMode != CUDNN_RNN_NO_BIAS && biasMode != CUDNN_RNN_SINGLE_INP_BIAS) {
+            memcpy(&lw.bR[size_t(gate) * H], bias, H * sizeof(double));
+        }
+    } else if (linLayerID == 2 * numGates && cellMode == CUDNN_LSTM) {
+        // The recurrent projection is only allocated when projSize < hiddenSize.
+        lw.hasP = (mat != NULL);
+        if (lw.hasP) {
+            if (rows != projSize || cols != H) {
+                refError("unexpected dimensions of projection weights in the RNN reference");
+            }
+            lw.P.assign(mat, mat + size_t(projSize) * H);
+        }
+        grads[pseudoLayer].hasP = lw.hasP;
+        grads[pseudoLayer].P.assign(lw.P.size(), 0.0);
+    } else {
+        refError("unknown linLayerID in the RNN reference");
+    }
+}
+
+void
+RNNRef::getLinLayerGrad(int pseudoLayer, int linLayerID, double *dmat, double *dbias) const {
+    const layerWeights &lg = grads[pseudoLayer];
+    const int H            = hiddenSize;
+    const int inSize       = layerInputSize(pseudoLayer / dirs);
+
+    if (linLayerID < numGates) {
+        if (dmat != NULL && lg.hasW) {
+            memcpy(dmat, &lg.W[size_t(linLayerID) * H * inSize], size_t(H) * inSize * sizeof(double));
+        }
+        if (dbias != NULL) {
+            memcpy(dbias, &lg.bW[size_t(linLayerID) * H], H * sizeof(double));
+        }
+    } else if (linLayerID < 2 * numGates) {
+        const int gate = linLayerID - numGates;
+        if (dmat != NULL) {
+            memcpy(dmat, &lg.R[size_t(gate) * H * projSize], size_t(H) * projSize * sizeof(double));
+        }
+        if (dbias != NULL) {
+            memcpy(dbias, &lg.bR[size_t(gate) * H], H * sizeof(double));
+        }
+    } else if (linLayerID == 2 * numGates && cellMode == CUDNN_LSTM) {
+        if (dmat != NULL && lg.hasP) {
+            memcpy(dmat, lg.P.data(), lg.P.size() * sizeof(double));
+        }
+    }
+}
+
+void
+RNNRef::forward(const double *x, const double *hx, const double *cx, double *y, double *hy, double *cy) {
+    const size_t rows     = size_t(seqLength) * miniBatch;
+    const size_t hBlock   = size_t(dirs) * miniBatch * projSize;
+    const size_t cBlock   = size_t(dirs) * miniBatch * hiddenSize;
+    const bool storeCells = (cellMode == CUDNN_LSTM);
+
+    for (int pl = 0; pl < numLayers * dirs; pl++) {
+        layerWeights &lw = weights[pl];
+        const int GH     = numGates * hiddenSize;
+
+        if (lw.hasW) {
+            transpose(GH, layerInputSize(pl / dirs), lw.W, lw.WT);
+        }
+        transpose(GH, projSize, lw.R, lw.RT);
+        if (lw.hasP) {
+            transpose(projSize, hiddenSize, lw.P, lw.PT);
+        }
+    }
+
+    layerData[0].assign(x, x + rows * inputSize);
+
+    for (int layer = 0; layer < numLayers; layer++) {
+        layerData[layer + 1].resize(rows * dirs * projSize);
+
+        forwardLayer(layer,
+                     layerData[layer].data(),
+                     hx ? hx + layer * hBlock : NULL,
+                     (cx && storeCells) ? cx + layer * cBlock : NULL,
+                     hy ? hy + layer * hBlock : NULL,
+                     (cy && storeCells) ? cy + layer * cBlock : NULL);
+    }
+
+    memcpy(y, layerData[numLayers].data(), layerData[numLayers].size() * sizeof(double));
+}
+
+void
+RNNRef::forwardLayer(int layer, const double *in, const double *hx, const double *cx, double *hy, double *cy) {
+    const int H       = hiddenSize;
+    const int P       = projSize;
+    const int B       = miniBatch;
+    const int T       = seqLength;
+    const int GH      = numGates * H;
+    const int inSize  = layerInputSize(layer);
+    const int outSize = dirs * P;
+    const size_t rows = size_t(T) * B;
+
+    double *out = layerData[layer + 1].data();
+
+    // Input projections of all time-steps, as [dir][time * miniBatch + batch][gates * hiddenSize].
+    // Both biases are added here, except the recurrent bias of the GRU new memory gate, which the reset gate
+    // multiplies along with the recurrent term.
+    std::vector<double> xw(dirs * rows * GH);
+
+    const int nBlocks = int((rows + REF_ROW_BLOCK - 1) / REF_ROW_BLOCK);
+
+#pragma omp parallel for schedule(dynamic)
+    for (int task = 0; task < dirs * nBlocks; task++) {
+        const int dir           = task / nBlocks;
+        const size_t r0         = size_t(task % nBlocks) * REF_ROW_BLOCK;
+        const int nr            = int(rows - r0 < REF_ROW_BLOCK ? rows - r0 : REF_ROW_BLOCK);
+        const layerWeights &lw  = weights[layer * dirs + dir];
+        const int recBiasLimit  = (cellMode == CUDNN_GRU ? 2 * H : GH);
+        double *c               = &xw[(dir * rows + r0) * GH];
+
+        if (lw.hasW) {
+            memset(c, 0, size_t(nr) * GH * sizeof(double));
+            gemmNN(nr, GH, inSize, in + r0 * inSize, inSize, lw.WT.data(), GH, c, GH);
+        } else {
+            for (int r = 0; r < nr; r++) {
+                for (int j = 0; j < GH; j++) {
+                    c[size_t(r) * GH + j] = in[(r0 + r) * inSize + j % H];
+                }
+            }
+        }
+
+        for (int r = 0; r < nr; r++) {
+            double *cr = c + size_t(r) * GH;
+            for (int j = 0; j < GH; j++) {
+                cr[j] += lw.bW[j] + (j < recBiasLimit ? lw.bR[j] : 0.0);
+            }
+        }
+    }
+
+#pragma omp parallel for schedule(static, 1)
+    for (int dir = 0; dir < dirs; dir++) {
+        const int pl           = layer * dirs + dir;
+        const layerWeights &lw = weights[pl];
+        layerState &st         = states[pl];
+
+        st.gates.resize(rows * GH);
+        st.hPrev.resize(rows * P);
+        if (cellMode == CUDNN_LSTM) {
+            st.cPrev.resize(rows * H);
+            st.c.resize(rows * H);
+            st.hCell.resize(rows * H);
+        }
+        if (cellMode == CUDNN_GRU) {
+            st.rh.resize(rows * H);
+        }
+
+        std::vector<double> h(size_t(B) * P, 0.0);
+        std::vector<double> c(size_t(B) * H, 0.0);
+        std::vector<double> rh(size_t(B) * GH);
+
+        if (hx != NULL) {
+            h.assign(hx + size_t(dir) * B * P, hx + size_t(dir + 1) * B * P);
+        }
+        if (cx != NULL) {
+            c.assign(cx + size_t(dir) * B * H, cx + size_t(dir + 1) * B * H);
+        }
+
+        for (int s = 0; s < T; s++) {
+            const int t     = (dir == 0 ? s : T - 1 - s);
+            const size_t tb = size_t(t) * B;
+
+            memcpy(&st.hPrev[tb * P], h.data(), h.size() * sizeof(double));
+            if (cellMode == CUDNN_LSTM) {
+                memcpy(&st.cPrev[tb * H], c.data(), c.size() * sizeof(double));
+            }
+
+            // Recurrent term of all gates for the whole minibatch.
+            memset(rh.data(), 0, rh.size() * sizeof(double));
+            gemmNN(B, GH, P, h.data(), P, lw.RT.data(), GH, rh.data(), GH);
+
+            // Biases and activations of all gates, fused in one pass.
+            for (int b = 0; b < B; b++) {
+                const double *xb = &xw[(dir * rows + tb + b) * GH];
+                const double *rb = &rh[size_t(b) * GH];
+                double *gb       = &st.gates[(tb + b) * GH];
+                double *hb       = &h[size_t(b) * P];
+
+                switch (cellMode) {
+                    case CUDNN_RNN_RELU:
+                        for (int k = 0; k < H; k++) {
+                            const double v = xb[k] + rb[k];
+                            gb[k]          = v > 0 ? v : 0;
+                            hb[k]          = gb[k];
+                        }
+                        break;
+                    case CUDNN_RNN_TANH:
+                        for (int k = 0; k < H; k++) {
+                            gb[k] = tanh(xb[k] + rb[k]);
+                            hb[k] = gb[k];
+                        }
+                        break;
+                    case CUDNN_LSTM: {
+                        double *cb = &c[size_t(b) * H];
+                        double *hc = &st.hCell[(tb + b) * H];
+                        for (int k = 0; k < H; k++) {
+                            const double gi = sigmoid(xb[k] + rb[k]);
+                            const double gf = sigmoid(xb[H + k] + rb[H + k]);
+                            const double gg = tanh(xb[2 * H + k] + rb[2 * H + k]);
+                            const double go = sigmoid(xb[3 * H + k] + rb[3 * H + k]);
+
+                            gb[k]         = gi;
+                            gb[H + k]     = gf;
+                            gb[2 * H + k] = gg;
+                            gb[3 * H + k] = go;
+
+                            cb[k] = gf * cb[k] + gi * gg;
+                            hc[k] = go * tanh(cb[k]);
+                        }
+                        memcpy(&st.c[(tb + b) * H], cb, H * sizeof(double));
+                        if (!lw.hasP) {
+                            memcpy(hb, hc, H * sizeof(double));
+                        }
+                    } break;
+                    case CUDNN_GRU: {
+                        double *rhb = &st.rh[(tb + b) * H];
+                        for (int k = 0; k < H; k++) {
+                            const double gr = sigmoid(xb[k] + rb[k]);
+                            const double gz = sigmoid(xb[H + k] + rb[H + k]);
+                            rhb[k]          = rb[2 * H + k] + lw.bR[2 * H + k];
+                            const double gn = tanh(xb[2 * H + k] + gr * rhb[k]);
+
+                            gb[k]         = gr;
+                            gb[H + k]     = gz;
+                            gb[2 * H + k] = gn;
+
+                            hb[k] = (1 - gz) * gn + gz * hb[k];
+                        }
+                    } break;
+                    default:
+                        break;
+                }
+            }
+
+            // Recurrent projection of the LSTM output.
+            if (lw.hasP) {
+                memset(h.data(), 0, h.size() * sizeof(double));
+                gemmNN(B, P, H, &st.hCell[tb * H], H, lw.PT.data(), P, h.data(), P);
+            }
+
+            for (int b = 0; b < B; b++) {
+                memcpy(&out[(tb + b) * outSize + dir * P], &h[size_t(b) * P], P * sizeof(double));
+            }
+        }
+
+        if (hy != NULL) {
+            memcpy(hy + size_t(dir) * B * P, h.data(), h.size() * sizeof(double));
+        }
+        if (cy != NULL) {
+            memcpy(cy + size_t(dir) * B * H, c.data(), c.size() * sizeof(double));
+        }
+    }
+}
+
+void
+RNNRef::backward(const double *dy, const double *dhy, const double *dcy, double *dx, double *dhx, double *dcx) {
+    const size_t rows     = size_t(seqLength) * miniBatch;
+    const size_t hBlock   = size_t(dirs) * miniBatch * projSize;
+    const size_t cBlock   = size_t(dirs) * miniBatch * hiddenSize;
+    const bool storeCells = (cellMode == CUDNN_LSTM);
+
+    std::vector<double> dout(dy, dy + rows * dirs * projSize);
+    std::vector<double> din;
+
+    for (int layer = numLayers - 1; layer >= 0; layer--) {
+        din.resize(rows * layerInputSize(layer));
+
+        backwardLayer(layer,
+                      dout.data(),
+                      din.data(),
+                      dhy ? dhy + layer * hBlock : NULL,
+                      (dcy && storeCells) ? dcy + layer * cBlock : NULL,
+                      dhx ? dhx + layer * hBlock : NULL,
+                      (dcx && storeCells) ? dcx + layer * cBlock : NULL);
+
+        dout.swap(din);
+    }
+
+    memcpy(dx, dout.data(), dout.size() * sizeof(double));
+}
+
+void
+RNNRef::backwardLayer(int layer,
+                      const double *dout,
+                      double *din,
+                      const double *dhy,
+                      const double *dcy,
+                      double *dhx,
+                      double *dcx) {
+    const int H       = hiddenSize;
+    const int P       = projSize;
+    const int B       = miniBatch;
+    const int T       = seqLength;
+    const int GH      = numGates * H;
+    const int inSize  = layerInputSize(layer);
+    const int outSize = dirs * P;
+    const size_t rows = size_t(T) * B;
+    const bool isGRU  = (cellMode == CUDNN_GRU);
+
+    const double *in = layerData[layer].data();
+
+    // Gradients of the gate pre-activations, as [dir][time * miniBatch + batch][gates * hiddenSize], seen by the
+    // input weights and by the recurrent weights.  They only differ in the GRU new memory gate, which the reset
+    // gate multiplies on the recurrent side.
+    std::vector<double> dzIn(dirs * rows * GH);
+    std::vector<double> dzRecGRU(isGRU ? dirs * rows * GH : 0);
+    double *dzRec = isGRU ? dzRecGRU.data() : dzIn.data();
+
+    // Gradients of the projected LSTM outputs, for the projection weights.
+    const bool hasP = weights[layer * dirs].hasP;
+    std::vector<double> dhProj(hasP ? dirs * rows * P : 0);
+
+#pragma omp parallel for schedule(static, 1)
+    for (int dir = 0; dir < dirs; dir++) {
+        const int pl           = layer * dirs + dir;
+        const layerWeights &lw = weights[pl];
+        const layerState &st   = states[pl];
+
+        std::vector<double> dh(size_t(B) * P, 0.0);
+        std::vector<double> dhNext(size_t(B) * P);
+        std::vector<double> dhCell(size_t(B) * H);
+        std::vector<double> dc(size_t(B) * H, 0.0);
+
+        if (dhy != NULL) {
+            dh.assign(dhy + size_t(dir) * B * P, dhy + size_t(dir + 1) * B * P);
+        }
+        if (dcy != NULL) {
+            dc.assign(dcy + size_t(dir) * B * H, dcy + size_t(dir + 1) * B * H);
+        }
+
+        for (int s = 0; s < T; s++) {
+            const int t     = (dir == 0 ? T - 1 - s : s);
+            const size_t tb = size_t(t) * B;
+
+            for (int b = 0; b < B; b++) {
+                const double *dob = &dout[(tb + b) * outSize + dir * P];
+                double *dhb       = &dh[size_t(b) * P];
+                for (int k = 0; k < P; k++) {
+                    dhb[k] += dob[k];
+                }
+            }
+
+            const double *dhc = dh.data();
+            if (lw.hasP) {
+                memcpy(&dhProj[(dir * rows + tb) * P], dh.data(), dh.size() * sizeof(double));
+                memset(dhCell.data(), 0, dhCell.size() * sizeof(double));
+                gemmNN(B, H, P, dh.data(), P, lw.P.data(), H, dhCell.data(), H);
+                dhc = dhCell.data();
+            }
+
+            memset(dhNext.data(), 0, dhNext.size() * sizeof(double));
+
+            for (int b = 0; b < B; b++) {
+                const double *gb  = &st.gates[(tb + b) * GH];
+                const double *dhb = &dhc[size_t(b) * (lw.hasP ? H : P)];
+                double *dzb       = &dzIn[(dir * rows + tb + b) * GH];
+
+                switch (cellMode) {
+                    case CUDNN_RNN_RELU:
+                        for (int k = 0; k < H; k++) {
+                            dzb[k] = gb[k] > 0 ? dhb[k] : 0;
+                        }
+                        break;
+                    case CUDNN_RNN_TANH:
+                        for (int k = 0; k < H; k++) {
+                            dzb[k] = dhb[k] * (1 - gb[k] * gb[k]);
+                        }
+                        break;
+                    case CUDNN_LSTM: {
+                        const double *cb  = &st.c[(tb + b) * H];
+                        const double *cpb = &st.cPrev[(tb + b) * H];
+                        double *dcb       = &dc[size_t(b) * H];
+                        for (int k = 0; k < H; k++) {
+                            const double gi = gb[k];
+                            const double gf = gb[H + k];
+                            const double gg = gb[2 * H + k];
+                            const double go = gb[3 * H + k];
+                            const double tc = tanh(cb[k]);
+                            const double dct = dcb[k] + dhb[k] * go * (1 - tc * tc);
+
+                            dzb[k]         = dct * gg * gi * (1 - gi);
+                            dzb[H + k]     = dct * cpb[k] * gf * (1 - gf);
+                            dzb[2 * H + k] = dct * gi * (1 - gg * gg);
+                            dzb[3 * H + k] = dhb[k] * tc * go * (1 - go);
+
+                            dcb[k] = dct * gf;
+                        }
+                    } break;
+                    case CUDNN_GRU: {
+                        const double *hpb = &st.hPrev[(tb + b) * P];
+                        const double *rhb = &st.rh[(tb + b) * H];
+                        double *dzrb      = &dzRec[(dir * rows + tb + b) * GH];
+                        double *dhnb      = &dhNext[size_t(b) * P];
+                        for (int k = 0; k < H; k++) {
+                            const double gr = gb[k];
+                            const double gz = gb[H + k];
+                            const double gn = gb[2 * H + k];
+                            const double dn = dhb[k] * (1 - gz) * (1 - gn * gn);
+
+                            dzb[k]         = dn * rhb[k] * gr * (1 - gr);
+                            dzb[H + k]     = dhb[k] * (hpb[k] - gn) * gz * (1 - gz);
+                            dzb[2 * H + k] = dn;
+
+                            dzrb[k]         = dzb[k];
+                            dzrb[H + k]     = dzb[H + k];
+                            dzrb[2 * H + k] = dn * gr;
+
+                            dhnb[k] = dhb[k] * gz;
+                        }
+                    } break;
+                    default:
+                        break;
+                }
+            }
+
+            // Gradient of the hidden state entering this time-step, through the recurrent weights.
+            gemmNN(B, P, GH, &dzRec[(dir * rows + tb) * GH], GH, lw.R.data(), P, dhNext.data(), P);
+            dh.swap(dhNext);
+        }
+
+        if (dhx != NULL) {
+            memcpy(dhx + size_t(dir) * B * P, dh.data(), dh.size() * sizeof(double));
+        }
+        if (dcx != NULL) {
+            memcpy(dcx + size_t(dir) * B * H, dc.data(), dc.size() * sizeof(double));
+        }
+    }
+
+    // Gradient of the layer input, summed over directions.
+    const int nBlocks = int((rows + REF_ROW_BLOCK - 1) / REF_ROW_BLOCK);
+
+#pragma omp parallel for schedule(dynamic)
+    for (int blk = 0; blk < nBlocks; blk++) {
+        const size_t r0 = size_t(blk) * REF_ROW_BLOCK;
+        const int nr    = int(rows - r0 < REF_ROW_BLOCK ? rows - r0 : REF_ROW_BLOCK);
+        double *d       = din + r0 * inSize;
+
+        memset(d, 0, size_t(nr) * inSize * sizeof(double));
+
+        for (int dir = 0; dir < dirs; dir++) {
+            const layerWeights &lw = weights[layer * dirs + dir];
+            const double *dz       = &dzIn[(dir * rows + r0) * GH];
+
+            if (lw.hasW) {
+                gemmNN(nr, inSize, GH, dz, GH, lw.W.data(), inSize, d, inSize);
+            } else {
+                for (int r = 0; r < nr; r++) {
+                    for (int j = 0; j < GH; j++) {
+                        d[size_t(r) * inSize + j % H] += dz[size_t(r) * GH + j];
+                    }
+                }
+            }
+        }
+    }
+
+    // Weight and bias gradients, over blocks of output rows of every direction: gates rows of the input and
+    // recurrent weights, followed by the rows of the projection.
+    const int gBlocks = (GH + REF_ROW_BLOCK - 1) / REF_ROW_BLOCK;
+    const int pBlocks = hasP ? (P + REF_ROW_BLOCK - 1) / REF_ROW_BLOCK : 0;
+
+#pragma omp parallel for schedule(dynamic)
+    for (int task = 0; task < dirs * (gBlocks + pBlocks); task++) {
+        const int dir          = task / (gBlocks + pBlocks);
+        const int blk          = task % (gBlocks + pBlocks);
+        const int pl           = layer * dirs + dir;
+        const layerState &st   = states[pl];
+        layerWeights &lg       = grads[pl];
+
+        if (blk < gBlocks) {
+            const int i0       = blk * REF_ROW_BLOCK;
+            const int ni       = (GH - i0 < REF_ROW_BLOCK ? GH - i0 : REF_ROW_BLOCK);
+            const double *dzi  = &dzIn[dir * rows * GH + i0];
+            const double *dzr  = &dzRec[dir * rows * GH + i0];
+
+            if (lg.hasW) {
+                memset(&lg.W[size_t(i0) * inSize], 0, size_t(ni) * inSize * sizeof(double));
+                gemmTN(ni, inSize, rows, dzi, GH, in, inSize, &lg.W[size_t(i0) * inSize], inSize);
+            }
+            memset(&lg.R[size_t(i0) * P], 0, size_t(ni) * P * sizeof(double));
+            gemmTN(ni, P, rows, dzr, GH, st.hPrev.data(), P, &lg.R[size_t(i0) * P], P);
+
+            for (int i = 0; i < ni; i++) {
+                double sumW = 0, sumR = 0;
+                for (size_t r = 0; r < rows; r++) {
+                    sumW += dzi[r * GH + i];
+                    sumR += dzr[r * GH + i];
+                }
+                lg.bW[i0 + i] = sumW;
+                lg.bR[i0 + i] = sumR;
+            }
+        } else {
+            const int i0 = (blk - gBlocks) * REF_ROW_BLOCK;
+            const int ni = (P - i0 < REF_ROW_BLOCK ? P - i0 : REF_ROW_BLOCK);
+
+            memset(&lg.P[size_t(i0) * H], 0, size_t(ni) * H * sizeof(double));
+            gemmTN(ni, H, rows, &dhProj[dir * rows * P + i0], P, st.hCell.data(), H, &lg.P[size_t(i0) * H], H);
+        }
+    }
+}
+
+bool
+rnnRefCompare(const char *tag, const double *res, const double *ref, size_t count, double rtol, double atol) {
+    double refMax = 0;
+    for (size_t i = 0; i < count; i++) {
+        refMax = fmax(refMax, fabs(ref[i]));
+    }
+
+    double absErr   = 0;
+    size_t fails    = 0;
+    size_t reported = 0;
+
+    for (size_t i = 0; i < count; i++) {
+        const double err = fabs(res[i] - ref[i]);
+
+        absErr = fmax(absErr, err);
+
+        // The negated comparison also catches NaNs in the result.
+        if (!(err <= atol * refMax + rtol * fabs(ref[i]))) {
+            if (reported < REF_MAX_REPORTED) {
+                printf("%s_res[%zu]=%+.6e, %s_ref=%+.6e\n", tag, i, res[i], tag, ref[i]);
+                reported++;
+            }
+            fails++;
+        }
+    }
+
+    printf("%s: %s [rel_err=%.6e abs_err=%.6e, rtol=%.6e, atol=%.6e, %zu of %zu mismatched]\n",
+           fails == 0 ? "PASS" : "FAIL",
+           tag,
+           refMax > 0 ? absErr / refMax : absErr,
+           absErr,
+           rtol,
+           atol,
+           fails,
+           count);
+
+    return fails == 0;
+}
@@ -0,0 +1,139 @@
+/**
+ * Copyright 2020 NVIDIA Corporation.  All rights reserved.
+ *
+ * Please refer to the NVIDIA end user license agreement (EULA) associated
+ * with this source code for terms and conditions that govern your use of
+ * this software. Any use, reproduction, disclosure, or distribution of
+ * this software and related documentation outside the terms of the EULA
+ * is strictly prohibited.
+ *
+ */
+
+#if !defined(_RNN_REF_H_)
+#define _RNN_REF_H_
+
+#include <cudnn.h>
+#include <stddef.h>
+
+#include <vector>
+
+// CPU reference of the cuDNN RNN forward training, backward data and backward
+// weights passes, computed in double precision.  All cell modes are covered
+// (RELU, TANH, LSTM with an optional recurrent projection, GRU), with any
+// number of layers, both direction modes, all bias modes and both input modes.
+// Every sequence of the minibatch has the full length, as in the sample.
+//
+// Tensors follow the layouts of the sample: x is [seqLength][miniBatch][inputSize],
+// y is [seqLength][miniBatch][dirs * projSize], hx/hy are [numLayers * dirs][miniBatch][projSize]
+// and cx/cy are [numLayers * dirs][miniBatch][hiddenSize].  Weights are set and
+// read back per pseudo-layer (layer * dirs + direction) and linLayerID, as
+// returned by cudnnGetRNNWeightParams(), in row-major [rows][cols] order.
+//
+// The input projections of all time-steps of a layer are computed up front as
+// one GEMM.  Each time-step then takes one GEMM over the minibatch for the
+// recurrent term, followed by a single fused pass that applies the bias and
+// the activations of all gates.  The directions of a layer are run in
+// parallel with OpenMP, and so are the row blocks of the large GEMMs.
+class RNNRef {
+   public:
+    RNNRef(cudnnRNNMode_t cellMode,
+           cudnnRNNBiasMode_t biasMode,
+           cudnnDirectionMode_t dirMode,
+           cudnnRNNInputMode_t inputMode,
+           int inputSize,
+           int hiddenSize,
+           int projSize,
+           int numLayers,
+           int seqLength,
+           int miniBatch);
+
+    // Number of linLayerID values of a pseudo-layer, including the projection of LSTM.
+    int
+    numLinearLayers() const;
+
+    // Copies one weight matrix and its bias into the model.  NULL stands for
+    // a matrix or bias that the library does not allocate, which is treated
+    // as an identity matrix (skip input) or as a zero bias.  rows and cols are
+    // checked against the expected dimensions.
+    void
+    setLinLayer(int pseudoLayer, int linLayerID, const double *mat, int rows, int cols, const double *bias);
+
+    // Copies out the gradients of one weight matrix and its bias, computed by
+    // backward().  NULL pointers are skipped.
+    void
+    getLinLayerGrad(int pseudoLayer, int linLayerID, double *dmat, double *dbias) const;
+
+    // hx and cx may be NULL, which stands for zero initial states.  hy and cy may be NULL.
+    void
+    forward(const double *x, const double *hx, const double *cx, double *y, double *hy, double *cy);
+
+    // Must follow forward().  dhy and dcy may be NULL, which stands for zero
+    // gradients; dhx and dcx may be NULL.  Weight gradients are overwritten.
+    void
+    backward(const double *dy, const double *dhy, const double *dcy, double *dx, double *dhx, double *dcx);
+
+   private:
+    // Weights of one pseudo-layer.  W is [gates * hiddenSize][layer input size],
+    // R is [gates * hiddenSize][projSize] and P is [projSize][hiddenSize].
+    // WT, RT and PT are their transposes, refreshed by forward(), so that the
+    // inner loops of all GEMMs run over unit stride rows.
+    struct layerWeights {
+        std::vector<double> W, R, bW, bR, P;
+        std::vector<double> WT, RT, PT;
+        bool hasW, hasP;
+    };
+
+    // Activations of one pseudo-layer saved by forward() for backward().
+    // gates holds the activated gates of every time-step, hPrev and cPrev
+    // the states entering each time-step, c the cell states leaving it, hCell
+    // the LSTM output before the projection and rh the GRU recurrent term of
+    // the new memory gate, which the reset gate multiplies.
+    struct layerState {
+        std::vector<double> gates, hPrev, cPrev, c, hCell, rh;
+    };
+
+    int
+    layerInputSize(int layer) const;
+
+    void
+    forwardLayer(int layer, const double *in, const double *hx, const double *cx, double *hy, double *cy);
+
+    void
+    backwardLayer(int layer,
+                  const double *dout,
+                  double *din,
+                  const double *dhy,
+                  const double *dcy,
+                  double *dhx,
+                  double *dcx);
+
+    cudnnRNNMode_t cellMode;
+    cudnnRNNBiasMode_t biasMode;
+    cudnnRNNInputMode_t inputMode;
+
+    int inputSize;
+    int hiddenSize;
+    int projSize;
+    int numLayers;
+    int seqLength;
+    int miniBatch;
+    int dirs;
+    int numGates;
+
+    std::vector<layerWeights> weights;
+    std::vector<layerWeights> grads;
+    std::vector<layerState> states;
+
+    // Inputs of every layer, followed by the output of the last one, as
+    // [seqLength][miniBatch][vector].
+    std::vector<std::vector<double> > layerData;
+};
+
+// Compares a result of the library with the reference under the condition
+// |res - ref| <= atol * max|ref| + rtol * |ref|, where the absolute tolerance
+// is scaled by the largest reference magnitude of the tensor, so that long
+// sums of mixed signs are judged by their scale.  Prints one PASS/FAIL line.
+bool
+rnnRefCompare(const char *tag, const double *res, const double *ref, size_t count, double rtol, double atol);
+
+#endif  // _RNN_REF_H_
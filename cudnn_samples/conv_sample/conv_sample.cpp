@@ -37,6 +37,7 @@
 #include <algorithm>
 #include <chrono>
 #include <iostream>
+#include <vector>
 
 #include "fp16_dev.h"
 #include "fp16_emu.h"
@@ -153,6 +154,12 @@ printPerf(std::chrono::duration<long double> cudaTime,
     }
 }
 
+static void
+printRefPerf(std::chrono::duration<long double> refTime, bool fastRef) {
+    double refDuration = refTime.count();
+    printf("^^^^ CPU %s reference : elapsed = %g sec\n", fastRef ? "fast" : "naive", refDuration);
+}
+
 static void
 generateStrides(const int *dimA, int *strideA, int nbDims, cudnnTensorFormat_t filterFormat) {
     // For INT8x4 and INT8x32 we still compute standard strides here to input
@@ -574,6 +581,489 @@ weightGrad_cpu_ref(const T_ELEM *image,
     }
 }
 
+// Fast host reference, selected with -fastRef. It computes every output with the same doFma sequence as the
+// references above, and so gives the same results, but hoists the index arithmetic and the padding checks out of
+// the inner loops. Outputs are computed in register tiles of REF_TILE_C feature layers by REF_TILE_W pixels of a
+// row, so that every input and filter value which is loaded serves a whole row or column of the tile, and the
+// tiles of the batch and the feature layers are spread over the cores with OpenMP.
+#define REF_TILE_C 8
+#define REF_TILE_W 16
+
+// Geometry of a convolution for the fast reference, in which 2D problems are 3D problems of depth 1.
+// x is the image, y is the output of the convolution and w is the filter; strides are in (n, c, d, h, w) order.
+struct refConvGeom {
+    int n, c, k;
+    int xDims[3], yDims[3], wDims[3];
+    int xStride[5], yStride[5], wStride[5];
+    int stride[3], pad[3], dilation[3];
+};
+
+// Copy the imDims spatial values of src to the last of the three spatial values of dst
+static void
+toRefSpatial(const int *src, int *dst, int imDims, int fill) {
+    for (int d = 0; d < 3; d++) {
+        dst[d] = (d < 3 - imDims) ? fill : src[d - (3 - imDims)];
+    }
+}
+
+static refConvGeom
+makeRefConvGeom(const int *xDims,
+                const int *xStride,
+                const int *yDims,
+                const int *yStride,
+                const int *wDims,
+                const int *wStride,
+                const int *stride,
+                const int *pad,
+                const int *dilation,
+                int nbDims) {
+    int imDims = nbDims - 2;
+
+    refConvGeom g;
+    g.n = xDims[0];
+    g.c = xDims[1];
+    g.k = yDims[1];
+
+    toRefSpatial(xDims + 2, g.xDims, imDims, 1);
+    toRefSpatial(yDims + 2, g.yDims, imDims, 1);
+    toRefSpatial(wDims + 2, g.wDims, imDims, 1);
+
+    for (int i = 0; i < 2; i++) {
+        g.xStride[i] = xStride[i];
+        g.yStride[i] = yStride[i];
+        g.wStride[i] = wStride[i];
+    }
+    toRefSpatial(xStride + 2, g.xStride + 2, imDims, 0);
+    toRefSpatial(yStride + 2, g.yStride + 2, imDims, 0);
+    toRefSpatial(wStride + 2, g.wStride + 2, imDims, 0);
+
+    toRefSpatial(stride, g.stride, imDims, 1);
+    toRefSpatial(pad, g.pad, imDims, 0);
+    toRefSpatial(dilation, g.dilation, imDims, 1);
+    return g;
+}
+
+// Find the range [*lo, *hi) of the j in [0, count) for which start + j * step lies in [begin, end)
+static void
+refStridedRange(int start, int step, int count, int begin, int end, int *lo, int *hi) {
+    *lo = (start >= begin) ? 0 : (begin - start + step - 1) / step;
+    *hi = (start >= end) ? 0 : std::min(count, (end - 1 - start) / step + 1);
+}
+
+// The fast reference reads half tensors as floats, which doFma converts every element to anyway
+template <typename T_ELEM>
+struct refMathElem {
+    typedef T_ELEM type;
+};
+
+template <>
+struct refMathElem<half1> {
+    typedef float type;
+};
+
+template <typename T_ELEM>
+static const T_ELEM *
+refElems(const T_ELEM *data, size_t, std::vector<T_ELEM> &) {
+    return data;
+}
+
+static const float *
+refElems(const half1 *data, size_t count, std::vector<float> &buffer) {
+    buffer.resize(count);
+    for (size_t i = 0; i < count; i++) {
+        buffer[i] = cpu_half2float(data[i]);
+    }
+    return buffer.data();
+}
+
+template <typename T_IN, typename T_OUT, typename T_MATH>
+static void
+conv_cpu_fast_tiles(const T_IN *x,
+                    const T_IN *w,
+                    T_OUT *y,
+                    float alpha,
+                    float beta,
+                    int resizeFactor,
+                    const refConvGeom &g) {
+    const int rf     = resizeFactor;
+    const int T      = g.wDims[0];
+    const int R      = g.wDims[1];
+    const int S      = g.wDims[2];
+    const int kTiles = (g.k + REF_TILE_C - 1) / REF_TILE_C;
+
+#pragma omp parallel for schedule(dynamic)
+    for (int tile = 0; tile < g.n * kTiles; tile++) {
+        const int ni = tile / kTiles;
+        const int k0 = (tile % kTiles) * REF_TILE_C;
+        const int kn = std::min(REF_TILE_C, g.k - k0);
+
+        T_MATH acc[REF_TILE_C][REF_TILE_W];
+        T_IN xv[REF_TILE_W];
+
+        for (int od = 0; od < g.yDims[0]; od++) {
+            for (int oh = 0; oh < g.yDims[1]; oh++) {
+                for (int ow0 = 0; ow0 < g.yDims[2]; ow0 += REF_TILE_W) {
+                    const int wn = std::min(REF_TILE_W, g.yDims[2] - ow0);
+
+                    for (int kb = 0; kb < REF_TILE_C; kb++) {
+                        for (int wb = 0; wb < REF_TILE_W; wb++) {
+                            acc[kb][wb] = 0;
+                        }
+                    }
+
+                    for (int ci = 0; ci < g.c / rf; ci++) {
+                        const int xOffset = ni * g.xStride[0] / rf + ci * g.xStride[1];
+                        // The filter is flipped, as in conv_cpu_ref
+                        for (int t = 0; t < T; t++) {
+                            const int id = od * g.stride[0] - g.pad[0] + g.dilation[0] * (T - 1 - t);
+                            if (id < 0 || id >= g.xDims[0]) {
+                                continue;
+                            }
+                            for (int r = 0; r < R; r++) {
+                                const int ih = oh * g.stride[1] - g.pad[1] + g.dilation[1] * (R - 1 - r);
+                                if (ih < 0 || ih >= g.xDims[1]) {
+                                    continue;
+                                }
+                                const int xRow = xOffset + id * g.xStride[2] + ih * g.xStride[3];
+                                for (int s = 0; s < S; s++) {
+                                    // Pixel ow0 + wb of the tile reads the input at iw0 + wb * stride
+                                    const int iw0 = ow0 * g.stride[2] - g.pad[2] + g.dilation[2] * (S - 1 - s);
+                                    int wLo, wHi;
+                                    refStridedRange(iw0, g.stride[2], wn, 0, g.xDims[2], &wLo, &wHi);
+
+                                    const int wPix =
+                                        ci * g.wStride[1] + t * g.wStride[2] + r * g.wStride[3] + s * g.wStride[4];
+                                    if (rf == 1) {
+                                        for (int wb = wLo; wb < wHi; wb++) {
+                                            xv[wb] = x[xRow + (iw0 + wb * g.stride[2]) * g.xStride[4]];
+                                        }
+                                        for (int kb = 0; kb < kn; kb++) {
+                                            const T_IN fval = w[(k0 + kb) * g.wStride[0] + wPix];
+                                            for (int wb = wLo; wb < wHi; wb++) {
+                                                acc[kb][wb] = doFma(fval, xv[wb], acc[kb][wb]);
+                                            }
+                                        }
+                                        continue;
+                                    }
+                                    // Vectorized layouts keep the packed feature layers contiguous in both
+                                    // tensors, so that their contribution is a dot product
+                                    for (int kb = 0; kb < kn; kb++) {
+                                        const T_IN *wVec = &w[((k0 + kb) * g.wStride[0] / rf + wPix) * rf];
+                                        for (int wb = wLo; wb < wHi; wb++) {
+                                            const int iw     = iw0 + wb * g.stride[2];
+                                            const T_IN *xVec = &x[(xRow + iw * g.xStride[4]) * rf];
+                                            T_MATH tmp       = acc[kb][wb];
+                                            for (int i = 0; i < rf; i++) {
+                                                tmp = doFma(wVec[i], xVec[i], tmp);
+                                            }
+                                            acc[kb][wb] = tmp;
+                                        }
+                                    }
+                                }
+                            }
+                        }
+                    }
+
+                    for (int kb = 0; kb < kn; kb++) {
+                        const int ki      = k0 + kb;
+                        const int yOffset = ni * g.yStride[0] / rf + (ki / rf) * g.yStride[1] + od * g.yStride[2] +
+                                            oh * g.yStride[3];
+                        for (int wb = 0; wb < wn; wb++) {
+                            const int yIdx = (yOffset + (ow0 + wb) * g.yStride[4]) * rf + ki % rf;
+                            doEpilog(y, yIdx, alpha * acc[kb][wb], beta);
+                        }
+                    }
+                }
+            }
+        }
+    }
+}
+
+// Same arguments and results as conv_cpu_ref
+template <typename T_ELEM, typename T_MATH>
+static void
+conv_cpu_fast(const T_ELEM *inputData,
+              const T_ELEM *filterData,
+              T_ELEM *outputData,
+              float alpha,
+              float beta,
+              int resizeFactor,
+              cudnnTensorFormat_t filterFormat,
+              const int *inDims,
+              const int *filDims,
+              const int *outDims,
+              const int *inStride,
+              const int *outStride,
+              const int *stride,
+              const int *pad,
+              const int *dilation,
+              int nbDims) {
+    typedef typename refMathElem<T_ELEM>::type T_IN;
+
+    int filStride[8] = {0};
+    generateStrides(filDims, filStride, nbDims, filterFormat);
+
+    refConvGeom g =
+        makeRefConvGeom(inDims, inStride, outDims, outStride, filDims, filStride, stride, pad, dilation, nbDims);
+
+    std::vector<T_IN> inBuffer, filBuffer;
+    const T_IN *x = refElems(inputData, size_t(inDims[0]) * inStride[0], inBuffer);
+    const T_IN *w = refElems(filterData, size_t(filDims[0]) * filStride[0], filBuffer);
+
+    conv_cpu_fast_tiles<T_IN, T_ELEM, T_MATH>(x, w, outputData, alpha, beta, resizeFactor, g);
+}
+
+template <typename T_IN, typename T_OUT>
+static void
+dataGrad_cpu_fast_tiles(const T_IN *w,
+                        const T_IN *dy,
+                        T_OUT *dx,
+                        float alpha,
+                        float beta,
+                        const refConvGeom &g,
+                        bool isConv) {
+    const int T      = g.wDims[0];
+    const int R      = g.wDims[1];
+    const int S      = g.wDims[2];
+    const int cTiles = (g.c + REF_TILE_C - 1) / REF_TILE_C;
+
+#pragma omp parallel for schedule(dynamic)
+    for (int tile = 0; tile < g.n * cTiles; tile++) {
+        const int ni = tile / cTiles;
+        const int c0 = (tile % cTiles) * REF_TILE_C;
+        const int cn = std::min(REF_TILE_C, g.c - c0);
+
+        float acc[REF_TILE_C][REF_TILE_W];
+        T_IN dv[REF_TILE_W];
+
+        for (int xd = 0; xd < g.xDims[0]; xd++) {
+            for (int xh = 0; xh < g.xDims[1]; xh++) {
+                for (int xw0 = 0; xw0 < g.xDims[2]; xw0 += REF_TILE_W) {
+                    const int wn = std::min(REF_TILE_W, g.xDims[2] - xw0);
+
+                    for (int cb = 0; cb < REF_TILE_C; cb++) {
+                        for (int wb = 0; wb < REF_TILE_W; wb++) {
+                            acc[cb][wb] = 0.f;
+                        }
+                    }
+
+                    for (int ki = 0; ki < g.k; ki++) {
+                        const int dyOffset = ni * g.yStride[0] + ki * g.yStride[1];
+                        // As in dataGrad_cpu_ref, only the diff pixels which lie on the stride contribute
+                        for (int t = 0; t < T; t++) {
+                            int pd = xd + g.pad[0] - (isConv ? (T - 1 - t) : t) * g.dilation[0];
+                            if (pd % g.stride[0]) {
+                                continue;
+                            }
+                            pd /= g.stride[0];
+                            if (pd < 0 || pd >= g.yDims[0]) {
+                                continue;
+                            }
+                            for (int r = 0; r < R; r++) {
+                                int ph = xh + g.pad[1] - (isConv ? (R - 1 - r) : r) * g.dilation[1];
+                                if (ph % g.stride[1]) {
+                                    continue;
+                                }
+                                ph /= g.stride[1];
+                                if (ph < 0 || ph >= g.yDims[1]) {
+                                    continue;
+                                }
+                                const int dyRow = dyOffset + pd * g.yStride[2] + ph * g.yStride[3];
+                                for (int s = 0; s < S; s++) {
+                                    // Diff pixel q reaches pixel xw0 + wb of the tile, with wb = wb0 + q * stride
+                                    const int wb0 = (isConv ? (S - 1 - s) : s) * g.dilation[2] - g.pad[2] - xw0;
+                                    int qLo, qHi;
+                                    refStridedRange(wb0, g.stride[2], g.yDims[2], 0, wn, &qLo, &qHi);
+
+                                    for (int q = qLo; q < qHi; q++) {
+                                        dv[q - qLo] = dy[dyRow + q * g.yStride[4]];
+                                    }
+                                    for (int cb = 0; cb < cn; cb++) {
+                                        const T_IN fval = w[ki * g.wStride[0] + (c0 + cb) * g.wStride[1] +
+                                                            t * g.wStride[2] + r * g.wStride[3] + s * g.wStride[4]];
+                                        for (int q = qLo; q < qHi; q++) {
+                                            const int wb = wb0 + q * g.stride[2];
+                                            acc[cb][wb]  = doFma(fval, dv[q - qLo], acc[cb][wb]);
+                                        }
+                                    }
+                                }
+                            }
+                        }
+                    }
+
+                    for (int cb = 0; cb < cn; cb++) {
+                        const int xOffset =
+                            ni * g.xStride[0] + (c0 + cb) * g.xStride[1] + xd * g.xStride[2] + xh * g.xStride[3];
+                        for (int wb = 0; wb < wn; wb++) {
+                            doEpilog(dx, xOffset + (xw0 + wb) * g.xStride[4], alpha * acc[cb][wb], beta);
+                        }
+                    }
+                }
+            }
+        }
+    }
+}
+
+// Same arguments and results as dataGrad_cpu_ref
+template <typename T_ELEM>
+static void
+dataGrad_cpu_fast(const T_ELEM *weight,
+                  const T_ELEM *top_diff,
+                  T_ELEM *output,
+                  float alpha,
+                  float beta,
+                  cudnnTensorFormat_t filterFormat,
+                  const int *inDims,
+                  const int *filDims,
+                  const int *outDims,
+                  const int *inStride,
+                  const int *outStride,
+                  const int *stride,
+                  const int *pad,
+                  const int *dilation,
+                  int nbDims,
+                  cudnnConvolutionMode_t mode) {
+    typedef typename refMathElem<T_ELEM>::type T_IN;
+
+    int filStride[8] = {0};
+    generateStrides(filDims, filStride, nbDims, filterFormat);
+
+    // The image of the convolution is the output of the data gradient, and its output is the diff
+    refConvGeom g =
+        makeRefConvGeom(outDims, outStride, inDims, inStride, filDims, filStride, stride, pad, dilation, nbDims);
+
+    std::vector<T_IN> filBuffer, diffBuffer;
+    const T_IN *w  = refElems(weight, size_t(filDims[0]) * filStride[0], filBuffer);
+    const T_IN *dy = refElems(top_diff, size_t(inDims[0]) * inStride[0], diffBuffer);
+
+    dataGrad_cpu_fast_tiles<T_IN, T_ELEM>(w, dy, output, alpha, beta, g, mode == CUDNN_CONVOLUTION);
+}
+
+template <typename T_IN, typename T_OUT>
+static void
+weightGrad_cpu_fast_tiles(const T_IN *x, const T_IN *dy, float alpha, float beta, T_OUT *dw, const refConvGeom &g) {
+    const int T      = g.wDims[0];
+    const int R      = g.wDims[1];
+    const int S      = g.wDims[2];
+    const int Q      = g.yDims[2];
+    const int nPix   = T * R * S;
+    const int kTiles = (g.k + REF_TILE_C - 1) / REF_TILE_C;
+
+#pragma omp parallel
+    {
+        // The accumulators of the filter elements of the tile, and the rows of the diff which the tile reads,
+        // both with the feature layers innermost
+        std::vector<float> acc(REF_TILE_C * nPix);
+        std::vector<T_IN> dv(REF_TILE_C * Q, T_IN(0));
+
+#pragma omp for schedule(dynamic)
+        for (int tile = 0; tile < kTiles * g.c; tile++) {
+            const int k0 = (tile / g.c) * REF_TILE_C;
+            const int ci = tile % g.c;
+            const int kn = std::min(REF_TILE_C, g.k - k0);
+
+            std::fill(acc.begin(), acc.end(), 0.f);
+
+            for (int ni = 0; ni < g.n; ni++) {
+                const int xOffset = ni * g.xStride[0] + ci * g.xStride[1];
+                for (int pd = 0; pd < g.yDims[0]; pd++) {
+                    for (int ph = 0; ph < g.yDims[1]; ph++) {
+                        for (int kb = 0; kb < kn; kb++) {
+                            const int dyRow = ni * g.yStride[0] + (k0 + kb) * g.yStride[1] + pd * g.yStride[2] +
+                                              ph * g.yStride[3];
+                            for (int q = 0; q < Q; q++) {
+                                dv[q * REF_TILE_C + kb] = dy[dyRow + q * g.yStride[4]];
+                            }
+                        }
+                        // The filter is flipped, as in weightGrad_cpu_ref
+                        for (int t = 0; t < T; t++) {
+                            const int id = pd * g.stride[0] - g.pad[0] + (T - 1 - t) * g.dilation[0];
+                            if (id < 0 || id >= g.xDims[0]) {
+                                continue;
+                            }
+                            for (int r = 0; r < R; r++) {
+                                const int ih = ph * g.stride[1] - g.pad[1] + (R - 1 - r) * g.dilation[1];
+                                if (ih < 0 || ih >= g.xDims[1]) {
+                                    continue;
+                                }
+                                const int xRow = xOffset + id * g.xStride[2] + ih * g.xStride[3];
+                                for (int s = 0; s < S; s++) {
+                                    // Diff pixel q reads the image at iw0 + q * stride
+                                    const int iw0 = (S - 1 - s) * g.dilation[2] - g.pad[2];
+                                    int qLo, qHi;
+                                    refStridedRange(iw0, g.stride[2], Q, 0, g.xDims[2], &qLo, &qHi);
+
+                                    // The accumulators of this filter pixel stay in registers over the row;
+                                    // those of the feature layers past the end of the tile are never stored
+                                    float *pixAcc = &acc[((t * R + r) * S + s) * REF_TILE_C];
+                                    float tmp[REF_TILE_C];
+                                    for (int kb = 0; kb < REF_TILE_C; kb++) {
+                                        tmp[kb] = pixAcc[kb];
+                                    }
+                                    for (int q = qLo; q < qHi; q++) {
+                                        const T_IN xval = x[xRow + (iw0 + q * g.stride[2]) * g.xStride[4]];
+                                        for (int kb = 0; kb < REF_TILE_C; kb++) {
+                                            tmp[kb] = doFma(dv[q * REF_TILE_C + kb], xval, tmp[kb]);
+                                        }
+                                    }
+                                    for (int kb = 0; kb < REF_TILE_C; kb++) {
+                                        pixAcc[kb] = tmp[kb];
+                                    }
+                                }
+                            }
+                        }
+                    }
+                }
+            }
+
+            for (int kb = 0; kb < kn; kb++) {
+                for (int t = 0; t < T; t++) {
+                    for (int r = 0; r < R; r++) {
+                        for (int s = 0; s < S; s++) {
+                            const int wIdx = (k0 + kb) * g.wStride[0] + ci * g.wStride[1] + t * g.wStride[2] +
+                                             r * g.wStride[3] + s * g.wStride[4];
+                            doEpilog(dw, wIdx, alpha * acc[((t * R + r) * S + s) * REF_TILE_C + kb], beta);
+                        }
+                    }
+                }
+            }
+        }
+    }
+}
+
+// Same arguments and results as weightGrad_cpu_ref
+template <typename T_ELEM>
+static void
+weightGrad_cpu_fast(const T_ELEM *image,
+                    const T_ELEM *diffData,
+                    float alpha,
+                    float beta,
+                    T_ELEM *output,
+                    cudnnTensorFormat_t filterFormat,
+                    const int *inDims,
+                    const int *filDims,
+                    const int *diffDims,
+                    const int *inStride,
+                    const int *diffStride,
+                    const int *stride,
+                    const int *pad,
+                    const int *dilation,
+                    int nbDims) {
+    typedef typename refMathElem<T_ELEM>::type T_IN;
+
+    int filStride[8] = {0};
+    generateStrides(filDims, filStride, nbDims, filterFormat);
+
+    refConvGeom g =
+        makeRefConvGeom(inDims, inStride, diffDims, diffStride, filDims, filStride, stride, pad, dilation, nbDims);
+
+    std::vector<T_IN> imageBuffer, diffBuffer;
+    const T_IN *x  = refElems(image, size_t(inDims[0]) * inStride[0], imageBuffer);
+    const T_IN *dy = refElems(diffData, size_t(diffDims[0]) * diffStride[0], diffBuffer);
+
+    weightGrad_cpu_fast_tiles<T_IN, T_ELEM>(x, dy, alpha, beta, output, g);
+}
+
 float
 getError(float dev, float ref) {
     if (ref > 1.0 || ref < -1.0)
@@ -675,7 +1165,8 @@ doConv(cudnnHandle_t handle_,
        const int *convstrideA,
        const int *padA,
        const int *dilationA,
-       const int benchmark) {
+       const int benchmark,
+       bool fastRef) {
     int outsize          = outstrideA[0] * outdimA[0];
     T_ELEM *hostOfromdev = (T_ELEM *)calloc(outsize, sizeof(hostO[0]));
 
@@ -716,65 +1207,68 @@ doConv(cudnnHandle_t handle_,
     checkCudaErr(cudaDeviceSynchronize());
 
     if (!benchmark) {
+        start = std::chrono::steady_clock::now();
         // Pass in resize factor for the cpu reference solution, this is the number
         // of packed variables in each element of the tensor
         if (filterFormat == CUDNN_TENSOR_NCHW_VECT_C) {
             if (dataType == CUDNN_DATA_INT8x4) {  // resizeFactor = 4
-                conv_cpu_ref<T_ELEM, int32_t>(hostI,
-                                              hostF,
-                                              hostO,
-                                              alpha,
-                                              beta,
-                                              4,
-                                              filterFormat,
-                                              dimA,
-                                              filterdimA,
-                                              outdimA,
-                                              strideA,
-                                              outstrideA,
-                                              convstrideA,
-                                              padA,
-                                              dilationA,
-                                              4);
+                (fastRef ? conv_cpu_fast<T_ELEM, int32_t> : conv_cpu_ref<T_ELEM, int32_t>)(hostI,
+                                                                                           hostF,
+                                                                                           hostO,
+                                                                                           alpha,
+                                                                                           beta,
+                                                                                           4,
+                                                                                           filterFormat,
+                                                                                           dimA,
+                                                                                           filterdimA,
+                                                                                           outdimA,
+                                                                                           strideA,
+                                                                                           outstrideA,
+                                                                                           convstrideA,
+                                                                                           padA,
+                                                                                           dilationA,
+                                                                                           4);
             } else if (dataType == CUDNN_DATA_INT8x32) {  // resizeFactor = 32
-                conv_cpu_ref<T_ELEM, int32_t>(hostI,
-                                              hostF,
-                                              hostO,
-                                              alpha,
-                                              beta,
-                                              32,
-                                              filterFormat,
-                                              dimA,
-                                              filterdimA,
-                                              outdimA,
-                                              strideA,
-                                              outstrideA,
-                                              convstrideA,
-                                              padA,
-                                              dilationA,
-                                              4);
+                (fastRef ? conv_cpu_fast<T_ELEM, int32_t> : conv_cpu_ref<T_ELEM, int32_t>)(hostI,
+                                                                                           hostF,
+                                                                                           hostO,
+                                                                                           alpha,
+                                                                                           beta,
+                                                                                           32,
+                                                                                           filterFormat,
+                                                                                           dimA,
+                                                                                           filterdimA,
+                                                                                           outdimA,
+                                                                                           strideA,
+                                                                                           outstrideA,
+                                                                                           convstrideA,
+                                                                                           padA,
+                                                                                           dilationA,
+                                                                                           4);
             } else {
                 printf("CUDNN_TENSOR_NCHW_VECT_C only supports INT8x4 and INT8x32");
                 return 1;
             }
         } else {
-            conv_cpu_ref<T_ELEM, float>(hostI,
-                                        hostF,
-                                        hostO,
-                                        alpha,
-                                        beta,
-                                        1,
-                                        filterFormat,
-                                        dimA,
-                                        filterdimA,
-                                        outdimA,
-                                        strideA,
-                                        outstrideA,
-                                        convstrideA,
-                                        padA,
-                                        dilationA,
-                                        4);
+            (fastRef ? conv_cpu_fast<T_ELEM, float> : conv_cpu_ref<T_ELEM, float>)(hostI,
+                                                                                   hostF,
+                                                                                   hostO,
+                                                                                   alpha,
+                                                                                   beta,
+                                                                                   1,
+                                                                                   filterFormat,
+                                                                                   dimA,
+                                                                                   filterdimA,
+                                                                                   outdimA,
+                                                                                   strideA,
+                                                                                   outstrideA,
+                                                                                   convstrideA,
+                                                                                   padA,
+                                                                                   dilationA,
+                                                                                   4);
         }
+        stop = std::chrono::steady_clock::now();
+        printRefPerf(std::chrono::duration<long double>(stop - start), fastRef);
 
         for (int index = 0; index < outsize; index++) {
             float diff = getError(hostOfromdev[index], hostO[index]);
@@ -820,6 +1314,7 @@ doDgrad(cudnnHandle_t handle_,
         const int *padA,
         const int *dilationA,
         const int benchmark,
+        bool fastRef,
         const bool fold,
         cudnnConvolutionMode_t mode) {
     int insize           = strideA[0] * dimA[0];
@@ -1006,22 +1501,26 @@ doDgrad(cudnnHandle_t handle_,
     checkCudaErr(cudaDeviceSynchronize());
 
     if (!benchmark) {
-        dataGrad_cpu_ref<T_ELEM>(hostF,
-                                 hostO,
-                                 hostI,
-                                 alpha,
-                                 beta,
-                                 filterFormat,
-                                 outdimA,
-                                 filterdimA,
-                                 dimA,
-                                 outstrideA,
-                                 strideA,
-                                 convstrideA,
-                                 padA,
-                                 dilationA,
-                                 4,
-                                 mode);
+        start = std::chrono::steady_clock::now();
+        (fastRef ? dataGrad_cpu_fast<T_ELEM> : dataGrad_cpu_ref<T_ELEM>)(hostF,
+                                                                         hostO,
+                                                                         hostI,
+                                                                         alpha,
+                                                                         beta,
+                                                                         filterFormat,
+                                                                         outdimA,
+                                                                         filterdimA,
+                                                                         dimA,
+                                                                         outstrideA,
+                                                                         strideA,
+                                                                         convstrideA,
+                                                                         padA,
+                                                                         dilationA,
+                                                                         4,
+                                                                         mode);
+        stop = std::chrono::steady_clock::now();
+        printRefPerf(std::chrono::duration<long double>(stop - start), fastRef);
+
         for (int index = 0; index < insize; index++) {  // assuming in data is packed
             float diff = getError(hostIfromdev[index], hostI[index]);
             if (diff < 0) diff = -diff;
@@ -1063,7 +1562,8 @@ doWgrad(cudnnHandle_t handle_,
         const int *convstrideA,
         const int *padA,
         const int *dilationA,
-        const int benchmark) {
+        const int benchmark,
+        bool fastRef) {
     int filsize                          = filterdimA[0] * filterdimA[1] * filterdimA[2] * filterdimA[3];
     T_ELEM *hostFfromdev                 = (T_ELEM *)calloc(filsize, sizeof(hostF[0]));
     cudnnConvolutionBwdFilterAlgo_t algo = CUDNN_CONVOLUTION_BWD_FILTER_ALGO_1;
@@ -1102,21 +1602,25 @@ doWgrad(cudnnHandle_t handle_,
     checkCudaErr(cudaDeviceSynchronize());
 
     if (!benchmark) {
-        weightGrad_cpu_ref<T_ELEM>(hostI,
-                                   hostO,
-                                   alpha,
-                                   beta,
-                                   hostF,
-                                   filterFormat,
-                                   dimA,
-                                   filterdimA,
-                                   outdimA,
-                                   strideA,
-                                   outstrideA,
-                                   convstrideA,
-                                   padA,
-                                   dilationA,
-                                   4);
+        start = std::chrono::steady_clock::now();
+        (fastRef ? weightGrad_cpu_fast<T_ELEM> : weightGrad_cpu_ref<T_ELEM>)(hostI,
+                                                                             hostO,
+                                                                             alpha,
+                                                                             beta,
+                                                                             hostF,
+                                                                             filterFormat,
+                                                                             dimA,
+                                                                             filterdimA,
+                                                                             outdimA,
+                                                                             strideA,
+                                                                             outstrideA,
+                                                                             convstrideA,
+                                                                             padA,
+                                                                             dilationA,
+                                                                             4);
+        stop = std::chrono::steady_clock::now();
+        printRefPerf(std::chrono::duration<long double>(stop - start), fastRef);
+
         for (int index = 0; index < filsize; index++) {  // assuming in data is packed
             float diff = getError(hostFfromdev[index], hostF[index]);
             if (diff < 0) diff = -diff;
@@ -1145,6 +1649,7 @@ doTest(int algo,
        cudnnDataType_t dataType,
        int mathType,
        int benchmark,
+       bool fastRef,
        bool fold,
        cudnnConvolutionMode_t mode) {
     cudnnHandle_t handle_;
@@ -1325,7 +1830,8 @@ doTest(int algo,
                            convstrideA,
                            padA,
                            dilationA,
-                           benchmark);
+                           benchmark,
+                           fastRef);
     } else if (algo == 1) {
         printf("Testing dgrad\n");
         numErrors = doDgrad(handle_,
@@ -1351,6 +1857,7 @@ doTest(int algo,
                             padA,
                             dilationA,
                             benchmark,
+                            fastRef,
                             fold,
                             mode);
     } else {
@@ -1377,7 +1884,8 @@ doTest(int algo,
                             convstrideA,
                             padA,
                             dilationA,
-                            benchmark);
+                            benchmark,
+                            fastRef);
     }
 
     if (!benchmark) {
@@ -1501,6 +2009,7 @@ main(int argc, char **argv) {
 
     cudnnTensorFormat_t filterFormat = CUDNN_TENSOR_NCHW;
     bool fold                        = false;
+    bool fastRef                     = false;
     cudnnConvolutionMode_t mode      = CUDNN_CONVOLUTION;
 
     cudnnTransformNCHWtype transformNCHWType = CUDNN_NO_TRANSFORM;
@@ -1539,6 +2048,9 @@ main(int argc, char **argv) {
                     if (strncmp(argv[0] + 1, "fold", strlen("fold")) == 0) {
                         fold = true;
                     }
+                    if (strncmp(argv[0] + 1, "fastRef", strlen("fastRef")) == 0) {
+                        fastRef = true;
+                    }
 
                     break;
                 case 'h':
@@ -1631,11 +2143,31 @@ main(int argc, char **argv) {
         }
 
         printf("Testing single precision\n");
-        ret += doTest<float>(
-            algo, dimA, padA, convstrideA, filterdimA, filterFormat, CUDNN_DATA_FLOAT, mathType, benchmark, fold, mode);
+        ret += doTest<float>(algo,
+                             dimA,
+                             padA,
+                             convstrideA,
+                             filterdimA,
+                             filterFormat,
+                             CUDNN_DATA_FLOAT,
+                             mathType,
+                             benchmark,
+                             fastRef,
+                             fold,
+                             mode);
         printf("Testing half precision (math in single precision)\n");
-        ret += doTest<half1>(
-            algo, dimA, padA, convstrideA, filterdimA, filterFormat, CUDNN_DATA_HALF, mathType, benchmark, fold, mode);
+        ret += doTest<half1>(algo,
+                             dimA,
+                             padA,
+                             convstrideA,
+                             filterdimA,
+                             filterFormat,
+                             CUDNN_DATA_HALF,
+                             mathType,
+                             benchmark,
+                             fastRef,
+                             fold,
+                             mode);
     } else {
         printf(
             "Using format CUDNN_TENSOR_NCHW_VECT_C (for single and double "
@@ -1660,6 +2192,7 @@ main(int argc, char **argv) {
                                       CUDNN_DATA_INT8x4,
                                       mathType,
                                       benchmark,
+                                      fastRef,
                                       fold,
                                       mode);
             }
@@ -1677,6 +2210,7 @@ main(int argc, char **argv) {
                                       CUDNN_DATA_INT8x32,
                                       mathType,
                                       benchmark,
+                                      fastRef,
                                       fold,
                                       mode);
             }
@@ -28,3 +28,8 @@
 #Use the following arguments to run sample dgrad with folding:
 ./conv_sample -dgrad -c1024 -h14 -w14 -k2048 -r1 -s1 -pad_h0 -pad_w0 -u2 -v2 -fold
 
+
+#Use the following arguments to check the results with the fast CPU reference:
+./conv_sample -c256 -h14 -w14 -k256 -r3 -s3 -pad_h1 -pad_w1 -u1 -v1 -fastRef
+./conv_sample -dgrad -c1024 -h14 -w14 -k512 -r1 -s1 -pad_h0 -pad_w0 -u2 -v2 -fastRef
+./conv_sample -wgrad -c512 -h7 -w7 -k512 -r3 -s3 -pad_h1 -pad_w1 -u1 -v1 -fastRef
@@ -26,6 +26,9 @@
 #include <fstream>
 #include <stdlib.h>
 
+#include <chrono>
+#include <vector>
+
 #include <cuda.h>  // need CUDA_VERSION
 #include <cudnn.h>
 
@@ -34,6 +37,7 @@
 #include "fp16_emu.h"
 #include "gemv.h"
 #include "error_util.h"
+#include "network_cpu.h"
 
 #define IMAGE_H 28
 #define IMAGE_W 28
@@ -42,6 +46,12 @@ const char* first_image  = "one_28x28.pgm";
 const char* second_image = "three_28x28.pgm";
 const char* third_image  = "five_28x28.pgm";
 
+// Digits of the three images above
+const int image_labels[] = {1, 3, 5};
+
+// Passes over the batch timed by the host benchmark
+#define HOST_BENCH_ITERATIONS 10
+
 const char* conv1_bin      = "conv1.bin";
 const char* conv1_bias_bin = "conv1.bias.bin";
 const char* conv2_bin      = "conv2.bin";
@@ -762,6 +772,135 @@ network_t<half1>::fullyConnectedForward(const Layer_t<half1>& ip,
 }
 #endif
 
+static std::vector<layerSpec_t>
+hostLayerSpecs(const char* pname) {
+    // inputs, outputs and kernel_dim of conv1, conv2, ip1 and ip2, as in main()
+    const layerSpec_t specs[] = {{1, 20, 5, conv1_bin, conv1_bias_bin},
+                                 {20, 50, 5, conv2_bin, conv2_bias_bin},
+                                 {800, 500, 1, ip1_bin, ip1_bias_bin},
+                                 {500, 10, 1, ip2_bin, ip2_bias_bin}};
+    std::vector<layerSpec_t> result(specs, specs + sizeof(specs) / sizeof(specs[0]));
+    for (size_t i = 0; i < result.size(); i++) {
+        get_path(result[i].weights_bin, specs[i].weights_bin.c_str(), pname);
+        get_path(result[i].bias_bin, specs[i].bias_bin.c_str(), pname);
+    }
+    return result;
+}
+
+// Classifies the three images on the host, then times the classification of
+// a batch of them, and checks every prediction
+template <class value_type>
+static void
+testOnHost(const packedModel_t& model, const char* pname, int batch) {
+    const char* images[] = {first_image, second_image, third_image};
+    const int numImages  = sizeof(images) / sizeof(images[0]);
+    const int imageSize  = IMAGE_H * IMAGE_W;
+    std::string image_path;
+
+    std::vector<float> imgData_h(numImages * imageSize);
+    for (int i = 0; i < numImages; i++) {
+        get_path(image_path, images[i], pname);
+        readImage(image_path.c_str(), &imgData_h[i * imageSize]);
+    }
+    for (size_t i = 0; i < imgData_h.size(); i++) {
+        imgData_h[i] = cpuRound<value_type>(imgData_h[i]);
+    }
+
+    network_cpu_t<value_type> mnist;
+    std::vector<int> ids(numImages);
+    std::vector<float> probs(numImages * 10);
+
+    std::cout << "Performing forward propagation ...\n";
+    mnist.classify_batch(model, numImages, IMAGE_H, IMAGE_W, &imgData_h[0], &ids[0], &probs[0]);
+
+    std::cout.precision(7);
+    std::cout.setf(std::ios::fixed, std::ios::floatfield);
+    for (int i = 0; i < numImages; i++) {
+        std::cout << "Resulting weights from Softmax:" << std::endl;
+        for (int j = 0; j < 10; j++) {
+            std::cout << probs[i * 10 + j] << " ";
+        }
+        std::cout << std::endl;
+    }
+
+    std::cout << "\nResult of classification: " << ids[0] << " " << ids[1] << " " << ids[2] << std::endl;
+    for (int i = 0; i < numImages; i++) {
+        if (ids[i] != image_labels[i]) {
+            std::cout << "\nTest failed!\n";
+            FatalError("Prediction mismatch");
+        }
+    }
+
+    // a batch of copies of the three images, after one pass to warm up
+    std::vector<float> batchData((size_t)batch * imageSize);
+    for (int b = 0; b < batch; b++) {
+        memcpy(&batchData[(size_t)b * imageSize], &imgData_h[(b % numImages) * imageSize], imageSize * sizeof(float));
+    }
+    ids.resize(batch);
+    mnist.classify_batch(model, batch, IMAGE_H, IMAGE_W, &batchData[0], &ids[0]);
+
+    std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+    for (int it = 0; it < HOST_BENCH_ITERATIONS; it++) {
+        mnist.classify_batch(model, batch, IMAGE_H, IMAGE_W, &batchData[0], &ids[0]);
+    }
+    double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+    printf("Classified %d images in batches of %d: %.3f ms per batch, %.1f images/sec\n",
+           HOST_BENCH_ITERATIONS * batch,
+           batch,
+           1e3 * seconds / HOST_BENCH_ITERATIONS,
+           HOST_BENCH_ITERATIONS * batch / seconds);
+
+    for (int b = 0; b < batch; b++) {
+        if (ids[b] != image_labels[b % numImages]) {
+            std::cout << "\nTest failed!\n";
+            FatalError("Prediction mismatch in batch");
+        }
+    }
+    std::cout << "\nTest passed!\n";
+}
+
+// Runs the network on the host, with network_cpu_t, and exits
+static void
+runOnHost(int argc, char* argv[]) {
+    char* cacheFile = NULL;
+    if (checkCmdLineFlag(argc, (const char**)argv, "cache")) {
+        getCmdLineArgumentString(argc, (const char**)argv, "cache", &cacheFile);
+    }
+    int batch = 64;
+    if (checkCmdLineFlag(argc, (const char**)argv, "batch")) {
+        batch = getCmdLineArgumentInt(argc, (const char**)argv, "batch");
+    }
+    if (batch < 1) {
+        FatalError("Batch size must be positive");
+    }
+
+    std::cout << "Running inference on the host\n";
+    packedModel_t model(hostLayerSpecs(argv[0]), cacheFile);
+
+    if (checkCmdLineFlag(argc, (const char**)argv, "image")) {
+        char* image_name;
+        getCmdLineArgumentString(argc, (const char**)argv, "image", (char**)&image_name);
+
+        float imgData_h[IMAGE_H * IMAGE_W];
+        readImage(image_name, imgData_h);
+
+        network_cpu_t<float> mnist;
+        int i1;
+        mnist.classify_batch(model, 1, IMAGE_H, IMAGE_W, imgData_h, &i1);
+        std::cout << "\nResult of classification: " << i1 << std::endl;
+        exit(0);
+    }
+
+    std::cout << "\nTesting single precision on the host\n";
+    testOnHost<float>(model, argv[0], batch);
+
+    std::cout << "\nTesting half precision (math in single precision) on the host\n";
+    testOnHost<half1>(model, argv[0], batch);
+
+    exit(0);
+}
+
 static char*
 baseFile(char* fname) {
     char* base;
@@ -779,6 +918,9 @@ displayUsage() {
     printf("help                   : display this help\n");
     printf("device=<int>           : set the device to run the sample\n");
     printf("image=<name>           : classify specific image\n");
+    printf("cpu                    : run the network on the host, which is the default without a GPU\n");
+    printf("batch=<int>            : batch size of the host benchmark (default 64)\n");
+    printf("cache=<file>           : map the packed host weights from this file, packing them first if needed\n");
 }
 
 int
@@ -801,6 +943,18 @@ main(int argc, char* argv[]) {
     printf(
         "cudnnGetVersion() : %d , CUDNN_VERSION from cudnn.h : %d (%s)\n", version, CUDNN_VERSION, CUDNN_VERSION_STR);
     printf("Host compiler version : %s %s\n", COMPILER_NAME, COMPILER_VER);
+
+    int totalDevices = 0;
+    bool onHost      = checkCmdLineFlag(argc, (const char**)argv, "cpu");
+    if (!onHost && (cudaGetDeviceCount(&totalDevices) != cudaSuccess || totalDevices == 0)) {
+        cudaGetLastError();
+        std::cout << "\nNo CUDA capable device found, falling back to the host\n";
+        onHost = true;
+    }
+    if (onHost) {
+        runOnHost(argc, argv);
+    }
+
     showDevices();
 
     int device = 0;
@@ -0,0 +1,712 @@
+/**
+ * Copyright 2014 NVIDIA Corporation.  All rights reserved.
+ *
+ * Please refer to the NVIDIA end user license agreement (EULA) associated
+ * with this source code for terms and conditions that govern your use of
+ * this software. Any use, reproduction, disclosure, or distribution of
+ * this software and related documentation outside the terms of the EULA
+ * is strictly prohibited.
+ *
+ */
+
+/*
+ * Host backend of the network, for batched classification on the CPU and for
+ * nodes without a GPU. It implements the same layers as network_t, with the
+ * same parameters, on NCHW tensors in host memory.
+ *
+ * The weights are packed once into blocks of CPU_OUT_BLOCK output channels,
+ * [outputBlock][inputs * kernel_dim * kernel_dim][CPU_OUT_BLOCK], so that the
+ * inner loop of every convolution and fully connected layer is a unit stride
+ * SIMD update of CPU_OUT_BLOCK accumulators. The packed weights can be saved
+ * to a cache file, which later runs map into memory instead of reading and
+ * converting the binary files of the weights again.
+ *
+ * Math is in single precision. With half1, every tensor is rounded to half
+ * precision where network_t stores it, and the weights are rounded too, so
+ * the results follow those of cuDNN with FP16 data and FP32 math.
+ */
+
+#if !defined(_NETWORK_CPU_H_)
+#define _NETWORK_CPU_H_
+
+#include <math.h>
+#include <stdio.h>
+#include <string.h>
+#include <sys/stat.h>
+#include <sys/types.h>
+
+#include <string>
+#include <vector>
+
+#if defined(_WIN32)
+#include <process.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <unistd.h>
+#endif
+
+#include "fp16_emu.h"
+#include "error_util.h"
+
+// Output channels of a packed weight block, which is the SIMD width of the
+// kernels: one AVX register, or one SSE/NEON register otherwise
+#if defined(__AVX__)
+#define CPU_OUT_BLOCK 8
+#else
+#define CPU_OUT_BLOCK 4
+#endif
+// Output pixels of a convolution row, and images of a fully connected layer,
+// which are accumulated in registers at once; the kernels are written for 4
+#define CPU_PIXEL_TILE 4
+#define CPU_BATCH_TILE 4
+// Alignment of the packed layers in the cache file, and offset of the first one
+#define CPU_PACK_ALIGN 64
+#define CPU_PACK_HEADER_BYTES 4096
+#define CPU_PACK_MAX_LAYERS 8
+#define CPU_PACK_VERSION 1
+
+typedef enum { PACKED_FP32 = 0, PACKED_FP16 = 1, PACKED_PRECISION_COUNT = 2 } packedPrecision_t;
+
+template <class value_type>
+struct packedPrecisionOf {
+    static const packedPrecision_t value = PACKED_FP32;
+};
+template <>
+struct packedPrecisionOf<half1> {
+    static const packedPrecision_t value = PACKED_FP16;
+};
+
+// Rounding of values to the precision in which network_t stores them
+template <class value_type>
+inline float
+cpuRound(float x) {
+    return x;
+}
+
+template <>
+inline float
+cpuRound<half1>(float x) {
+    return cpu_half2float(cpu_float2half_rn(x));
+}
+
+// Description of a layer, and of the binary files of its weights and bias, in single precision
+struct layerSpec_t {
+    int inputs;
+    int outputs;
+    int kernel_dim;
+    std::string weights_bin;
+    std::string bias_bin;
+};
+
+// A packed layer, pointing into the memory of a packedModel_t
+struct packedLayer_t {
+    int inputs;
+    int outputs;
+    int kernel_dim;
+    int outputBlocks;
+    const float *weights;  // [outputBlocks][inputs * kernel_dim * kernel_dim][CPU_OUT_BLOCK]
+    const float *bias;     // [outputBlocks * CPU_OUT_BLOCK]
+};
+
+// The packed weights of all layers, in both precisions. The layout of the
+// cache file is the same as that of the memory: a header of
+// CPU_PACK_HEADER_BYTES, then the packed weights and bias of every layer,
+// FP32 first. The sizes and modification times of the binary files, and the
+// block width, are kept in the header, so that a cache made from other
+// weights, or by a build for other SIMD registers, is packed again.
+class packedModel_t {
+    struct fileEntry_t {
+        int inputs;
+        int outputs;
+        int kernel_dim;
+        int outputBlocks;
+        long long weightsFileSize;
+        long long weightsFileTime;
+        long long biasFileSize;
+        long long biasFileTime;
+        long long offset[PACKED_PRECISION_COUNT];
+    };
+
+    struct fileHeader_t {
+        char magic[8];
+        int version;
+        int numLayers;
+        int outBlock;
+        int reserved;
+        long long totalBytes;
+        fileEntry_t entries[CPU_PACK_MAX_LAYERS];
+    };
+
+    std::vector<layerSpec_t> specs;
+    std::vector<char> image;
+    const char *base;
+    size_t mappedBytes;
+    std::vector<packedLayer_t> layers[PACKED_PRECISION_COUNT];
+
+    static long long
+    alignUp(long long n) {
+        return (n + CPU_PACK_ALIGN - 1) / CPU_PACK_ALIGN * CPU_PACK_ALIGN;
+    }
+
+    static void
+    fileStat(const std::string &fname, long long &size, long long &mtime) {
+        struct stat st;
+        if (stat(fname.c_str(), &st) != 0) {
+            std::stringstream error_s;
+            error_s << "Error opening file " << fname;
+            FatalError(error_s.str());
+        }
+        size  = (long long)st.st_size;
+        mtime = (long long)st.st_mtime;
+    }
+
+    static void
+    readFloats(const std::string &fname, size_t count, std::vector<float> &data) {
+        std::stringstream error_s;
+        FILE *fp = fopen(fname.c_str(), "rb");
+        if (fp == NULL) {
+            error_s << "Error opening file " << fname;
+            FatalError(error_s.str());
+        }
+
+        std::cout << "Loading binary file " << fname << std::endl;
+
+        data.resize(count);
+        size_t read = fread(data.data(), sizeof(float), count, fp);
+        fclose(fp);
+        if (read != count) {
+            error_s << "Error reading file " << fname;
+            FatalError(error_s.str());
+        }
+    }
+
+    // Expected header of the packed image of the current binary files
+    void
+    makeHeader(fileHeader_t &header) const {
+        memset(&header, 0, sizeof(header));
+        memcpy(header.magic, "MNISTPK", 8);
+        header.version   = CPU_PACK_VERSION;
+        header.numLayers = (int)specs.size();
+        header.outBlock  = CPU_OUT_BLOCK;
+
+        for (int i = 0; i < header.numLayers; i++) {
+            fileEntry_t &e = header.entries[i];
+            e.inputs       = specs[i].inputs;
+            e.outputs      = specs[i].outputs;
+            e.kernel_dim   = specs[i].kernel_dim;
+            e.outputBlocks = (e.outputs + CPU_OUT_BLOCK - 1) / CPU_OUT_BLOCK;
+            fileStat(specs[i].weights_bin, e.weightsFileSize, e.weightsFileTime);
+            fileStat(specs[i].bias_bin, e.biasFileSize, e.biasFileTime);
+        }
+
+        long long offset = CPU_PACK_HEADER_BYTES;
+        for (int p = 0; p < PACKED_PRECISION_COUNT; p++) {
+            for (int i = 0; i < header.numLayers; i++) {
+                fileEntry_t &e       = header.entries[i];
+                long long filterSize = (long long)e.inputs * e.kernel_dim * e.kernel_dim;
+                long long floats     = (filterSize + 1) * e.outputBlocks * CPU_OUT_BLOCK;
+                e.offset[p]          = offset;
+                offset               = alignUp(offset + floats * (long long)sizeof(float));
+            }
+        }
+        header.totalBytes = offset;
+    }
+
+    // Reads the binary files of the weights and packs them, in both precisions, into the image
+    void
+    pack(const fileHeader_t &header) {
+        image.assign((size_t)header.totalBytes, 0);
+        memcpy(&image[0], &header, sizeof(header));
+
+        std::vector<float> weights, bias;
+        for (int i = 0; i < header.numLayers; i++) {
+            const fileEntry_t &e = header.entries[i];
+            const int filterSize = e.inputs * e.kernel_dim * e.kernel_dim;
+            readFloats(specs[i].weights_bin, (size_t)filterSize * e.outputs, weights);
+            readFloats(specs[i].bias_bin, (size_t)e.outputs, bias);
+
+            for (int p = 0; p < PACKED_PRECISION_COUNT; p++) {
+                float *dst     = (float *)&image[(size_t)e.offset[p]];
+                float *dstBias = dst + (size_t)filterSize * e.outputBlocks * CPU_OUT_BLOCK;
+                for (int ob = 0; ob < e.outputBlocks; ob++) {
+                    for (int l = 0; l < CPU_OUT_BLOCK; l++) {
+                        const int o = ob * CPU_OUT_BLOCK + l;
+                        if (o >= e.outputs) {
+                            continue;  // padding of the last block stays zero
+                        }
+                        for (int j = 0; j < filterSize; j++) {
+                            float v = weights[(size_t)o * filterSize + j];
+                            dst[((size_t)ob * filterSize + j) * CPU_OUT_BLOCK + l] =
+                                p == PACKED_FP16 ? cpuRound<half1>(v) : v;
+                        }
+                        dstBias[o] = p == PACKED_FP16 ? cpuRound<half1>(bias[o]) : bias[o];
+                    }
+                }
+            }
+        }
+        base = &image[0];
+    }
+
+    // Maps a cache file which matches the header, returns false if there is none
+    bool
+    map(const char *cacheFile, const fileHeader_t &header) {
+        fileHeader_t cached;
+        FILE *fp = fopen(cacheFile, "rb");
+        if (fp == NULL) {
+            return false;
+        }
+        bool valid = fread(&cached, sizeof(cached), 1, fp) == 1 && memcmp(&cached, &header, sizeof(header)) == 0;
+        if (valid) {
+            fseek(fp, 0, SEEK_END);
+            valid = ftell(fp) == (long)header.totalBytes;
+        }
+#if defined(_WIN32)
+        if (valid) {
+            image.resize((size_t)header.totalBytes);
+            fseek(fp, 0, SEEK_SET);
+            valid = fread(&image[0], 1, image.size(), fp) == image.size();
+            base  = &image[0];
+        }
+        fclose(fp);
+#else
+        fclose(fp);
+        if (valid) {
+            int fd = open(cacheFile, O_RDONLY);
+            void *p = fd < 0 ? MAP_FAILED : mmap(NULL, (size_t)header.totalBytes, PROT_READ, MAP_PRIVATE, fd, 0);
+            if (fd >= 0) {
+                close(fd);
+            }
+            valid = p != MAP_FAILED;
+            if (valid) {
+                base        = (const char *)p;
+                mappedBytes = (size_t)header.totalBytes;
+            }
+        }
+#endif
+        if (!valid) {
+            std::cout << "Packed weights in " << cacheFile << " are out of date" << std::endl;
+        }
+        return valid;
+    }
+
+    // Writes the image to the cache file, through a temporary file, so that
+    // other processes never map a partly written cache. The temporary name
+    // carries the pid, so that processes saving at the same time do not write
+    // to the same file, and the rename replaces the cache atomically on POSIX.
+    void
+    save(const char *cacheFile) const {
+#if defined(_WIN32)
+        int pid = _getpid();
+#else
+        int pid = (int)getpid();
+#endif
+        std::string tmpFile = std::string(cacheFile) + "." + std::to_string(pid) + ".tmp";
+        FILE *fp            = fopen(tmpFile.c_str(), "wb");
+        bool written        = fp != NULL && fwrite(&image[0], 1, image.size(), fp) == image.size();
+        if (fp != NULL) {
+            written = (fclose(fp) == 0) && written;
+        }
+        if (written) {
+#if defined(_WIN32)
+            // rename does not replace an existing file on Windows
+            remove(cacheFile);
+#endif
+            written = rename(tmpFile.c_str(), cacheFile) == 0;
+        }
+        if (written) {
+            std::cout << "Saved packed weights to " << cacheFile << std::endl;
+        } else {
+            remove(tmpFile.c_str());
+            std::cout << "Could not save packed weights to " << cacheFile << std::endl;
+        }
+    }
+
+   public:
+    // cacheFile may be NULL, in which case the weights are packed in memory on every run
+    packedModel_t(const std::vector<layerSpec_t> &_specs, const char *cacheFile)
+        : specs(_specs), base(NULL), mappedBytes(0) {
+        if (specs.size() > CPU_PACK_MAX_LAYERS || sizeof(fileHeader_t) > CPU_PACK_HEADER_BYTES) {
+            FatalError("Too many layers to pack");
+        }
+
+        fileHeader_t header;
+        makeHeader(header);
+
+        if (cacheFile != NULL && map(cacheFile, header)) {
+            std::cout << "Mapped packed weights from " << cacheFile << std::endl;
+        } else {
+            pack(header);
+            if (cacheFile != NULL) {
+                save(cacheFile);
+            }
+        }
+
+        for (int p = 0; p < PACKED_PRECISION_COUNT; p++) {
+            for (int i = 0; i < header.numLayers; i++) {
+                const fileEntry_t &e = header.entries[i];
+                packedLayer_t layer;
+                layer.inputs       = e.inputs;
+                layer.outputs      = e.outputs;
+                layer.kernel_dim   = e.kernel_dim;
+                layer.outputBlocks = e.outputBlocks;
+                layer.weights      = (const float *)(base + e.offset[p]);
+                layer.bias = layer.weights + (size_t)e.inputs * e.kernel_dim * e.kernel_dim * e.outputBlocks * CPU_OUT_BLOCK;
+                layers[p].push_back(layer);
+            }
+        }
+    }
+
+    ~packedModel_t() {
+#if !defined(_WIN32)
+        if (mappedBytes != 0) {
+            munmap((void *)base, mappedBytes);
+        }
+#endif
+    }
+
+    const packedLayer_t &
+    layer(int index, packedPrecision_t precision) const {
+        return layers[precision][index];
+    }
+
+   private:
+    packedModel_t(const packedModel_t &);
+    packedModel_t &
+    operator=(const packedModel_t &);
+};
+
+template <class value_type>
+class network_cpu_t {
+   public:
+    void
+    fullyConnectedForward(const packedLayer_t &ip,
+                          int &n,
+                          int &c,
+                          int &h,
+                          int &w,
+                          const float *srcData,
+                          std::vector<float> &dstData) {
+        const int dim_x = c * h * w;
+        const int dim_y = ip.outputs;
+        if (dim_x != ip.inputs * ip.kernel_dim * ip.kernel_dim) {
+            FatalError("Fully connected layer input size mismatch");
+        }
+        dstData.resize((size_t)n * dim_y);
+
+        // each task takes CPU_BATCH_TILE images through one output block
+        const int batchTiles = (n + CPU_BATCH_TILE - 1) / CPU_BATCH_TILE;
+        const int tasks      = batchTiles * ip.outputBlocks;
+#pragma omp parallel for schedule(static)
+        for (int t = 0; t < tasks; t++) {
+            const int b0    = (t / ip.outputBlocks) * CPU_BATCH_TILE;
+            const int ob    = t % ip.outputBlocks;
+            const int nb    = n - b0 < CPU_BATCH_TILE ? n - b0 : CPU_BATCH_TILE;
+            const int o0    = ob * CPU_OUT_BLOCK;
+            const int lanes = dim_y - o0 < CPU_OUT_BLOCK ? dim_y - o0 : CPU_OUT_BLOCK;
+
+            // the images past the end of the batch repeat the last one, and are not stored
+            const float *x0 = srcData + (size_t)b0 * dim_x;
+            const float *x1 = x0 + (nb > 1 ? (size_t)dim_x : 0);
+            const float *x2 = x0 + (size_t)(nb > 2 ? 2 : nb - 1) * dim_x;
+            const float *x3 = x0 + (size_t)(nb > 3 ? 3 : nb - 1) * dim_x;
+            const float *wb = ip.weights + (size_t)ob * dim_x * CPU_OUT_BLOCK;
+
+            // separate accumulators per image, which compilers keep in registers without unrolling
+            float a0[CPU_OUT_BLOCK], a1[CPU_OUT_BLOCK], a2[CPU_OUT_BLOCK], a3[CPU_OUT_BLOCK];
+            for (int l = 0; l < CPU_OUT_BLOCK; l++) {
+                a0[l] = a1[l] = a2[l] = a3[l] = 0.0f;
+            }
+            for (int i = 0; i < dim_x; i++) {
+                const float *w8 = wb + (size_t)i * CPU_OUT_BLOCK;
+                const float v0 = x0[i], v1 = x1[i], v2 = x2[i], v3 = x3[i];
+#pragma omp simd
+                for (int l = 0; l < CPU_OUT_BLOCK; l++) {
+                    a0[l] += v0 * w8[l];
+                    a1[l] += v1 * w8[l];
+                    a2[l] += v2 * w8[l];
+                    a3[l] += v3 * w8[l];
+                }
+            }
+
+            const float *acc[CPU_BATCH_TILE] = {a0, a1, a2, a3};
+            for (int b = 0; b < nb; b++) {
+                for (int l = 0; l < lanes; l++) {
+                    dstData[(size_t)(b0 + b) * dim_y + o0 + l] = cpuRound<value_type>(acc[b][l] + ip.bias[o0 + l]);
+                }
+            }
+        }
+
+        h = 1;
+        w = 1;
+        c = dim_y;
+    }
+
+    void
+    convoluteForward(const packedLayer_t &conv,
+                     int &n,
+                     int &c,
+                     int &h,
+                     int &w,
+                     const float *srcData,
+                     std::vector<float> &dstData) {
+        if (c != conv.inputs) {
+            FatalError("Convolution input channels mismatch");
+        }
+        const int k       = conv.kernel_dim;
+        const int outputs = conv.outputs;
+        const int oh      = h - k + 1;
+        const int ow      = w - k + 1;
+        const int inSize  = c * h * w;
+        const int outSize = outputs * oh * ow;
+        dstData.resize((size_t)n * outSize);
+
+        // each task takes one image through one output block
+        const int tasks = n * conv.outputBlocks;
+#pragma omp parallel for schedule(static)
+        for (int t = 0; t < tasks; t++) {
+            const int img   = t / conv.outputBlocks;
+            const int ob    = t % conv.outputBlocks;
+            const int o0    = ob * CPU_OUT_BLOCK;
+            const int lanes = outputs - o0 < CPU_OUT_BLOCK ? outputs - o0 : CPU_OUT_BLOCK;
+
+            const float *src = srcData + (size_t)img * inSize;
+            const float *wb  = conv.weights + (size_t)ob * c * k * k * CPU_OUT_BLOCK;
+            float *dst       = &dstData[(size_t)img * outSize];
+
+            float acc[CPU_PIXEL_TILE][CPU_OUT_BLOCK];
+            for (int y = 0; y < oh; y++) {
+                for (int x0 = 0; x0 < ow; x0 += CPU_PIXEL_TILE) {
+                    // the last tile of a row is moved back to end with the row, recomputing a few pixels,
+                    // so that every tile but those of rows narrower than a tile is full
+                    const int xs = (x0 + CPU_PIXEL_TILE <= ow || ow < CPU_PIXEL_TILE) ? x0 : ow - CPU_PIXEL_TILE;
+                    const int nx = ow - xs < CPU_PIXEL_TILE ? ow - xs : CPU_PIXEL_TILE;
+                    const float *in = src + (size_t)y * w + xs;
+                    if (nx == CPU_PIXEL_TILE) {
+                        convPixels4(in, wb, c, h, w, k, acc);
+                    } else {
+                        for (int x = 0; x < nx; x++) {
+                            convPixel(in + x, wb, c, h, w, k, acc[x]);
+                        }
+                    }
+                    // network_t stores the convolution before adding the bias
+                    for (int l = 0; l < lanes; l++) {
+                        float *out = dst + ((size_t)(o0 + l) * oh + y) * ow + xs;
+                        for (int x = 0; x < nx; x++) {
+                            out[x] = cpuRound<value_type>(cpuRound<value_type>(acc[x][l]) + conv.bias[o0 + l]);
+                        }
+                    }
+                }
+            }
+        }
+
+        c = outputs;
+        h = oh;
+        w = ow;
+    }
+
+    void
+    poolForward(int &n, int &c, int &h, int &w, const float *srcData, std::vector<float> &dstData) {
+        // 2x2 max pooling with a stride of 2, propagating NaN
+        const int oh = (h - 2) / 2 + 1;
+        const int ow = (w - 2) / 2 + 1;
+        dstData.resize((size_t)n * c * oh * ow);
+
+        const int planes = n * c;
+#pragma omp parallel for schedule(static)
+        for (int p = 0; p < planes; p++) {
+            const float *src = srcData + (size_t)p * h * w;
+            float *dst       = &dstData[(size_t)p * oh * ow];
+            for (int y = 0; y < oh; y++) {
+                const float *row0 = src + (size_t)(2 * y) * w;
+                const float *row1 = row0 + w;
+                for (int x = 0; x < ow; x++) {
+                    float m       = row0[2 * x];
+                    const float a = row0[2 * x + 1], b = row1[2 * x], d = row1[2 * x + 1];
+                    m             = (a > m || a != a) ? a : m;
+                    m             = (b > m || b != b) ? b : m;
+                    m             = (d > m || d != d) ? d : m;
+                    dst[y * ow + x] = m;
+                }
+            }
+        }
+
+        h = oh;
+        w = ow;
+    }
+
+    void
+    softmaxForward(int n, int c, int h, int w, const float *srcData, std::vector<float> &dstData) {
+        dstData.resize((size_t)n * c * h * w);
+
+        // accurate softmax over the channels of every pixel
+        const int hw     = h * w;
+        const int pixels = n * hw;
+#pragma omp parallel for schedule(static)
+        for (int p = 0; p < pixels; p++) {
+            const float *src = srcData + (size_t)(p / hw) * c * hw + p % hw;
+            float *dst       = &dstData[(size_t)(p / hw) * c * hw + p % hw];
+            float m          = src[0];
+            for (int i = 1; i < c; i++) {
+                m = src[(size_t)i * hw] > m ? src[(size_t)i * hw] : m;
+            }
+            float sum = 0.0f;
+            for (int i = 0; i < c; i++) {
+                float e            = expf(src[(size_t)i * hw] - m);
+                dst[(size_t)i * hw] = e;
+                sum += e;
+            }
+            for (int i = 0; i < c; i++) {
+                dst[(size_t)i * hw] = cpuRound<value_type>(dst[(size_t)i * hw] / sum);
+            }
+        }
+    }
+
+    void
+    lrnForward(int n, int c, int h, int w, const float *srcData, std::vector<float> &dstData) {
+        const int lrnN        = 5;
+        const float lrnAlpha  = 0.0001f;
+        const float lrnBeta   = 0.75f;
+        const float lrnK      = 1.0f;
+        const int lrnLow      = (lrnN - 1) / 2;
+        const int lrnHigh     = lrnN - 1 - lrnLow;
+        const float alphaOver = lrnAlpha / lrnN;
+
+        dstData.resize((size_t)n * c * h * w);
+
+        // cross channel normalization over a window of lrnN channels around each one
+        const int hw     = h * w;
+        const int pixels = n * hw;
+#pragma omp parallel for schedule(static)
+        for (int p = 0; p < pixels; p++) {
+            const float *src = srcData + (size_t)(p / hw) * c * hw + p % hw;
+            float *dst       = &dstData[(size_t)(p / hw) * c * hw + p % hw];
+            for (int i = 0; i < c; i++) {
+                const int lo = i - lrnLow < 0 ? 0 : i - lrnLow;
+                const int hi = i + lrnHigh > c - 1 ? c - 1 : i + lrnHigh;
+                float sum    = 0.0f;
+                for (int j = lo; j <= hi; j++) {
+                    sum += src[(size_t)j * hw] * src[(size_t)j * hw];
+                }
+                dst[(size_t)i * hw] = cpuRound<value_type>(src[(size_t)i * hw] * powf(lrnK + alphaOver * sum, -lrnBeta));
+            }
+        }
+    }
+
+    void
+    activationForward(int n, int c, int h, int w, const float *srcData, std::vector<float> &dstData) {
+        const int size = n * c * h * w;
+        dstData.resize((size_t)size);
+
+        // ReLU, propagating NaN
+        float *dst = &dstData[0];
+#pragma omp parallel for schedule(static)
+        for (int i = 0; i < size; i++) {
+            dst[i] = srcData[i] < 0.0f ? 0.0f : srcData[i];
+        }
+    }
+
+   private:
+    // Accumulates CPU_PIXEL_TILE output pixels of a row, starting at in, over
+    // all input channels and kernel taps, for the CPU_OUT_BLOCK filters of wb.
+    // The accumulators are separate arrays rather than one indexed by pixel,
+    // so that compilers keep them in registers without unrolling.
+    static void
+    convPixels4(const float *in, const float *wb, int c, int h, int w, int k, float acc[][CPU_OUT_BLOCK]) {
+        float s0[CPU_OUT_BLOCK], s1[CPU_OUT_BLOCK], s2[CPU_OUT_BLOCK], s3[CPU_OUT_BLOCK];
+        for (int l = 0; l < CPU_OUT_BLOCK; l++) {
+            s0[l] = s1[l] = s2[l] = s3[l] = 0.0f;
+        }
+        for (int ci = 0; ci < c; ci++) {
+            for (int r = 0; r < k; r++) {
+                const float *row = in + ((size_t)ci * h + r) * w;
+                const float *wr  = wb + ((size_t)ci * k + r) * k * CPU_OUT_BLOCK;
+                for (int s = 0; s < k; s++) {
+                    const float *w8 = wr + s * CPU_OUT_BLOCK;
+                    const float v0 = row[s], v1 = row[s + 1], v2 = row[s + 2], v3 = row[s + 3];
+#pragma omp simd
+                    for (int l = 0; l < CPU_OUT_BLOCK; l++) {
+                        s0[l] += v0 * w8[l];
+                        s1[l] += v1 * w8[l];
+                        s2[l] += v2 * w8[l];
+                        s3[l] += v3 * w8[l];
+                    }
+                }
+            }
+        }
+        for (int l = 0; l < CPU_OUT_BLOCK; l++) {
+            acc[0][l] = s0[l];
+            acc[1][l] = s1[l];
+            acc[2][l] = s2[l];
+            acc[3][l] = s3[l];
+        }
+    }
+
+    // The same for a single output pixel, for rows narrower than CPU_PIXEL_TILE
+    static void
+    convPixel(const float *in, const float *wb, int c, int h, int w, int k, float *acc) {
+        float s0[CPU_OUT_BLOCK];
+        for (int l = 0; l < CPU_OUT_BLOCK; l++) {
+            s0[l] = 0.0f;
+        }
+        for (int ci = 0; ci < c; ci++) {
+            for (int r = 0; r < k; r++) {
+                const float *row = in + ((size_t)ci * h + r) * w;
+                const float *wr  = wb + ((size_t)ci * k + r) * k * CPU_OUT_BLOCK;
+                for (int s = 0; s < k; s++) {
+                    const float *w8 = wr + s * CPU_OUT_BLOCK;
+                    const float v0  = row[s];
+#pragma omp simd
+                    for (int l = 0; l < CPU_OUT_BLOCK; l++) {
+                        s0[l] += v0 * w8[l];
+                    }
+                }
+            }
+        }
+        for (int l = 0; l < CPU_OUT_BLOCK; l++) {
+            acc[l] = s0[l];
+        }
+    }
+
+   public:
+    // Classifies a batch of n IMAGE_H x IMAGE_W images, stored as [n][h][w].
+    // The digits are written to ids, and the softmax outputs to probs, when it is not NULL.
+    void
+    classify_batch(const packedModel_t &model, int n, int h, int w, const float *images, int *ids, float *probs = NULL) {
+        const packedPrecision_t p = packedPrecisionOf<value_type>::value;
+        int c                     = 1;
+
+        convoluteForward(model.layer(0, p), n, c, h, w, images, dstData);
+        poolForward(n, c, h, w, &dstData[0], srcData);
+
+        convoluteForward(model.layer(1, p), n, c, h, w, &srcData[0], dstData);
+        poolForward(n, c, h, w, &dstData[0], srcData);
+
+        fullyConnectedForward(model.layer(2, p), n, c, h, w, &srcData[0], dstData);
+        activationForward(n, c, h, w, &dstData[0], srcData);
+        lrnForward(n, c, h, w, &srcData[0], dstData);
+
+        fullyConnectedForward(model.layer(3, p), n, c, h, w, &dstData[0], srcData);
+        softmaxForward(n, c, h, w, &srcData[0], dstData);
+
+        for (int b = 0; b < n; b++) {
+            const float *result = &dstData[(size_t)b * c];
+            int id              = 0;
+            for (int i = 1; i < c; i++) {
+                if (result[id] < result[i]) {
+                    id = i;
+                }
+            }
+            ids[b] = id;
+        }
+        if (probs != NULL) {
+            memcpy(probs, &dstData[0], (size_t)n * c * sizeof(float));
+        }
+    }
+
+   private:
+    // activations, which are reused from one batch to the next
+    std::vector<float> srcData, dstData;
+};
+
+#endif  // _NETWORK_CPU_H_
@@ -27,6 +27,7 @@
 // ----------------------------------------------------------------------
 
 #include "multiHeadAttention.h"
+#include "multiHeadAttentionRef.h"
 
 #include <errno.h>
 #include <math.h>
@@ -35,6 +36,7 @@
 
 #include <chrono>
 #include <random>
+#include <vector>
 
 #define COUNTOF(arr) int(sizeof(arr) / sizeof(arr[0]))
 #define INIT_MEAN 0.0
@@ -115,44 +117,153 @@ saveWeights(const char *fName, int dimA[3], int strideA[3], T_ELEM *weightAddr)
     }
 }
 
+// Writes a binary dump file: the header, zero padding up to the data offset,
+// and the data itself.
+void
+saveBinary(const char *fName, attnDumpHeader *hdr, const void *dataBuf) {
+    FILE *fp = fopen(fName, "wb");
+    if (fp == NULL) {
+        const char *reason = (errno ? strerror(errno) : "unknown reason");
+        fprintf(stderr, "ERROR: failed to open '%s' file (%s)\n\n", fName, reason);
+        exit(-1);
+    }
+
+    memcpy(hdr->magic, "cuDNNMHA", sizeof(hdr->magic));
+    hdr->version    = ATTN_DUMP_VERSION;
+    hdr->dataOffset = ATTN_DUMP_DATA_OFFSET;
+
+    char head[ATTN_DUMP_DATA_OFFSET] = {0};
+    memcpy(head, hdr, sizeof(*hdr));
+
+    size_t dataSize = size_t(hdr->dataSize);
+    bool failed     = fwrite(head, 1, sizeof(head), fp) != sizeof(head);
+    failed          = failed || fwrite(dataBuf, 1, dataSize, fp) != dataSize;
+
+    if (fclose(fp) != 0 || failed) {
+        const char *reason = (errno ? strerror(errno) : "unknown reason");
+        fprintf(stderr, "ERROR: failed to write to '%s' file (%s)\n\n", fName, reason);
+        exit(-1);
+    }
+}
+
+// Saves a one-dimensional array of integers, such as sequence lengths.
+void
+saveBinaryArray(const char *fName, int count, const int *arrayBuf) {
+    attnDumpHeader hdr;
+    memset(&hdr, 0, sizeof(hdr));
+
+    hdr.dataType   = CUDNN_DATA_INT32;
+    hdr.elemSize   = sizeof(int32_t);
+    hdr.nbDims     = 1;
+    hdr.dimA[0]    = count;
+    hdr.axisA[0]   = -1;
+    hdr.strideA[0] = 1;
+    hdr.dataSize   = int64_t(count) * sizeof(int32_t);
+
+    saveBinary(fName, &hdr, arrayBuf);
+}
+
+// Saves [heads, rows, cols] weights packed, in the row-major order.
+template <typename T_ELEM>
+void
+saveBinaryWeights(const char *fName, cudnnDataType_t dataType, int dimA[3], int strideA[3], T_ELEM *weightAddr) {
+    std::vector<T_ELEM> packed(size_t(dimA[0]) * dimA[1] * dimA[2]);
+
+    size_t pos = 0;
+    for (int h = 0; h < dimA[0]; h++) {
+        for (int r = 0; r < dimA[1]; r++) {
+            for (int c = 0; c < dimA[2]; c++) {
+                size_t idx    = size_t(h) * strideA[0] + size_t(r) * strideA[1] + size_t(c) * strideA[2];
+                packed[pos++] = weightAddr[idx];
+            }
+        }
+    }
+
+    attnDumpHeader hdr;
+    memset(&hdr, 0, sizeof(hdr));
+
+    hdr.dataType = dataType;
+    hdr.elemSize = sizeof(T_ELEM);
+    hdr.nbDims   = 3;
+    hdr.dataSize = int64_t(packed.size()) * sizeof(T_ELEM);
+
+    for (int i = 2, stride = 1; i >= 0; i--) {
+        hdr.dimA[i]    = dimA[i];
+        hdr.axisA[i]   = -1;
+        hdr.strideA[i] = stride;
+        stride *= dimA[i];
+    }
+
+    saveBinary(fName, &hdr, packed.empty() ? NULL : &packed[0]);
+}
+
+// Returns the address and geometry of one group of weights in the parameter
+// buffer (which can be the device or the host copy of weights or gradients).
+template <typename T_ELEM>
+void
+getWeights(cudnnHandle_t handle,
+           cudnnAttnDescriptor_t desc,
+           cudnnMultiHeadAttnWeightKind_t wKind,
+           size_t paramSize,
+           void *paramBuf,
+           cudnnTensorDescriptor_t weightDesc,
+           int dimA[3],
+           int strideA[3],
+           T_ELEM **weightAddr) {
+    int nbDims;
+    cudnnDataType_t dataTypeUnsed;
+
+    *weightAddr = NULL;
+    CHECK_CUDNN_ERR(
+        cudnnGetMultiHeadAttnWeights(handle, desc, wKind, paramSize, paramBuf, weightDesc, (void **)weightAddr));
+
+    CHECK_CUDNN_ERR(cudnnGetTensorNdDescriptor(weightDesc, 3, &dataTypeUnsed, &nbDims, dimA, strideA));
+
+    // cudnnGetMultiHeadAttnWeights() reports a wrong stride in ealier
+    // cuDNN versions for input projection weight tensors.
+    if (cudnnGetVersion() < 7602 && wKind != CUDNN_MH_ATTN_O_WEIGHTS) {
+        strideA[2] = dimA[0] * dimA[1];
+    }
+
+    if (nbDims != 3) {
+        fprintf(stderr,
+                "ERROR: weight tensor descriptor should have 3 dimensions, not "
+                "%d\n\n",
+                nbDims);
+        exit(-1);
+    }
+}
+
 template <typename T_ELEM>
 void
-saveAllParams(cudnnHandle_t handle, cudnnAttnDescriptor_t desc, bool isGgrad, size_t paramSize, void *paramBuf) {
+saveAllParams(cudnnHandle_t handle,
+              cudnnAttnDescriptor_t desc,
+              bool isGgrad,
+              int fileDump,
+              cudnnDataType_t dataType,
+              size_t paramSize,
+              void *paramBuf) {
     static cudnnMultiHeadAttnWeightKind_t wKind[WGROUP_COUNT] = {
         CUDNN_MH_ATTN_Q_WEIGHTS, CUDNN_MH_ATTN_K_WEIGHTS, CUDNN_MH_ATTN_V_WEIGHTS, CUDNN_MH_ATTN_O_WEIGHTS};
 
-    static const char *baseName[WGROUP_COUNT] = {"wq.dat", "wk.dat", "wv.dat", "wo.dat"};
+    static const char *baseName[WGROUP_COUNT] = {"wq", "wk", "wv", "wo"};
 
     cudnnTensorDescriptor_t weightDesc = NULL;
-    int nbDims, dimA[3], strideA[3];
-    cudnnDataType_t dataTypeUnsed;
+    int dimA[3], strideA[3];
     char fileName[64];
 
     CHECK_CUDNN_ERR(cudnnCreateTensorDescriptor(&weightDesc));
 
     for (int i = 0; i < WGROUP_COUNT; i++) {
         T_ELEM *weightAddr = NULL;
-        CHECK_CUDNN_ERR(cudnnGetMultiHeadAttnWeights(
-            handle, desc, wKind[i], paramSize, paramBuf, weightDesc, (void **)&weightAddr));
-
-        CHECK_CUDNN_ERR(cudnnGetTensorNdDescriptor(weightDesc, 3, &dataTypeUnsed, &nbDims, dimA, strideA));
-
-        // cudnnGetMultiHeadAttnWeights() reports a wrong stride in ealier
-        // cuDNN versions for input projection weight tensors.
-        if (cudnnGetVersion() < 7602 && wKind[i] != CUDNN_MH_ATTN_O_WEIGHTS) {
-            strideA[2] = dimA[0] * dimA[1];
-        }
+        getWeights<T_ELEM>(handle, desc, wKind[i], paramSize, paramBuf, weightDesc, dimA, strideA, &weightAddr);
 
-        if (nbDims != 3) {
-            fprintf(stderr,
-                    "ERROR: weight tensor descriptor should have 3 dimensions, not "
-                    "%d\n\n",
-                    nbDims);
-            exit(-1);
+        sprintf(fileName, "%s%s.%s", isGgrad ? "d" : "", baseName[i], fileDump == 1 ? "dat" : "bin");
+        if (fileDump == 1) {
+            saveWeights<T_ELEM>(fileName, dimA, strideA, weightAddr);
+        } else {
+            saveBinaryWeights<T_ELEM>(fileName, dataType, dimA, strideA, weightAddr);
         }
-
-        sprintf(fileName, "%s%s", isGgrad ? "d" : "", baseName[i]);
-        saveWeights<T_ELEM>(fileName, dimA, strideA, weightAddr);
     }
 
     cudnnDestroyTensorDescriptor(weightDesc);
@@ -190,17 +301,7 @@ saveData(const char *fName, int batch, int beam, int nDims, int dimA[4], cudnnSe
     size_t strA[4] = {0};
 
     // Compute strides from dimensions (SeqData is a packed container).
-    strA[nDims - 1] = 1;
-    size_t stride   = veclen;
-    for (int i = nDims - 2; i >= 0; i--) {
-        if (ordA[i] < nDims - 1 && strA[ordA[i]] == 0) {
-            strA[ordA[i]] = stride;
-            stride *= dimA[ordA[i]];
-        } else {
-            fprintf(stderr, "ERROR: invalid re-order index ordA[i=%d]=%d\n\n", i, ordA[i]);
-            exit(-1);
-        }
-    }
+    seqDataStrides(nDims, dimA, ordA, strA);
 
     // Number of decimal digits when saving as text.
     int decDigs = (sizeof(T_ELEM) == sizeof(double) ? 16 : 8);
@@ -222,6 +323,81 @@ saveData(const char *fName, int batch, int beam, int nDims, int dimA[4], cudnnSe
     }
 }
 
+// Saves all sentences of SeqData as they are in memory.  Dimensions of the
+// header follow the order of axes in memory, from the outermost one.
+template <typename T_ELEM>
+void
+saveBinaryData(const char *fName,
+               cudnnDataType_t dataType,
+               int nDims,
+               int dimA[4],
+               cudnnSeqDataAxis_t ordA[4],
+               T_ELEM *dataBuf) {
+    if (nDims != 4) {
+        fprintf(stderr, "ERROR: unexpected number of dimensions %d!=4 in seqdata\n\n", nDims);
+        exit(-1);
+    }
+
+    size_t strA[4] = {0};
+    seqDataStrides(nDims, dimA, ordA, strA);
+
+    attnDumpHeader hdr;
+    memset(&hdr, 0, sizeof(hdr));
+
+    hdr.dataType = dataType;
+    hdr.elemSize = sizeof(T_ELEM);
+    hdr.nbDims   = nDims;
+    hdr.dataSize = sizeof(T_ELEM);
+
+    for (int i = 0; i < nDims; i++) {
+        hdr.dimA[i]    = dimA[ordA[i]];
+        hdr.axisA[i]   = ordA[i];
+        hdr.strideA[i] = int64_t(strA[ordA[i]]);
+        hdr.dataSize *= dimA[ordA[i]];
+    }
+
+    saveBinary(fName, &hdr, dataBuf);
+}
+
+// Saves the data of a SeqData container as text (fileDump=1, first sentence
+// only) or in the binary format (fileDump=2).
+template <typename T_ELEM>
+void
+dumpSeqData(cudnnSeqDataDescriptor_t desc, const char *baseName, int fileDump, T_ELEM *dataBuf) {
+    cudnnSeqDataAxis_t ordA[CUDNN_SEQDATA_DIM_COUNT];
+    cudnnDataType_t dataType;
+    int nbDims, dimA[CUDNN_SEQDATA_DIM_COUNT];
+    char fileName[64];
+
+    CHECK_CUDNN_ERR(
+        cudnnGetSeqDataDescriptor(desc, &dataType, &nbDims, CUDNN_SEQDATA_DIM_COUNT, dimA, ordA, NULL, 0, NULL, NULL));
+
+    sprintf(fileName, "%s.%s", baseName, fileDump == 1 ? "dat" : "bin");
+    if (fileDump == 1) {
+        saveData<T_ELEM>(fileName, 0, 0, nbDims, dimA, ordA, dataBuf);
+    } else {
+        saveBinaryData<T_ELEM>(fileName, dataType, nbDims, dimA, ordA, dataBuf);
+    }
+}
+
+// Returns dimensions and strides of a SeqData container, both indexed by
+// cudnnSeqDataAxis_t.
+void
+getSeqDataGeom(cudnnSeqDataDescriptor_t desc, int dimA[CUDNN_SEQDATA_DIM_COUNT], size_t strA[CUDNN_SEQDATA_DIM_COUNT]) {
+    cudnnSeqDataAxis_t ordA[CUDNN_SEQDATA_DIM_COUNT];
+    int nbDims;
+
+    CHECK_CUDNN_ERR(
+        cudnnGetSeqDataDescriptor(desc, NULL, &nbDims, CUDNN_SEQDATA_DIM_COUNT, dimA, ordA, NULL, 0, NULL, NULL));
+
+    if (nbDims != CUDNN_SEQDATA_DIM_COUNT) {
+        fprintf(stderr, "ERROR: unexpected number of dimensions %d!=4 in seqdata\n\n", nbDims);
+        exit(-1);
+    }
+
+    seqDataStrides(nbDims, dimA, ordA, strA);
+}
+
 template <bool IS_TRAINING, typename T_ELEM, typename T_MATH>
 void
 MultiheadAttentionTest<IS_TRAINING, T_ELEM, T_MATH>::setup(testOpts &opts) {
@@ -296,7 +472,8 @@ MultiheadAttentionTest<IS_TRAINING, T_ELEM, T_MATH>::setup(testOpts &opts) {
     mainCfg.randSeed    = opts.attnRandSeed;
     mainCfg.dataType    = cudnnDataType_t(opts.attnDataType);
     mainCfg.compPrec    = cudnnDataType_t(opts.attnCompPrec);
-    mainCfg.fileDump    = opts.attnFileDump != 0 ? 1 : 0;
+    mainCfg.fileDump    = opts.attnFileDump;
+    mainCfg.refCheck    = opts.attnRefCheck != 0 ? 1 : 0;
 
     if (opts.attnQueryMap == 0) {
         mainCfg.attnMode = (mainCfg.attnMode | CUDNN_ATTN_QUERYMAP_ALL_TO_ONE);
@@ -321,7 +498,13 @@ MultiheadAttentionTest<IS_TRAINING, T_ELEM, T_MATH>::setup(testOpts &opts) {
         exit(-1);
     }
 
-    if (mainCfg.fileDump != 0) {
+    if (mainCfg.fileDump < 0 || mainCfg.fileDump > 2) {
+        fprintf(stderr, "ERROR: wrong -attnFileDump value\n\n");
+        exit(-1);
+    }
+
+    // Text files hold one sentence for attn_ref.py, binary files hold all data.
+    if (mainCfg.fileDump == 1) {
         if (mainCfg.batchSize > 1) {
             fprintf(stderr, "ERROR: -attnFileDump%d requires -attnBatchSize=1\n\n", opts.attnFileDump);
             exit(-1);
@@ -348,6 +531,18 @@ MultiheadAttentionTest<IS_TRAINING, T_ELEM, T_MATH>::setup(testOpts &opts) {
         }
     }
 
+    if (mainCfg.refCheck != 0) {
+        if (mainCfg.projBias != 0) {
+            fprintf(stderr, "ERROR: -attnRefCheck%d requires -attnProjBias=0\n\n", opts.attnRefCheck);
+            exit(-1);
+        }
+
+        if (IS_TRAINING && mainCfg.dropoutRate > 0.0) {
+            fprintf(stderr, "ERROR: -attnRefCheck%d requires -attnDropoutRate=0\n\n", opts.attnRefCheck);
+            exit(-1);
+        }
+    }
+
     int qProjLen = mainCfg.qLength();
     int kProjLen = mainCfg.kLength();
     int outLen   = mainCfg.oLength();
@@ -696,7 +891,8 @@ MultiheadAttentionTest<IS_TRAINING, T_ELEM, T_MATH>::testgen(attnConfig *testCfg
     printf("#### attnSweep       = %d\n", testCfg->sweep);
     printf("#### attnRandGeom    = %d\n", testCfg->randGeom);
     printf("#### attnRandSeed    = %d\n", testCfg->randSeed);
-    printf("#### attnFileDump    = %d\n\n", testCfg->fileDump);
+    printf("#### attnFileDump    = %d\n", testCfg->fileDump);
+    printf("#### attnRefCheck    = %d\n\n", testCfg->refCheck);
 
     for (size_t i = 0; i < qBatches; ++i) {
         printf("sequence_length_q[idx=%zu]=%d\n", i, qSeqArray[i]);
@@ -868,28 +1064,25 @@ MultiheadAttentionTest<IS_TRAINING, T_ELEM, T_MATH>::run() {
     }
 
     if (testCfg.fileDump) {
-        cudnnSeqDataAxis_t ordA[CUDNN_SEQDATA_DIM_COUNT];
-        int nbDims;
-
         saveMeta("meta.dat", IS_TRAINING, &testCfg);
 
-        CHECK_CUDNN_ERR(
-            cudnnGetSeqDataDescriptor(q_desc, NULL, &nbDims, CUDNN_SEQDATA_DIM_COUNT, dimA, ordA, NULL, 0, NULL, NULL));
-        saveData<T_ELEM>("q.dat", 0, 0, nbDims, dimA, ordA, hostQ);
-        CHECK_CUDNN_ERR(
-            cudnnGetSeqDataDescriptor(k_desc, NULL, &nbDims, CUDNN_SEQDATA_DIM_COUNT, dimA, ordA, NULL, 0, NULL, NULL));
-        saveData<T_ELEM>("k.dat", 0, 0, nbDims, dimA, ordA, hostK);
-        CHECK_CUDNN_ERR(
-            cudnnGetSeqDataDescriptor(v_desc, NULL, &nbDims, CUDNN_SEQDATA_DIM_COUNT, dimA, ordA, NULL, 0, NULL, NULL));
-        saveData<T_ELEM>("v.dat", 0, 0, nbDims, dimA, ordA, hostV);
+        dumpSeqData<T_ELEM>(q_desc, "q", testCfg.fileDump, hostQ);
+        dumpSeqData<T_ELEM>(k_desc, "k", testCfg.fileDump, hostK);
+        dumpSeqData<T_ELEM>(v_desc, "v", testCfg.fileDump, hostV);
 
         if (IS_TRAINING) {
-            CHECK_CUDNN_ERR(cudnnGetSeqDataDescriptor(
-                o_desc, NULL, &nbDims, CUDNN_SEQDATA_DIM_COUNT, dimA, ordA, NULL, 0, NULL, NULL));
-            saveData<T_ELEM>("dout.dat", 0, 0, nbDims, dimA, ordA, hostDO);
+            dumpSeqData<T_ELEM>(o_desc, "dout", testCfg.fileDump, hostDO);
         }
 
-        saveAllParams<T_ELEM>(handle, attn_desc, false, sizeWeights, hostW);
+        // Binary files also keep the sequence lengths and attention windows.
+        if (testCfg.fileDump == 2) {
+            saveBinaryArray("seqlenq.bin", qSeqArraySize, qSeqArray);
+            saveBinaryArray("seqlenk.bin", kSeqArraySize, kSeqArray);
+            saveBinaryArray("lowin.bin", testCfg.seqLenQ, loWinIdx);
+            saveBinaryArray("hiwin.bin", testCfg.seqLenQ, hiWinIdx);
+        }
+
+        saveAllParams<T_ELEM>(handle, attn_desc, false, testCfg.fileDump, testCfg.dataType, sizeWeights, hostW);
     }
 
     std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
@@ -1036,38 +1229,112 @@ MultiheadAttentionTest<IS_TRAINING, T_ELEM, T_MATH>::run() {
     // Copy forward output to host.
     CHECK_CUDA_ERR(cudaMemcpy(hostO, devO, oNmbElem * sizeof(devO[0]), cudaMemcpyDeviceToHost));
 
-    if (testCfg.fileDump) {
-        cudnnSeqDataAxis_t ordA[CUDNN_SEQDATA_DIM_COUNT];
-        int nbDims;
+    // Copy dgrad and wgrad results to host.
+    if (IS_TRAINING && (testCfg.fileDump || testCfg.refCheck)) {
+        CHECK_CUDA_ERR(cudaMemcpy(hostDQ, devDQ, sizeof(devDQ[0]) * qNmbElem, cudaMemcpyDeviceToHost));
+        CHECK_CUDA_ERR(cudaMemcpy(hostDK, devDK, sizeof(devDK[0]) * kNmbElem, cudaMemcpyDeviceToHost));
+        CHECK_CUDA_ERR(cudaMemcpy(hostDV, devDV, sizeof(devDV[0]) * vNmbElem, cudaMemcpyDeviceToHost));
 
-        CHECK_CUDNN_ERR(
-            cudnnGetSeqDataDescriptor(o_desc, NULL, &nbDims, CUDNN_SEQDATA_DIM_COUNT, dimA, ordA, NULL, 0, NULL, NULL));
-        saveData<T_ELEM>("out.dat", 0, 0, nbDims, dimA, ordA, hostO);
+        if (sizeWeights > 0) {
+            CHECK_CUDA_ERR(cudaMemcpy(hostDW, devDW, sizeWeights, cudaMemcpyDeviceToHost));
+        }
+    }
+
+    if (testCfg.fileDump) {
+        dumpSeqData<T_ELEM>(o_desc, "out", testCfg.fileDump, hostO);
 
         if (IS_TRAINING) {
-            CHECK_CUDA_ERR(cudaMemcpy(hostDQ, devDQ, sizeof(devDQ[0]) * qNmbElem, cudaMemcpyDeviceToHost));
-            CHECK_CUDA_ERR(cudaMemcpy(hostDK, devDK, sizeof(devDK[0]) * kNmbElem, cudaMemcpyDeviceToHost));
-            CHECK_CUDA_ERR(cudaMemcpy(hostDV, devDV, sizeof(devDV[0]) * vNmbElem, cudaMemcpyDeviceToHost));
+            dumpSeqData<T_ELEM>(q_desc, "dq", testCfg.fileDump, hostDQ);
+            dumpSeqData<T_ELEM>(k_desc, "dk", testCfg.fileDump, hostDK);
+            dumpSeqData<T_ELEM>(v_desc, "dv", testCfg.fileDump, hostDV);
 
-            CHECK_CUDNN_ERR(cudnnGetSeqDataDescriptor(
-                q_desc, NULL, &nbDims, CUDNN_SEQDATA_DIM_COUNT, dimA, ordA, NULL, 0, NULL, NULL));
-            saveData<T_ELEM>("dq.dat", 0, 0, nbDims, dimA, ordA, hostDQ);
+            if (sizeWeights > 0) {
+                saveAllParams<T_ELEM>(
+                    handle, attn_desc, true, testCfg.fileDump, testCfg.dataType, sizeWeights, hostDW);
+            }
+        }
+    }
 
-            CHECK_CUDNN_ERR(cudnnGetSeqDataDescriptor(
-                k_desc, NULL, &nbDims, CUDNN_SEQDATA_DIM_COUNT, dimA, ordA, NULL, 0, NULL, NULL));
-            saveData<T_ELEM>("dk.dat", 0, 0, nbDims, dimA, ordA, hostDK);
+    if (testCfg.refCheck && !refCheck(&testCfg, sizeWeights)) {
+        fprintf(stderr, "ERROR: cuDNN results do not match the reference model\n\n");
+        exit(-1);
+    }
+}
 
-            CHECK_CUDNN_ERR(cudnnGetSeqDataDescriptor(
-                v_desc, NULL, &nbDims, CUDNN_SEQDATA_DIM_COUNT, dimA, ordA, NULL, 0, NULL, NULL));
-            saveData<T_ELEM>("dv.dat", 0, 0, nbDims, dimA, ordA, hostDV);
+// Computes the forward response (and in the training mode, dgrad and wgrad
+// results) of the CPU reference model, and compares the cuDNN results copied
+// to host buffers with them.  Returns false on any mismatch.
+template <bool IS_TRAINING, typename T_ELEM, typename T_MATH>
+bool
+MultiheadAttentionTest<IS_TRAINING, T_ELEM, T_MATH>::refCheck(attnConfig *testCfg, size_t sizeWeights) {
+    static cudnnMultiHeadAttnWeightKind_t wKind[WGROUP_COUNT] = {
+        CUDNN_MH_ATTN_Q_WEIGHTS, CUDNN_MH_ATTN_K_WEIGHTS, CUDNN_MH_ATTN_V_WEIGHTS, CUDNN_MH_ATTN_O_WEIGHTS};
 
-            // Copy wgrad results to host
-            if (sizeWeights > 0) {
-                CHECK_CUDA_ERR(cudaMemcpy(hostDW, devDW, sizeWeights, cudaMemcpyDeviceToHost));
-                saveAllParams<T_ELEM>(handle, attn_desc, true, sizeWeights, hostDW);
+    // Tolerances of attn_ref.py, relaxed for FP16 data.
+    double rtol = (sizeof(T_ELEM) < sizeof(float) ? 1e-2 : 1e-4);
+    double atol = (sizeof(T_ELEM) < sizeof(float) ? 1e-2 : 1e-3);
+
+    cudnnTensorDescriptor_t weightDesc = NULL;
+    int wDimA[3], wStrideA[3];
+    T_ELEM *weightAddr;
+
+    int qDimA[CUDNN_SEQDATA_DIM_COUNT], kDimA[CUDNN_SEQDATA_DIM_COUNT];
+    int vDimA[CUDNN_SEQDATA_DIM_COUNT], oDimA[CUDNN_SEQDATA_DIM_COUNT];
+    size_t qStrA[CUDNN_SEQDATA_DIM_COUNT], kStrA[CUDNN_SEQDATA_DIM_COUNT];
+    size_t vStrA[CUDNN_SEQDATA_DIM_COUNT], oStrA[CUDNN_SEQDATA_DIM_COUNT];
+
+    getSeqDataGeom(q_desc, qDimA, qStrA);
+    getSeqDataGeom(k_desc, kDimA, kStrA);
+    getSeqDataGeom(v_desc, vDimA, vStrA);
+    getSeqDataGeom(o_desc, oDimA, oStrA);
+
+    CHECK_CUDNN_ERR(cudnnCreateTensorDescriptor(&weightDesc));
+
+    std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+
+    attnRefModel ref(testCfg, qSeqArray, kSeqArray, loWinIdx, hiWinIdx);
+
+    for (int i = 0; i < WGROUP_COUNT; i++) {
+        if (ref.hasWeights(wKind[i])) {
+            getWeights<T_ELEM>(
+                handle, attn_desc, wKind[i], sizeWeights, hostW, weightDesc, wDimA, wStrideA, &weightAddr);
+            ref.loadWeights<T_ELEM>(wKind[i], wDimA, wStrideA, weightAddr);
+        }
+    }
+
+    ref.loadData<T_ELEM>('q', qDimA, qStrA, hostQ);
+    ref.loadData<T_ELEM>('k', kDimA, kStrA, hostK);
+    ref.loadData<T_ELEM>('v', vDimA, vStrA, hostV);
+    ref.forward();
+
+    if (IS_TRAINING) {
+        ref.loadData<T_ELEM>('d', oDimA, oStrA, hostDO);
+        ref.backward();
+    }
+
+    std::chrono::steady_clock::time_point stop = std::chrono::steady_clock::now();
+
+    printf("\nReference model elapsed time = %Lf sec\n\n", (std::chrono::duration<long double>(stop - start)).count());
+
+    bool pass = ref.compareData<T_ELEM>('o', oDimA, oStrA, hostO, rtol, atol);
+
+    if (IS_TRAINING) {
+        pass = ref.compareData<T_ELEM>('q', qDimA, qStrA, hostDQ, rtol, atol) && pass;
+        pass = ref.compareData<T_ELEM>('k', kDimA, kStrA, hostDK, rtol, atol) && pass;
+        pass = ref.compareData<T_ELEM>('v', vDimA, vStrA, hostDV, rtol, atol) && pass;
+
+        for (int i = 0; i < WGROUP_COUNT; i++) {
+            if (ref.hasWeights(wKind[i])) {
+                getWeights<T_ELEM>(
+                    handle, attn_desc, wKind[i], sizeWeights, hostDW, weightDesc, wDimA, wStrideA, &weightAddr);
+                pass = ref.compareWeights<T_ELEM>(wKind[i], wDimA, wStrideA, weightAddr, rtol, atol) && pass;
             }
         }
     }
+
+    cudnnDestroyTensorDescriptor(weightDesc);
+
+    return pass;
 }
 
 template <bool IS_TRAINING, typename T_ELEM, typename T_MATH>
@@ -1123,7 +1390,8 @@ parseAttnParameters(int argc, char **argv, testOpts *opts) {
         {"attnSweep", "%d", offsetof(testOpts, attnSweep), "sweep all time-steps in one inference API call"},
         {"attnRandGeom", "%d", offsetof(testOpts, attnRandGeom), "randomize attention task dimensions"},
         {"attnRandSeed", "%d", offsetof(testOpts, attnRandSeed), "seed for the random number generator"},
-        {"attnFileDump", "%d", offsetof(testOpts, attnFileDump), "dump weights/data to file for single sentence"},
+        {"attnFileDump", "%d", offsetof(testOpts, attnFileDump), "dump weights/data to file (1-text, 2-binary)"},
+        {"attnRefCheck", "%d", offsetof(testOpts, attnRefCheck), "check results with the CPU reference model"},
     };
 
     if (argc == 1) {
@@ -1204,6 +1472,7 @@ main(int argc, char **argv) {
     opts.attnRandGeom    = 0;
     opts.attnRandSeed    = 1234;
     opts.attnFileDump    = 0;
+    opts.attnRefCheck    = 0;
 
     parseAttnParameters(argc, argv, &opts);
 
@@ -26,8 +26,12 @@
 // OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 // ----------------------------------------------------------------------
 
+#if !defined(_MULTI_HEAD_ATTENTION_H_)
+#define _MULTI_HEAD_ATTENTION_H_
+
 #include <stdio.h>
 #include <stdlib.h>
+#include <stdint.h>
 #include <string.h>
 #include <ctype.h>
 #include <cuda.h>
@@ -99,6 +103,7 @@ struct testOpts {
     int attnRandGeom;
     int attnRandSeed;
     int attnFileDump;
+    int attnRefCheck;
 };
 
 struct attnConfig {
@@ -125,7 +130,8 @@ struct attnConfig {
     int sweep;          // sweep all time-steps in inference mode
     int randGeom;       // randomize poblem dimensions
     int randSeed;       // random number generator seed
-    int fileDump;       // save single sentence data to file
+    int fileDump;       // save data to file (1-single sentence as text, 2-binary)
+    int refCheck;       // check results against the CPU reference model
 
     unsigned attnMode;  // Attention Mode parameter
 
@@ -232,6 +238,51 @@ struct attnConfig {
     }
 };
 
+// Header of binary dump files (-attnFileDump2).  Dimensions are listed from
+// the outermost to the innermost one, and strides are given in elements.  For
+// SeqData containers, axisA[] holds the cudnnSeqDataAxis_t of every dimension;
+// it is -1 for weights and other arrays.  The elements follow, in the native
+// byte order, at dataOffset bytes from the beginning of the file.  The offset
+// is a multiple of the page size, so that the data can be mapped in place.
+#define ATTN_DUMP_VERSION 1
+#define ATTN_DUMP_MAX_DIMS 4
+#define ATTN_DUMP_DATA_OFFSET 4096
+
+struct attnDumpHeader {
+    char magic[8];                          // "cuDNNMHA"
+    int32_t version;                        // ATTN_DUMP_VERSION
+    int32_t dataType;                       // cudnnDataType_t of elements
+    int32_t elemSize;                       // size of one element in bytes
+    int32_t nbDims;                         // number of dimensions
+    int32_t dimA[ATTN_DUMP_MAX_DIMS];       // dimensions
+    int32_t axisA[ATTN_DUMP_MAX_DIMS];      // SeqData axis of every dimension
+    int64_t strideA[ATTN_DUMP_MAX_DIMS];    // strides in elements
+    int64_t dataOffset;                     // offset of data in bytes
+    int64_t dataSize;                       // size of data in bytes
+};
+
+// Computes strides of a packed SeqData container from its dimensions and the
+// order of axes in memory (ordA[0] is the outermost one).  Both dimA[] and
+// strA[] are indexed by cudnnSeqDataAxis_t.
+inline void
+seqDataStrides(int nDims, const int dimA[], const cudnnSeqDataAxis_t ordA[], size_t strA[]) {
+    for (int i = 0; i < nDims; i++) {
+        strA[i] = 0;
+    }
+
+    strA[nDims - 1] = 1;
+    size_t stride   = dimA[nDims - 1];
+    for (int i = nDims - 2; i >= 0; i--) {
+        if (ordA[i] < nDims - 1 && strA[ordA[i]] == 0) {
+            strA[ordA[i]] = stride;
+            stride *= dimA[ordA[i]];
+        } else {
+            fprintf(stderr, "ERROR: invalid re-order index ordA[i=%d]=%d\n\n", i, ordA[i]);
+            exit(-1);
+        }
+    }
+}
+
 template <bool IS_TRAINING, typename T_ELEM, typename T_MATH>
 class MultiheadAttentionTest {
    public:
@@ -317,4 +368,9 @@ class MultiheadAttentionTest {
 
     void
     testgen(attnConfig *testDesc);
+
+    bool
+    refCheck(attnConfig *testCfg, size_t sizeWeights);
 };
+
+#endif  // _MULTI_HEAD_ATTENTION_H_
@@ -0,0 +1,743 @@
+// ----------------------------------------------------------------------
+// Copyright (c) 2019, NVIDIA CORPORATION. All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions
+// are met:
+//  * Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//  * Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//  * Neither the name of NVIDIA CORPORATION nor the names of its
+//    contributors may be used to endorse or promote products derived
+//    from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS ``AS IS'' AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+// OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+// ----------------------------------------------------------------------
+
+#if !defined(_MULTI_HEAD_ATTENTION_REF_H_)
+#define _MULTI_HEAD_ATTENTION_REF_H_
+
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+#include <vector>
+
+#include "multiHeadAttention.h"
+
+// Number of Q, K, V, O weight groups, indexed by cudnnMultiHeadAttnWeightKind_t.
+#define REF_WGROUP_COUNT 4
+
+// Largest number of mismatches printed for one compared tensor.
+#define REF_MAX_REPORTED 10
+
+// CPU reference model of the multi-head attention forward, dgrad and wgrad
+// passes, computed in double precision.  The model follows the attnConfig of
+// the test: every Q sequence attends to the keys of its K/V sequence that lie
+// in the attention window [loWinIdx[t], hiWinIdx[t]) of its time-step t and
+// before the end of the K/V sequence.  Time-steps past the end of a Q sequence
+// are not computed.  As in cuDNN, dq does not include the residual path from
+// the output.  Projection biases and dropout are not modeled.
+//
+// Data are kept packed as [sequence][time][vector] and weights of every head
+// as row-major [rows][cols] matrices, so that inner loops are unit stride.
+// The work is spread over (sequence, head) pairs with OpenMP.
+class attnRefModel {
+   public:
+    attnRefModel(attnConfig *cfg, const int *qSeqArray, const int *kSeqArray, const int *loWinIdx, const int *hiWinIdx);
+
+    // True when the given weight group is present (projection enabled).
+    bool
+    hasWeights(int kind) const {
+        return rows[kind] > 0;
+    }
+
+    template <typename T_ELEM>
+    void
+    loadWeights(int kind, const int dimA[3], const int strideA[3], const T_ELEM *weightAddr);
+
+    template <typename T_ELEM>
+    void
+    loadData(char tag, const int dimA[4], const size_t strA[4], const T_ELEM *dataBuf);
+
+    void
+    forward();
+
+    void
+    backward();
+
+    template <typename T_ELEM>
+    bool
+    compareData(char tag, const int dimA[4], const size_t strA[4], const T_ELEM *dataBuf, double rtol, double atol);
+
+    template <typename T_ELEM>
+    bool
+    compareWeights(
+        int kind, const int dimA[3], const int strideA[3], const T_ELEM *weightAddr, double rtol, double atol);
+
+   private:
+    int numHeads;
+    double smScaler;
+    bool resLink;
+    bool oneToOne;
+    int beamSize;
+
+    // Input vector lengths, and lengths after projections.
+    int qSize, kSize, vSize;
+    int qLen, kLen, vLen, oLen;
+
+    // Number of Q/O and K/V sequences, and their largest lengths.
+    int qSeqs, kSeqs;
+    int seqLenQ, seqLenK;
+
+    std::vector<int> qSeqLen;
+    std::vector<int> kSeqLen;
+    std::vector<int> loWin;
+    std::vector<int> hiWin;
+
+    // Shapes of weight groups: rows[kind] x cols[kind] per head (rows=0 if absent).
+    int rows[REF_WGROUP_COUNT];
+    int cols[REF_WGROUP_COUNT];
+
+    std::vector<double> w[REF_WGROUP_COUNT];
+    std::vector<double> dw[REF_WGROUP_COUNT];
+
+    // Packed [sequence][time][vector] inputs, outputs and their gradients.
+    std::vector<double> q, k, v, o, dout;
+    std::vector<double> dq, dk, dv;
+
+    // Packed [sequence][head][time][vector] projections and their gradients.
+    std::vector<double> qbar, kbar, vbar, hbar;
+    std::vector<double> dqbar, dkbar, dvbar;
+
+    int
+    kvSeq(int qs) const {
+        return oneToOne ? qs : qs / beamSize;
+    }
+
+    size_t
+    barIdx(int seq, int head, int time, int seqLen, int len) const {
+        return ((size_t(seq) * numHeads + head) * seqLen + time) * len;
+    }
+
+    void
+    project(int kind, int head, const double *x, double *y) const;
+
+    void
+    projectBack(int kind, int head, const double *dy, double *dx) const;
+
+    int
+    softmax(int qs, int head, int time, double *alpha, int *lo) const;
+
+    std::vector<double> *
+    dataOf(char tag, int *seqLen, int *vecLen, int **lengths);
+
+    bool
+    report(const char *tag, size_t count, size_t fails, double relErr, double absErr, double rtol, double atol) const;
+};
+
+inline attnRefModel::attnRefModel(
+    attnConfig *cfg, const int *qSeqArray, const int *kSeqArray, const int *loWinIdx, const int *hiWinIdx) {
+    numHeads = cfg->numHeads;
+    smScaler = cfg->smScaler;
+    resLink  = cfg->resLink;
+    oneToOne = (cfg->queryMap == CUDNN_ATTN_QUERYMAP_ONE_TO_ONE);
+    beamSize = cfg->beamSize;
+
+    qSize = cfg->qSize;
+    kSize = cfg->kSize;
+    vSize = cfg->vSize;
+    qLen  = cfg->qLength();
+    kLen  = cfg->kLength();
+    vLen  = cfg->vLength();
+    oLen  = cfg->oLength();
+
+    if (qLen != kLen) {
+        fprintf(stderr, "ERROR: reference model requires the same Q and K lengths after projection\n\n");
+        exit(-1);
+    }
+
+    if (resLink && oLen != qSize) {
+        fprintf(stderr, "ERROR: residual connections require the same Q and O vector lengths\n\n");
+        exit(-1);
+    }
+
+    qSeqs   = int(cfg->qSeqLenCount());
+    kSeqs   = int(cfg->kSeqLenCount());
+    seqLenQ = cfg->seqLenQ;
+    seqLenK = cfg->seqLenK;
+
+    qSeqLen.assign(qSeqArray, qSeqArray + qSeqs);
+    kSeqLen.assign(kSeqArray, kSeqArray + kSeqs);
+    loWin.assign(loWinIdx, loWinIdx + seqLenQ);
+    hiWin.assign(hiWinIdx, hiWinIdx + seqLenQ);
+
+    rows[CUDNN_MH_ATTN_Q_WEIGHTS] = cfg->qProjSize;
+    cols[CUDNN_MH_ATTN_Q_WEIGHTS] = qSize;
+    rows[CUDNN_MH_ATTN_K_WEIGHTS] = cfg->kProjSize;
+    cols[CUDNN_MH_ATTN_K_WEIGHTS] = kSize;
+    rows[CUDNN_MH_ATTN_V_WEIGHTS] = cfg->vProjSize;
+    cols[CUDNN_MH_ATTN_V_WEIGHTS] = vSize;
+    rows[CUDNN_MH_ATTN_O_WEIGHTS] = cfg->oProjSize;
+    cols[CUDNN_MH_ATTN_O_WEIGHTS] = vLen;
+
+    for (int i = 0; i < REF_WGROUP_COUNT; i++) {
+        w[i].assign(size_t(numHeads) * rows[i] * cols[i], 0.0);
+    }
+}
+
+// Copies one group of weights from the [heads][rows][cols] tensor reported by
+// cudnnGetMultiHeadAttnWeights().
+template <typename T_ELEM>
+void
+attnRefModel::loadWeights(int kind, const int dimA[3], const int strideA[3], const T_ELEM *weightAddr) {
+    if (dimA[0] != numHeads || dimA[1] != rows[kind] || dimA[2] != cols[kind]) {
+        fprintf(stderr,
+                "ERROR: unexpected [%dx%dx%d] weight tensor of kind %d, reference expects [%dx%dx%d]\n\n",
+                dimA[0],
+                dimA[1],
+                dimA[2],
+                kind,
+                numHeads,
+                rows[kind],
+                cols[kind]);
+        exit(-1);
+    }
+
+    double *dst = &w[kind][0];
+    for (int h = 0; h < dimA[0]; h++) {
+        for (int r = 0; r < dimA[1]; r++) {
+            for (int c = 0; c < dimA[2]; c++) {
+                size_t idx = size_t(h) * strideA[0] + size_t(r) * strideA[1] + size_t(c) * strideA[2];
+                *dst++     = double(weightAddr[idx]);
+            }
+        }
+    }
+}
+
+// Returns the packed buffer of 'q', 'k', 'v' inputs, 'o' output or 'd' output
+// gradient together with its sequence geometry.
+inline std::vector<double> *
+attnRefModel::dataOf(char tag, int *seqLen, int *vecLen, int **lengths) {
+    switch (tag) {
+        case 'q':
+            *seqLen  = seqLenQ;
+            *vecLen  = qSize;
+            *lengths = &qSeqLen[0];
+            return &q;
+        case 'k':
+            *seqLen  = seqLenK;
+            *vecLen  = kSize;
+            *lengths = &kSeqLen[0];
+            return &k;
+        case 'v':
+            *seqLen  = seqLenK;
+            *vecLen  = vSize;
+            *lengths = &kSeqLen[0];
+            return &v;
+        case 'o':
+            *seqLen  = seqLenQ;
+            *vecLen  = oLen;
+            *lengths = &qSeqLen[0];
+            return &o;
+        case 'd':
+            *seqLen  = seqLenQ;
+            *vecLen  = oLen;
+            *lengths = &qSeqLen[0];
+            return &dout;
+    }
+
+    fprintf(stderr, "ERROR: unknown reference data tag '%c'\n\n", tag);
+    exit(-1);
+}
+
+// Copies a SeqData container into its packed buffer ('q', 'k', 'v' or 'd').
+// Sequences are numbered batch-major, like the sequence length arrays.
+template <typename T_ELEM>
+void
+attnRefModel::loadData(char tag, const int dimA[4], const size_t strA[4], const T_ELEM *dataBuf) {
+    int seqLen, vecLen, *lengths;
+    std::vector<double> *dst = dataOf(tag, &seqLen, &vecLen, &lengths);
+
+    int batches = dimA[CUDNN_SEQDATA_BATCH_DIM];
+    int beams   = dimA[CUDNN_SEQDATA_BEAM_DIM];
+
+    if (dimA[CUDNN_SEQDATA_TIME_DIM] != seqLen || dimA[CUDNN_SEQDATA_VECT_DIM] != vecLen) {
+        fprintf(stderr, "ERROR: unexpected dimensions of '%c' data in the reference model\n\n", tag);
+        exit(-1);
+    }
+
+    dst->assign(size_t(batches) * beams * seqLen * vecLen, 0.0);
+
+    double *out = &(*dst)[0];
+    for (int n = 0; n < batches; n++) {
+        for (int b = 0; b < beams; b++) {
+            for (int t = 0; t < seqLen; t++) {
+                size_t base = n * strA[CUDNN_SEQDATA_BATCH_DIM] + b * strA[CUDNN_SEQDATA_BEAM_DIM] +
+                              t * strA[CUDNN_SEQDATA_TIME_DIM];
+                for (int x = 0; x < vecLen; x++) {
+                    *out++ = double(dataBuf[base + x * strA[CUDNN_SEQDATA_VECT_DIM]]);
+                }
+            }
+        }
+    }
+}
+
+// y = W[head] * x, or y = x when the projection is disabled.
+inline void
+attnRefModel::project(int kind, int head, const double *x, double *y) const {
+    int nr = rows[kind], nc = cols[kind];
+
+    if (nr == 0) {
+        for (int c = 0; c < nc; c++) {
+            y[c] = x[c];
+        }
+        return;
+    }
+
+    const double *wh = &w[kind][size_t(head) * nr * nc];
+    for (int r = 0; r < nr; r++) {
+        double sum = 0.0;
+        for (int c = 0; c < nc; c++) {
+            sum += wh[c] * x[c];
+        }
+        y[r] = sum;
+        wh += nc;
+    }
+}
+
+// dx += W[head]^T * dy, or dx += dy when the projection is disabled.
+inline void
+attnRefModel::projectBack(int kind, int head, const double *dy, double *dx) const {
+    int nr = rows[kind], nc = cols[kind];
+
+    if (nr == 0) {
+        for (int c = 0; c < nc; c++) {
+            dx[c] += dy[c];
+        }
+        return;
+    }
+
+    const double *wh = &w[kind][size_t(head) * nr * nc];
+    for (int r = 0; r < nr; r++) {
+        double g = dy[r];
+        for (int c = 0; c < nc; c++) {
+            dx[c] += wh[c] * g;
+        }
+        wh += nc;
+    }
+}
+
+// Computes the attention weights of one query time-step and head over the keys
+// [lo, lo + count) of its window, clipped to the K/V sequence.  Returns count,
+// which is zero when the window is empty.  Uses qbar and kbar.
+inline int
+attnRefModel::softmax(int qs, int head, int time, double *alpha, int *lo) const {
+    int ks    = kvSeq(qs);
+    int first = loWin[time] > 0 ? loWin[time] : 0;
+    int last  = hiWin[time] < kSeqLen[ks] ? hiWin[time] : kSeqLen[ks];
+
+    *lo = first;
+    if (first >= last) {
+        return 0;
+    }
+
+    const double *qb = &qbar[barIdx(qs, head, time, seqLenQ, qLen)];
+
+    double maxScore = -HUGE_VAL;
+    for (int j = first; j < last; j++) {
+        const double *kb = &kbar[barIdx(ks, head, j, seqLenK, kLen)];
+
+        double sum = 0.0;
+        for (int x = 0; x < kLen; x++) {
+            sum += qb[x] * kb[x];
+        }
+
+        alpha[j - first] = smScaler * sum;
+        maxScore         = alpha[j - first] > maxScore ? alpha[j - first] : maxScore;
+    }
+
+    double norm = 0.0;
+    for (int j = 0; j < last - first; j++) {
+        alpha[j] = exp(alpha[j] - maxScore);
+        norm += alpha[j];
+    }
+
+    for (int j = 0; j < last - first; j++) {
+        alpha[j] /= norm;
+    }
+
+    return last - first;
+}
+
+inline void
+attnRefModel::forward() {
+    qbar.assign(size_t(qSeqs) * numHeads * seqLenQ * qLen, 0.0);
+    kbar.assign(size_t(kSeqs) * numHeads * seqLenK * kLen, 0.0);
+    vbar.assign(size_t(kSeqs) * numHeads * seqLenK * vLen, 0.0);
+    hbar.assign(size_t(qSeqs) * numHeads * seqLenQ * vLen, 0.0);
+    o.assign(size_t(qSeqs) * seqLenQ * oLen, 0.0);
+
+    // Key and value projections.
+    int tasks = kSeqs * numHeads;
+#pragma omp parallel for schedule(dynamic)
+    for (int task = 0; task < tasks; task++) {
+        int ks = task / numHeads;
+        int h  = task % numHeads;
+        for (int t = 0; t < kSeqLen[ks]; t++) {
+            size_t tok = size_t(ks) * seqLenK + t;
+            project(CUDNN_MH_ATTN_K_WEIGHTS, h, &k[tok * kSize], &kbar[barIdx(ks, h, t, seqLenK, kLen)]);
+            project(CUDNN_MH_ATTN_V_WEIGHTS, h, &v[tok * vSize], &vbar[barIdx(ks, h, t, seqLenK, vLen)]);
+        }
+    }
+
+    // Query projections, attention weights and the output of every head.
+    tasks = qSeqs * numHeads;
+#pragma omp parallel for schedule(dynamic)
+    for (int task = 0; task < tasks; task++) {
+        int qs = task / numHeads;
+        int h  = task % numHeads;
+        int ks = kvSeq(qs);
+
+        std::vector<double> alpha(seqLenK + 1);
+
+        for (int t = 0; t < qSeqLen[qs]; t++) {
+            size_t tok = size_t(qs) * seqLenQ + t;
+            project(CUDNN_MH_ATTN_Q_WEIGHTS, h, &q[tok * qSize], &qbar[barIdx(qs, h, t, seqLenQ, qLen)]);
+
+            int lo;
+            int count = softmax(qs, h, t, &alpha[0], &lo);
+
+            double *hb = &hbar[barIdx(qs, h, t, seqLenQ, vLen)];
+            for (int j = 0; j < count; j++) {
+                const double *vb = &vbar[barIdx(ks, h, lo + j, seqLenK, vLen)];
+                for (int x = 0; x < vLen; x++) {
+                    hb[x] += alpha[j] * vb[x];
+                }
+            }
+        }
+    }
+
+    // Output projections summed over heads, and the residual connection.
+    tasks = qSeqs * seqLenQ;
+#pragma omp parallel for schedule(dynamic)
+    for (int task = 0; task < tasks; task++) {
+        int qs = task / seqLenQ;
+        int t  = task % seqLenQ;
+        if (t >= qSeqLen[qs]) {
+            continue;
+        }
+
+        double *ot = &o[size_t(task) * oLen];
+        std::vector<double> y(oLen);
+
+        for (int h = 0; h < numHeads; h++) {
+            const double *hb = &hbar[barIdx(qs, h, t, seqLenQ, vLen)];
+            if (hasWeights(CUDNN_MH_ATTN_O_WEIGHTS)) {
+                project(CUDNN_MH_ATTN_O_WEIGHTS, h, hb, &y[0]);
+                for (int x = 0; x < oLen; x++) {
+                    ot[x] += y[x];
+                }
+            } else {
+                // Without output projections, head outputs are concatenated.
+                for (int x = 0; x < vLen; x++) {
+                    ot[h * vLen + x] = hb[x];
+                }
+            }
+        }
+
+        if (resLink) {
+            for (int x = 0; x < oLen; x++) {
+                ot[x] += q[size_t(task) * qSize + x];
+            }
+        }
+    }
+}
+
+// Back-propagates 'dout' (see loadData()) through the model; forward() must
+// have been called.  Weight gradients are accumulated from zero.
+inline void
+attnRefModel::backward() {
+    dqbar.assign(qbar.size(), 0.0);
+    dkbar.assign(kbar.size(), 0.0);
+    dvbar.assign(vbar.size(), 0.0);
+    dq.assign(q.size(), 0.0);
+    dk.assign(k.size(), 0.0);
+    dv.assign(v.size(), 0.0);
+
+    // Gradients of projections.  Each task owns one K/V sequence and head, so
+    // it visits all queries attending to it, and writes their dqbar alone.
+    int tasks = kSeqs * numHeads;
+#pragma omp parallel for schedule(dynamic)
+    for (int task = 0; task < tasks; task++) {
+        int ks = task / numHeads;
+        int h  = task % numHeads;
+
+        int qFirst = oneToOne ? ks : ks * beamSize;
+        int qLast  = oneToOne ? ks + 1 : qFirst + beamSize;
+
+        std::vector<double> alpha(seqLenK + 1);
+        std::vector<double> dalpha(seqLenK + 1);
+        std::vector<double> dh(vLen);
+
+        for (int qs = qFirst; qs < qLast; qs++) {
+            for (int t = 0; t < qSeqLen[qs]; t++) {
+                const double *dot = &dout[(size_t(qs) * seqLenQ + t) * oLen];
+
+                int lo;
+                int count = softmax(qs, h, t, &alpha[0], &lo);
+                if (count == 0) {
+                    continue;
+                }
+
+                // Gradient of the head output.
+                if (hasWeights(CUDNN_MH_ATTN_O_WEIGHTS)) {
+                    for (int x = 0; x < vLen; x++) {
+                        dh[x] = 0.0;
+                    }
+                    projectBack(CUDNN_MH_ATTN_O_WEIGHTS, h, dot, &dh[0]);
+                } else {
+                    for (int x = 0; x < vLen; x++) {
+                        dh[x] = dot[h * vLen + x];
+                    }
+                }
+
+                // Gradients of values and attention weights.
+                double dsum = 0.0;
+                for (int j = 0; j < count; j++) {
+                    const double *vb = &vbar[barIdx(ks, h, lo + j, seqLenK, vLen)];
+                    double *dvb      = &dvbar[barIdx(ks, h, lo + j, seqLenK, vLen)];
+
+                    double sum = 0.0;
+                    for (int x = 0; x < vLen; x++) {
+                        sum += dh[x] * vb[x];
+                        dvb[x] += alpha[j] * dh[x];
+                    }
+
+                    dalpha[j] = sum;
+                    dsum += alpha[j] * sum;
+                }
+
+                // Through the softmax to queries and keys.
+                const double *qb = &qbar[barIdx(qs, h, t, seqLenQ, qLen)];
+                double *dqb      = &dqbar[barIdx(qs, h, t, seqLenQ, qLen)];
+                for (int j = 0; j < count; j++) {
+                    double ds        = smScaler * alpha[j] * (dalpha[j] - dsum);
+                    const double *kb = &kbar[barIdx(ks, h, lo + j, seqLenK, kLen)];
+                    double *dkb      = &dkbar[barIdx(ks, h, lo + j, seqLenK, kLen)];
+                    for (int x = 0; x < kLen; x++) {
+                        dqb[x] += ds * kb[x];
+                        dkb[x] += ds * qb[x];
+                    }
+                }
+            }
+        }
+    }
+
+    // Data gradients, summed over heads.
+    tasks = qSeqs * seqLenQ;
+#pragma omp parallel for schedule(dynamic)
+    for (int task = 0; task < tasks; task++) {
+        int qs = task / seqLenQ;
+        int t  = task % seqLenQ;
+        for (int h = 0; h < numHeads && t < qSeqLen[qs]; h++) {
+            projectBack(CUDNN_MH_ATTN_Q_WEIGHTS, h, &dqbar[barIdx(qs, h, t, seqLenQ, qLen)], &dq[task * size_t(qSize)]);
+        }
+    }
+
+    tasks = kSeqs * seqLenK;
+#pragma omp parallel for schedule(dynamic)
+    for (int task = 0; task < tasks; task++) {
+        int ks = task / seqLenK;
+        int t  = task % seqLenK;
+        for (int h = 0; h < numHeads && t < kSeqLen[ks]; h++) {
+            projectBack(CUDNN_MH_ATTN_K_WEIGHTS, h, &dkbar[barIdx(ks, h, t, seqLenK, kLen)], &dk[task * size_t(kSize)]);
+            projectBack(CUDNN_MH_ATTN_V_WEIGHTS, h, &dvbar[barIdx(ks, h, t, seqLenK, vLen)], &dv[task * size_t(vSize)]);
+        }
+    }
+
+    // Weight gradients: every group and head is an independent sum over tokens.
+    for (int i = 0; i < REF_WGROUP_COUNT; i++) {
+        dw[i].assign(w[i].size(), 0.0);
+    }
+
+    tasks = REF_WGROUP_COUNT * numHeads;
+#pragma omp parallel for schedule(dynamic)
+    for (int task = 0; task < tasks; task++) {
+        int kind = task / numHeads;
+        int h    = task % numHeads;
+        int nr   = rows[kind];
+        int nc   = cols[kind];
+        if (nr == 0) {
+            continue;
+        }
+
+        bool isQO  = (kind == CUDNN_MH_ATTN_Q_WEIGHTS || kind == CUDNN_MH_ATTN_O_WEIGHTS);
+        int seqs   = isQO ? qSeqs : kSeqs;
+        int seqLen = isQO ? seqLenQ : seqLenK;
+
+        double *dwh = &dw[kind][size_t(h) * nr * nc];
+
+        for (int s = 0; s < seqs; s++) {
+            for (int t = 0; t < (isQO ? qSeqLen[s] : kSeqLen[s]); t++) {
+                size_t tok = size_t(s) * seqLen + t;
+
+                // Gradient of the projection output, and its input.
+                const double *dy, *x;
+                switch (kind) {
+                    case CUDNN_MH_ATTN_Q_WEIGHTS:
+                        dy = &dqbar[barIdx(s, h, t, seqLen, qLen)];
+                        x  = &q[tok * qSize];
+                        break;
+                    case CUDNN_MH_ATTN_K_WEIGHTS:
+                        dy = &dkbar[barIdx(s, h, t, seqLen, kLen)];
+                        x  = &k[tok * kSize];
+                        break;
+                    case CUDNN_MH_ATTN_V_WEIGHTS:
+                        dy = &dvbar[barIdx(s, h, t, seqLen, vLen)];
+                        x  = &v[tok * vSize];
+                        break;
+                    default:
+                        dy = &dout[tok * oLen];
+                        x  = &hbar[barIdx(s, h, t, seqLen, vLen)];
+                        break;
+                }
+
+                for (int r = 0; r < nr; r++) {
+                    for (int c = 0; c < nc; c++) {
+                        dwh[size_t(r) * nc + c] += dy[r] * x[c];
+                    }
+                }
+            }
+        }
+    }
+}
+
+inline bool
+attnRefModel::report(
+    const char *tag, size_t count, size_t fails, double relErr, double absErr, double rtol, double atol) const {
+    printf("%s: %s [rel_err=%.6e abs_err=%.6e, rtol=%.6e, atol=%.6e, %zu of %zu mismatched]\n",
+           fails == 0 ? "PASS" : "FAIL",
+           tag,
+           relErr,
+           absErr,
+           rtol,
+           atol,
+           fails,
+           count);
+    return fails == 0;
+}
+
+// Compares a SeqData result of the library ('o' output, or 'q', 'k', 'v'
+// gradients) with the reference under the condition of numpy's allclose():
+// |res - ref| <= atol + rtol * |ref|.  Padding past sequence ends is skipped.
+template <typename T_ELEM>
+bool
+attnRefModel::compareData(
+    char tag, const int dimA[4], const size_t strA[4], const T_ELEM *dataBuf, double rtol, double atol) {
+    int seqLen, vecLen, *lengths;
+    const std::vector<double> *ref = dataOf(tag, &seqLen, &vecLen, &lengths);
+    char name[8];
+
+    if (tag != 'o') {
+        ref = (tag == 'q' ? &dq : tag == 'k' ? &dk : &dv);
+    }
+    sprintf(name, tag == 'o' ? "out" : "d%c", tag);
+
+    int beams    = dimA[CUDNN_SEQDATA_BEAM_DIM];
+    size_t count = 0, fails = 0;
+    double relErr = 0.0, absErr = 0.0;
+
+    for (int s = 0; s < dimA[CUDNN_SEQDATA_BATCH_DIM] * beams; s++) {
+        for (int t = 0; t < lengths[s]; t++) {
+            size_t base = (s / beams) * strA[CUDNN_SEQDATA_BATCH_DIM] + (s % beams) * strA[CUDNN_SEQDATA_BEAM_DIM] +
+                          t * strA[CUDNN_SEQDATA_TIME_DIM];
+            const double *rt = &(*ref)[(size_t(s) * seqLen + t) * vecLen];
+
+            for (int x = 0; x < vecLen; x++) {
+                double res  = double(dataBuf[base + x * strA[CUDNN_SEQDATA_VECT_DIM]]);
+                double diff = fabs(res - rt[x]);
+
+                absErr = diff > absErr ? diff : absErr;
+                if (rt[x] != 0.0 && diff / fabs(rt[x]) > relErr) {
+                    relErr = diff / fabs(rt[x]);
+                }
+
+                // Written so that NaN results fail.
+                if (!(diff <= atol + rtol * fabs(rt[x]))) {
+                    if (fails < REF_MAX_REPORTED) {
+                        printf("%s_res[seq=%d,time=%d,vect=%d]=%+.6e, %s_ref=%+.6e\n", name, s, t, x, res, name, rt[x]);
+                    }
+                    fails++;
+                }
+                count++;
+            }
+        }
+    }
+
+    return report(name, count, fails, relErr, absErr, rtol, atol);
+}
+
+// Compares one group of weight gradients of the library with the reference.
+template <typename T_ELEM>
+bool
+attnRefModel::compareWeights(
+    int kind, const int dimA[3], const int strideA[3], const T_ELEM *weightAddr, double rtol, double atol) {
+    static const char *name[REF_WGROUP_COUNT] = {"dwq", "dwk", "dwv", "dwo"};
+
+    if (dimA[0] != numHeads || dimA[1] != rows[kind] || dimA[2] != cols[kind]) {
+        fprintf(stderr, "ERROR: unexpected dimensions of '%s' weight gradients\n\n", name[kind]);
+        exit(-1);
+    }
+
+    size_t count = 0, fails = 0;
+    double relErr = 0.0, absErr = 0.0;
+
+    const double *ref = &dw[kind][0];
+    for (int h = 0; h < dimA[0]; h++) {
+        for (int r = 0; r < dimA[1]; r++) {
+            for (int c = 0; c < dimA[2]; c++) {
+                size_t idx  = size_t(h) * strideA[0] + size_t(r) * strideA[1] + size_t(c) * strideA[2];
+                double res  = double(weightAddr[idx]);
+                double diff = fabs(res - *ref);
+
+                absErr = diff > absErr ? diff : absErr;
+                if (*ref != 0.0 && diff / fabs(*ref) > relErr) {
+                    relErr = diff / fabs(*ref);
+                }
+
+                if (!(diff <= atol + rtol * fabs(*ref))) {
+                    if (fails < REF_MAX_REPORTED) {
+                        printf("%s_res[head=%d,row=%d,col=%d]=%+.6e, %s_ref=%+.6e\n",
+                               name[kind],
+                               h,
+                               r,
+                               c,
+                               res,
+                               name[kind],
+                               *ref);
+                    }
+                    fails++;
+                }
+                count++;
+                ref++;
+            }
+        }
+    }
+
+    return report(name[kind], count, fails, relErr, absErr, rtol, atol);
+}
+
+#endif  // _MULTI_HEAD_ATTENTION_REF_H_
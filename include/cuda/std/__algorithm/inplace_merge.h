@@ -0,0 +1,269 @@
+//===----------------------------------------------------------------------===//
+//
+// Part of the LLVM Project, under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+// SPDX-FileCopyrightText: Copyright (c) 2024 NVIDIA CORPORATION & AFFILIATES.
+//
+//===----------------------------------------------------------------------===//
+
+#ifndef _LIBCUDACXX___ALGORITHM_INPLACE_MERGE_H
+#define _LIBCUDACXX___ALGORITHM_INPLACE_MERGE_H
+
+#include <cuda/std/detail/__config>
+
+#if defined(_CCCL_IMPLICIT_SYSTEM_HEADER_GCC)
+#  pragma GCC system_header
+#elif defined(_CCCL_IMPLICIT_SYSTEM_HEADER_CLANG)
+#  pragma clang system_header
+#elif defined(_CCCL_IMPLICIT_SYSTEM_HEADER_MSVC)
+#  pragma system_header
+#endif // no system header
+
+#include <cuda/std/__algorithm/comp.h>
+#include <cuda/std/__algorithm/comp_ref_type.h>
+#include <cuda/std/__algorithm/iterator_operations.h>
+#include <cuda/std/__algorithm/lower_bound.h>
+#include <cuda/std/__algorithm/min.h>
+#include <cuda/std/__algorithm/move.h>
+#include <cuda/std/__algorithm/move_backward.h>
+#include <cuda/std/__algorithm/rotate.h>
+#include <cuda/std/__algorithm/upper_bound.h>
+#include <cuda/std/__functional/identity.h>
+#include <cuda/std/__iterator/iterator_traits.h>
+#include <cuda/std/__memory/destruct_n.h>
+#include <cuda/std/__memory/temporary_buffer.h>
+#include <cuda/std/__memory/unique_ptr.h>
+#include <cuda/std/__type_traits/is_constant_evaluated.h>
+#include <cuda/std/__utility/move.h>
+#include <cuda/std/__utility/pair.h>
+#include <cuda/std/cstddef>
+
+_LIBCUDACXX_BEGIN_NAMESPACE_STD
+
+// Merges [__first, __middle) and [__middle, __last) by moving the shorter one
+// into __buff, which must hold at least min(__len1, __len2) elements.
+template <class _AlgPolicy, class _Compare, class _BidirectionalIterator>
+_LIBCUDACXX_INLINE_VISIBILITY void __buffered_inplace_merge(
+  _BidirectionalIterator __first,
+  _BidirectionalIterator __middle,
+  _BidirectionalIterator __last,
+  _Compare __comp,
+  typename iterator_traits<_BidirectionalIterator>::difference_type __len1,
+  typename iterator_traits<_BidirectionalIterator>::difference_type __len2,
+  typename iterator_traits<_BidirectionalIterator>::value_type* __buff)
+{
+  using _Ops       = _IterOps<_AlgPolicy>;
+  using value_type = typename iterator_traits<_BidirectionalIterator>::value_type;
+
+  __destruct_n __d(0);
+  unique_ptr<value_type, __destruct_n&> __h(__buff, __d);
+  value_type* __p = __buff;
+  if (__len1 <= __len2)
+  {
+    for (_BidirectionalIterator __i = __first; __i != __middle; __d.template __incr<value_type>(), (void) ++__i, ++__p)
+    {
+      ::new ((void*) __p) value_type(_Ops::__iter_move(__i));
+    }
+    // Merge forward. The output never overtakes the unread part of the
+    // second range, and equal elements are taken from the buffer first.
+    for (value_type* __b = __buff; __b != __p; ++__first)
+    {
+      if (__middle == __last)
+      {
+        (void) _CUDA_VSTD::__move<_AlgPolicy>(__b, __p, __first);
+        return;
+      }
+      if (__comp(*__middle, *__b))
+      {
+        *__first = _Ops::__iter_move(__middle);
+        ++__middle;
+      }
+      else
+      {
+        *__first = _CUDA_VSTD::move(*__b);
+        ++__b;
+      }
+    }
+  }
+  else
+  {
+    for (_BidirectionalIterator __i = __middle; __i != __last; __d.template __incr<value_type>(), (void) ++__i, ++__p)
+    {
+      ::new ((void*) __p) value_type(_Ops::__iter_move(__i));
+    }
+    // Merge backward, taking equal elements from the buffer first.
+    while (__p != __buff)
+    {
+      if (__middle == __first)
+      {
+        (void) _CUDA_VSTD::__move_backward<_AlgPolicy>(__buff, __p, __last);
+        return;
+      }
+      _BidirectionalIterator __m = __middle;
+      if (__comp(*(__p - 1), *--__m))
+      {
+        *--__last = _Ops::__iter_move(__m);
+        __middle  = __m;
+      }
+      else
+      {
+        *--__last = _CUDA_VSTD::move(*--__p);
+      }
+    }
+  }
+}
+
+// Merges [__first, __middle) and [__middle, __last), of __len1 and __len2
+// elements. Merges whose shorter run fits into __buff go through it, the
+// others are split with a binary search and a rotation into two smaller
+// merges. The smaller of them is merged recursively, which bounds the depth
+// of recursion to log2(__len1 + __len2). Without a buffer the merge takes
+// O(n log n) moves.
+template <class _AlgPolicy, class _Compare, class _BidirectionalIterator>
+_LIBCUDACXX_INLINE_VISIBILITY _CCCL_CONSTEXPR_CXX14 void __inplace_merge(
+  _BidirectionalIterator __first,
+  _BidirectionalIterator __middle,
+  _BidirectionalIterator __last,
+  _Compare __comp,
+  typename iterator_traits<_BidirectionalIterator>::difference_type __len1,
+  typename iterator_traits<_BidirectionalIterator>::difference_type __len2,
+  typename iterator_traits<_BidirectionalIterator>::value_type* __buff,
+  ptrdiff_t __buff_size)
+{
+  using _Ops            = _IterOps<_AlgPolicy>;
+  using difference_type = typename iterator_traits<_BidirectionalIterator>::difference_type;
+
+  auto __proj = _CUDA_VSTD::__identity();
+  while (true)
+  {
+    if (__len2 == 0)
+    {
+      return;
+    }
+    // Elements of the first range that are not greater than *__middle are in place.
+    for (;; ++__first, (void) --__len1)
+    {
+      if (__len1 == 0)
+      {
+        return;
+      }
+      if (__comp(*__middle, *__first))
+      {
+        break;
+      }
+    }
+    if (__len1 <= __buff_size || __len2 <= __buff_size)
+    {
+      _CUDA_VSTD::__buffered_inplace_merge<_AlgPolicy, _Compare>(
+        __first, __middle, __last, __comp, __len1, __len2, __buff);
+      return;
+    }
+
+    // Split the longer range in half and the other one at the matching
+    // position, so that [__m1, __middle) and [__middle, __m2) swap places.
+    _BidirectionalIterator __m1 = __first;
+    _BidirectionalIterator __m2 = __middle;
+    difference_type __len11     = 0;
+    difference_type __len21     = 0;
+    if (__len1 < __len2)
+    {
+      __len21 = __len2 / 2;
+      __m2    = _Ops::next(__middle, __len21);
+      __m1    = _CUDA_VSTD::__upper_bound<_AlgPolicy>(__first, __middle, *__m2, __comp, __proj);
+      __len11 = _Ops::distance(__first, __m1);
+    }
+    else
+    {
+      if (__len1 == 1)
+      {
+        // Both ranges hold a single element, and *__middle < *__first.
+        _Ops::iter_swap(__first, __middle);
+        return;
+      }
+      __len11 = __len1 / 2;
+      __m1    = _Ops::next(__first, __len11);
+      __m2    = _CUDA_VSTD::__lower_bound<_AlgPolicy>(__middle, __last, *__m1, __comp, __proj);
+      __len21 = _Ops::distance(__middle, __m2);
+    }
+    const difference_type __len12 = __len1 - __len11;
+    const difference_type __len22 = __len2 - __len21;
+
+    __middle = _CUDA_VSTD::__rotate<_AlgPolicy>(__m1, __middle, __m2).first;
+    if (__len11 + __len21 < __len12 + __len22)
+    {
+      _CUDA_VSTD::__inplace_merge<_AlgPolicy, _Compare>(
+        __first, __m1, __middle, __comp, __len11, __len21, __buff, __buff_size);
+      __first  = __middle;
+      __middle = __m2;
+      __len1   = __len12;
+      __len2   = __len22;
+    }
+    else
+    {
+      _CUDA_VSTD::__inplace_merge<_AlgPolicy, _Compare>(
+        __middle, __m2, __last, __comp, __len12, __len22, __buff, __buff_size);
+      __last   = __middle;
+      __middle = __m1;
+      __len1   = __len11;
+      __len2   = __len21;
+    }
+  }
+}
+
+template <class _AlgPolicy, class _Compare, class _BidirectionalIterator>
+_LIBCUDACXX_INLINE_VISIBILITY void __inplace_merge_with_temporary_buffer(
+  _BidirectionalIterator __first,
+  _BidirectionalIterator __middle,
+  _BidirectionalIterator __last,
+  _Compare __comp,
+  typename iterator_traits<_BidirectionalIterator>::difference_type __len1,
+  typename iterator_traits<_BidirectionalIterator>::difference_type __len2)
+{
+  using value_type = typename iterator_traits<_BidirectionalIterator>::value_type;
+
+  pair<value_type*, ptrdiff_t> __buf = _CUDA_VSTD::get_temporary_buffer<value_type>(_CUDA_VSTD::min(__len1, __len2));
+  unique_ptr<value_type, __return_temporary_buffer> __h(__buf.first);
+  _CUDA_VSTD::__inplace_merge<_AlgPolicy, _Compare>(
+    __first, __middle, __last, __comp, __len1, __len2, __buf.first, __buf.second);
+}
+
+// The buffer is only taken from the heap on host. Device code and constant
+// evaluation merge without one.
+template <class _AlgPolicy, class _Compare, class _BidirectionalIterator>
+_LIBCUDACXX_INLINE_VISIBILITY _CCCL_CONSTEXPR_CXX14 void __inplace_merge(
+  _BidirectionalIterator __first, _BidirectionalIterator __middle, _BidirectionalIterator __last, _Compare __comp)
+{
+  using _Ops            = _IterOps<_AlgPolicy>;
+  using difference_type = typename iterator_traits<_BidirectionalIterator>::difference_type;
+
+  const difference_type __len1 = _Ops::distance(__first, __middle);
+  const difference_type __len2 = _Ops::distance(__middle, __last);
+  if (!__libcpp_is_constant_evaluated())
+  {
+    NV_IF_TARGET(NV_IS_HOST,
+                 (_CUDA_VSTD::__inplace_merge_with_temporary_buffer<_AlgPolicy, _Compare>(
+                    __first, __middle, __last, __comp, __len1, __len2);
+                  return;))
+  }
+  _CUDA_VSTD::__inplace_merge<_AlgPolicy, _Compare>(__first, __middle, __last, __comp, __len1, __len2, nullptr, 0);
+}
+
+template <class _BidirectionalIterator, class _Compare>
+inline _LIBCUDACXX_INLINE_VISIBILITY _CCCL_CONSTEXPR_CXX14 void inplace_merge(
+  _BidirectionalIterator __first, _BidirectionalIterator __middle, _BidirectionalIterator __last, _Compare __comp)
+{
+  _CUDA_VSTD::__inplace_merge<_ClassicAlgPolicy, __comp_ref_type<_Compare>>(
+    _CUDA_VSTD::move(__first), _CUDA_VSTD::move(__middle), _CUDA_VSTD::move(__last), __comp);
+}
+
+template <class _BidirectionalIterator>
+inline _LIBCUDACXX_INLINE_VISIBILITY _CCCL_CONSTEXPR_CXX14 void
+inplace_merge(_BidirectionalIterator __first, _BidirectionalIterator __middle, _BidirectionalIterator __last)
+{
+  _CUDA_VSTD::inplace_merge(_CUDA_VSTD::move(__first), _CUDA_VSTD::move(__middle), _CUDA_VSTD::move(__last), __less{});
+}
+
+_LIBCUDACXX_END_NAMESPACE_STD
+
+#endif // _LIBCUDACXX___ALGORITHM_INPLACE_MERGE_H
@@ -0,0 +1,132 @@
+//===----------------------------------------------------------------------===//
+//
+// Part of the LLVM Project, under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+// SPDX-FileCopyrightText: Copyright (c) 2024 NVIDIA CORPORATION & AFFILIATES.
+//
+//===----------------------------------------------------------------------===//
+
+#ifndef _LIBCUDACXX___ALGORITHM_NTH_ELEMENT_H
+#define _LIBCUDACXX___ALGORITHM_NTH_ELEMENT_H
+
+#include <cuda/std/detail/__config>
+
+#if defined(_CCCL_IMPLICIT_SYSTEM_HEADER_GCC)
+#  pragma GCC system_header
+#elif defined(_CCCL_IMPLICIT_SYSTEM_HEADER_CLANG)
+#  pragma clang system_header
+#elif defined(_CCCL_IMPLICIT_SYSTEM_HEADER_MSVC)
+#  pragma system_header
+#endif // no system header
+
+#include <cuda/std/__algorithm/comp.h>
+#include <cuda/std/__algorithm/comp_ref_type.h>
+#include <cuda/std/__algorithm/iterator_operations.h>
+#include <cuda/std/__algorithm/partial_sort.h>
+#include <cuda/std/__algorithm/sort.h>
+#include <cuda/std/__iterator/iterator_traits.h>
+#include <cuda/std/__type_traits/is_copy_assignable.h>
+#include <cuda/std/__type_traits/is_copy_constructible.h>
+#include <cuda/std/__utility/move.h>
+#include <cuda/std/__utility/pair.h>
+
+_LIBCUDACXX_BEGIN_NAMESPACE_STD
+
+// Introselect. Partitions like __pdqsort_loop, but only keeps the side that
+// holds __nth. After 2 log2(n) unbalanced partitions the remaining range is
+// finished by heap selection, which bounds the run time to O(n log n).
+template <class _AlgPolicy, class _Compare, class _RandomAccessIterator>
+_LIBCUDACXX_INLINE_VISIBILITY _CCCL_CONSTEXPR_CXX14 void
+__nth_element(_RandomAccessIterator __first, _RandomAccessIterator __nth, _RandomAccessIterator __last, _Compare __comp)
+{
+  using difference_type = typename iterator_traits<_RandomAccessIterator>::difference_type;
+
+  if (__nth == __last)
+  {
+    return;
+  }
+  int __bad_allowed = 2 * _CUDA_VSTD::__sort_log2(__last - __first);
+  bool __leftmost   = true;
+  while (true)
+  {
+    const difference_type __len = __last - __first;
+    if (__len < __sort_limits::__insertion_sort)
+    {
+      if (__leftmost)
+      {
+        _CUDA_VSTD::__insertion_sort<_AlgPolicy, _Compare>(__first, __last, __comp);
+      }
+      else
+      {
+        _CUDA_VSTD::__insertion_sort_unguarded<_AlgPolicy, _Compare>(__first, __last, __comp);
+      }
+      return;
+    }
+
+    _CUDA_VSTD::__choose_pivot<_AlgPolicy, _Compare>(__first, __last, __comp);
+
+    // Everything left of the returned position equals the pivot, so __nth is
+    // in place if it falls there.
+    if (!__leftmost && !__comp(*(__first - 1), *__first))
+    {
+      __first = _CUDA_VSTD::__partition_with_equals_on_left<_AlgPolicy, _Compare>(__first, __last, __comp) + 1;
+      if (__nth < __first)
+      {
+        return;
+      }
+      continue;
+    }
+
+    const _RandomAccessIterator __pivot_pos =
+      _CUDA_VSTD::__partition_with_equals_on_right<_AlgPolicy, _Compare>(__first, __last, __comp).first;
+    if (__pivot_pos == __nth)
+    {
+      return;
+    }
+
+    const difference_type __l_len = __pivot_pos - __first;
+    const difference_type __r_len = __last - (__pivot_pos + 1);
+    if (__l_len < __len / 8 || __r_len < __len / 8)
+    {
+      if (--__bad_allowed == 0)
+      {
+        (void) _CUDA_VSTD::__partial_sort_impl<_AlgPolicy>(__first, __nth + 1, __last, __comp);
+        return;
+      }
+      _CUDA_VSTD::__break_patterns<_AlgPolicy>(__first, __pivot_pos, __last);
+    }
+
+    if (__nth < __pivot_pos)
+    {
+      __last = __pivot_pos;
+    }
+    else
+    {
+      __first    = __pivot_pos + 1;
+      __leftmost = false;
+    }
+  }
+}
+
+template <class _RandomAccessIterator, class _Compare>
+inline _LIBCUDACXX_INLINE_VISIBILITY _CCCL_CONSTEXPR_CXX14 void
+nth_element(_RandomAccessIterator __first, _RandomAccessIterator __nth, _RandomAccessIterator __last, _Compare __comp)
+{
+  static_assert(_CCCL_TRAIT(is_copy_constructible, _RandomAccessIterator), "Iterators must be copy constructible.");
+  static_assert(_CCCL_TRAIT(is_copy_assignable, _RandomAccessIterator), "Iterators must be copy assignable.");
+
+  _CUDA_VSTD::__nth_element<_ClassicAlgPolicy, __comp_ref_type<_Compare>>(
+    _CUDA_VSTD::move(__first), _CUDA_VSTD::move(__nth), _CUDA_VSTD::move(__last), __comp);
+}
+
+template <class _RandomAccessIterator>
+inline _LIBCUDACXX_INLINE_VISIBILITY _CCCL_CONSTEXPR_CXX14 void
+nth_element(_RandomAccessIterator __first, _RandomAccessIterator __nth, _RandomAccessIterator __last)
+{
+  _CUDA_VSTD::nth_element(__first, __nth, __last, __less{});
+}
+
+_LIBCUDACXX_END_NAMESPACE_STD
+
+#endif // _LIBCUDACXX___ALGORITHM_NTH_ELEMENT_H
@@ -0,0 +1,442 @@
+//===----------------------------------------------------------------------===//
+//
+// Part of the LLVM Project, under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+// SPDX-FileCopyrightText: Copyright (c) 2024 NVIDIA CORPORATION & AFFILIATES.
+//
+//===----------------------------------------------------------------------===//
+
+#ifndef _LIBCUDACXX___ALGORITHM_SORT_H
+#define _LIBCUDACXX___ALGORITHM_SORT_H
+
+#include <cuda/std/detail/__config>
+
+#if defined(_CCCL_IMPLICIT_SYSTEM_HEADER_GCC)
+#  pragma GCC system_header
+#elif defined(_CCCL_IMPLICIT_SYSTEM_HEADER_CLANG)
+#  pragma clang system_header
+#elif defined(_CCCL_IMPLICIT_SYSTEM_HEADER_MSVC)
+#  pragma system_header
+#endif // no system header
+
+#include <cuda/std/__algorithm/comp.h>
+#include <cuda/std/__algorithm/comp_ref_type.h>
+#include <cuda/std/__algorithm/iterator_operations.h>
+#include <cuda/std/__algorithm/partial_sort.h>
+#include <cuda/std/__iterator/iterator_traits.h>
+#include <cuda/std/__type_traits/is_copy_assignable.h>
+#include <cuda/std/__type_traits/is_copy_constructible.h>
+#include <cuda/std/__utility/move.h>
+#include <cuda/std/__utility/pair.h>
+#include <cuda/std/cstddef>
+
+_LIBCUDACXX_BEGIN_NAMESPACE_STD
+
+// Tuning of the pattern-defeating quicksort used by sort and nth_element.
+struct __sort_limits
+{
+  // Ranges shorter than this are insertion sorted.
+  static constexpr ptrdiff_t __insertion_sort = 24;
+  // Ranges longer than this take the pivot as the median of three medians.
+  static constexpr ptrdiff_t __ninther = 128;
+  // Number of element moves after which an attempt to finish an already
+  // partitioned range with insertion sort is given up.
+  static constexpr ptrdiff_t __partial_insertion_sort = 8;
+};
+
+template <class _Size>
+_LIBCUDACXX_INLINE_VISIBILITY _CCCL_CONSTEXPR_CXX14 int __sort_log2(_Size __n)
+{
+  int __log = 0;
+  while (__n >>= 1)
+  {
+    ++__log;
+  }
+  return __log;
+}
+
+// Sorts *__a, *__b and *__c in place.
+template <class _AlgPolicy, class _Compare, class _RandomAccessIterator>
+_LIBCUDACXX_INLINE_VISIBILITY _CCCL_CONSTEXPR_CXX14 void
+__sort3(_RandomAccessIterator __a, _RandomAccessIterator __b, _RandomAccessIterator __c, _Compare __comp)
+{
+  if (__comp(*__b, *__a))
+  {
+    _IterOps<_AlgPolicy>::iter_swap(__a, __b);
+  }
+  if (__comp(*__c, *__b))
+  {
+    _IterOps<_AlgPolicy>::iter_swap(__b, __c);
+    if (__comp(*__b, *__a))
+    {
+      _IterOps<_AlgPolicy>::iter_swap(__a, __b);
+    }
+  }
+}
+
+template <class _AlgPolicy, class _Compare, class _RandomAccessIterator>
+_LIBCUDACXX_INLINE_VISIBILITY _CCCL_CONSTEXPR_CXX14 void
+__insertion_sort(_RandomAccessIterator __first, _RandomAccessIterator __last, _Compare __comp)
+{
+  using _Ops       = _IterOps<_AlgPolicy>;
+  using value_type = typename iterator_traits<_RandomAccessIterator>::value_type;
+
+  if (__first == __last)
+  {
+    return;
+  }
+  for (_RandomAccessIterator __i = __first + 1; __i != __last; ++__i)
+  {
+    _RandomAccessIterator __j = __i - 1;
+    if (__comp(*__i, *__j))
+    {
+      value_type __t(_Ops::__iter_move(__i));
+      _RandomAccessIterator __k = __i;
+      do
+      {
+        *__k = _Ops::__iter_move(__j);
+        __k  = __j;
+      } while (__k != __first && __comp(__t, *--__j));
+      *__k = _CUDA_VSTD::move(__t);
+    }
+  }
+}
+
+// Same as __insertion_sort, but assumes that *(__first - 1) is not greater
+// than any element of the range, which bounds the inner loop.
+template <class _AlgPolicy, class _Compare, class _RandomAccessIterator>
+_LIBCUDACXX_INLINE_VISIBILITY _CCCL_CONSTEXPR_CXX14 void
+__insertion_sort_unguarded(_RandomAccessIterator __first, _RandomAccessIterator __last, _Compare __comp)
+{
+  using _Ops       = _IterOps<_AlgPolicy>;
+  using value_type = typename iterator_traits<_RandomAccessIterator>::value_type;
+
+  if (__first == __last)
+  {
+    return;
+  }
+  for (_RandomAccessIterator __i = __first + 1; __i != __last; ++__i)
+  {
+    _RandomAccessIterator __j = __i - 1;
+    if (__comp(*__i, *__j))
+    {
+      value_type __t(_Ops::__iter_move(__i));
+      _RandomAccessIterator __k = __i;
+      do
+      {
+        *__k = _Ops::__iter_move(__j);
+        __k  = __j;
+      } while (__comp(__t, *--__j));
+      *__k = _CUDA_VSTD::move(__t);
+    }
+  }
+}
+
+// Insertion sorts [__first, __last) unless that takes more than
+// __sort_limits::__partial_insertion_sort moves, in which case it gives up and
+// returns false, leaving the range permuted.
+template <class _AlgPolicy, class _Compare, class _RandomAccessIterator>
+_LIBCUDACXX_INLINE_VISIBILITY _CCCL_CONSTEXPR_CXX14 bool
+__partial_insertion_sort(_RandomAccessIterator __first, _RandomAccessIterator __last, _Compare __comp)
+{
+  using _Ops       = _IterOps<_AlgPolicy>;
+  using value_type = typename iterator_traits<_RandomAccessIterator>::value_type;
+
+  if (__first == __last)
+  {
+    return true;
+  }
+  ptrdiff_t __moves = 0;
+  for (_RandomAccessIterator __i = __first + 1; __i != __last; ++__i)
+  {
+    _RandomAccessIterator __j = __i - 1;
+    if (__comp(*__i, *__j))
+    {
+      value_type __t(_Ops::__iter_move(__i));
+      _RandomAccessIterator __k = __i;
+      do
+      {
+        *__k = _Ops::__iter_move(__j);
+        __k  = __j;
+      } while (__k != __first && __comp(__t, *--__j));
+      *__k = _CUDA_VSTD::move(__t);
+      __moves += __i - __k;
+      if (__moves > __sort_limits::__partial_insertion_sort)
+      {
+        return false;
+      }
+    }
+  }
+  return true;
+}
+
+// Moves the median of a sample of [__first, __last) to *__first. The sample
+// leaves an element not less than the pivot at the end of the range, and one
+// not greater than it behind *__first, which bounds the partitioning loops.
+// Requires __last - __first >= __sort_limits::__insertion_sort.
+template <class _AlgPolicy, class _Compare, class _RandomAccessIterator>
+_LIBCUDACXX_INLINE_VISIBILITY _CCCL_CONSTEXPR_CXX14 void
+__choose_pivot(_RandomAccessIterator __first, _RandomAccessIterator __last, _Compare __comp)
+{
+  const typename iterator_traits<_RandomAccessIterator>::difference_type __half = (__last - __first) / 2;
+  if (__last - __first > __sort_limits::__ninther)
+  {
+    _CUDA_VSTD::__sort3<_AlgPolicy, _Compare>(__first, __first + __half, __last - 1, __comp);
+    _CUDA_VSTD::__sort3<_AlgPolicy, _Compare>(__first + 1, __first + (__half - 1), __last - 2, __comp);
+    _CUDA_VSTD::__sort3<_AlgPolicy, _Compare>(__first + 2, __first + (__half + 1), __last - 3, __comp);
+    _CUDA_VSTD::__sort3<_AlgPolicy, _Compare>(
+      __first + (__half - 1), __first + __half, __first + (__half + 1), __comp);
+    _IterOps<_AlgPolicy>::iter_swap(__first, __first + __half);
+  }
+  else
+  {
+    _CUDA_VSTD::__sort3<_AlgPolicy, _Compare>(__first + __half, __first, __last - 1, __comp);
+  }
+}
+
+// Partitions [__first, __last) around the pivot *__first into the elements
+// less than the pivot and those not less than it. Returns the final position
+// of the pivot, and whether the range already was partitioned.
+template <class _AlgPolicy, class _Compare, class _RandomAccessIterator>
+_LIBCUDACXX_INLINE_VISIBILITY _CCCL_CONSTEXPR_CXX14 pair<_RandomAccessIterator, bool>
+__partition_with_equals_on_right(_RandomAccessIterator __first, _RandomAccessIterator __last, _Compare __comp)
+{
+  using _Ops       = _IterOps<_AlgPolicy>;
+  using value_type = typename iterator_traits<_RandomAccessIterator>::value_type;
+
+  value_type __pivot(_Ops::__iter_move(__first));
+  _RandomAccessIterator __i = __first;
+  _RandomAccessIterator __j = __last;
+
+  // The pivot selection guarantees an element not less than the pivot.
+  while (__comp(*++__i, __pivot))
+  {
+  }
+  // Only guard the search if nothing was found below the pivot yet.
+  if (__i - 1 == __first)
+  {
+    while (__i < __j && !__comp(*--__j, __pivot))
+    {
+    }
+  }
+  else
+  {
+    while (!__comp(*--__j, __pivot))
+    {
+    }
+  }
+
+  const bool __already_partitioned = __i >= __j;
+  while (__i < __j)
+  {
+    _Ops::iter_swap(__i, __j);
+    while (__comp(*++__i, __pivot))
+    {
+    }
+    while (!__comp(*--__j, __pivot))
+    {
+    }
+  }
+
+  _RandomAccessIterator __pivot_pos = __i - 1;
+  *__first                          = _Ops::__iter_move(__pivot_pos);
+  *__pivot_pos                      = _CUDA_VSTD::move(__pivot);
+  return pair<_RandomAccessIterator, bool>(__pivot_pos, __already_partitioned);
+}
+
+// Partitions [__first, __last) around the pivot *__first into the elements
+// not greater than the pivot and those greater than it, and returns the final
+// position of the pivot. Used when the pivot equals an element known to be
+// not greater than any element of the range, so that everything left of the
+// returned position compares equal to the pivot.
+template <class _AlgPolicy, class _Compare, class _RandomAccessIterator>
+_LIBCUDACXX_INLINE_VISIBILITY _CCCL_CONSTEXPR_CXX14 _RandomAccessIterator
+__partition_with_equals_on_left(_RandomAccessIterator __first, _RandomAccessIterator __last, _Compare __comp)
+{
+  using _Ops       = _IterOps<_AlgPolicy>;
+  using value_type = typename iterator_traits<_RandomAccessIterator>::value_type;
+
+  value_type __pivot(_Ops::__iter_move(__first));
+  _RandomAccessIterator __i = __first;
+  _RandomAccessIterator __j = __last;
+
+  // The pivot selection guarantees an element not greater than the pivot.
+  while (__comp(__pivot, *--__j))
+  {
+  }
+  if (__j + 1 == __last)
+  {
+    while (__i < __j && !__comp(__pivot, *++__i))
+    {
+    }
+  }
+  else
+  {
+    while (!__comp(__pivot, *++__i))
+    {
+    }
+  }
+
+  while (__i < __j)
+  {
+    _Ops::iter_swap(__i, __j);
+    while (__comp(__pivot, *--__j))
+    {
+    }
+    while (!__comp(__pivot, *++__i))
+    {
+    }
+  }
+
+  *__first = _Ops::__iter_move(__j);
+  *__j     = _CUDA_VSTD::move(__pivot);
+  return __j;
+}
+
+// Swaps a few elements on both sides of an unbalanced partition, so that the
+// next pivots are taken from a different sample.
+template <class _AlgPolicy, class _RandomAccessIterator>
+_LIBCUDACXX_INLINE_VISIBILITY _CCCL_CONSTEXPR_CXX14 void
+__break_patterns(_RandomAccessIterator __first, _RandomAccessIterator __pivot_pos, _RandomAccessIterator __last)
+{
+  using _Ops            = _IterOps<_AlgPolicy>;
+  using difference_type = typename iterator_traits<_RandomAccessIterator>::difference_type;
+
+  const difference_type __l_len = __pivot_pos - __first;
+  const difference_type __r_len = __last - (__pivot_pos + 1);
+  if (__l_len >= __sort_limits::__insertion_sort)
+  {
+    _Ops::iter_swap(__first, __first + __l_len / 4);
+    _Ops::iter_swap(__pivot_pos - 1, __pivot_pos - __l_len / 4);
+    if (__l_len > __sort_limits::__ninther)
+    {
+      _Ops::iter_swap(__first + 1, __first + (__l_len / 4 + 1));
+      _Ops::iter_swap(__first + 2, __first + (__l_len / 4 + 2));
+      _Ops::iter_swap(__pivot_pos - 2, __pivot_pos - (__l_len / 4 + 1));
+      _Ops::iter_swap(__pivot_pos - 3, __pivot_pos - (__l_len / 4 + 2));
+    }
+  }
+  if (__r_len >= __sort_limits::__insertion_sort)
+  {
+    _Ops::iter_swap(__pivot_pos + 1, __pivot_pos + (1 + __r_len / 4));
+    _Ops::iter_swap(__last - 1, __last - __r_len / 4);
+    if (__r_len > __sort_limits::__ninther)
+    {
+      _Ops::iter_swap(__pivot_pos + 2, __pivot_pos + (2 + __r_len / 4));
+      _Ops::iter_swap(__pivot_pos + 3, __pivot_pos + (3 + __r_len / 4));
+      _Ops::iter_swap(__last - 2, __last - (1 + __r_len / 4));
+      _Ops::iter_swap(__last - 3, __last - (2 + __r_len / 4));
+    }
+  }
+}
+
+// Pattern-defeating quicksort. Partitions that leave one side shorter than an
+// eighth of the range are counted against __bad_allowed and break up patterns
+// by swapping a few elements; once the budget is spent the range is
+// heapsorted, which bounds the run time to O(n log n). Ranges that partition
+// without any swap are first tried to be finished by insertion sort, which
+// makes sorted and reverse sorted inputs linear. The shorter side is sorted
+// recursively, which bounds the depth of recursion to log2(n).
+template <class _AlgPolicy, class _Compare, class _RandomAccessIterator>
+_LIBCUDACXX_INLINE_VISIBILITY _CCCL_CONSTEXPR_CXX14 void __pdqsort_loop(
+  _RandomAccessIterator __first, _RandomAccessIterator __last, _Compare __comp, int __bad_allowed, bool __leftmost)
+{
+  using difference_type = typename iterator_traits<_RandomAccessIterator>::difference_type;
+
+  while (true)
+  {
+    const difference_type __len = __last - __first;
+    if (__len < __sort_limits::__insertion_sort)
+    {
+      if (__leftmost)
+      {
+        _CUDA_VSTD::__insertion_sort<_AlgPolicy, _Compare>(__first, __last, __comp);
+      }
+      else
+      {
+        _CUDA_VSTD::__insertion_sort_unguarded<_AlgPolicy, _Compare>(__first, __last, __comp);
+      }
+      return;
+    }
+
+    _CUDA_VSTD::__choose_pivot<_AlgPolicy, _Compare>(__first, __last, __comp);
+
+    // *(__first - 1) is not greater than any element of the range. If it is
+    // equal to the pivot, all elements equal to the pivot go to the left and
+    // need no further sorting. This makes ranges with many duplicates linear.
+    if (!__leftmost && !__comp(*(__first - 1), *__first))
+    {
+      __first = _CUDA_VSTD::__partition_with_equals_on_left<_AlgPolicy, _Compare>(__first, __last, __comp) + 1;
+      continue;
+    }
+
+    const pair<_RandomAccessIterator, bool> __ret =
+      _CUDA_VSTD::__partition_with_equals_on_right<_AlgPolicy, _Compare>(__first, __last, __comp);
+    const _RandomAccessIterator __pivot_pos = __ret.first;
+    const difference_type __l_len           = __pivot_pos - __first;
+    const difference_type __r_len           = __last - (__pivot_pos + 1);
+
+    if (__l_len < __len / 8 || __r_len < __len / 8)
+    {
+      if (--__bad_allowed == 0)
+      {
+        (void) _CUDA_VSTD::__partial_sort_impl<_AlgPolicy>(__first, __last, __last, __comp);
+        return;
+      }
+      _CUDA_VSTD::__break_patterns<_AlgPolicy>(__first, __pivot_pos, __last);
+    }
+    else if (__ret.second
+             && _CUDA_VSTD::__partial_insertion_sort<_AlgPolicy, _Compare>(__first, __pivot_pos, __comp)
+             && _CUDA_VSTD::__partial_insertion_sort<_AlgPolicy, _Compare>(__pivot_pos + 1, __last, __comp))
+    {
+      return;
+    }
+
+    if (__l_len < __r_len)
+    {
+      _CUDA_VSTD::__pdqsort_loop<_AlgPolicy, _Compare>(__first, __pivot_pos, __comp, __bad_allowed, __leftmost);
+      __first    = __pivot_pos + 1;
+      __leftmost = false;
+    }
+    else
+    {
+      _CUDA_VSTD::__pdqsort_loop<_AlgPolicy, _Compare>(__pivot_pos + 1, __last, __comp, __bad_allowed, false);
+      __last = __pivot_pos;
+    }
+  }
+}
+
+template <class _AlgPolicy, class _Compare, class _RandomAccessIterator>
+_LIBCUDACXX_INLINE_VISIBILITY _CCCL_CONSTEXPR_CXX14 void
+__sort(_RandomAccessIterator __first, _RandomAccessIterator __last, _Compare __comp)
+{
+  const typename iterator_traits<_RandomAccessIterator>::difference_type __len = __last - __first;
+  if (__len > 1)
+  {
+    _CUDA_VSTD::__pdqsort_loop<_AlgPolicy, _Compare>(
+      __first, __last, __comp, _CUDA_VSTD::__sort_log2(__len), true);
+  }
+}
+
+template <class _RandomAccessIterator, class _Compare>
+inline _LIBCUDACXX_INLINE_VISIBILITY _CCCL_CONSTEXPR_CXX14 void
+sort(_RandomAccessIterator __first, _RandomAccessIterator __last, _Compare __comp)
+{
+  static_assert(_CCCL_TRAIT(is_copy_constructible, _RandomAccessIterator), "Iterators must be copy constructible.");
+  static_assert(_CCCL_TRAIT(is_copy_assignable, _RandomAccessIterator), "Iterators must be copy assignable.");
+
+  _CUDA_VSTD::__sort<_ClassicAlgPolicy, __comp_ref_type<_Compare>>(
+    _CUDA_VSTD::move(__first), _CUDA_VSTD::move(__last), __comp);
+}
+
+template <class _RandomAccessIterator>
+inline _LIBCUDACXX_INLINE_VISIBILITY _CCCL_CONSTEXPR_CXX14 void
+sort(_RandomAccessIterator __first, _RandomAccessIterator __last)
+{
+  _CUDA_VSTD::sort(__first, __last, __less{});
+}
+
+_LIBCUDACXX_END_NAMESPACE_STD
+
+#endif // _LIBCUDACXX___ALGORITHM_SORT_H
@@ -0,0 +1,138 @@
+//===----------------------------------------------------------------------===//
+//
+// Part of the LLVM Project, under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+// SPDX-FileCopyrightText: Copyright (c) 2024 NVIDIA CORPORATION & AFFILIATES.
+//
+//===----------------------------------------------------------------------===//
+
+#ifndef _LIBCUDACXX___ALGORITHM_STABLE_SORT_H
+#define _LIBCUDACXX___ALGORITHM_STABLE_SORT_H
+
+#include <cuda/std/detail/__config>
+
+#if defined(_CCCL_IMPLICIT_SYSTEM_HEADER_GCC)
+#  pragma GCC system_header
+#elif defined(_CCCL_IMPLICIT_SYSTEM_HEADER_CLANG)
+#  pragma clang system_header
+#elif defined(_CCCL_IMPLICIT_SYSTEM_HEADER_MSVC)
+#  pragma system_header
+#endif // no system header
+
+#include <cuda/std/__algorithm/comp.h>
+#include <cuda/std/__algorithm/comp_ref_type.h>
+#include <cuda/std/__algorithm/inplace_merge.h>
+#include <cuda/std/__algorithm/iterator_operations.h>
+#include <cuda/std/__algorithm/min.h>
+#include <cuda/std/__algorithm/sort.h>
+#include <cuda/std/__iterator/iterator_traits.h>
+#include <cuda/std/__memory/temporary_buffer.h>
+#include <cuda/std/__memory/unique_ptr.h>
+#include <cuda/std/__type_traits/is_constant_evaluated.h>
+#include <cuda/std/__type_traits/is_copy_assignable.h>
+#include <cuda/std/__type_traits/is_copy_constructible.h>
+#include <cuda/std/__utility/move.h>
+#include <cuda/std/__utility/pair.h>
+#include <cuda/std/cstddef>
+
+_LIBCUDACXX_BEGIN_NAMESPACE_STD
+
+// Length of the runs that stable_sort insertion sorts before merging them.
+struct __stable_sort_limits
+{
+  static constexpr ptrdiff_t __run = 16;
+};
+
+// Bottom-up merge sort. Runs are insertion sorted and then merged pairwise
+// with __inplace_merge, which goes through __buff when the shorter run fits,
+// and otherwise rotates in place. Pairs that are already in order are skipped,
+// which makes sorted inputs linear.
+template <class _AlgPolicy, class _Compare, class _RandomAccessIterator>
+_LIBCUDACXX_INLINE_VISIBILITY _CCCL_CONSTEXPR_CXX14 void __stable_sort(
+  _RandomAccessIterator __first,
+  _RandomAccessIterator __last,
+  _Compare __comp,
+  typename iterator_traits<_RandomAccessIterator>::value_type* __buff,
+  ptrdiff_t __buff_size)
+{
+  using difference_type = typename iterator_traits<_RandomAccessIterator>::difference_type;
+
+  const difference_type __len = __last - __first;
+  const difference_type __run = __stable_sort_limits::__run;
+
+  _RandomAccessIterator __i = __first;
+  for (; __last - __i > __run; __i += __run)
+  {
+    _CUDA_VSTD::__insertion_sort<_AlgPolicy, _Compare>(__i, __i + __run, __comp);
+  }
+  _CUDA_VSTD::__insertion_sort<_AlgPolicy, _Compare>(__i, __last, __comp);
+
+  for (difference_type __width = __run; __width < __len; __width *= 2)
+  {
+    for (__i = __first; __last - __i > __width;)
+    {
+      const _RandomAccessIterator __middle = __i + __width;
+      const difference_type __len2         = _CUDA_VSTD::min(__width, __last - __middle);
+      if (__comp(*__middle, *(__middle - 1)))
+      {
+        _CUDA_VSTD::__inplace_merge<_AlgPolicy, _Compare>(
+          __i, __middle, __middle + __len2, __comp, __width, __len2, __buff, __buff_size);
+      }
+      __i = __middle + __len2;
+    }
+  }
+}
+
+template <class _AlgPolicy, class _Compare, class _RandomAccessIterator>
+_LIBCUDACXX_INLINE_VISIBILITY void
+__stable_sort_with_temporary_buffer(_RandomAccessIterator __first, _RandomAccessIterator __last, _Compare __comp)
+{
+  using value_type = typename iterator_traits<_RandomAccessIterator>::value_type;
+
+  pair<value_type*, ptrdiff_t> __buf = _CUDA_VSTD::get_temporary_buffer<value_type>((__last - __first + 1) / 2);
+  unique_ptr<value_type, __return_temporary_buffer> __h(__buf.first);
+  _CUDA_VSTD::__stable_sort<_AlgPolicy, _Compare>(__first, __last, __comp, __buf.first, __buf.second);
+}
+
+// The buffer is only taken from the heap on host. Device code and constant
+// evaluation merge in place, in O(n log^2 n) moves.
+template <class _AlgPolicy, class _Compare, class _RandomAccessIterator>
+_LIBCUDACXX_INLINE_VISIBILITY _CCCL_CONSTEXPR_CXX14 void
+__stable_sort(_RandomAccessIterator __first, _RandomAccessIterator __last, _Compare __comp)
+{
+  if (__last - __first <= __stable_sort_limits::__run)
+  {
+    _CUDA_VSTD::__insertion_sort<_AlgPolicy, _Compare>(__first, __last, __comp);
+    return;
+  }
+  if (!__libcpp_is_constant_evaluated())
+  {
+    NV_IF_TARGET(
+      NV_IS_HOST,
+      (_CUDA_VSTD::__stable_sort_with_temporary_buffer<_AlgPolicy, _Compare>(__first, __last, __comp); return;))
+  }
+  _CUDA_VSTD::__stable_sort<_AlgPolicy, _Compare>(__first, __last, __comp, nullptr, 0);
+}
+
+template <class _RandomAccessIterator, class _Compare>
+inline _LIBCUDACXX_INLINE_VISIBILITY _CCCL_CONSTEXPR_CXX14 void
+stable_sort(_RandomAccessIterator __first, _RandomAccessIterator __last, _Compare __comp)
+{
+  static_assert(_CCCL_TRAIT(is_copy_constructible, _RandomAccessIterator), "Iterators must be copy constructible.");
+  static_assert(_CCCL_TRAIT(is_copy_assignable, _RandomAccessIterator), "Iterators must be copy assignable.");
+
+  _CUDA_VSTD::__stable_sort<_ClassicAlgPolicy, __comp_ref_type<_Compare>>(
+    _CUDA_VSTD::move(__first), _CUDA_VSTD::move(__last), __comp);
+}
+
+template <class _RandomAccessIterator>
+inline _LIBCUDACXX_INLINE_VISIBILITY _CCCL_CONSTEXPR_CXX14 void
+stable_sort(_RandomAccessIterator __first, _RandomAccessIterator __last)
+{
+  _CUDA_VSTD::stable_sort(__first, __last, __less{});
+}
+
+_LIBCUDACXX_END_NAMESPACE_STD
+
+#endif // _LIBCUDACXX___ALGORITHM_STABLE_SORT_H
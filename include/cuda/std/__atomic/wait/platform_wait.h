@@ -0,0 +1,126 @@
+//===----------------------------------------------------------------------===//
+//
+// Part of libcu++, the C++ Standard Library for your entire system,
+// under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+// SPDX-FileCopyrightText: Copyright (c) 2024 NVIDIA CORPORATION & AFFILIATES.
+//
+//===----------------------------------------------------------------------===//
+
+#ifndef _LIBCUDACXX___ATOMIC_WAIT_PLATFORM_WAIT_H
+#define _LIBCUDACXX___ATOMIC_WAIT_PLATFORM_WAIT_H
+
+#include <cuda/std/detail/__config>
+
+#if defined(_CCCL_IMPLICIT_SYSTEM_HEADER_GCC)
+#  pragma GCC system_header
+#elif defined(_CCCL_IMPLICIT_SYSTEM_HEADER_CLANG)
+#  pragma clang system_header
+#elif defined(_CCCL_IMPLICIT_SYSTEM_HEADER_MSVC)
+#  pragma system_header
+#endif // no system header
+
+#include <cuda/std/__atomic/functions/host.h>
+#include <cuda/std/__atomic/order.h>
+#include <cuda/std/__atomic/scopes.h>
+#include <cuda/std/__atomic/types.h>
+#include <cuda/std/__atomic/wait/polling.h>
+#include <cuda/std/__type_traits/enable_if.h>
+#include <cuda/std/detail/libcxx/include/__threading_support>
+#include <cuda/std/detail/libcxx/include/cstring>
+
+_LIBCUDACXX_BEGIN_NAMESPACE_STD
+
+template <typename _Tp>
+_LIBCUDACXX_INLINE_VISIBILITY bool __nonatomic_compare_equal(_Tp const& __lhs, _Tp const& __rhs)
+{
+#if defined(_CCCL_CUDA_COMPILER)
+  return __lhs == __rhs;
+#else
+  return memcmp(&__lhs, &__rhs, sizeof(_Tp)) == 0;
+#endif
+}
+
+#if defined(_LIBCUDACXX_HAS_PLATFORM_WAIT) && !defined(_LIBCUDACXX_HAS_NO_THREAD_CONTENTION_TABLE)
+
+// Host threads which outlast the polling phase of __atomic_wait sleep in the
+// kernel. Atomics of the platform wait type sleep on their own value, and
+// every notification wakes that address: the kernel keys the sleepers by
+// address, so this needs no shared state between the waiter and the notifier.
+//
+// Any other atomic sleeps on the version of its contention table slot, which
+// every notification of an address mapping to that slot bumps. Sleepers
+// register in the waiter count of the slot, so that notifying an atomic
+// nobody sleeps on costs no system call. The notifier writes the value, then
+// reads the waiter count; the waiter bumps the waiter count, then reads the
+// value. The sequentially consistent fences between the two steps guarantee
+// that the notifier sees the waiter, or the waiter sees the new value.
+
+template <typename _Tp>
+using __atomic_waits_on_value = __libcpp_platform_wait_uses_type<__atomic_underlying_remove_cv_t<_Tp>>;
+
+template <typename _Tp, typename _Sco, __enable_if_t<__atomic_waits_on_value<_Tp>::__value, int> = 0>
+void __atomic_try_wait_slow_host(
+  _Tp const volatile* __a, __atomic_underlying_remove_cv_t<_Tp> __val, memory_order __order, _Sco)
+{
+  if (__nonatomic_compare_equal(__atomic_load_dispatch(__a, __order, _Sco{}), __val))
+  {
+    __libcpp_platform_wait(const_cast<__libcpp_platform_wait_t const*>(__a->get()), __val, nullptr);
+  }
+}
+
+template <typename _Tp, typename _Sco, __enable_if_t<!__atomic_waits_on_value<_Tp>::__value, int> = 0>
+void __atomic_try_wait_slow_host(
+  _Tp const volatile* __a, __atomic_underlying_remove_cv_t<_Tp> __val, memory_order __order, _Sco)
+{
+  __libcpp_contention_t* const __c = __libcpp_contention_state(__a);
+
+  __atomic_fetch_add_host(&__c->__waiters, ptrdiff_t(1), memory_order_relaxed);
+  __atomic_thread_fence_host(memory_order_seq_cst);
+  __libcpp_platform_wait_t const __version = __atomic_load_host(&__c->__version, memory_order_relaxed);
+  if (__nonatomic_compare_equal(__atomic_load_dispatch(__a, __order, _Sco{}), __val))
+  {
+    __libcpp_platform_wait(&__c->__version, __version, nullptr);
+  }
+  __atomic_fetch_sub_host(&__c->__waiters, ptrdiff_t(1), memory_order_relaxed);
+}
+
+template <typename _Tp, __enable_if_t<__atomic_waits_on_value<_Tp>::__value, int> = 0>
+void __atomic_notify_host(_Tp const volatile* __a, bool __all)
+{
+  __libcpp_platform_wake(const_cast<__libcpp_platform_wait_t const*>(__a->get()), __all);
+}
+
+// The slot may be shared with other addresses, so every sleeper is woken up.
+template <typename _Tp, __enable_if_t<!__atomic_waits_on_value<_Tp>::__value, int> = 0>
+void __atomic_notify_host(_Tp const volatile* __a, bool)
+{
+  __libcpp_contention_t* const __c = __libcpp_contention_state(__a);
+
+  __atomic_fetch_add_host(&__c->__version, __libcpp_platform_wait_t(1), memory_order_relaxed);
+  __atomic_thread_fence_host(memory_order_seq_cst);
+  if (0 != __atomic_load_host(&__c->__waiters, memory_order_relaxed))
+  {
+    __libcpp_platform_wake(&__c->__version, true);
+  }
+}
+
+#else // ^^^ _LIBCUDACXX_HAS_PLATFORM_WAIT ^^^ / vvv !_LIBCUDACXX_HAS_PLATFORM_WAIT vvv
+
+template <typename _Tp, typename _Sco>
+_CCCL_HOST_DEVICE void __atomic_try_wait_slow_host(
+  _Tp const volatile* __a, __atomic_underlying_remove_cv_t<_Tp> __val, memory_order __order, _Sco)
+{
+  __atomic_try_wait_slow_fallback(__a, __val, __order, _Sco{});
+}
+
+template <typename _Tp>
+_CCCL_HOST_DEVICE void __atomic_notify_host(_Tp const volatile*, bool)
+{}
+
+#endif // !_LIBCUDACXX_HAS_PLATFORM_WAIT
+
+_LIBCUDACXX_END_NAMESPACE_STD
+
+#endif // _LIBCUDACXX___ATOMIC_WAIT_PLATFORM_WAIT_H
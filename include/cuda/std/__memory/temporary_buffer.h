@@ -83,6 +83,15 @@ inline _LIBCUDACXX_INLINE_VISIBILITY void return_temporary_buffer(_Tp* __p) noex
   _CUDA_VSTD::__libcpp_deallocate_unsized((void*) __p, _LIBCUDACXX_ALIGNOF(_Tp));
 }
 
+struct __return_temporary_buffer
+{
+  template <class _Tp>
+  _LIBCUDACXX_INLINE_VISIBILITY void operator()(_Tp* __p) const
+  {
+    _CUDA_VSTD::return_temporary_buffer(__p);
+  }
+};
+
 _LIBCUDACXX_END_NAMESPACE_STD
 
 #endif // _LIBCUDACXX___MEMORY_TEMPORARY_BUFFER_H
@@ -0,0 +1,195 @@
+/*
+ * Copyright 2024 NVIDIA Corporation.  All rights reserved.
+ *
+ * NOTICE TO LICENSEE:
+ *
+ * This source code and/or documentation ("Licensed Deliverables") are
+ * subject to NVIDIA intellectual property rights under U.S. and
+ * international Copyright laws.
+ *
+ * These Licensed Deliverables contained herein is PROPRIETARY and
+ * CONFIDENTIAL to NVIDIA and is being provided under the terms and
+ * conditions of a form of NVIDIA software license agreement by and
+ * between NVIDIA and Licensee ("License Agreement") or electronically
+ * accepted by Licensee.  Notwithstanding any terms or conditions to
+ * the contrary in the License Agreement, reproduction or disclosure
+ * of the Licensed Deliverables to any third party without the express
+ * written consent of NVIDIA is prohibited.
+ *
+ * NOTWITHSTANDING ANY TERMS OR CONDITIONS TO THE CONTRARY IN THE
+ * LICENSE AGREEMENT, NVIDIA MAKES NO REPRESENTATION ABOUT THE
+ * SUITABILITY OF THESE LICENSED DELIVERABLES FOR ANY PURPOSE.  IT IS
+ * PROVIDED "AS IS" WITHOUT EXPRESS OR IMPLIED WARRANTY OF ANY KIND.
+ * NVIDIA DISCLAIMS ALL WARRANTIES WITH REGARD TO THESE LICENSED
+ * DELIVERABLES, INCLUDING ALL IMPLIED WARRANTIES OF MERCHANTABILITY,
+ * NONINFRINGEMENT, AND FITNESS FOR A PARTICULAR PURPOSE.
+ * NOTWITHSTANDING ANY TERMS OR CONDITIONS TO THE CONTRARY IN THE
+ * LICENSE AGREEMENT, IN NO EVENT SHALL NVIDIA BE LIABLE FOR ANY
+ * SPECIAL, INDIRECT, INCIDENTAL, OR CONSEQUENTIAL DAMAGES, OR ANY
+ * DAMAGES WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS,
+ * WHETHER IN AN ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS
+ * ACTION, ARISING OUT OF OR IN CONNECTION WITH THE USE OR PERFORMANCE
+ * OF THESE LICENSED DELIVERABLES.
+ *
+ * U.S. Government End Users.  These Licensed Deliverables are a
+ * "commercial item" as that term is defined at 48 C.F.R. 2.101 (OCT
+ * 1995), consisting of "commercial computer software" and "commercial
+ * computer software documentation" as such terms are used in 48
+ * C.F.R. 12.212 (SEPT 1995) and is provided to the U.S. Government
+ * only as a commercial end item.  Consistent with 48 C.F.R.12.212 and
+ * 48 C.F.R. 227.7202-1 through 227.7202-4 (JUNE 1995), all
+ * U.S. Government End Users acquire the Licensed Deliverables with
+ * only those rights set forth herein.
+ *
+ * Any use of the Licensed Deliverables in individual and commercial
+ * software must include, in the user documentation and internal
+ * comments to the code, the above Disclaimer and U.S. Government End
+ * Users Notice.
+ */
+
+#ifndef __CUDA_FP_CONVERT_H__
+#define __CUDA_FP_CONVERT_H__
+
+/**
+ * \defgroup CUDA_MATH_INTRINSIC_BULK_CONVERT Bulk Precision Conversion
+ * \ingroup CUDA_MATH_INTRINSIC_FP8
+ * To use these functions, include the header file \p cuda_fp_convert.h in
+ * your host program.
+ *
+ * \details The functions below convert whole arrays between \p float and the
+ * \p half, \p nv_bfloat16 and \p fp8 formats on the host. Every element is
+ * converted exactly like the corresponding scalar function does on the host,
+ * but the work is done with F16C and AVX2 instructions when the processor
+ * supports them, and split across OpenMP threads when the translation unit is
+ * compiled with OpenMP support. Defining \p __CUDA_NO_FP_CONVERT_OPENMP__
+ * before including this header keeps the conversions single-threaded.
+ * The vector code assumes the default floating-point environment, in which
+ * denormal inputs are not treated as zero.
+ */
+
+/* Set up function decorations */
+#if defined(__GNUC__)
+#define __CUDA_HOST_FP_CONVERT_DECL__ static inline __attribute__((unused))
+#else
+#define __CUDA_HOST_FP_CONVERT_DECL__ static inline
+#endif /* defined(__GNUC__) */
+
+#include "cuda_fp16.h"
+#include "cuda_bf16.h"
+#include "cuda_fp8.h"
+
+/* The bulk conversions are host functions, and need C++11 */
+#if defined(__cplusplus) && !defined(__CUDACC_RTC__) && \
+    (__cplusplus >= 201103L || (defined(_MSVC_LANG) && _MSVC_LANG >= 201103L))
+
+#include <cstddef>
+
+/**
+ * \ingroup CUDA_MATH_INTRINSIC_BULK_CONVERT
+ * \brief Enumerates the rounding modes of the bulk narrowing conversions.
+ */
+typedef enum __nv_cvt_rounding_t {
+    __NV_CVT_RN, /**< Round to nearest, ties to even, like \p __float2half_rn. */
+    __NV_CVT_RZ, /**< Round towards zero, like \p __float2half_rz. */
+    __NV_CVT_RD, /**< Round down, towards negative infinity, like \p __float2half_rd. */
+    __NV_CVT_RU, /**< Round up, towards positive infinity, like \p __float2half_ru. */
+} __nv_cvt_rounding_t;
+
+/**
+ * \ingroup CUDA_MATH_INTRINSIC_BULK_CONVERT
+ * \brief Converts \p n \p float values to \p half precision in the requested
+ * rounding mode.
+ *
+ * \details Stores in \p out[i] the result of \p __float2half_rn,
+ * \p __float2half_rz, \p __float2half_rd or \p __float2half_ru of \p in[i],
+ * for every \p i in [0, \p n), as selected by \p rounding.
+ * The ranges must not overlap.
+ * \param[in] in - the values to convert.
+ * \param[out] out - the converted values.
+ * \param[in] n - the number of values.
+ * \param[in] rounding - the rounding mode.
+ */
+__CUDA_HOST_FP_CONVERT_DECL__ void __nv_cvt_float_to_half_n(const float *in, __half *out, const size_t n,
+                                                            const __nv_cvt_rounding_t rounding = __NV_CVT_RN);
+
+/**
+ * \ingroup CUDA_MATH_INTRINSIC_BULK_CONVERT
+ * \brief Converts \p n \p half precision values to \p float.
+ *
+ * \details Stores in \p out[i] the result of \p __half2float of \p in[i],
+ * for every \p i in [0, \p n). The ranges must not overlap.
+ * \param[in] in - the values to convert.
+ * \param[out] out - the converted values.
+ * \param[in] n - the number of values.
+ */
+__CUDA_HOST_FP_CONVERT_DECL__ void __nv_cvt_half_to_float_n(const __half *in, float *out, const size_t n);
+
+/**
+ * \ingroup CUDA_MATH_INTRINSIC_BULK_CONVERT
+ * \brief Converts \p n \p float values to \p nv_bfloat16 precision in the
+ * requested rounding mode.
+ *
+ * \details Stores in \p out[i] the result of \p __float2bfloat16_rn,
+ * \p __float2bfloat16_rz, \p __float2bfloat16_rd or \p __float2bfloat16_ru
+ * of \p in[i], for every \p i in [0, \p n), as selected by \p rounding.
+ * The ranges must not overlap.
+ * \param[in] in - the values to convert.
+ * \param[out] out - the converted values.
+ * \param[in] n - the number of values.
+ * \param[in] rounding - the rounding mode.
+ */
+__CUDA_HOST_FP_CONVERT_DECL__ void __nv_cvt_float_to_bfloat16_n(const float *in, __nv_bfloat16 *out, const size_t n,
+                                                                const __nv_cvt_rounding_t rounding = __NV_CVT_RN);
+
+/**
+ * \ingroup CUDA_MATH_INTRINSIC_BULK_CONVERT
+ * \brief Converts \p n \p nv_bfloat16 precision values to \p float.
+ *
+ * \details Stores in \p out[i] the result of \p __bfloat162float of \p in[i],
+ * for every \p i in [0, \p n). The ranges must not overlap.
+ * \param[in] in - the values to convert.
+ * \param[out] out - the converted values.
+ * \param[in] n - the number of values.
+ */
+__CUDA_HOST_FP_CONVERT_DECL__ void __nv_cvt_bfloat16_to_float_n(const __nv_bfloat16 *in, float *out, const size_t n);
+
+/**
+ * \ingroup CUDA_MATH_INTRINSIC_BULK_CONVERT
+ * \brief Converts \p n \p float values to \p fp8 type of the requested kind
+ * using round-to-nearest-even rounding and the requested saturation mode.
+ *
+ * \details Stores in \p out[i] the result of \p __nv_cvt_float_to_fp8 of
+ * \p in[i] with the same \p saturate and \p fp8_interpretation, for every
+ * \p i in [0, \p n). The ranges must not overlap.
+ * \param[in] in - the values to convert.
+ * \param[out] out - the converted values.
+ * \param[in] n - the number of values.
+ * \param[in] saturate - the saturation mode.
+ * \param[in] fp8_interpretation - the kind of \p fp8 values to produce.
+ */
+__CUDA_HOST_FP_CONVERT_DECL__ void __nv_cvt_float_to_fp8_n(const float *in, __nv_fp8_storage_t *out, const size_t n,
+                                                           const __nv_saturation_t saturate,
+                                                           const __nv_fp8_interpretation_t fp8_interpretation);
+
+/**
+ * \ingroup CUDA_MATH_INTRINSIC_BULK_CONVERT
+ * \brief Converts \p n \p fp8 values of the requested kind to \p float.
+ *
+ * \details Stores in \p out[i] the value the \p float conversion operator of
+ * \p __nv_fp8_e4m3 or \p __nv_fp8_e5m2 returns for \p in[i], for every \p i
+ * in [0, \p n). The ranges must not overlap.
+ * \param[in] in - the values to convert.
+ * \param[out] out - the converted values.
+ * \param[in] n - the number of values.
+ * \param[in] fp8_interpretation - the kind of the \p fp8 values.
+ */
+__CUDA_HOST_FP_CONVERT_DECL__ void __nv_cvt_fp8_to_float_n(const __nv_fp8_storage_t *in, float *out, const size_t n,
+                                                           const __nv_fp8_interpretation_t fp8_interpretation);
+
+#include "cuda_fp_convert.hpp"
+
+#endif /* defined(__cplusplus) && !defined(__CUDACC_RTC__) && C++11 */
+
+#undef __CUDA_HOST_FP_CONVERT_DECL__
+
+#endif /* end of include guard: __CUDA_FP_CONVERT_H__ */
@@ -0,0 +1,613 @@
+/*
+ * Copyright 2024 NVIDIA Corporation.  All rights reserved.
+ *
+ * NOTICE TO LICENSEE:
+ *
+ * This source code and/or documentation ("Licensed Deliverables") are
+ * subject to NVIDIA intellectual property rights under U.S. and
+ * international Copyright laws.
+ *
+ * These Licensed Deliverables contained herein is PROPRIETARY and
+ * CONFIDENTIAL to NVIDIA and is being provided under the terms and
+ * conditions of a form of NVIDIA software license agreement by and
+ * between NVIDIA and Licensee ("License Agreement") or electronically
+ * accepted by Licensee.  Notwithstanding any terms or conditions to
+ * the contrary in the License Agreement, reproduction or disclosure
+ * of the Licensed Deliverables to any third party without the express
+ * written consent of NVIDIA is prohibited.
+ *
+ * NOTWITHSTANDING ANY TERMS OR CONDITIONS TO THE CONTRARY IN THE
+ * LICENSE AGREEMENT, NVIDIA MAKES NO REPRESENTATION ABOUT THE
+ * SUITABILITY OF THESE LICENSED DELIVERABLES FOR ANY PURPOSE.  IT IS
+ * PROVIDED "AS IS" WITHOUT EXPRESS OR IMPLIED WARRANTY OF ANY KIND.
+ * NVIDIA DISCLAIMS ALL WARRANTIES WITH REGARD TO THESE LICENSED
+ * DELIVERABLES, INCLUDING ALL IMPLIED WARRANTIES OF MERCHANTABILITY,
+ * NONINFRINGEMENT, AND FITNESS FOR A PARTICULAR PURPOSE.
+ * NOTWITHSTANDING ANY TERMS OR CONDITIONS TO THE CONTRARY IN THE
+ * LICENSE AGREEMENT, IN NO EVENT SHALL NVIDIA BE LIABLE FOR ANY
+ * SPECIAL, INDIRECT, INCIDENTAL, OR CONSEQUENTIAL DAMAGES, OR ANY
+ * DAMAGES WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS,
+ * WHETHER IN AN ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS
+ * ACTION, ARISING OUT OF OR IN CONNECTION WITH THE USE OR PERFORMANCE
+ * OF THESE LICENSED DELIVERABLES.
+ *
+ * U.S. Government End Users.  These Licensed Deliverables are a
+ * "commercial item" as that term is defined at 48 C.F.R. 2.101 (OCT
+ * 1995), consisting of "commercial computer software" and "commercial
+ * computer software documentation" as such terms are used in 48
+ * C.F.R. 12.212 (SEPT 1995) and is provided to the U.S. Government
+ * only as a commercial end item.  Consistent with 48 C.F.R.12.212 and
+ * 48 C.F.R. 227.7202-1 through 227.7202-4 (JUNE 1995), all
+ * U.S. Government End Users acquire the Licensed Deliverables with
+ * only those rights set forth herein.
+ *
+ * Any use of the Licensed Deliverables in individual and commercial
+ * software must include, in the user documentation and internal
+ * comments to the code, the above Disclaimer and U.S. Government End
+ * Users Notice.
+ */
+
+#if !defined(__CUDA_FP_CONVERT_HPP__)
+#define __CUDA_FP_CONVERT_HPP__
+
+#if !defined(__CUDA_FP_CONVERT_H__)
+#error "Do not include this file directly. Instead, include cuda_fp_convert.h."
+#endif
+
+/* Split large conversions across OpenMP threads, unless asked not to */
+#if defined(_OPENMP) && !defined(__CUDA_NO_FP_CONVERT_OPENMP__)
+#define __CUDA_FP_CONVERT_OPENMP__
+#include <omp.h>
+#endif /* defined(_OPENMP) && !defined(__CUDA_NO_FP_CONVERT_OPENMP__) */
+
+/* Set up the x86 vector code. When AVX2 and F16C are enabled for the whole
+ * translation unit they are used unconditionally; otherwise GCC and Clang
+ * compile the vector code for those instruction sets alone, and select it at
+ * run time when the processor supports them.
+ */
+#if defined(__x86_64__) || defined(_M_X64) || defined(__i386__) || defined(_M_IX86)
+#if defined(__AVX2__) && (defined(__F16C__) || defined(_MSC_VER))
+#define __CUDA_FP_CONVERT_AVX2__
+#define __CUDA_FP_CONVERT_AVX2_DECL__ static inline
+#include <immintrin.h>
+#elif (defined(__GNUC__) || defined(__clang__)) && !defined(__CUDACC__)
+#define __CUDA_FP_CONVERT_AVX2__
+#define __CUDA_FP_CONVERT_AVX2_RUNTIME_CHECK__
+#define __CUDA_FP_CONVERT_AVX2_DECL__ static inline __attribute__((target("avx2,f16c")))
+#include <immintrin.h>
+#endif /* defined(__AVX2__) && (defined(__F16C__) || defined(_MSC_VER)) */
+#endif /* x86 */
+
+#if !(defined __DOXYGEN_ONLY__)
+
+/* The number of elements every OpenMP thread converts at a time */
+static const size_t __internal_cvt_chunk_size = 65536U;
+
+/* Calls body(first, last) on consecutive ranges covering [0, n) */
+template <typename Body>
+static inline void __internal_cvt_for_chunks(const size_t n, const Body &body) {
+#if defined(__CUDA_FP_CONVERT_OPENMP__)
+    /* Nested in a parallel region, the caller already keeps the threads busy */
+    if ((n >= 4U * __internal_cvt_chunk_size) && !omp_in_parallel()) {
+        const int chunks =
+            (int)((n + __internal_cvt_chunk_size - 1U) / __internal_cvt_chunk_size);
+#pragma omp parallel for schedule(static)
+        for (int i = 0; i < chunks; ++i) {
+            const size_t first = (size_t)i * __internal_cvt_chunk_size;
+            const size_t last = (n - first < __internal_cvt_chunk_size)
+                                    ? n
+                                    : first + __internal_cvt_chunk_size;
+            body(first, last);
+        }
+        return;
+    }
+#endif /* defined(__CUDA_FP_CONVERT_OPENMP__) */
+    body((size_t)0, n);
+}
+
+/* Scalar conversions, used without vector units and for the tails of arrays */
+static inline void __internal_cvt_float_to_half_scalar(
+    const float *in, __half *out, const size_t n,
+    const __nv_cvt_rounding_t rounding) {
+    switch (rounding) {
+    case __NV_CVT_RZ:
+        for (size_t i = 0U; i < n; ++i) {
+            out[i] = __float2half_rz(in[i]);
+        }
+        break;
+    case __NV_CVT_RD:
+        for (size_t i = 0U; i < n; ++i) {
+            out[i] = __float2half_rd(in[i]);
+        }
+        break;
+    case __NV_CVT_RU:
+        for (size_t i = 0U; i < n; ++i) {
+            out[i] = __float2half_ru(in[i]);
+        }
+        break;
+    default:
+        for (size_t i = 0U; i < n; ++i) {
+            out[i] = __float2half_rn(in[i]);
+        }
+        break;
+    }
+}
+
+static inline void __internal_cvt_half_to_float_scalar(const __half *in,
+                                                       float *out,
+                                                       const size_t n) {
+    for (size_t i = 0U; i < n; ++i) {
+        out[i] = __half2float(in[i]);
+    }
+}
+
+static inline void __internal_cvt_float_to_bfloat16_scalar(
+    const float *in, __nv_bfloat16 *out, const size_t n,
+    const __nv_cvt_rounding_t rounding) {
+    switch (rounding) {
+    case __NV_CVT_RZ:
+        for (size_t i = 0U; i < n; ++i) {
+            out[i] = __float2bfloat16_rz(in[i]);
+        }
+        break;
+    case __NV_CVT_RD:
+        for (size_t i = 0U; i < n; ++i) {
+            out[i] = __float2bfloat16_rd(in[i]);
+        }
+        break;
+    case __NV_CVT_RU:
+        for (size_t i = 0U; i < n; ++i) {
+            out[i] = __float2bfloat16_ru(in[i]);
+        }
+        break;
+    default:
+        for (size_t i = 0U; i < n; ++i) {
+            out[i] = __float2bfloat16_rn(in[i]);
+        }
+        break;
+    }
+}
+
+static inline void __internal_cvt_bfloat16_to_float_scalar(
+    const __nv_bfloat16 *in, float *out, const size_t n) {
+    for (size_t i = 0U; i < n; ++i) {
+        out[i] = __bfloat162float(in[i]);
+    }
+}
+
+static inline void __internal_cvt_float_to_fp8_scalar(
+    const float *in, __nv_fp8_storage_t *out, const size_t n,
+    const __nv_saturation_t saturate,
+    const __nv_fp8_interpretation_t fp8_interpretation) {
+    for (size_t i = 0U; i < n; ++i) {
+        out[i] = __nv_cvt_float_to_fp8(in[i], saturate, fp8_interpretation);
+    }
+}
+
+/* There are only 256 fp8 values of either kind, so look them up */
+struct __internal_cvt_fp8_table {
+    float value[256];
+
+    explicit __internal_cvt_fp8_table(
+        const __nv_fp8_interpretation_t fp8_interpretation) {
+        for (unsigned int i = 0U; i < 256U; ++i) {
+            value[i] = __internal_halfraw_to_float(__nv_cvt_fp8_to_halfraw(
+                (__nv_fp8_storage_t)i, fp8_interpretation));
+        }
+    }
+};
+
+static inline const float *
+__internal_cvt_fp8_to_float_table(const __nv_fp8_interpretation_t fp8_interpretation) {
+    static const __internal_cvt_fp8_table e4m3(__NV_E4M3);
+    static const __internal_cvt_fp8_table e5m2(__NV_E5M2);
+    return (fp8_interpretation == __NV_E4M3) ? e4m3.value : e5m2.value;
+}
+
+static inline void __internal_cvt_fp8_to_float_scalar(
+    const __nv_fp8_storage_t *in, float *out, const size_t n,
+    const float *table) {
+    for (size_t i = 0U; i < n; ++i) {
+        out[i] = table[in[i]];
+    }
+}
+
+#if defined(__CUDA_FP_CONVERT_AVX2__)
+
+static inline bool __internal_cvt_have_avx2() {
+#if defined(__CUDA_FP_CONVERT_AVX2_RUNTIME_CHECK__)
+    static const bool supported = (__builtin_cpu_init(), true) &&
+                                  __builtin_cpu_supports("avx2") &&
+                                  __builtin_cpu_supports("f16c");
+    return supported;
+#else
+    return true;
+#endif /* defined(__CUDA_FP_CONVERT_AVX2_RUNTIME_CHECK__) */
+}
+
+/* The vector conversions below assume that denormal inputs are not treated
+ * as zero (MXCSR.DAZ), which is the default floating-point environment.
+ */
+template <__nv_cvt_rounding_t rounding>
+__CUDA_FP_CONVERT_AVX2_DECL__ void
+__internal_cvt_float_to_half_avx2(const float *in, __half *out, const size_t n) {
+    const int mode = (rounding == __NV_CVT_RZ)   ? _MM_FROUND_TO_ZERO
+                     : (rounding == __NV_CVT_RD) ? _MM_FROUND_TO_NEG_INF
+                     : (rounding == __NV_CVT_RU) ? _MM_FROUND_TO_POS_INF
+                                                 : _MM_FROUND_TO_NEAREST_INT;
+    const __m256i abs_mask = _mm256_set1_epi32(0x7fffffff);
+    const __m256i inf = _mm256_set1_epi32(0x7f800000);
+    const __m128i nan = _mm_set1_epi16(0x7fff);
+
+    size_t i = 0U;
+    for (; i + 8U <= n; i += 8U) {
+        const __m256 x = _mm256_loadu_ps(in + i);
+        __m128i h = _mm256_cvtps_ph(x, mode | _MM_FROUND_NO_EXC);
+
+        // the scalar conversion returns the canonical NaN for every NaN
+        const __m256i isnan = _mm256_cmpgt_epi32(
+            _mm256_and_si256(_mm256_castps_si256(x), abs_mask), inf);
+        h = _mm_blendv_epi8(h, nan,
+                            _mm_packs_epi32(_mm256_castsi256_si128(isnan),
+                                            _mm256_extracti128_si256(isnan, 1)));
+        _mm_storeu_si128(reinterpret_cast<__m128i *>(out + i), h);
+    }
+    __internal_cvt_float_to_half_scalar(in + i, out + i, n - i, rounding);
+}
+
+__CUDA_FP_CONVERT_AVX2_DECL__ void
+__internal_cvt_half_to_float_avx2(const __half *in, float *out, const size_t n) {
+    const __m256i abs_mask = _mm256_set1_epi32(0x7fffffff);
+    const __m256i inf = _mm256_set1_epi32(0x7f800000);
+
+    size_t i = 0U;
+    for (; i + 8U <= n; i += 8U) {
+        const __m256i x = _mm256_castps_si256(_mm256_cvtph_ps(
+            _mm_loadu_si128(reinterpret_cast<const __m128i *>(in + i))));
+
+        // the scalar conversion drops the sign of a NaN, and sets its payload
+        const __m256i isnan =
+            _mm256_cmpgt_epi32(_mm256_and_si256(x, abs_mask), inf);
+        _mm256_storeu_si256(reinterpret_cast<__m256i *>(out + i),
+                            _mm256_blendv_epi8(x, abs_mask, isnan));
+    }
+    __internal_cvt_half_to_float_scalar(in + i, out + i, n - i);
+}
+
+/* Rounds the upper halves of eight floats, exactly like the scalar code */
+template <__nv_cvt_rounding_t rounding>
+__CUDA_FP_CONVERT_AVX2_DECL__ __m256i
+__internal_cvt_float_to_bfloat16_avx2_round(const __m256i x) {
+    const __m256i low_mask = _mm256_set1_epi32(0xffff);
+    const __m256i ones = _mm256_set1_epi32(-1);
+    __m256i r;
+
+    if (rounding == __NV_CVT_RZ) {
+        r = _mm256_srli_epi32(x, 16);
+    } else if (rounding == __NV_CVT_RN) {
+        // ties go to the even neighbour; only NaNs could wrap around
+        const __m256i bias = _mm256_add_epi32(
+            _mm256_set1_epi32(0x7fff),
+            _mm256_and_si256(_mm256_srli_epi32(x, 16), _mm256_set1_epi32(1)));
+        r = _mm256_srli_epi32(_mm256_add_epi32(x, bias), 16);
+    } else {
+        // away from zero on the side of the requested direction
+        const __m256i exact =
+            _mm256_cmpeq_epi32(_mm256_and_si256(x, low_mask), _mm256_setzero_si256());
+        __m256i wrong_side = _mm256_srai_epi32(x, 31);
+        if (rounding == __NV_CVT_RD) {
+            wrong_side = _mm256_xor_si256(wrong_side, ones);
+        }
+        const __m256i increment =
+            _mm256_andnot_si256(_mm256_or_si256(exact, wrong_side), ones);
+        r = _mm256_sub_epi32(_mm256_srli_epi32(x, 16), increment);
+    }
+
+    const __m256i isnan = _mm256_cmpgt_epi32(
+        _mm256_and_si256(x, _mm256_set1_epi32(0x7fffffff)),
+        _mm256_set1_epi32(0x7f800000));
+    return _mm256_blendv_epi8(r, _mm256_set1_epi32(0x7fff), isnan);
+}
+
+template <__nv_cvt_rounding_t rounding>
+__CUDA_FP_CONVERT_AVX2_DECL__ void
+__internal_cvt_float_to_bfloat16_avx2(const float *in, __nv_bfloat16 *out,
+                                      const size_t n) {
+    size_t i = 0U;
+    for (; i + 16U <= n; i += 16U) {
+        const __m256i lo = __internal_cvt_float_to_bfloat16_avx2_round<rounding>(
+            _mm256_loadu_si256(reinterpret_cast<const __m256i *>(in + i)));
+        const __m256i hi = __internal_cvt_float_to_bfloat16_avx2_round<rounding>(
+            _mm256_loadu_si256(reinterpret_cast<const __m256i *>(in + i + 8U)));
+
+        // packing works within 128-bit lanes, so put the quarters back in order
+        const __m256i packed =
+            _mm256_permute4x64_epi64(_mm256_packus_epi32(lo, hi), 0xD8);
+        _mm256_storeu_si256(reinterpret_cast<__m256i *>(out + i), packed);
+    }
+    __internal_cvt_float_to_bfloat16_scalar(in + i, out + i, n - i, rounding);
+}
+
+__CUDA_FP_CONVERT_AVX2_DECL__ void
+__internal_cvt_bfloat16_to_float_avx2(const __nv_bfloat16 *in, float *out,
+                                      const size_t n) {
+    size_t i = 0U;
+    for (; i + 8U <= n; i += 8U) {
+        const __m256i x = _mm256_cvtepu16_epi32(
+            _mm_loadu_si128(reinterpret_cast<const __m128i *>(in + i)));
+        _mm256_storeu_si256(reinterpret_cast<__m256i *>(out + i),
+                            _mm256_slli_epi32(x, 16));
+    }
+    __internal_cvt_bfloat16_to_float_scalar(in + i, out + i, n - i);
+}
+
+/* The vector form of __nv_cvt_double_to_fp8, on the bits of floats */
+template <__nv_fp8_interpretation_t fp8_interpretation,
+          __nv_saturation_t saturate>
+__CUDA_FP_CONVERT_AVX2_DECL__ void
+__internal_cvt_float_to_fp8_avx2(const float *in, __nv_fp8_storage_t *out,
+                                 const size_t n) {
+    const bool e4m3 = (fp8_interpretation == __NV_E4M3);
+    const int FP8_SIGNIFICAND_BITS = e4m3 ? 4 : 3;
+    const int FP8_EXP_BIAS = e4m3 ? 7 : 15;
+    // mindenorm/2 = 2^-10 or 2^-17
+    const __m256i FP8_MINDENORM_O2 = _mm256_set1_epi32(e4m3 ? 0x3A800000 : 0x37000000);
+    // maxnorm + 1/2ulp = 0x1.Dp+8 or 0x1.Ep+15, and -1 to have common code
+    const __m256i FP8_OVERFLOW_THRESHOLD =
+        _mm256_set1_epi32(e4m3 ? 0x43E80000 : 0x47700000 - 1);
+    // minnorm = 2^-6 or 2^-14, and -1 to compare with >
+    const __m256i FP8_MINNORM = _mm256_set1_epi32((e4m3 ? 0x3C800000 : 0x38800000) - 1);
+    const __m256i FP8_OVERFLOW = _mm256_set1_epi32(
+        (saturate == __NV_SATFINITE) ? (e4m3 ? 0x7E : 0x7B) : (e4m3 ? 0x7F : 0x7C));
+    const __m256i FP8_MANTISSA_MASK = _mm256_set1_epi32(e4m3 ? 0x7 : 0x3);
+    // 1/2 LSB of the target format, positioned in single precision mantissa
+    const __m256i FP8_SP_HALF_ULP = _mm256_set1_epi32(1 << (23 - FP8_SIGNIFICAND_BITS));
+    const __m256i one = _mm256_set1_epi32(1);
+
+    size_t i = 0U;
+    for (; i + 8U <= n; i += 8U) {
+        const __m256i x = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(in + i));
+        const __m256i absx = _mm256_and_si256(x, _mm256_set1_epi32(0x7fffffff));
+
+        const __m256i sign = _mm256_slli_epi32(_mm256_srli_epi32(x, 31), 7);
+        const __m256i exp = _mm256_sub_epi32(
+            _mm256_and_si256(_mm256_srli_epi32(x, 23), _mm256_set1_epi32(0xff)),
+            _mm256_set1_epi32(127 - FP8_EXP_BIAS));
+        const __m256i mantissa = _mm256_and_si256(
+            _mm256_srli_epi32(x, 24 - FP8_SIGNIFICAND_BITS), FP8_MANTISSA_MASK);
+
+        // normal range, with round-to-nearest-even
+        __m256i normal = _mm256_or_si256(
+            _mm256_slli_epi32(exp, FP8_SIGNIFICAND_BITS - 1), mantissa);
+        __m256i round = _mm256_and_si256(
+            x, _mm256_sub_epi32(_mm256_slli_epi32(FP8_SP_HALF_ULP, 1), one));
+        __m256i increment = _mm256_or_si256(
+            _mm256_cmpgt_epi32(round, FP8_SP_HALF_ULP),
+            _mm256_and_si256(_mm256_cmpeq_epi32(round, FP8_SP_HALF_ULP),
+                             _mm256_cmpeq_epi32(_mm256_and_si256(mantissa, one), one)));
+        normal = _mm256_sub_epi32(normal, increment);
+
+        // denormal range, where the shift is at most 4
+        const __m256i shift = _mm256_sub_epi32(one, exp);
+        __m256i denormal = _mm256_srlv_epi32(
+            _mm256_or_si256(mantissa, _mm256_set1_epi32(1 << (FP8_SIGNIFICAND_BITS - 1))),
+            shift);
+        const __m256i denormal_half_ulp = _mm256_sllv_epi32(FP8_SP_HALF_ULP, shift);
+        round = _mm256_and_si256(
+            _mm256_or_si256(x, _mm256_set1_epi32(0x800000)),
+            _mm256_sub_epi32(_mm256_slli_epi32(denormal_half_ulp, 1), one));
+        increment = _mm256_or_si256(
+            _mm256_cmpgt_epi32(round, denormal_half_ulp),
+            _mm256_and_si256(_mm256_cmpeq_epi32(round, denormal_half_ulp),
+                             _mm256_cmpeq_epi32(_mm256_and_si256(denormal, one), one)));
+        denormal = _mm256_sub_epi32(denormal, increment);
+
+        __m256i res = _mm256_blendv_epi8(denormal, normal,
+                                         _mm256_cmpgt_epi32(absx, FP8_MINNORM));
+        res = _mm256_blendv_epi8(res, FP8_OVERFLOW,
+                                 _mm256_cmpgt_epi32(absx, FP8_OVERFLOW_THRESHOLD));
+        res = _mm256_and_si256(res, _mm256_cmpgt_epi32(absx, FP8_MINDENORM_O2));
+        res = _mm256_or_si256(res, sign);
+        // every NaN is the canonical NaN, which has no sign
+        res = _mm256_blendv_epi8(
+            res, _mm256_set1_epi32(0x7F),
+            _mm256_cmpgt_epi32(absx, _mm256_set1_epi32(0x7f800000)));
+
+        // narrow to bytes within each 128-bit lane, then join the lanes
+        const __m256i bytes =
+            _mm256_packus_epi16(_mm256_packus_epi32(res, res), _mm256_setzero_si256());
+        _mm_storel_epi64(reinterpret_cast<__m128i *>(out + i),
+                         _mm_unpacklo_epi32(_mm256_castsi256_si128(bytes),
+                                            _mm256_extracti128_si256(bytes, 1)));
+    }
+    __internal_cvt_float_to_fp8_scalar(in + i, out + i, n - i, saturate,
+                                       fp8_interpretation);
+}
+
+__CUDA_FP_CONVERT_AVX2_DECL__ void
+__internal_cvt_fp8_to_float_avx2(const __nv_fp8_storage_t *in, float *out,
+                                 const size_t n, const float *table) {
+    size_t i = 0U;
+    for (; i + 8U <= n; i += 8U) {
+        const __m256i index = _mm256_cvtepu8_epi32(
+            _mm_loadl_epi64(reinterpret_cast<const __m128i *>(in + i)));
+        _mm256_storeu_ps(out + i, _mm256_i32gather_ps(table, index, 4));
+    }
+    __internal_cvt_fp8_to_float_scalar(in + i, out + i, n - i, table);
+}
+
+#endif /* defined(__CUDA_FP_CONVERT_AVX2__) */
+
+/* Single-threaded conversions of whole ranges */
+static inline void __internal_cvt_float_to_half(const float *in, __half *out,
+                                                const size_t n,
+                                                const __nv_cvt_rounding_t rounding) {
+#if defined(__CUDA_FP_CONVERT_AVX2__)
+    if (__internal_cvt_have_avx2()) {
+        switch (rounding) {
+        case __NV_CVT_RZ:
+            __internal_cvt_float_to_half_avx2<__NV_CVT_RZ>(in, out, n);
+            return;
+        case __NV_CVT_RD:
+            __internal_cvt_float_to_half_avx2<__NV_CVT_RD>(in, out, n);
+            return;
+        case __NV_CVT_RU:
+            __internal_cvt_float_to_half_avx2<__NV_CVT_RU>(in, out, n);
+            return;
+        default:
+            __internal_cvt_float_to_half_avx2<__NV_CVT_RN>(in, out, n);
+            return;
+        }
+    }
+#endif /* defined(__CUDA_FP_CONVERT_AVX2__) */
+    __internal_cvt_float_to_half_scalar(in, out, n, rounding);
+}
+
+static inline void __internal_cvt_half_to_float(const __half *in, float *out,
+                                                const size_t n) {
+#if defined(__CUDA_FP_CONVERT_AVX2__)
+    if (__internal_cvt_have_avx2()) {
+        __internal_cvt_half_to_float_avx2(in, out, n);
+        return;
+    }
+#endif /* defined(__CUDA_FP_CONVERT_AVX2__) */
+    __internal_cvt_half_to_float_scalar(in, out, n);
+}
+
+static inline void
+__internal_cvt_float_to_bfloat16(const float *in, __nv_bfloat16 *out,
+                                 const size_t n,
+                                 const __nv_cvt_rounding_t rounding) {
+#if defined(__CUDA_FP_CONVERT_AVX2__)
+    if (__internal_cvt_have_avx2()) {
+        switch (rounding) {
+        case __NV_CVT_RZ:
+            __internal_cvt_float_to_bfloat16_avx2<__NV_CVT_RZ>(in, out, n);
+            return;
+        case __NV_CVT_RD:
+            __internal_cvt_float_to_bfloat16_avx2<__NV_CVT_RD>(in, out, n);
+            return;
+        case __NV_CVT_RU:
+            __internal_cvt_float_to_bfloat16_avx2<__NV_CVT_RU>(in, out, n);
+            return;
+        default:
+            __internal_cvt_float_to_bfloat16_avx2<__NV_CVT_RN>(in, out, n);
+            return;
+        }
+    }
+#endif /* defined(__CUDA_FP_CONVERT_AVX2__) */
+    __internal_cvt_float_to_bfloat16_scalar(in, out, n, rounding);
+}
+
+static inline void __internal_cvt_bfloat16_to_float(const __nv_bfloat16 *in,
+                                                    float *out, const size_t n) {
+#if defined(__CUDA_FP_CONVERT_AVX2__)
+    if (__internal_cvt_have_avx2()) {
+        __internal_cvt_bfloat16_to_float_avx2(in, out, n);
+        return;
+    }
+#endif /* defined(__CUDA_FP_CONVERT_AVX2__) */
+    __internal_cvt_bfloat16_to_float_scalar(in, out, n);
+}
+
+static inline void
+__internal_cvt_float_to_fp8(const float *in, __nv_fp8_storage_t *out,
+                            const size_t n, const __nv_saturation_t saturate,
+                            const __nv_fp8_interpretation_t fp8_interpretation) {
+#if defined(__CUDA_FP_CONVERT_AVX2__)
+    if (__internal_cvt_have_avx2()) {
+        if (fp8_interpretation == __NV_E4M3) {
+            if (saturate == __NV_SATFINITE) {
+                __internal_cvt_float_to_fp8_avx2<__NV_E4M3, __NV_SATFINITE>(in, out, n);
+            } else {
+                __internal_cvt_float_to_fp8_avx2<__NV_E4M3, __NV_NOSAT>(in, out, n);
+            }
+        } else {
+            if (saturate == __NV_SATFINITE) {
+                __internal_cvt_float_to_fp8_avx2<__NV_E5M2, __NV_SATFINITE>(in, out, n);
+            } else {
+                __internal_cvt_float_to_fp8_avx2<__NV_E5M2, __NV_NOSAT>(in, out, n);
+            }
+        }
+        return;
+    }
+#endif /* defined(__CUDA_FP_CONVERT_AVX2__) */
+    __internal_cvt_float_to_fp8_scalar(in, out, n, saturate, fp8_interpretation);
+}
+
+static inline void __internal_cvt_fp8_to_float(const __nv_fp8_storage_t *in,
+                                               float *out, const size_t n,
+                                               const float *table) {
+#if defined(__CUDA_FP_CONVERT_AVX2__)
+    if (__internal_cvt_have_avx2()) {
+        __internal_cvt_fp8_to_float_avx2(in, out, n, table);
+        return;
+    }
+#endif /* defined(__CUDA_FP_CONVERT_AVX2__) */
+    __internal_cvt_fp8_to_float_scalar(in, out, n, table);
+}
+
+__CUDA_HOST_FP_CONVERT_DECL__ void
+__nv_cvt_float_to_half_n(const float *in, __half *out, const size_t n,
+                         const __nv_cvt_rounding_t rounding) {
+    __internal_cvt_for_chunks(n, [=](const size_t first, const size_t last) {
+        __internal_cvt_float_to_half(in + first, out + first, last - first,
+                                     rounding);
+    });
+}
+
+__CUDA_HOST_FP_CONVERT_DECL__ void
+__nv_cvt_half_to_float_n(const __half *in, float *out, const size_t n) {
+    __internal_cvt_for_chunks(n, [=](const size_t first, const size_t last) {
+        __internal_cvt_half_to_float(in + first, out + first, last - first);
+    });
+}
+
+__CUDA_HOST_FP_CONVERT_DECL__ void
+__nv_cvt_float_to_bfloat16_n(const float *in, __nv_bfloat16 *out,
+                             const size_t n,
+                             const __nv_cvt_rounding_t rounding) {
+    __internal_cvt_for_chunks(n, [=](const size_t first, const size_t last) {
+        __internal_cvt_float_to_bfloat16(in + first, out + first, last - first,
+                                         rounding);
+    });
+}
+
+__CUDA_HOST_FP_CONVERT_DECL__ void
+__nv_cvt_bfloat16_to_float_n(const __nv_bfloat16 *in, float *out,
+                             const size_t n) {
+    __internal_cvt_for_chunks(n, [=](const size_t first, const size_t last) {
+        __internal_cvt_bfloat16_to_float(in + first, out + first, last - first);
+    });
+}
+
+__CUDA_HOST_FP_CONVERT_DECL__ void
+__nv_cvt_float_to_fp8_n(const float *in, __nv_fp8_storage_t *out,
+                        const size_t n, const __nv_saturation_t saturate,
+                        const __nv_fp8_interpretation_t fp8_interpretation) {
+    __internal_cvt_for_chunks(n, [=](const size_t first, const size_t last) {
+        __internal_cvt_float_to_fp8(in + first, out + first, last - first,
+                                    saturate, fp8_interpretation);
+    });
+}
+
+__CUDA_HOST_FP_CONVERT_DECL__ void
+__nv_cvt_fp8_to_float_n(const __nv_fp8_storage_t *in, float *out,
+                        const size_t n,
+                        const __nv_fp8_interpretation_t fp8_interpretation) {
+    // build the table before the threads start
+    const float *table = __internal_cvt_fp8_to_float_table(fp8_interpretation);
+    __internal_cvt_for_chunks(n, [=](const size_t first, const size_t last) {
+        __internal_cvt_fp8_to_float(in + first, out + first, last - first,
+                                    table);
+    });
+}
+
+#endif /* !(defined __DOXYGEN_ONLY__) */
+
+#undef __CUDA_FP_CONVERT_OPENMP__
+#undef __CUDA_FP_CONVERT_AVX2__
+#undef __CUDA_FP_CONVERT_AVX2_RUNTIME_CHECK__
+#undef __CUDA_FP_CONVERT_AVX2_DECL__
+
+#endif /* end of include guard: __CUDA_FP_CONVERT_HPP__ */
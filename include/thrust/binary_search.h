@@ -976,6 +976,11 @@ equal_range(ForwardIterator first, ForwardIterator last, const T& value, StrictW
 
 /*! \addtogroup vectorized_binary_search Vectorized Searches
  *  \ingroup binary_search
+ *
+ *  The OpenMP and TBB backends split the values into pieces searched in parallel. By default, a piece is swept
+ *  through the ordered range while its values are sorted, and searched value by value otherwise. Defining
+ *  \c THRUST_HOST_BINARY_SEARCH_STRATEGY as \c THRUST_BINARY_SEARCH_BRANCHLESS before including Thrust always searches
+ *  every value independently, with a branchless binary search. The default is \c THRUST_BINARY_SEARCH_ADAPTIVE.
  *  \{
  */
 
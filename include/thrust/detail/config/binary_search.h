@@ -0,0 +1,42 @@
+/*
+ *  Copyright 2024 NVIDIA Corporation
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+#pragma once
+
+// Internal config header that is only included through thrust/detail/config/config.h
+
+#if defined(_CCCL_IMPLICIT_SYSTEM_HEADER_GCC)
+#  pragma GCC system_header
+#elif defined(_CCCL_IMPLICIT_SYSTEM_HEADER_CLANG)
+#  pragma clang system_header
+#elif defined(_CCCL_IMPLICIT_SYSTEM_HEADER_MSVC)
+#  pragma system_header
+#endif // no system header
+
+// The strategies of the vectorized lower_bound, upper_bound and binary_search of the OpenMP and TBB backends:
+//   THRUST_BINARY_SEARCH_ADAPTIVE   sweeps through the data while the queries are sorted, and searches otherwise
+//   THRUST_BINARY_SEARCH_BRANCHLESS searches every query independently
+#define THRUST_BINARY_SEARCH_ADAPTIVE   1
+#define THRUST_BINARY_SEARCH_BRANCHLESS 2
+
+#ifndef THRUST_HOST_BINARY_SEARCH_STRATEGY
+#  define THRUST_HOST_BINARY_SEARCH_STRATEGY THRUST_BINARY_SEARCH_ADAPTIVE
+#endif // THRUST_HOST_BINARY_SEARCH_STRATEGY
+
+#if THRUST_HOST_BINARY_SEARCH_STRATEGY != THRUST_BINARY_SEARCH_ADAPTIVE \
+  && THRUST_HOST_BINARY_SEARCH_STRATEGY != THRUST_BINARY_SEARCH_BRANCHLESS
+#  error THRUST_HOST_BINARY_SEARCH_STRATEGY must be THRUST_BINARY_SEARCH_ADAPTIVE or THRUST_BINARY_SEARCH_BRANCHLESS.
+#endif
@@ -42,6 +42,7 @@
 // because other config headers depend on it
 #include <thrust/detail/config/host_system.h>
 
+#include <thrust/detail/config/binary_search.h>
 #include <thrust/detail/config/debug.h>
 #include <thrust/detail/config/device_system.h>
 #include <thrust/detail/config/global_workarounds.h>
@@ -30,6 +30,7 @@
 #define THRUST_HOST_SYSTEM_CPP 1
 #define THRUST_HOST_SYSTEM_OMP 2
 #define THRUST_HOST_SYSTEM_TBB 3
+#define THRUST_HOST_SYSTEM_THREADS 4
 
 #ifndef THRUST_HOST_SYSTEM
 #  define THRUST_HOST_SYSTEM THRUST_HOST_SYSTEM_CPP
@@ -45,6 +46,8 @@
 #  define __THRUST_HOST_SYSTEM_NAMESPACE omp
 #elif THRUST_HOST_SYSTEM == THRUST_HOST_SYSTEM_TBB
 #  define __THRUST_HOST_SYSTEM_NAMESPACE tbb
+#elif THRUST_HOST_SYSTEM == THRUST_HOST_SYSTEM_THREADS
+#  define __THRUST_HOST_SYSTEM_NAMESPACE threads
 #endif
 
 // clang-format off
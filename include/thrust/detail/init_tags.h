@@ -0,0 +1,73 @@
+/*
+ *  Copyright 2024 NVIDIA Corporation
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+/*! \file init_tags.h
+ *  \brief Tags which select how the constructors and \p resize of vectors
+ *         initialize new elements.
+ */
+
+#pragma once
+
+#include <thrust/detail/config.h>
+
+#if defined(_CCCL_IMPLICIT_SYSTEM_HEADER_GCC)
+#  pragma GCC system_header
+#elif defined(_CCCL_IMPLICIT_SYSTEM_HEADER_CLANG)
+#  pragma clang system_header
+#elif defined(_CCCL_IMPLICIT_SYSTEM_HEADER_MSVC)
+#  pragma system_header
+#endif // no system header
+
+THRUST_NAMESPACE_BEGIN
+
+/*! \addtogroup containers
+ *  \{
+ */
+
+/*! \p default_init_t is the type of \p default_init.
+ */
+struct default_init_t
+{};
+
+/*! \p default_init requests that new elements of a vector are default-initialized
+ *  rather than value-initialized. Elements of trivially default-constructible types,
+ *  such as \c float, are left uninitialized, which saves a pass over the memory when
+ *  the elements are overwritten anyway. Other elements are default-constructed.
+ *
+ *  \code
+ *  #include <thrust/host_vector.h>
+ *  ...
+ *  thrust::host_vector<float> v(n, thrust::default_init); // the elements of v are indeterminate
+ *  v.resize(2 * n, thrust::default_init);                 // and so are the new ones
+ *  \endcode
+ */
+THRUST_INLINE_CONSTANT default_init_t default_init{};
+
+/*! \p no_init_t is the type of \p no_init.
+ */
+struct no_init_t
+{};
+
+/*! \p no_init requests that new elements of a vector are left uninitialized. Unlike
+ *  \p default_init, it is an error to use \p no_init with an element type which is
+ *  not trivially default-constructible.
+ */
+THRUST_INLINE_CONSTANT no_init_t no_init{};
+
+/*! \} // containers
+ */
+
+THRUST_NAMESPACE_END
@@ -32,6 +32,7 @@
 #endif // no system header
 
 #include <thrust/detail/contiguous_storage.h>
+#include <thrust/detail/init_tags.h>
 #include <thrust/detail/type_traits.h>
 #include <thrust/iterator/detail/normal_iterator.h>
 #include <thrust/iterator/iterator_traits.h>
@@ -90,6 +91,19 @@ public:
    */
   explicit vector_base(size_type n, const Alloc& alloc);
 
+  /*! This constructor creates a vector_base with default-initialized
+   *  elements, which are left uninitialized if \c T is trivially
+   *  default-constructible.
+   *  \param n The number of elements to create.
+   */
+  vector_base(size_type n, default_init_t);
+
+  /*! This constructor creates a vector_base with uninitialized elements.
+   *  \c T must be trivially default-constructible.
+   *  \param n The number of elements to create.
+   */
+  vector_base(size_type n, no_init_t);
+
   /*! This constructor creates a vector_base with copies
    *  of an exemplar element.
    *  \param n The number of elements to initially create.
@@ -226,6 +240,30 @@ public:
    */
   void resize(size_type new_size, const value_type& x);
 
+  /*! \brief Resizes this vector_base to the specified number of elements.
+   *  \param new_size Number of elements this vector_base should contain.
+   *  \throw std::length_error If n exceeds max_size().
+   *
+   *  This method will resize this vector_base to the specified number of
+   *  elements. If the number is smaller than this vector_base's current
+   *  size this vector_base is truncated, otherwise this vector_base is
+   *  extended and new elements are default-initialized, which leaves them
+   *  uninitialized if \c T is trivially default-constructible.
+   */
+  void resize(size_type new_size, default_init_t);
+
+  /*! \brief Resizes this vector_base to the specified number of elements.
+   *  \param new_size Number of elements this vector_base should contain.
+   *  \throw std::length_error If n exceeds max_size().
+   *
+   *  This method will resize this vector_base to the specified number of
+   *  elements. If the number is smaller than this vector_base's current
+   *  size this vector_base is truncated, otherwise this vector_base is
+   *  extended and new elements are left uninitialized. \c T must be
+   *  trivially default-constructible.
+   */
+  void resize(size_type new_size, no_init_t);
+
   /*! Returns the number of elements in this vector_base.
    */
   _CCCL_HOST_DEVICE size_type size() const;
@@ -501,6 +539,9 @@ private:
 
   void default_init(size_type n);
 
+  // allocates n elements without constructing them
+  void uninitialized_init(size_type n);
+
   void fill_init(size_type n, const T& x);
 
   // these methods resolve the ambiguity of the insert() template of form (iterator, InputIterator, InputIterator)
@@ -512,8 +553,8 @@ private:
   template <typename InputIteratorOrIntegralType>
   void insert_dispatch(iterator position, InputIteratorOrIntegralType n, InputIteratorOrIntegralType x, true_type);
 
-  // this method appends n default-constructed elements at the end
-  void append(size_type n);
+  // this method appends n elements at the end, which are default-constructed if construct is true
+  void append(size_type n, bool construct);
 
   // this method performs insertion from a fill value
   void fill_insert(iterator position, size_type n, const T& x);
@@ -75,6 +75,32 @@ vector_base<T, Alloc>::vector_base(size_type n, const Alloc& alloc)
   default_init(n);
 } // end vector_base::vector_base()
 
+template <typename T, typename Alloc>
+vector_base<T, Alloc>::vector_base(size_type n, default_init_t)
+    : m_storage()
+    , m_size(0)
+{
+  if (::cuda::std::is_trivially_default_constructible<T>::value)
+  {
+    uninitialized_init(n);
+  }
+  else
+  {
+    default_init(n);
+  }
+} // end vector_base::vector_base()
+
+template <typename T, typename Alloc>
+vector_base<T, Alloc>::vector_base(size_type n, no_init_t)
+    : m_storage()
+    , m_size(0)
+{
+  static_assert(::cuda::std::is_trivially_default_constructible<T>::value,
+                "thrust::no_init requires a trivially default-constructible element type");
+
+  uninitialized_init(n);
+} // end vector_base::vector_base()
+
 template <typename T, typename Alloc>
 vector_base<T, Alloc>::vector_base(size_type n, const value_type& value)
     : m_storage()
@@ -223,6 +249,16 @@ void vector_base<T, Alloc>::default_init(size_type n)
   } // end if
 } // end vector_base::default_init()
 
+template <typename T, typename Alloc>
+void vector_base<T, Alloc>::uninitialized_init(size_type n)
+{
+  if (n > 0)
+  {
+    m_storage.allocate(n);
+    m_size = n;
+  } // end if
+} // end vector_base::uninitialized_init()
+
 template <typename T, typename Alloc>
 void vector_base<T, Alloc>::fill_init(size_type n, const T& x)
 {
@@ -306,7 +342,7 @@ void vector_base<T, Alloc>::resize(size_type new_size)
   } // end if
   else
   {
-    append(new_size - size());
+    append(new_size - size(), true);
   } // end else
 } // end vector_base::resize()
 
@@ -325,6 +361,39 @@ void vector_base<T, Alloc>::resize(size_type new_size, const value_type& x)
   } // end else
 } // end vector_base::resize()
 
+template <typename T, typename Alloc>
+void vector_base<T, Alloc>::resize(size_type new_size, default_init_t)
+{
+  if (new_size < size())
+  {
+    iterator new_end = begin();
+    thrust::advance(new_end, new_size);
+    erase(new_end, end());
+  } // end if
+  else
+  {
+    append(new_size - size(), !::cuda::std::is_trivially_default_constructible<T>::value);
+  } // end else
+} // end vector_base::resize()
+
+template <typename T, typename Alloc>
+void vector_base<T, Alloc>::resize(size_type new_size, no_init_t)
+{
+  static_assert(::cuda::std::is_trivially_default_constructible<T>::value,
+                "thrust::no_init requires a trivially default-constructible element type");
+
+  if (new_size < size())
+  {
+    iterator new_end = begin();
+    thrust::advance(new_end, new_size);
+    erase(new_end, end());
+  } // end if
+  else
+  {
+    append(new_size - size(), false);
+  } // end else
+} // end vector_base::resize()
+
 template <typename T, typename Alloc>
 _CCCL_HOST_DEVICE typename vector_base<T, Alloc>::size_type vector_base<T, Alloc>::size() const
 {
@@ -783,7 +852,7 @@ void vector_base<T, Alloc>::copy_insert(iterator position, ForwardIterator first
 } // end vector_base::copy_insert()
 
 template <typename T, typename Alloc>
-void vector_base<T, Alloc>::append(size_type n)
+void vector_base<T, Alloc>::append(size_type n, bool construct)
 {
   if (n != 0)
   {
@@ -792,7 +861,10 @@ void vector_base<T, Alloc>::append(size_type n)
       // we've got room for all of them
 
       // default construct new elements at the end of the vector
-      m_storage.default_construct_n(end(), n);
+      if (construct)
+      {
+        m_storage.default_construct_n(end(), n);
+      } // end if
 
       // extend the size
       m_size += n;
@@ -822,7 +894,10 @@ void vector_base<T, Alloc>::append(size_type n)
         new_end = m_storage.uninitialized_copy(begin(), end(), new_storage.begin());
 
         // construct new elements to insert
-        new_storage.default_construct_n(new_end, n);
+        if (construct)
+        {
+          new_storage.default_construct_n(new_end, n);
+        } // end if
         new_end += n;
       } // end try
       catch (...)
@@ -106,6 +106,25 @@ public:
       : Parent(n, alloc)
   {}
 
+  /*! This constructor creates a \p host_vector with the given
+   *  size, whose elements are default-initialized rather than
+   *  value-initialized. Elements of trivially default-constructible
+   *  types are left uninitialized.
+   *  \param n The number of elements to initially create.
+   */
+  _CCCL_HOST host_vector(size_type n, default_init_t)
+      : Parent(n, default_init_t())
+  {}
+
+  /*! This constructor creates a \p host_vector with the given
+   *  size, whose elements are left uninitialized. \c T must be
+   *  trivially default-constructible.
+   *  \param n The number of elements to initially create.
+   */
+  _CCCL_HOST host_vector(size_type n, no_init_t)
+      : Parent(n, no_init_t())
+  {}
+
   /*! This constructor creates a \p host_vector with copies
    *  of an exemplar element.
    *  \param n The number of elements to initially create.
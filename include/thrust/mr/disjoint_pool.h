@@ -33,15 +33,17 @@
 
 #include <thrust/detail/config.h>
 
-#include <thrust/binary_search.h>
 #include <thrust/detail/algorithm_wrapper.h>
-#include <thrust/detail/seq.h>
 #include <thrust/host_vector.h>
 #include <thrust/mr/allocator.h>
 #include <thrust/mr/memory_resource.h>
 #include <thrust/mr/pool_options.h>
 
 #include <cassert>
+#include <functional>
+#include <map>
+#include <utility>
+#include <vector>
 
 THRUST_NAMESPACE_BEGIN
 namespace mr
@@ -105,6 +107,9 @@ public:
     ret.cached_size_cutoff_factor      = 16;
     ret.cached_alignment_cutoff_factor = 16;
 
+    ret.thread_cache_size  = 32;
+    ret.thread_cache_bytes = static_cast<std::size_t>(1) << 20;
+
     return ret;
   }
 
@@ -123,7 +128,7 @@ public:
       , m_pools(m_bookkeeper)
       , m_allocated(m_bookkeeper)
       , m_cached_oversized(m_bookkeeper)
-      , m_oversized(m_bookkeeper)
+      , m_oversized(typename oversized_block_map::key_compare(), m_bookkeeper)
   {
     assert(m_options.validate());
 
@@ -146,7 +151,7 @@ public:
       , m_pools(m_bookkeeper)
       , m_allocated(m_bookkeeper)
       , m_cached_oversized(m_bookkeeper)
-      , m_oversized(m_bookkeeper)
+      , m_oversized(typename oversized_block_map::key_compare(), m_bookkeeper)
   {
     assert(m_options.validate());
 
@@ -179,53 +184,29 @@ private:
     std::size_t size;
     std::size_t alignment;
     void_ptr pointer;
-
-    _CCCL_HOST_DEVICE bool operator==(const oversized_block_descriptor& other) const
-    {
-      return size == other.size && alignment == other.alignment && pointer == other.pointer;
-    }
-
-    _CCCL_HOST_DEVICE bool operator<(const oversized_block_descriptor& other) const
-    {
-      return size < other.size || (size == other.size && alignment < other.alignment);
-    }
   };
 
-  struct equal_pointers
-  {
-  public:
-    _CCCL_HOST_DEVICE equal_pointers(void_ptr p)
-        : p(p)
-    {}
-
-    _CCCL_HOST_DEVICE bool operator()(const oversized_block_descriptor& desc) const
-    {
-      return desc.pointer == p;
-    }
+  // oversized/overaligned allocations from upstream, keyed by their address
+  typedef std::map<void*,
+                   oversized_block_descriptor,
+                   std::less<void*>,
+                   allocator<std::pair<void* const, oversized_block_descriptor>, Bookkeeper>>
+    oversized_block_map;
 
-  private:
-    void_ptr p;
-  };
+  // cached oversized/overaligned blocks, sorted by alignment, then by size. The vector always has room for every
+  // oversized block, so that caching one in do_deallocate never allocates.
+  typedef std::pair<std::size_t, std::size_t> cached_block_key;
+  typedef std::pair<cached_block_key, void_ptr> cached_block;
+  typedef std::vector<cached_block, allocator<cached_block, Bookkeeper>> cached_block_vector;
 
-  struct matching_alignment
+  struct cached_block_less
   {
-  public:
-    _CCCL_HOST_DEVICE matching_alignment(std::size_t requested)
-        : requested(requested)
-    {}
-
-    _CCCL_HOST_DEVICE bool operator()(const oversized_block_descriptor& desc) const
+    bool operator()(const cached_block& block, const cached_block_key& key) const
     {
-      return desc.alignment >= requested;
+      return block.first < key;
     }
-
-  private:
-    std::size_t requested;
   };
 
-  typedef thrust::host_vector<oversized_block_descriptor, allocator<oversized_block_descriptor, Bookkeeper>>
-    oversized_block_vector;
-
   typedef thrust::host_vector<void_ptr, allocator<void_ptr, Bookkeeper>> pointer_vector;
 
   struct pool
@@ -260,10 +241,49 @@ private:
   pool_vector m_pools;
   // list of all allocations from upstream for the above
   chunk_vector m_allocated;
-  // list of all cached oversized/overaligned blocks that have been returned to the pool to cache
-  oversized_block_vector m_cached_oversized;
-  // list of all oversized/overaligned allocations from upstream
-  oversized_block_vector m_oversized;
+  // index of all cached oversized/overaligned blocks that have been returned to the pool to cache
+  cached_block_vector m_cached_oversized;
+  // index of all oversized/overaligned allocations from upstream
+  oversized_block_map m_oversized;
+
+  // Finds the smallest cached block that fits the request, among the alignments the cutoff factor allows. Looks up
+  // every allowed alignment once, so the cost is logarithmic in the number of cached blocks.
+  typename cached_block_vector::iterator find_cached_oversized(std::size_t bytes, std::size_t alignment)
+  {
+    typename cached_block_vector::iterator best = m_cached_oversized.end();
+
+    for (std::size_t a = alignment; a / alignment < m_options.cached_alignment_cutoff_factor; a <<= 1)
+    {
+      typename cached_block_vector::iterator it = std::lower_bound(
+        m_cached_oversized.begin(), m_cached_oversized.end(), cached_block_key(a, bytes), cached_block_less());
+
+      // no cached block is this aligned or more
+      if (it == m_cached_oversized.end())
+      {
+        break;
+      }
+
+      // if the size is bigger than the requested size by a factor
+      // bigger than or equal to the specified cutoff for size,
+      // the block is not used
+      if (it->first.first == a && it->first.second / bytes < m_options.cached_size_cutoff_factor
+          && (best == m_cached_oversized.end() || it->first.second < best->first.second))
+      {
+        best = it;
+      }
+    }
+
+    return best;
+  }
+
+  // called before a new oversized block is allocated from upstream
+  void reserve_cached_oversized(std::size_t count)
+  {
+    if (m_cached_oversized.capacity() < count)
+    {
+      m_cached_oversized.reserve((std::max)(count, 2 * m_cached_oversized.capacity()));
+    }
+  }
 
 public:
   /*! Releases all held memory to upstream.
@@ -284,9 +304,9 @@ public:
     }
 
     // deallocate cached oversized/overaligned memory
-    for (std::size_t i = 0; i < m_oversized.size(); ++i)
+    for (typename oversized_block_map::iterator it = m_oversized.begin(); it != m_oversized.end(); ++it)
     {
-      m_upstream->do_deallocate(m_oversized[i].pointer, m_oversized[i].size, m_oversized[i].alignment);
+      m_upstream->do_deallocate(it->second.pointer, it->second.size, it->second.alignment);
     }
 
     m_allocated.clear();
@@ -309,49 +329,24 @@ public:
 
       if (m_options.cache_oversized && !m_cached_oversized.empty())
       {
-        typename oversized_block_vector::iterator it =
-          thrust::lower_bound(thrust::seq, m_cached_oversized.begin(), m_cached_oversized.end(), oversized);
-
-        // if the size is bigger than the requested size by a factor
-        // bigger than or equal to the specified cutoff for size,
-        // allocate a new block
-        if (it != m_cached_oversized.end())
-        {
-          std::size_t size_factor = (*it).size / bytes;
-          if (size_factor >= m_options.cached_size_cutoff_factor)
-          {
-            it = m_cached_oversized.end();
-          }
-        }
-
-        if (it != m_cached_oversized.end() && (*it).alignment < alignment)
-        {
-          it = find_if(it + 1, m_cached_oversized.end(), matching_alignment(alignment));
-        }
-
-        // if the alignment is bigger than the requested one by a factor
-        // bigger than or equal to the specified cutoff for alignment,
-        // allocate a new block
-        if (it != m_cached_oversized.end())
-        {
-          std::size_t alignment_factor = (*it).alignment / alignment;
-          if (alignment_factor >= m_options.cached_alignment_cutoff_factor)
-          {
-            it = m_cached_oversized.end();
-          }
-        }
+        typename cached_block_vector::iterator it = find_cached_oversized(bytes, alignment);
 
         if (it != m_cached_oversized.end())
         {
-          oversized.pointer = (*it).pointer;
+          oversized.pointer = it->second;
           m_cached_oversized.erase(it);
           return oversized.pointer;
         }
       }
 
+      if (m_options.cache_oversized)
+      {
+        reserve_cached_oversized(m_oversized.size() + 1);
+      }
+
       // no fitting cached block found; allocate a new one that's just up to the specs
       oversized.pointer = m_upstream->do_allocate(bytes, alignment);
-      m_oversized.push_back(oversized);
+      m_oversized.insert(std::make_pair(thrust::detail::pointer_traits<void_ptr>::get(oversized.pointer), oversized));
 
       return oversized.pointer;
     }
@@ -426,16 +421,17 @@ public:
     // the deallocated block is oversized and/or overaligned
     if (n > m_options.largest_block_size || alignment > m_options.alignment)
     {
-      typename oversized_block_vector::iterator it = find_if(m_oversized.begin(), m_oversized.end(), equal_pointers(p));
+      typename oversized_block_map::iterator it = m_oversized.find(detail::pointer_traits<void_ptr>::get(p));
       assert(it != m_oversized.end());
 
-      oversized_block_descriptor oversized = *it;
+      oversized_block_descriptor oversized = it->second;
 
       if (m_options.cache_oversized)
       {
-        typename oversized_block_vector::iterator position =
-          lower_bound(m_cached_oversized.begin(), m_cached_oversized.end(), oversized);
-        m_cached_oversized.insert(position, oversized);
+        const cached_block_key key(oversized.alignment, oversized.size);
+        m_cached_oversized.insert(
+          std::lower_bound(m_cached_oversized.begin(), m_cached_oversized.end(), key, cached_block_less()),
+          cached_block(key, oversized.pointer));
         return;
       }
 
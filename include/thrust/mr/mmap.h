@@ -0,0 +1,363 @@
+/*
+ *  Copyright 2024 NVIDIA Corporation
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+/*! \file
+ *  \brief A host memory resource which maps its allocations directly from the operating system.
+ */
+
+#pragma once
+
+#include <thrust/detail/config.h>
+
+#if defined(_CCCL_IMPLICIT_SYSTEM_HEADER_GCC)
+#  pragma GCC system_header
+#elif defined(_CCCL_IMPLICIT_SYSTEM_HEADER_CLANG)
+#  pragma clang system_header
+#elif defined(_CCCL_IMPLICIT_SYSTEM_HEADER_MSVC)
+#  pragma system_header
+#endif // no system header
+
+#include <thrust/mr/memory_resource.h>
+#include <thrust/mr/new.h>
+
+#include <cstddef>
+#include <new>
+
+#if defined(__linux__)
+#  include <sys/mman.h>
+#  include <unistd.h>
+
+#  include <cstdio>
+#endif // __linux__
+
+THRUST_NAMESPACE_BEGIN
+namespace mr
+{
+
+/** \addtogroup memory_resources Memory Resources
+ *  \ingroup memory_management
+ *  \{
+ */
+
+/*! The ways in which \p mmap_memory_resource backs its allocations with huge pages.
+ */
+enum class huge_page_policy
+{
+  /*! Allocations are backed by pages of the default size. */
+  none,
+  /*! Allocations of at least one huge page are aligned to huge pages and advised with \p MADV_HUGEPAGE, so that
+   *  the kernel backs them with transparent huge pages where it can. */
+  transparent,
+  /*! Allocations of at least one huge page are mapped with \p MAP_HUGETLB from the pages reserved for that by the
+   *  administrator. Where none are left, they are backed as under \p huge_page_policy::transparent. */
+  hugetlb
+};
+
+/*! A type used for configuring \p mmap_memory_resource.
+ */
+struct mmap_options
+{
+  /*! Decides whether, and how, allocations are backed by huge pages.
+   */
+  huge_page_policy huge_pages;
+
+  /*! Decides whether the pages of allocations are faulted in by the kernel when they are mapped, with
+   *  \p MAP_POPULATE, rather than one at a time when they are first touched. This makes allocation slower, and
+   *  the first pass over fresh memory faster; it also places all pages on the NUMA node of the allocating thread.
+   */
+  bool populate;
+};
+
+/*! A memory resource which maps every allocation from the operating system with \p mmap, and unmaps it on
+ *  deallocation. Allocations are whole pages, which makes this resource suitable for large buffers, and as the
+ *  upstream resource of the pools, such as \p unsynchronized_pool_resource, rather than for many small buffers.
+ *  Huge pages spare large buffers most of the page faults and TLB misses of a first pass over them.
+ *
+ *  \code
+ *  #include <thrust/mr/mmap.h>
+ *  #include <thrust/mr/pool.h>
+ *  ...
+ *  thrust::mr::mmap_options options = thrust::mr::mmap_memory_resource::get_default_options();
+ *  options.huge_pages               = thrust::mr::huge_page_policy::transparent;
+ *
+ *  thrust::mr::mmap_memory_resource upstream(options);
+ *  thrust::mr::unsynchronized_pool_resource<thrust::mr::mmap_memory_resource> pool(&upstream);
+ *
+ *  // the temporary buffers of the algorithms are drawn from the pool
+ *  thrust::mr::allocator<char, decltype(pool)> alloc(&pool);
+ *  thrust::sort(thrust::omp::par(alloc), v.begin(), v.end());
+ *  \endcode
+ *
+ *  On systems other than Linux, this resource allocates with global operators new and delete.
+ */
+class mmap_memory_resource final : public memory_resource<>
+{
+public:
+  /*! Get the default options of the resource: pages of the default size, which are not faulted in by the kernel
+   *  ahead of their first touch. These are the semantics of memory allocated with operator new.
+   */
+  static mmap_options get_default_options()
+  {
+    mmap_options ret;
+
+    ret.huge_pages = huge_page_policy::none;
+    ret.populate   = false;
+
+    return ret;
+  }
+
+  /*! Constructor.
+   *
+   *  \param options the options to use
+   */
+  mmap_memory_resource(mmap_options options = get_default_options())
+      : m_options(options)
+  {}
+
+  /*! Returns the options of this resource.
+   */
+  mmap_options options() const
+  {
+    return m_options;
+  }
+
+  /*! Returns the size of pages of the default size.
+   */
+  static std::size_t page_size()
+  {
+#if defined(__linux__)
+    static const std::size_t size = static_cast<std::size_t>(::sysconf(_SC_PAGESIZE));
+#else
+    static const std::size_t size = 4096;
+#endif
+    return size;
+  }
+
+  /*! Returns the size of huge pages, or 0 where the system has none.
+   */
+  static std::size_t huge_page_size()
+  {
+    static const std::size_t size = read_huge_page_size();
+    return size;
+  }
+
+  void* do_allocate(std::size_t bytes, std::size_t alignment = THRUST_MR_DEFAULT_ALIGNMENT) override
+  {
+#if defined(__linux__)
+    // mmap rejects empty mappings, so an empty allocation takes a page, like any other small one
+    bytes = bytes > 0 ? bytes : 1;
+
+    const std::size_t huge = huge_page_size();
+
+    int flags = MAP_PRIVATE | MAP_ANONYMOUS;
+
+    if (m_options.populate)
+    {
+      flags |= MAP_POPULATE;
+    }
+
+    if (use_huge_pages(bytes))
+    {
+      if (m_options.huge_pages == huge_page_policy::hugetlb)
+      {
+        void* p = map(round_up(bytes, huge), alignment, flags | MAP_HUGETLB);
+
+        if (p != nullptr)
+        {
+          return p;
+        }
+      }
+
+      // transparent huge pages only back the parts of a mapping which are aligned to huge pages
+      void* p = map(round_up(bytes, huge), alignment > huge ? alignment : huge, flags & ~MAP_POPULATE);
+
+      if (p == nullptr)
+      {
+        throw std::bad_alloc();
+      }
+
+      // the advice comes before the pages are populated, or they would be populated with pages of the default size
+      ::madvise(p, round_up(bytes, huge), MADV_HUGEPAGE);
+
+      if (m_options.populate)
+      {
+        populate(p, round_up(bytes, huge));
+      }
+
+      return p;
+    }
+
+    void* p = map(round_up(bytes, page_size()), alignment, flags);
+
+    if (p == nullptr)
+    {
+      throw std::bad_alloc();
+    }
+
+    return p;
+#else
+    return get_global_resource<new_delete_resource>()->do_allocate(bytes, alignment);
+#endif
+  }
+
+  void do_deallocate(void* p, std::size_t bytes, std::size_t alignment = THRUST_MR_DEFAULT_ALIGNMENT) override
+  {
+#if defined(__linux__)
+    (void) alignment;
+    bytes = bytes > 0 ? bytes : 1;
+    ::munmap(p, mapped_size(bytes));
+#else
+    get_global_resource<new_delete_resource>()->do_deallocate(p, bytes, alignment);
+#endif
+  }
+
+  /*! Returns the physical memory behind the whole pages of [p, p + bytes) to the operating system, with
+   *  \p MADV_DONTNEED, and keeps the addresses mapped. The range must lie in an allocation of this resource. The
+   *  pages read as zeros, and are faulted in again, when they are next touched. This lets the owner of a large
+   *  buffer, such as a pool, shed its memory while holding on to the buffer.
+   *
+   *  \param p the beginning of the range
+   *  \param bytes the size of the range
+   */
+  void discard(void* p, std::size_t bytes)
+  {
+#if defined(__linux__)
+    const std::size_t page = page_size();
+
+    const std::size_t first = round_up(reinterpret_cast<std::size_t>(p), page);
+    const std::size_t last  = (reinterpret_cast<std::size_t>(p) + bytes) / page * page;
+
+    if (first < last)
+    {
+      ::madvise(reinterpret_cast<void*>(first), last - first, MADV_DONTNEED);
+    }
+#else
+    (void) p;
+    (void) bytes;
+#endif
+  }
+
+private:
+  static std::size_t round_up(std::size_t n, std::size_t multiple)
+  {
+    return (n + multiple - 1) / multiple * multiple;
+  }
+
+  bool use_huge_pages(std::size_t bytes) const
+  {
+    return m_options.huge_pages != huge_page_policy::none && huge_page_size() != 0 && bytes >= huge_page_size();
+  }
+
+  // the size of the mapping of an allocation of the given size
+  std::size_t mapped_size(std::size_t bytes) const
+  {
+    return round_up(bytes, use_huge_pages(bytes) ? huge_page_size() : page_size());
+  }
+
+  static std::size_t read_huge_page_size()
+  {
+    std::size_t result = 0;
+
+#if defined(__linux__)
+    std::FILE* meminfo = std::fopen("/proc/meminfo", "r");
+
+    if (meminfo != nullptr)
+    {
+      char line[256];
+      unsigned long kilobytes = 0;
+
+      while (std::fgets(line, sizeof(line), meminfo) != nullptr)
+      {
+        if (std::sscanf(line, "Hugepagesize: %lu kB", &kilobytes) == 1)
+        {
+          result = static_cast<std::size_t>(kilobytes) * 1024;
+          break;
+        }
+      }
+
+      std::fclose(meminfo);
+    }
+#endif // __linux__
+
+    return result;
+  }
+
+#if defined(__linux__)
+  // faults in the pages of [p, p + length), which must not have been written to before
+  static void populate(void* p, std::size_t length)
+  {
+#  if defined(MADV_POPULATE_WRITE)
+    if (::madvise(p, length, MADV_POPULATE_WRITE) == 0)
+    {
+      return;
+    }
+#  endif // MADV_POPULATE_WRITE
+
+    const std::size_t page = page_size();
+
+    for (std::size_t offset = 0; offset < length; offset += page)
+    {
+      static_cast<volatile char*>(p)[offset] = 0;
+    }
+  }
+
+  // maps length bytes, which are a multiple of the page size, at the given alignment; a stricter alignment than
+  // that of pages is found in a larger mapping, whose excess is unmapped. Returns nullptr on failure.
+  static void* map(std::size_t length, std::size_t alignment, int flags)
+  {
+    const std::size_t page  = page_size();
+    const std::size_t slack = alignment > page ? alignment - page : 0;
+
+    // huge pages cannot be mapped in part, so a mapping of them is never larger than requested
+    if ((flags & MAP_HUGETLB) && alignment > huge_page_size())
+    {
+      return nullptr;
+    }
+
+    const std::size_t mapped = (flags & MAP_HUGETLB) ? length : length + slack;
+
+    void* mapping = ::mmap(nullptr, mapped, PROT_READ | PROT_WRITE, flags, -1, 0);
+
+    if (mapping == MAP_FAILED)
+    {
+      return nullptr;
+    }
+
+    char* first = static_cast<char*>(mapping);
+    char* p     = reinterpret_cast<char*>(round_up(reinterpret_cast<std::size_t>(first), mapped - length + page));
+
+    if (p != first)
+    {
+      ::munmap(first, p - first);
+    }
+
+    if (first + mapped != p + length)
+    {
+      ::munmap(p + length, (first + mapped) - (p + length));
+    }
+
+    return p;
+  }
+#endif // __linux__
+
+  mmap_options m_options;
+};
+
+/*! \} // memory_resources
+ */
+
+} // namespace mr
+THRUST_NAMESPACE_END
@@ -0,0 +1,253 @@
+/*
+ *  Copyright 2024 NVIDIA Corporation
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+/*! \file
+ *  \brief A host memory resource which places its pages on NUMA nodes.
+ */
+
+#pragma once
+
+#include <thrust/detail/config.h>
+
+#if defined(_CCCL_IMPLICIT_SYSTEM_HEADER_GCC)
+#  pragma GCC system_header
+#elif defined(_CCCL_IMPLICIT_SYSTEM_HEADER_CLANG)
+#  pragma clang system_header
+#elif defined(_CCCL_IMPLICIT_SYSTEM_HEADER_MSVC)
+#  pragma system_header
+#endif // no system header
+
+#include <thrust/mr/memory_resource.h>
+#include <thrust/mr/mmap.h>
+
+#include <cstddef>
+#include <stdexcept>
+#include <vector>
+
+#if defined(__linux__)
+#  include <linux/mempolicy.h>
+#  include <sys/syscall.h>
+#  include <unistd.h>
+#endif // __linux__
+
+THRUST_NAMESPACE_BEGIN
+namespace mr
+{
+
+/** \addtogroup memory_resources Memory Resources
+ *  \ingroup memory_management
+ *  \{
+ */
+
+/*! The ways in which \p numa_memory_resource places the pages of an allocation on NUMA nodes.
+ */
+enum class numa_policy
+{
+  /*! Every page is placed on the node of the thread which touches it first. */
+  local,
+  /*! Pages are placed round-robin on the nodes, so that bandwidth is spread over all of them. */
+  interleave,
+  /*! Pages are only placed on the given nodes. */
+  bind
+};
+
+/*! A memory resource which maps its allocations from the operating system with \p mmap_memory_resource, and sets
+ *  the NUMA memory policy of their pages with \p mbind. Allocations are whole pages, which makes this resource
+ *  suitable for large buffers rather than for many small ones; wrap it in a pool for the latter.
+ *
+ *  Placement is best effort: where the kernel has no NUMA support, or on systems other than Linux, pages are
+ *  placed as the system chooses.
+ */
+class numa_memory_resource final : public memory_resource<>
+{
+public:
+  /*! Creates a resource which places pages on the node of the thread which touches them first.
+   */
+  numa_memory_resource()
+      : m_policy(numa_policy::local)
+      , m_nodes(allowed_nodes())
+  {}
+
+  /*! Creates a resource with the given policy over all nodes which this process may use.
+   *
+   *  \param policy the placement policy.
+   */
+  explicit numa_memory_resource(numa_policy policy)
+      : m_policy(policy)
+      , m_nodes(allowed_nodes())
+  {}
+
+  /*! Creates a resource with the given policy over the given nodes.
+   *
+   *  \param policy the placement policy; the nodes are ignored under \p numa_policy::local.
+   *  \param nodes the nodes on which to place pages.
+   *  \throw std::invalid_argument if \p nodes is empty or contains a node which this process may not use.
+   */
+  numa_memory_resource(numa_policy policy, const std::vector<int>& nodes)
+      : m_policy(policy)
+      , m_nodes(allowed_nodes())
+  {
+    if (nodes.empty())
+    {
+      throw std::invalid_argument("numa_memory_resource: no nodes given");
+    }
+
+    // without NUMA support, there is nothing to validate the nodes against, nor to place pages with
+    if (m_nodes.empty())
+    {
+      return;
+    }
+
+    std::vector<unsigned long> mask(m_nodes.size(), 0);
+
+    for (std::size_t i = 0; i < nodes.size(); ++i)
+    {
+      const std::size_t word = static_cast<std::size_t>(nodes[i]) / bits_per_word;
+      const std::size_t bit  = static_cast<std::size_t>(nodes[i]) % bits_per_word;
+
+      if (nodes[i] < 0 || word >= m_nodes.size() || !(m_nodes[word] & (1ul << bit)))
+      {
+        throw std::invalid_argument("numa_memory_resource: node not available");
+      }
+
+      mask[word] |= 1ul << bit;
+    }
+
+    m_nodes.swap(mask);
+  }
+
+  /*! Returns the placement policy of this resource.
+   */
+  numa_policy policy() const
+  {
+    return m_policy;
+  }
+
+  /*! Returns the number of NUMA nodes which this process may use, or 1 where there is no NUMA support.
+   */
+  static int num_nodes()
+  {
+    const std::vector<unsigned long> nodes = allowed_nodes();
+
+    int result = 0;
+
+    for (std::size_t i = 0; i < nodes.size(); ++i)
+    {
+      for (unsigned long word = nodes[i]; word != 0; word &= word - 1)
+      {
+        ++result;
+      }
+    }
+
+    return result > 0 ? result : 1;
+  }
+
+  /*! Returns the granularity in which this resource places memory on nodes.
+   */
+  static std::size_t page_size()
+  {
+    return mmap_memory_resource::page_size();
+  }
+
+  void* do_allocate(std::size_t bytes, std::size_t alignment = THRUST_MR_DEFAULT_ALIGNMENT) override
+  {
+    void* p = m_upstream.do_allocate(bytes, alignment);
+
+#if defined(__linux__)
+    // an empty allocation takes a page of its own upstream
+    set_policy(p, round_up(bytes > 0 ? bytes : 1, page_size()));
+#endif // __linux__
+
+    return p;
+  }
+
+  void do_deallocate(void* p, std::size_t bytes, std::size_t alignment = THRUST_MR_DEFAULT_ALIGNMENT) override
+  {
+    m_upstream.do_deallocate(p, bytes, alignment);
+  }
+
+private:
+  static const std::size_t bits_per_word = 8 * sizeof(unsigned long);
+
+  // the largest number of nodes which this resource supports
+  static const std::size_t max_nodes = 1024;
+
+  static std::size_t round_up(std::size_t n, std::size_t multiple)
+  {
+    return (n + multiple - 1) / multiple * multiple;
+  }
+
+  // the mask of the nodes which this process may use, which is empty where there is no NUMA support
+  static std::vector<unsigned long> allowed_nodes()
+  {
+    std::vector<unsigned long> mask(max_nodes / bits_per_word, 0);
+
+#if defined(__linux__)
+    int mode = 0;
+
+    if (::syscall(SYS_get_mempolicy, &mode, mask.data(), max_nodes, nullptr, MPOL_F_MEMS_ALLOWED) != 0)
+    {
+      mask.clear();
+    }
+#else
+    mask.clear();
+#endif // __linux__
+
+    return mask;
+  }
+
+#if defined(__linux__)
+  void set_policy(void* p, std::size_t length) const
+  {
+    if (m_nodes.empty())
+    {
+      return;
+    }
+
+    int mode = MPOL_LOCAL;
+
+    if (m_policy == numa_policy::interleave)
+    {
+      mode = MPOL_INTERLEAVE;
+    }
+    else if (m_policy == numa_policy::bind)
+    {
+      mode = MPOL_BIND;
+    }
+
+    const unsigned long* mask = (mode == MPOL_LOCAL) ? nullptr : m_nodes.data();
+
+    // the kernel ignores the last bit of the mask, hence the + 1
+    const unsigned long max_node = (mode == MPOL_LOCAL) ? 0 : m_nodes.size() * bits_per_word + 1;
+
+    // the pages are still usable if this fails, merely placed by the default policy
+    ::syscall(SYS_mbind, p, length, mode, mask, max_node, 0);
+  }
+#endif // __linux__
+
+  mmap_memory_resource m_upstream;
+
+  numa_policy m_policy;
+
+  // the nodes on which to place pages, as a mask
+  std::vector<unsigned long> m_nodes;
+};
+
+/*! \} // memory_resources
+ */
+
+} // namespace mr
+THRUST_NAMESPACE_END
@@ -39,6 +39,9 @@
 #include <thrust/mr/pool_options.h>
 
 #include <cassert>
+#include <functional>
+#include <utility>
+#include <vector>
 
 THRUST_NAMESPACE_BEGIN
 namespace mr
@@ -69,6 +72,9 @@ namespace mr
  *      efficient than the disjoint version, which wouldn't need to touch device memory at all, and therefore wouldn't
  * need to transfer it back and forth between the host and the device whenever an allocation or a deallocation happens.
  *
+ *  Cached oversized and overaligned blocks are the one exception to embedded bookkeeping: they are indexed by
+ * alignment and size in host memory, so that finding a fitting block does not require walking all of them.
+ *
  *  \tparam Upstream the type of memory resources that will be used for allocating memory blocks
  */
 template <typename Upstream>
@@ -100,6 +106,9 @@ public:
     ret.cached_size_cutoff_factor      = 16;
     ret.cached_alignment_cutoff_factor = 16;
 
+    ret.thread_cache_size  = 32;
+    ret.thread_cache_bytes = static_cast<std::size_t>(1) << 20;
+
     return ret;
   }
 
@@ -115,6 +124,7 @@ public:
       , m_pools(upstream)
       , m_allocated()
       , m_oversized()
+      , m_oversized_count(0)
       , m_cached_oversized()
   {
     assert(m_options.validate());
@@ -136,6 +146,7 @@ public:
       , m_pools(get_global_resource<Upstream>())
       , m_allocated()
       , m_oversized()
+      , m_oversized_count(0)
       , m_cached_oversized()
   {
     assert(m_options.validate());
@@ -178,26 +189,30 @@ private:
 
   // this was originally a forward list, but I made it a doubly linked list
   // because that way deallocation when not caching is faster and doesn't require
-  // traversal of a linked list (it's still a forward list for the cached list,
-  // because allocation from that list already traverses)
-  //
-  // TODO: investigate whether it's better to have this be a doubly-linked list
-  // with fast do_deallocate when !m_options.cache_oversized, or to have this be
-  // a forward list and require traversal in do_deallocate
-  //
-  // I assume that it is better this way, but the additional pointer could
-  // potentially hurt? these are supposed to be oversized and/or overaligned,
-  // so they are kinda memory intensive already
+  // traversal of a linked list
   struct oversized_block_descriptor
   {
     std::size_t size;
     std::size_t alignment;
     oversized_block_descriptor_ptr prev;
     oversized_block_descriptor_ptr next;
-    oversized_block_descriptor_ptr next_cached;
     std::size_t current_size;
   };
 
+  // cached oversized/overaligned blocks, sorted by alignment, then by size. The vector always has room for every
+  // oversized block, so that caching one in do_deallocate never allocates.
+  typedef std::pair<std::size_t, std::size_t> cached_block_key;
+  typedef std::pair<cached_block_key, oversized_block_descriptor_ptr> cached_block;
+  typedef std::vector<cached_block> cached_block_vector;
+
+  struct cached_block_less
+  {
+    bool operator()(const cached_block& block, const cached_block_key& key) const
+    {
+      return block.first < key;
+    }
+  };
+
   struct pool
   {
     block_descriptor_ptr free_list;
@@ -214,7 +229,47 @@ private:
   pool_vector m_pools;
   chunk_descriptor_ptr m_allocated;
   oversized_block_descriptor_ptr m_oversized;
-  oversized_block_descriptor_ptr m_cached_oversized;
+  std::size_t m_oversized_count;
+  cached_block_vector m_cached_oversized;
+
+  // Finds the smallest cached block that fits the request, among the alignments the cutoff factor allows. Looks up
+  // every allowed alignment once, so the cost is logarithmic in the number of cached blocks.
+  typename cached_block_vector::iterator find_cached_oversized(std::size_t bytes, std::size_t alignment)
+  {
+    typename cached_block_vector::iterator best = m_cached_oversized.end();
+
+    for (std::size_t a = alignment; a / alignment < m_options.cached_alignment_cutoff_factor; a <<= 1)
+    {
+      typename cached_block_vector::iterator it = std::lower_bound(
+        m_cached_oversized.begin(), m_cached_oversized.end(), cached_block_key(a, bytes), cached_block_less());
+
+      // no cached block is this aligned or more
+      if (it == m_cached_oversized.end())
+      {
+        break;
+      }
+
+      // if the size is bigger than the requested size by a factor
+      // bigger than or equal to the specified cutoff for size,
+      // the block is not used
+      if (it->first.first == a && it->first.second / bytes < m_options.cached_size_cutoff_factor
+          && (best == m_cached_oversized.end() || it->first.second < best->first.second))
+      {
+        best = it;
+      }
+    }
+
+    return best;
+  }
+
+  // called before a new oversized block is allocated from upstream
+  void reserve_cached_oversized(std::size_t count)
+  {
+    if (m_cached_oversized.capacity() < count)
+    {
+      m_cached_oversized.reserve((std::max)(count, 2 * m_cached_oversized.capacity()));
+    }
+  }
 
 public:
   /*! Releases all held memory to upstream.
@@ -252,7 +307,8 @@ public:
       m_upstream->do_deallocate(p, desc.size + sizeof(oversized_block_descriptor), desc.alignment);
     }
 
-    m_cached_oversized = oversized_block_descriptor_ptr();
+    m_oversized_count = 0;
+    m_cached_oversized.clear();
   }
 
   _CCCL_NODISCARD virtual void_ptr
@@ -264,87 +320,53 @@ public:
     // an oversized and/or overaligned allocation requested; needs to be allocated separately
     if (bytes > m_options.largest_block_size || alignment > m_options.alignment)
     {
-      if (m_options.cache_oversized)
+      if (m_options.cache_oversized && !m_cached_oversized.empty())
       {
-        oversized_block_descriptor_ptr ptr       = m_cached_oversized;
-        oversized_block_descriptor_ptr* previous = &m_cached_oversized;
-        while (oversized_block_ptr_traits::get(ptr))
+        typename cached_block_vector::iterator it = find_cached_oversized(bytes, alignment);
+
+        if (it != m_cached_oversized.end())
         {
-          oversized_block_descriptor desc = *ptr;
-          bool is_good                    = desc.size >= bytes && desc.alignment >= alignment;
+          oversized_block_descriptor_ptr ptr = it->second;
+          oversized_block_descriptor desc    = *ptr;
+          m_cached_oversized.erase(it);
 
-          // if the size is bigger than the requested size by a factor
-          // bigger than or equal to the specified cutoff for size,
-          // allocate a new block
-          if (is_good)
-          {
-            std::size_t size_factor = desc.size / bytes;
-            if (size_factor >= m_options.cached_size_cutoff_factor)
-            {
-              is_good = false;
-            }
-          }
+          auto ret = static_cast<char_ptr>(static_cast<void_ptr>(ptr)) - desc.size;
 
-          // if the alignment is bigger than the requested one by a factor
-          // bigger than or equal to the specified cutoff for alignment,
-          // allocate a new block
-          if (is_good)
+          if (bytes != desc.size)
           {
-            std::size_t alignment_factor = desc.alignment / alignment;
-            if (alignment_factor >= m_options.cached_alignment_cutoff_factor)
-            {
-              is_good = false;
-            }
-          }
+            desc.current_size = bytes;
 
-          if (is_good)
-          {
-            if (previous != &m_cached_oversized)
+            ptr = static_cast<oversized_block_descriptor_ptr>(static_cast<void_ptr>(ret + bytes));
+
+            if (oversized_block_ptr_traits::get(desc.prev))
             {
-              *previous = desc.next_cached;
+              thrust::raw_reference_cast(*desc.prev).next = ptr;
             }
             else
             {
-              m_cached_oversized = desc.next_cached;
+              m_oversized = ptr;
             }
 
-            desc.next_cached = oversized_block_descriptor_ptr();
-
-            auto ret = static_cast<char_ptr>(static_cast<void_ptr>(ptr)) - desc.size;
-
-            if (bytes != desc.size)
+            if (oversized_block_ptr_traits::get(desc.next))
             {
-              desc.current_size = bytes;
-
-              ptr = static_cast<oversized_block_descriptor_ptr>(static_cast<void_ptr>(ret + bytes));
-
-              if (oversized_block_ptr_traits::get(desc.prev))
-              {
-                thrust::raw_reference_cast(*desc.prev).next = ptr;
-              }
-              else
-              {
-                m_oversized = ptr;
-              }
-
-              if (oversized_block_ptr_traits::get(desc.next))
-              {
-                thrust::raw_reference_cast(*desc.next).prev = ptr;
-              }
+              thrust::raw_reference_cast(*desc.next).prev = ptr;
             }
-
-            *ptr = desc;
-
-            return static_cast<void_ptr>(ret);
           }
 
-          previous = &thrust::raw_reference_cast(*ptr).next_cached;
-          ptr      = *previous;
+          *ptr = desc;
+
+          return static_cast<void_ptr>(ret);
         }
       }
 
+      if (m_options.cache_oversized)
+      {
+        reserve_cached_oversized(m_oversized_count + 1);
+      }
+
       // no fitting cached block found; allocate a new one that's just up to the specs
       void_ptr allocated = m_upstream->do_allocate(bytes + sizeof(oversized_block_descriptor), alignment);
+      ++m_oversized_count;
       oversized_block_descriptor_ptr block =
         static_cast<oversized_block_descriptor_ptr>(static_cast<void_ptr>(static_cast<char_ptr>(allocated) + bytes));
 
@@ -353,7 +375,6 @@ public:
       desc.alignment    = alignment;
       desc.prev         = oversized_block_descriptor_ptr();
       desc.next         = m_oversized;
-      desc.next_cached  = oversized_block_descriptor_ptr();
       desc.current_size = bytes;
       *block            = desc;
       m_oversized       = block;
@@ -451,12 +472,10 @@ public:
 
       oversized_block_descriptor desc = *block;
       assert(desc.current_size == n);
-      assert(desc.alignment == alignment);
+      assert(desc.alignment >= alignment);
 
       if (m_options.cache_oversized)
       {
-        desc.next_cached = m_cached_oversized;
-
         if (desc.size != n)
         {
           desc.current_size = desc.size;
@@ -477,8 +496,12 @@ public:
           }
         }
 
-        m_cached_oversized = block;
-        *block             = desc;
+        *block = desc;
+
+        const cached_block_key key(desc.alignment, desc.size);
+        m_cached_oversized.insert(
+          std::lower_bound(m_cached_oversized.begin(), m_cached_oversized.end(), key, cached_block_less()),
+          cached_block(key, block));
 
         return;
       }
@@ -498,6 +521,7 @@ public:
       }
 
       m_upstream->do_deallocate(p, desc.size + sizeof(oversized_block_descriptor), desc.alignment);
+      --m_oversized_count;
 
       return;
     }
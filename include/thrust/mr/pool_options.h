@@ -98,6 +98,17 @@ struct pool_options
    */
   std::size_t cached_alignment_cutoff_factor;
 
+  /*! The maximal number of free blocks of a given size held by a single shard of a \p sharded_pool_resource. Blocks
+   *      beyond this number are returned to the shared pool, and an empty shard refills half of it at once. A value of
+   *      0 disables the shard caches. Ignored by the other pool resources.
+   */
+  std::size_t thread_cache_size;
+  /*! The maximal number of bytes in free blocks of a given size held by a single shard of a \p sharded_pool_resource.
+   *      For large blocks, it lowers \p thread_cache_size to this many bytes worth of blocks, but a shard can always
+   *      cache at least one block of every pooled size. Ignored by the other pool resources.
+   */
+  std::size_t thread_cache_bytes;
+
   /*! Checks if the options are self-consistent.
    *
    *  /returns true if the options are self-consitent, false otherwise.
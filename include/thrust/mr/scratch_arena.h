@@ -0,0 +1,387 @@
+/*
+ *  Copyright 2024 NVIDIA Corporation
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+/*! \file
+ *  \brief A bump-pointer memory resource adaptor for short-lived scratch memory,
+ *  such as the temporary buffers of algorithms.
+ */
+
+#pragma once
+
+#include <thrust/detail/config.h>
+
+#if defined(_CCCL_IMPLICIT_SYSTEM_HEADER_GCC)
+#  pragma GCC system_header
+#elif defined(_CCCL_IMPLICIT_SYSTEM_HEADER_CLANG)
+#  pragma clang system_header
+#elif defined(_CCCL_IMPLICIT_SYSTEM_HEADER_MSVC)
+#  pragma system_header
+#endif // no system header
+
+#include <thrust/detail/pointer.h>
+#include <thrust/mr/memory_resource.h>
+#include <thrust/mr/new.h>
+#include <thrust/mr/validator.h>
+
+#include <cstddef>
+#include <vector>
+
+THRUST_NAMESPACE_BEGIN
+namespace mr
+{
+
+/** \addtogroup memory_resources Memory Resources
+ *  \ingroup memory_management
+ *  \{
+ */
+
+/*! The statistics of a \p scratch_arena_resource, which tell how well it serves its allocations.
+ */
+struct scratch_arena_statistics
+{
+  /*! The number of bytes the arena holds, which its allocations are served from. */
+  std::size_t capacity;
+  /*! The largest number of bytes the arena has held at once. */
+  std::size_t peak_capacity;
+  /*! The largest number of bytes which were in use at once, including the padding for alignment. */
+  std::size_t peak_bytes;
+  /*! The number of allocations served. */
+  std::size_t allocations;
+  /*! The number of allocations served from memory which the arena already held. */
+  std::size_t reused_allocations;
+  /*! The number of allocations from upstream, either to grow the arena or for oversized allocations. */
+  std::size_t upstream_allocations;
+  /*! The number of times every allocation was deallocated, and the arena started over from its beginning. */
+  std::size_t resets;
+};
+
+/*! A memory resource adaptor which serves allocations by bumping a pointer through a chunk of memory from
+ *  \p Upstream, and takes all of them back at once, when the last one is deallocated. This suits the scratch memory
+ *  of algorithms, which is allocated and deallocated over and over in the same sizes: after the first few calls,
+ *  every allocation is a handful of instructions, and touches memory which is already faulted in and likely cached.
+ *
+ *  The last allocation is also taken back when it is deallocated, so that memory is reused while allocations are
+ *  deallocated in reverse order. When an allocation does not fit, the arena allocates a chunk of at least twice the
+ *  size of the current one; once every allocation is deallocated, the smaller chunks are returned to upstream, so
+ *  that the arena settles on a single chunk which fits the largest working set seen. Allocations larger than the
+ *  largest chunk the arena allocates are passed to upstream.
+ *
+ *  Between allocations, the arena retains that single chunk only while it is no larger than \p max_retained_bytes,
+ *  which defaults to the largest chunk size (64 MiB); a larger chunk is returned to upstream as soon as every
+ *  allocation is deallocated. So an idle arena holds at most \p max_retained_bytes, and \p release returns even that.
+ *
+ *  This resource is not thread safe. Every thread of the host systems has an arena of its own, which serves the
+ *  temporary buffers of their algorithms; see \p get_thread_scratch_arena. An arena can also be given to a single
+ *  call, through an allocator:
+ *
+ *  \code
+ *  #include <thrust/mr/allocator.h>
+ *  #include <thrust/mr/scratch_arena.h>
+ *  ...
+ *  thrust::mr::scratch_arena_resource<thrust::mr::new_delete_resource> arena;
+ *  thrust::mr::allocator<char, decltype(arena)> alloc(&arena);
+ *  thrust::sort(thrust::omp::par(alloc), v.begin(), v.end());
+ *  \endcode
+ *
+ *  \tparam Upstream the type of memory resources that will be used for allocating memory
+ */
+template <typename Upstream>
+class scratch_arena_resource final
+    : public memory_resource<typename Upstream::pointer>
+    , private validator<Upstream>
+{
+  typedef typename Upstream::pointer void_ptr;
+  typedef thrust::detail::pointer_traits<void_ptr> void_ptr_traits;
+  typedef typename void_ptr_traits::template rebind<char>::other char_ptr;
+
+public:
+  /*! The size of the first chunk of an arena, unless it is given.
+   */
+  static const std::size_t default_initial_bytes = static_cast<std::size_t>(1) << 16;
+
+  /*! The size of the largest chunk an arena allocates, unless it is given.
+   */
+  static const std::size_t default_max_chunk_bytes = static_cast<std::size_t>(1) << 26;
+
+  /*! The size of the largest chunk an arena retains once every allocation is deallocated, unless it is given.
+   */
+  static const std::size_t default_max_retained_bytes = default_max_chunk_bytes;
+
+  /*! Constructor.
+   *
+   *  \param upstream the upstream memory resource for allocations
+   *  \param initial_bytes the size of the first chunk
+   *  \param max_chunk_bytes the size of the largest chunk; larger allocations are passed to upstream
+   *  \param max_retained_bytes the size of the largest chunk retained once every allocation is deallocated
+   */
+  scratch_arena_resource(Upstream* upstream,
+                         std::size_t initial_bytes      = default_initial_bytes,
+                         std::size_t max_chunk_bytes    = default_max_chunk_bytes,
+                         std::size_t max_retained_bytes = default_max_retained_bytes)
+      : m_upstream(upstream)
+      , m_initial_bytes(initial_bytes)
+      , m_max_chunk_bytes(max_chunk_bytes)
+      , m_max_retained_bytes(max_retained_bytes)
+      , m_chunks()
+      , m_top(0)
+      , m_live(0)
+      , m_statistics()
+  {}
+
+  /*! Constructor. The upstream resource is obtained by calling \p get_global_resource<Upstream>.
+   *
+   *  \param initial_bytes the size of the first chunk
+   *  \param max_chunk_bytes the size of the largest chunk; larger allocations are passed to upstream
+   *  \param max_retained_bytes the size of the largest chunk retained once every allocation is deallocated
+   */
+  scratch_arena_resource(std::size_t initial_bytes      = default_initial_bytes,
+                         std::size_t max_chunk_bytes    = default_max_chunk_bytes,
+                         std::size_t max_retained_bytes = default_max_retained_bytes)
+      : m_upstream(get_global_resource<Upstream>())
+      , m_initial_bytes(initial_bytes)
+      , m_max_chunk_bytes(max_chunk_bytes)
+      , m_max_retained_bytes(max_retained_bytes)
+      , m_chunks()
+      , m_top(0)
+      , m_live(0)
+      , m_statistics()
+  {}
+
+  /*! Destructor. Releases all held memory to upstream.
+   */
+  ~scratch_arena_resource()
+  {
+    release();
+  }
+
+  /*! Releases all held memory to upstream, such as the chunk retained between allocations. Every allocation must
+   *  have been deallocated.
+   */
+  void release()
+  {
+    for (std::size_t i = 0; i < m_chunks.size(); ++i)
+    {
+      m_upstream->do_deallocate(m_chunks[i].ptr, m_chunks[i].size, chunk_alignment);
+    }
+
+    m_chunks.clear();
+    m_top                 = 0;
+    m_statistics.capacity = 0;
+  }
+
+  /*! Returns the statistics of this arena.
+   */
+  scratch_arena_statistics statistics() const
+  {
+    return m_statistics;
+  }
+
+  _CCCL_NODISCARD virtual void_ptr
+  do_allocate(std::size_t bytes, std::size_t alignment = THRUST_MR_DEFAULT_ALIGNMENT) override
+  {
+    ++m_statistics.allocations;
+
+    // every allocation takes at least one byte, so that no two allocations begin at the same address
+    bytes = bytes > 0 ? bytes : 1;
+
+    if (bytes > m_max_chunk_bytes || alignment > chunk_alignment)
+    {
+      ++m_statistics.upstream_allocations;
+      return m_upstream->do_allocate(bytes, alignment);
+    }
+
+    if (m_chunks.empty() || !fits(m_chunks.back(), bytes, alignment))
+    {
+      grow(bytes);
+    }
+    else
+    {
+      ++m_statistics.reused_allocations;
+    }
+
+    const chunk& current = m_chunks.back();
+
+    const std::size_t offset = align_up(m_top, alignment);
+    m_top                    = offset + bytes;
+    ++m_live;
+
+    record_peak();
+
+    return static_cast<void_ptr>(static_cast<char_ptr>(current.ptr) + offset);
+  }
+
+  virtual void
+  do_deallocate(void_ptr p, std::size_t bytes, std::size_t alignment = THRUST_MR_DEFAULT_ALIGNMENT) override
+  {
+    bytes = bytes > 0 ? bytes : 1;
+
+    if (bytes > m_max_chunk_bytes || alignment > chunk_alignment)
+    {
+      m_upstream->do_deallocate(p, bytes, alignment);
+      return;
+    }
+
+    const chunk& current = m_chunks.back();
+    const std::size_t offset   = static_cast<std::size_t>(
+      static_cast<char*>(void_ptr_traits::get(p)) - static_cast<char*>(void_ptr_traits::get(current.ptr)));
+
+    // the most recent allocation of the current chunk is taken back right away
+    if (offset <= current.size && offset + bytes == m_top)
+    {
+      m_top = offset;
+    }
+
+    if (--m_live == 0)
+    {
+      reset();
+    }
+  }
+
+private:
+  // chunks are aligned to cache lines, so that they share none with other memory
+  static const std::size_t chunk_alignment = 64;
+
+  struct chunk
+  {
+    void_ptr ptr;
+    std::size_t size;
+  };
+
+  static std::size_t align_up(std::size_t n, std::size_t alignment)
+  {
+    return (n + alignment - 1) / alignment * alignment;
+  }
+
+  bool fits(const chunk& c, std::size_t bytes, std::size_t alignment) const
+  {
+    const std::size_t offset = align_up(m_top, alignment);
+    return offset <= c.size && c.size - offset >= bytes;
+  }
+
+  // starts a new chunk, at least twice as large as the current one, which fits an allocation of the given size
+  void grow(std::size_t bytes)
+  {
+    std::size_t size = m_chunks.empty() ? m_initial_bytes : 2 * m_chunks.back().size;
+
+    while (size < bytes)
+    {
+      size *= 2;
+    }
+
+    size = size < m_max_chunk_bytes ? size : m_max_chunk_bytes;
+
+    chunk c;
+    c.ptr  = m_upstream->do_allocate(size, chunk_alignment);
+    c.size = size;
+
+    m_chunks.push_back(c);
+    m_top = 0;
+
+    ++m_statistics.upstream_allocations;
+    m_statistics.capacity += size;
+    m_statistics.peak_capacity =
+      m_statistics.capacity > m_statistics.peak_capacity ? m_statistics.capacity : m_statistics.peak_capacity;
+  }
+
+  // the bytes in use, which are the full earlier chunks and the used part of the current one
+  void record_peak()
+  {
+    const std::size_t in_use = m_statistics.capacity - m_chunks.back().size + m_top;
+
+    m_statistics.peak_bytes = in_use > m_statistics.peak_bytes ? in_use : m_statistics.peak_bytes;
+  }
+
+  // every allocation is deallocated: only the largest chunk, which is the current one, is kept, unless it is larger
+  // than the arena retains
+  void reset()
+  {
+    ++m_statistics.resets;
+
+    if (m_chunks.back().size > m_max_retained_bytes)
+    {
+      release();
+      return;
+    }
+
+    for (std::size_t i = 0; i + 1 < m_chunks.size(); ++i)
+    {
+      m_upstream->do_deallocate(m_chunks[i].ptr, m_chunks[i].size, chunk_alignment);
+      m_statistics.capacity -= m_chunks[i].size;
+    }
+
+    if (m_chunks.size() > 1)
+    {
+      m_chunks.erase(m_chunks.begin(), m_chunks.end() - 1);
+    }
+
+    m_top = 0;
+  }
+
+  Upstream* m_upstream;
+
+  std::size_t m_initial_bytes;
+  std::size_t m_max_chunk_bytes;
+  std::size_t m_max_retained_bytes;
+
+  // the chunks from upstream, in the order in which they were allocated; allocations bump m_top in the last one
+  std::vector<chunk> m_chunks;
+  std::size_t m_top;
+
+  // the number of allocations in the chunks which are not yet deallocated
+  std::size_t m_live;
+
+  scratch_arena_statistics m_statistics;
+};
+
+// The sizes the scratch arenas of the host threads are built with; see get_thread_scratch_arena.
+#ifndef THRUST_SCRATCH_ARENA_INITIAL_BYTES
+#  define THRUST_SCRATCH_ARENA_INITIAL_BYTES                                                        \
+    THRUST_NS_QUALIFIER::mr::scratch_arena_resource<THRUST_NS_QUALIFIER::mr::new_delete_resource>:: \
+      default_initial_bytes
+#endif // THRUST_SCRATCH_ARENA_INITIAL_BYTES
+
+#ifndef THRUST_SCRATCH_ARENA_MAX_CHUNK_BYTES
+#  define THRUST_SCRATCH_ARENA_MAX_CHUNK_BYTES                                                      \
+    THRUST_NS_QUALIFIER::mr::scratch_arena_resource<THRUST_NS_QUALIFIER::mr::new_delete_resource>:: \
+      default_max_chunk_bytes
+#endif // THRUST_SCRATCH_ARENA_MAX_CHUNK_BYTES
+
+#ifndef THRUST_SCRATCH_ARENA_MAX_RETAINED_BYTES
+#  define THRUST_SCRATCH_ARENA_MAX_RETAINED_BYTES THRUST_SCRATCH_ARENA_MAX_CHUNK_BYTES
+#endif // THRUST_SCRATCH_ARENA_MAX_RETAINED_BYTES
+
+/*! Returns the scratch arena of the calling thread, which serves the temporary buffers of the algorithms of the host
+ *  systems (\p cpp, \p omp, \p tbb and \p threads) which run on it, unless they are given an allocator with
+ *  \p par(alloc). Its statistics tell how well it serves them.
+ *
+ *  The arena is built with the sizes \p THRUST_SCRATCH_ARENA_INITIAL_BYTES, \p THRUST_SCRATCH_ARENA_MAX_CHUNK_BYTES
+ *  and \p THRUST_SCRATCH_ARENA_MAX_RETAINED_BYTES, which default to those of \p scratch_arena_resource and can be
+ *  defined before including Thrust. It lives until the thread exits, and retains up to
+ *  \p THRUST_SCRATCH_ARENA_MAX_RETAINED_BYTES (64 MiB by default) between algorithms. A thread can return that memory
+ *  with <tt>get_thread_scratch_arena().release()</tt> while none of its algorithms runs.
+ */
+_CCCL_HOST inline scratch_arena_resource<new_delete_resource>& get_thread_scratch_arena()
+{
+  static thread_local scratch_arena_resource<new_delete_resource> arena(
+    THRUST_SCRATCH_ARENA_INITIAL_BYTES, THRUST_SCRATCH_ARENA_MAX_CHUNK_BYTES, THRUST_SCRATCH_ARENA_MAX_RETAINED_BYTES);
+  return arena;
+}
+
+/*! \} // memory_resources
+ */
+
+} // namespace mr
+THRUST_NAMESPACE_END
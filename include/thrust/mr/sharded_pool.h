@@ -0,0 +1,285 @@
+/*
+ *  Copyright 2024 NVIDIA Corporation
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+/*! \file
+ *  \brief A thread-safe version of \p unsynchronized_pool_resource, which caches free blocks in per-thread shards.
+ */
+
+#pragma once
+
+#include <thrust/detail/config.h>
+
+#if defined(_CCCL_IMPLICIT_SYSTEM_HEADER_GCC)
+#  pragma GCC system_header
+#elif defined(_CCCL_IMPLICIT_SYSTEM_HEADER_CLANG)
+#  pragma clang system_header
+#elif defined(_CCCL_IMPLICIT_SYSTEM_HEADER_MSVC)
+#  pragma system_header
+#endif // no system header
+#include <thrust/detail/cpp11_required.h>
+#include <thrust/mr/pool.h>
+
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+THRUST_NAMESPACE_BEGIN
+namespace mr
+{
+
+/*! \addtogroup memory_resources Memory Resources
+ *  \ingroup memory_management
+ *  \{
+ */
+
+/*! A thread-safe version of \p unsynchronized_pool_resource, meant for many threads allocating concurrently. Uses \p
+ * std::mutex, and therefore requires C++11.
+ *
+ *  Unlike \p synchronized_pool_resource, which serializes every call on a single mutex, this resource assigns every
+ * thread to one of a number of shards. A shard keeps up to \p pool_options::thread_cache_size free blocks of every
+ * pooled size, but no more than \p pool_options::thread_cache_bytes worth of them, and only takes the lock of the
+ * shared pool to move half of that many blocks at once from or to it. A
+ * block may be deallocated from any thread; it is then cached in the shard of the deallocating thread. Oversized and
+ * overaligned allocations go straight to the shared pool.
+ *
+ *  \tparam Upstream the type of memory resources that will be used for allocating memory
+ */
+template <typename Upstream>
+struct sharded_pool_resource : public memory_resource<typename Upstream::pointer>
+{
+  typedef unsynchronized_pool_resource<Upstream> unsync_pool;
+  typedef std::lock_guard<std::mutex> lock_t;
+
+  typedef typename Upstream::pointer void_ptr;
+
+public:
+  /*! Get the default options for a pool. These are meant to be a sensible set of values for many use cases,
+   *      and as such, may be tuned in the future. This function is exposed so that creating a set of options that are
+   *      just a slight departure from the defaults is easy.
+   */
+  static pool_options get_default_options()
+  {
+    return unsync_pool::get_default_options();
+  }
+
+  /*! Constructor.
+   *
+   *  \param upstream the upstream memory resource for allocations
+   *  \param options pool options to use
+   */
+  sharded_pool_resource(Upstream* upstream, pool_options options = get_default_options())
+      : m_options(options)
+      , m_smallest_block_log2(thrust::detail::log2_ri(options.smallest_block_size))
+      , m_upstream_pool(upstream, options)
+  {
+    init_shards();
+  }
+
+  /*! Constructor. The upstream resource is obtained by calling \p get_global_resource<Upstream>.
+   *
+   *  \param options pool options to use
+   */
+  sharded_pool_resource(pool_options options = get_default_options())
+      : m_options(options)
+      , m_smallest_block_log2(thrust::detail::log2_ri(options.smallest_block_size))
+      , m_upstream_pool(get_global_resource<Upstream>(), options)
+  {
+    init_shards();
+  }
+
+  /*! Releases all held memory to upstream.
+   */
+  void release()
+  {
+    for (std::size_t i = 0; i < m_shard_count; ++i)
+    {
+      lock_t lock(m_shards[i].mtx);
+      for (std::size_t j = 0; j < m_shards[i].caches.size(); ++j)
+      {
+        m_shards[i].caches[j].clear();
+      }
+    }
+
+    lock_t lock(m_mtx);
+    m_upstream_pool.release();
+  }
+
+  _CCCL_NODISCARD virtual void_ptr
+  do_allocate(std::size_t bytes, std::size_t alignment = THRUST_MR_DEFAULT_ALIGNMENT) override
+  {
+    std::size_t bucket_idx;
+    if (!find_bucket(bytes, alignment, bucket_idx))
+    {
+      lock_t lock(m_mtx);
+      return m_upstream_pool.do_allocate(bytes, alignment);
+    }
+
+    shard& s = current_shard();
+    lock_t lock(s.mtx);
+    block_cache& cache = s.caches[bucket_idx];
+
+    if (cache.empty())
+    {
+      refill(cache, bucket_idx);
+    }
+
+    void_ptr ret = cache.back();
+    cache.pop_back();
+    return ret;
+  }
+
+  virtual void do_deallocate(void_ptr p, std::size_t n, std::size_t alignment = THRUST_MR_DEFAULT_ALIGNMENT) override
+  {
+    std::size_t bucket_idx;
+    if (!find_bucket(n, alignment, bucket_idx))
+    {
+      lock_t lock(m_mtx);
+      m_upstream_pool.do_deallocate(p, n, alignment);
+      return;
+    }
+
+    shard& s = current_shard();
+    lock_t lock(s.mtx);
+    block_cache& cache = s.caches[bucket_idx];
+
+    if (cache.size() >= cache_capacity(bucket_idx))
+    {
+      drain(cache, bucket_idx);
+    }
+
+    cache.push_back(p);
+  }
+
+private:
+  typedef std::vector<void_ptr> block_cache;
+
+  struct shard
+  {
+    std::mutex mtx;
+    std::vector<block_cache> caches;
+    // keeps the locks of neighbouring shards on separate cache lines
+    char padding[64];
+  };
+
+  void init_shards()
+  {
+    std::size_t count = (std::max)(std::thread::hardware_concurrency(), 1u);
+    m_shard_count     = static_cast<std::size_t>(1) << thrust::detail::log2_ri(count);
+    m_shards.reset(new shard[m_shard_count]);
+
+    std::size_t bucket_count = thrust::detail::log2_ri(m_options.largest_block_size) - m_smallest_block_log2 + 1;
+    for (std::size_t i = 0; i < m_shard_count; ++i)
+    {
+      m_shards[i].caches.resize(bucket_count);
+      for (std::size_t j = 0; j < bucket_count; ++j)
+      {
+        m_shards[i].caches[j].reserve(cache_capacity(j));
+      }
+    }
+  }
+
+  // Returns false for the requests the shards do not cache: oversized and overaligned ones, and all of them when
+  // the shard caches are disabled.
+  bool find_bucket(std::size_t bytes, std::size_t alignment, std::size_t& bucket_idx) const
+  {
+    bytes = (std::max)(bytes, m_options.smallest_block_size);
+
+    if (m_options.thread_cache_size == 0 || bytes > m_options.largest_block_size || alignment > m_options.alignment)
+    {
+      return false;
+    }
+
+    bucket_idx = thrust::detail::log2_ri(bytes) - m_smallest_block_log2;
+    return true;
+  }
+
+  std::size_t block_size(std::size_t bucket_idx) const
+  {
+    return static_cast<std::size_t>(1) << (bucket_idx + m_smallest_block_log2);
+  }
+
+  // a small integer identifying the calling thread, assigned on first use
+  static std::size_t thread_index()
+  {
+    static std::atomic<std::size_t> next_index(0);
+    static thread_local std::size_t index = next_index.fetch_add(1, std::memory_order_relaxed);
+
+    return index;
+  }
+
+  shard& current_shard()
+  {
+    return m_shards[thread_index() & (m_shard_count - 1)];
+  }
+
+  // the number of free blocks a shard caches in a bucket: thread_cache_size, lowered so that they fit in
+  // thread_cache_bytes, but at least one
+  std::size_t cache_capacity(std::size_t bucket_idx) const
+  {
+    const std::size_t fitting = m_options.thread_cache_bytes >> (bucket_idx + m_smallest_block_log2);
+
+    return (std::max)((std::min)(m_options.thread_cache_size, fitting), static_cast<std::size_t>(1));
+  }
+
+  std::size_t batch_size(std::size_t bucket_idx) const
+  {
+    return (std::max)(cache_capacity(bucket_idx) / 2, static_cast<std::size_t>(1));
+  }
+
+  // moves a batch of free blocks from the shared pool to an empty cache
+  void refill(block_cache& cache, std::size_t bucket_idx)
+  {
+    const std::size_t size = block_size(bucket_idx);
+    const std::size_t n    = batch_size(bucket_idx);
+
+    lock_t lock(m_mtx);
+    for (std::size_t i = 0; i < n; ++i)
+    {
+      cache.push_back(m_upstream_pool.do_allocate(size, m_options.alignment));
+    }
+  }
+
+  // returns all but a batch of free blocks of a full cache to the shared pool
+  void drain(block_cache& cache, std::size_t bucket_idx)
+  {
+    const std::size_t size = block_size(bucket_idx);
+    const std::size_t keep = cache_capacity(bucket_idx) - batch_size(bucket_idx);
+
+    lock_t lock(m_mtx);
+    while (cache.size() > keep)
+    {
+      m_upstream_pool.do_deallocate(cache.back(), size, m_options.alignment);
+      cache.pop_back();
+    }
+  }
+
+  pool_options m_options;
+  std::size_t m_smallest_block_log2;
+
+  std::mutex m_mtx;
+  unsync_pool m_upstream_pool;
+
+  std::size_t m_shard_count;
+  std::unique_ptr<shard[]> m_shards;
+};
+
+/*! \} // memory_resources
+ */
+
+} // namespace mr
+THRUST_NAMESPACE_END
@@ -85,11 +85,25 @@ discard_block_engine<Engine, p, r>::operator()(void)
 template <typename Engine, size_t p, size_t r>
 _CCCL_HOST_DEVICE void discard_block_engine<Engine, p, r>::discard(unsigned long long z)
 {
-  // XXX this should be accelerated
-  for (; z > 0; --z)
+  // values left in the current block
+  const unsigned long long left = m_n < used_block ? used_block - m_n : 0;
+
+  if (z <= left)
   {
-    this->operator()();
-  } // end for
+    m_e.discard(z);
+    m_n += static_cast<unsigned int>(z);
+    return;
+  }
+
+  // skip the rest of the current block and the blocks consumed entirely, then the
+  // used part of the last block, leaving the end of a block to the next operator()
+  // like the stepping version does
+  z -= left;
+  const unsigned long long blocks = (z - 1) / used_block;
+  const unsigned long long last   = z - blocks * used_block;
+
+  m_e.discard((block_size - m_n) + blocks * block_size + last);
+  m_n = static_cast<unsigned int>(last);
 }
 
 template <typename Engine, size_t p, size_t r>
@@ -37,32 +37,81 @@ namespace random
 namespace detail
 {
 
+// x -> a * x + c composed with itself z times is the affine map x -> A * x + C,
+// which is computed by repeated squaring: composing x -> a * x + c with itself
+// yields x -> (a * a) * x + (a * c + c)
 template <typename UIntType, UIntType a, unsigned long long c, UIntType m>
 struct linear_congruential_engine_discard_implementation
 {
+  // (x + y) mod m for x, y < m, without overflow
+  _CCCL_HOST_DEVICE static UIntType add_mod(UIntType x, UIntType y)
+  {
+    _CCCL_IF_CONSTEXPR (m == 0)
+    {
+      return x + y;
+    }
+    return (x >= m - y) ? x - (m - y) : x + y;
+  }
+
+  // (x * y) mod m for x, y < m, without overflow, by doubling and adding
+  _CCCL_HOST_DEVICE static UIntType multiply_mod(UIntType x, UIntType y)
+  {
+    _CCCL_IF_CONSTEXPR (m == 0)
+    {
+      return x * y;
+    }
+
+    UIntType result = 0;
+    for (UIntType bit = ~(~UIntType(0) >> 1); bit != 0; bit >>= 1)
+    {
+      result = add_mod(result, result);
+      if (y & bit)
+      {
+        result = add_mod(result, x);
+      }
+    }
+    return result;
+  }
+
   _CCCL_HOST_DEVICE static void discard(UIntType& state, unsigned long long z)
   {
-    for (; z > 0; --z)
+    UIntType multiplier = a;
+    UIntType increment  = static_cast<UIntType>(c);
+
+    UIntType multiplier_to_z = 1;
+    UIntType increment_to_z  = 0;
+
+    while (z > 0)
     {
-      state = detail::mod<UIntType, a, c, m>(state);
+      if (z & 1)
+      {
+        multiplier_to_z = multiply_mod(multiplier_to_z, multiplier);
+        increment_to_z  = add_mod(multiply_mod(increment_to_z, multiplier), increment);
+      }
+
+      z >>= 1;
+      increment  = add_mod(multiply_mod(increment, multiplier), increment);
+      multiplier = multiply_mod(multiplier, multiplier);
     }
+
+    state = add_mod(multiply_mod(multiplier_to_z, state), increment_to_z);
   }
 }; // end linear_congruential_engine_discard
 
-// specialize for small integers and c == 0
-// XXX figure out a robust implemenation of this for any unsigned integer type later
-template <thrust::detail::uint32_t a, thrust::detail::uint32_t m>
-struct linear_congruential_engine_discard_implementation<thrust::detail::uint32_t, a, 0, m>
+// specialize for small integers, whose products fit in unsigned long long
+template <thrust::detail::uint32_t a, unsigned long long c, thrust::detail::uint32_t m>
+struct linear_congruential_engine_discard_implementation<thrust::detail::uint32_t, a, c, m>
 {
   _CCCL_HOST_DEVICE static void discard(thrust::detail::uint32_t& state, unsigned long long z)
   {
-    const thrust::detail::uint32_t modulus = m;
+    // m == 0 stands for 2^32
+    const unsigned long long modulus = (m == 0) ? (1ull << 32) : m;
+
+    unsigned long long multiplier = a;
+    unsigned long long increment  = c % modulus;
 
-    // XXX we need to use unsigned long long here or we will encounter overflow in the
-    //     multiplies below
-    //     figure out a robust implementation of this later
-    unsigned long long multiplier      = a;
     unsigned long long multiplier_to_z = 1;
+    unsigned long long increment_to_z  = 0;
 
     // see http://en.wikipedia.org/wiki/Modular_exponentiation
     while (z > 0)
@@ -71,14 +120,16 @@ struct linear_congruential_engine_discard_implementation<thrust::detail::uint32_
       {
         // multiply in this bit's contribution while using modulus to keep result small
         multiplier_to_z = (multiplier_to_z * multiplier) % modulus;
+        increment_to_z  = (increment_to_z * multiplier + increment) % modulus;
       }
 
-      // move to the next bit of the exponent, square (and mod) the base accordingly
+      // move to the next bit of the exponent, square (and mod) the map accordingly
       z >>= 1;
+      increment  = (increment * multiplier + increment) % modulus;
       multiplier = (multiplier * multiplier) % modulus;
     }
 
-    state = static_cast<thrust::detail::uint32_t>((multiplier_to_z * state) % modulus);
+    state = static_cast<thrust::detail::uint32_t>((multiplier_to_z * state + increment_to_z) % modulus);
   }
 }; // end linear_congruential_engine_discard
 
@@ -97,6 +148,18 @@ struct linear_congruential_engine_discard
     (void) a;
     (void) m;
 
+    // operator() reduces with Schrage's method (see static_mod), which only
+    // computes a * x + c mod m exactly when m % a <= m / a. Otherwise the jump
+    // would leave the sequence operator() produces, so step instead.
+    _CCCL_IF_CONSTEXPR (m != 0 && a != 1 && m % a > m / a)
+    {
+      for (; z > 0; --z)
+      {
+        lcg();
+      }
+      return;
+    }
+
     linear_congruential_engine_discard_implementation<result_type, a, c, m>::discard(lcg.m_x, z);
   }
 }; // end linear_congruential_engine_discard
@@ -0,0 +1,369 @@
+/*
+ *  Copyright 2024 NVIDIA Corporation
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+#pragma once
+
+#include <thrust/detail/config.h>
+
+#if defined(_CCCL_IMPLICIT_SYSTEM_HEADER_GCC)
+#  pragma GCC system_header
+#elif defined(_CCCL_IMPLICIT_SYSTEM_HEADER_CLANG)
+#  pragma clang system_header
+#elif defined(_CCCL_IMPLICIT_SYSTEM_HEADER_MSVC)
+#  pragma system_header
+#endif // no system header
+
+#include <thrust/random/detail/philox_engine_mulhilo.h>
+#include <thrust/random/detail/random_core_access.h>
+#include <thrust/random/philox_engine.h>
+
+THRUST_NAMESPACE_BEGIN
+
+namespace random
+{
+
+template <typename UIntType, size_t w, size_t r, UIntType m0, UIntType c0, UIntType m1, UIntType c1>
+_CCCL_HOST_DEVICE philox_engine<UIntType, w, r, m0, c0, m1, c1>::philox_engine(unsigned long long s)
+{
+  seed(s);
+} // end philox_engine::philox_engine()
+
+template <typename UIntType, size_t w, size_t r, UIntType m0, UIntType c0, UIntType m1, UIntType c1>
+_CCCL_HOST_DEVICE philox_engine<UIntType, w, r, m0, c0, m1, c1>::philox_engine(
+  unsigned long long s, unsigned long long subsequence, unsigned long long offset)
+{
+  seed(s, subsequence, offset);
+} // end philox_engine::philox_engine()
+
+template <typename UIntType, size_t w, size_t r, UIntType m0, UIntType c0, UIntType m1, UIntType c1>
+_CCCL_HOST_DEVICE void philox_engine<UIntType, w, r, m0, c0, m1, c1>::seed(unsigned long long s)
+{
+  // a shift by the full width of unsigned long long would be undefined
+  const unsigned long long high = (w < 64) ? (s >> (w % 64)) : 0ull;
+
+  set_key(static_cast<result_type>(s & max), static_cast<result_type>(high & max));
+} // end philox_engine::seed()
+
+template <typename UIntType, size_t w, size_t r, UIntType m0, UIntType c0, UIntType m1, UIntType c1>
+_CCCL_HOST_DEVICE void philox_engine<UIntType, w, r, m0, c0, m1, c1>::seed(
+  unsigned long long s, unsigned long long subsequence, unsigned long long offset)
+{
+  seed(s);
+
+  // a subsequence is the range of the two upper words of the counter
+  increment_counter(m_counter, subsequence, 2);
+  generate();
+
+  discard(offset);
+} // end philox_engine::seed()
+
+template <typename UIntType, size_t w, size_t r, UIntType m0, UIntType c0, UIntType m1, UIntType c1>
+_CCCL_HOST_DEVICE void philox_engine<UIntType, w, r, m0, c0, m1, c1>::set_key(result_type k0, result_type k1)
+{
+  m_key[0] = k0;
+  m_key[1] = k1;
+
+  set_counter(0, 0, 0, 0);
+} // end philox_engine::set_key()
+
+template <typename UIntType, size_t w, size_t r, UIntType m0, UIntType c0, UIntType m1, UIntType c1>
+_CCCL_HOST_DEVICE void philox_engine<UIntType, w, r, m0, c0, m1, c1>::set_counter(
+  result_type x0, result_type x1, result_type x2, result_type x3)
+{
+  m_counter[0] = x0 & max;
+  m_counter[1] = x1 & max;
+  m_counter[2] = x2 & max;
+  m_counter[3] = x3 & max;
+  m_index      = 0;
+
+  generate();
+} // end philox_engine::set_counter()
+
+template <typename UIntType, size_t w, size_t r, UIntType m0, UIntType c0, UIntType m1, UIntType c1>
+_CCCL_HOST_DEVICE typename philox_engine<UIntType, w, r, m0, c0, m1, c1>::result_type
+philox_engine<UIntType, w, r, m0, c0, m1, c1>::operator()(void)
+{
+  // m_output always holds the block of the next value
+  const result_type result = m_output[m_index];
+
+  if (++m_index == word_count)
+  {
+    increment_counter(m_counter, 1);
+    generate();
+    m_index = 0;
+  }
+
+  return result;
+} // end philox_engine::operator()()
+
+template <typename UIntType, size_t w, size_t r, UIntType m0, UIntType c0, UIntType m1, UIntType c1>
+_CCCL_HOST_DEVICE void
+philox_engine<UIntType, w, r, m0, c0, m1, c1>::generate_block(result_type (&result)[word_count])
+{
+  for (size_t i = 0; i < word_count; ++i)
+  {
+    result[i] = (m_index + i < word_count) ? m_output[m_index + i] : result_type(0);
+  }
+
+  increment_counter(m_counter, 1);
+  generate();
+
+  // the tail of the values comes from the next block
+  for (size_t i = word_count - m_index; i < word_count; ++i)
+  {
+    result[i] = m_output[i - (word_count - m_index)];
+  }
+} // end philox_engine::generate_block()
+
+template <typename UIntType, size_t w, size_t r, UIntType m0, UIntType c0, UIntType m1, UIntType c1>
+_CCCL_HOST_DEVICE void philox_engine<UIntType, w, r, m0, c0, m1, c1>::discard(unsigned long long z)
+{
+  unsigned long long blocks = z / word_count;
+  m_index += static_cast<unsigned int>(z % word_count);
+
+  if (m_index >= word_count)
+  {
+    m_index -= word_count;
+    ++blocks;
+  }
+
+  if (blocks > 0)
+  {
+    increment_counter(m_counter, blocks);
+    generate();
+  }
+} // end philox_engine::discard()
+
+template <typename UIntType, size_t w, size_t r, UIntType m0, UIntType c0, UIntType m1, UIntType c1>
+_CCCL_HOST_DEVICE void philox_engine<UIntType, w, r, m0, c0, m1, c1>::generate_block_at(
+  unsigned long long i, result_type (&result)[word_count]) const
+{
+  result_type counter[word_count] = {m_counter[0], m_counter[1], m_counter[2], m_counter[3]};
+  increment_counter(counter, i);
+
+  if (m_index == 0)
+  {
+    block(counter, result);
+    return;
+  }
+
+  // the values straddle the blocks of two counters
+  result_type head[word_count];
+  result_type tail[word_count];
+  block(counter, head);
+  increment_counter(counter, 1);
+  block(counter, tail);
+
+  for (size_t j = 0; j < word_count; ++j)
+  {
+    result[j] = (m_index + j < word_count) ? head[m_index + j] : tail[m_index + j - word_count];
+  }
+} // end philox_engine::generate_block_at()
+
+template <typename UIntType, size_t w, size_t r, UIntType m0, UIntType c0, UIntType m1, UIntType c1>
+_CCCL_HOST_DEVICE void philox_engine<UIntType, w, r, m0, c0, m1, c1>::increment_counter(
+  result_type (&counter)[word_count], unsigned long long z, size_t first_word)
+{
+  for (size_t i = first_word; i < word_count && z > 0; ++i)
+  {
+    const result_type digit = static_cast<result_type>(z & max);
+
+    // a shift by the full width of unsigned long long would be undefined
+    z = (w < 64) ? (z >> (w % 64)) : 0ull;
+
+    counter[i] = (counter[i] + digit) & max;
+    if (counter[i] < digit)
+    {
+      ++z;
+    }
+  }
+} // end philox_engine::increment_counter()
+
+template <typename UIntType, size_t w, size_t r, UIntType m0, UIntType c0, UIntType m1, UIntType c1>
+_CCCL_HOST_DEVICE void philox_engine<UIntType, w, r, m0, c0, m1, c1>::generate()
+{
+  block(m_counter, m_output);
+} // end philox_engine::generate()
+
+template <typename UIntType, size_t w, size_t r, UIntType m0, UIntType c0, UIntType m1, UIntType c1>
+_CCCL_HOST_DEVICE void philox_engine<UIntType, w, r, m0, c0, m1, c1>::block(
+  const result_type (&counter)[word_count], result_type (&result)[word_count]) const
+{
+  typedef thrust::random::detail::philox_engine_mulhilo<result_type, w> mulhilo;
+
+  result_type x0 = counter[0];
+  result_type x1 = counter[1];
+  result_type x2 = counter[2];
+  result_type x3 = counter[3];
+  result_type k0 = m_key[0];
+  result_type k1 = m_key[1];
+
+  for (size_t round = 0; round < r; ++round)
+  {
+    if (round > 0)
+    {
+      k0 = (k0 + c0) & max;
+      k1 = (k1 + c1) & max;
+    }
+
+    result_type hi0, hi1;
+    const result_type lo0 = mulhilo::multiply(m0, x0, hi0);
+    const result_type lo1 = mulhilo::multiply(m1, x2, hi1);
+
+    x0 = hi1 ^ x1 ^ k0;
+    x1 = lo1;
+    x2 = hi0 ^ x3 ^ k1;
+    x3 = lo0;
+  }
+
+  result[0] = x0;
+  result[1] = x1;
+  result[2] = x2;
+  result[3] = x3;
+} // end philox_engine::block()
+
+template <typename UIntType, size_t w, size_t r, UIntType m0, UIntType c0, UIntType m1, UIntType c1>
+template <typename CharT, typename Traits>
+std::basic_ostream<CharT, Traits>&
+philox_engine<UIntType, w, r, m0, c0, m1, c1>::stream_out(std::basic_ostream<CharT, Traits>& os) const
+{
+  typedef std::basic_ostream<CharT, Traits> ostream_type;
+  typedef typename ostream_type::ios_base ios_base;
+
+  // save old flags & fill character
+  const typename ios_base::fmtflags flags = os.flags();
+  const CharT fill                        = os.fill();
+
+  const CharT space = os.widen(' ');
+  os.flags(ios_base::dec | ios_base::fixed | ios_base::left);
+  os.fill(space);
+
+  // output the key, the counter and the position in the block
+  for (size_t i = 0; i < key_count; ++i)
+  {
+    os << m_key[i] << space;
+  }
+  for (size_t i = 0; i < word_count; ++i)
+  {
+    os << m_counter[i] << space;
+  }
+  os << m_index;
+
+  // restore flags & fill character
+  os.flags(flags);
+  os.fill(fill);
+
+  return os;
+}
+
+template <typename UIntType, size_t w, size_t r, UIntType m0, UIntType c0, UIntType m1, UIntType c1>
+template <typename CharT, typename Traits>
+std::basic_istream<CharT, Traits>&
+philox_engine<UIntType, w, r, m0, c0, m1, c1>::stream_in(std::basic_istream<CharT, Traits>& is)
+{
+  typedef std::basic_istream<CharT, Traits> istream_type;
+  typedef typename istream_type::ios_base ios_base;
+
+  // save old flags
+  const typename ios_base::fmtflags flags = is.flags();
+
+  is.flags(ios_base::skipws);
+
+  // input the key, the counter and the position in the block
+  for (size_t i = 0; i < key_count; ++i)
+  {
+    is >> m_key[i];
+  }
+  for (size_t i = 0; i < word_count; ++i)
+  {
+    is >> m_counter[i];
+  }
+  is >> m_index;
+  m_index %= word_count;
+
+  generate();
+
+  // restore old flags
+  is.flags(flags);
+
+  return is;
+}
+
+template <typename UIntType, size_t w, size_t r, UIntType m0, UIntType c0, UIntType m1, UIntType c1>
+_CCCL_HOST_DEVICE bool
+philox_engine<UIntType, w, r, m0, c0, m1, c1>::equal(const philox_engine<UIntType, w, r, m0, c0, m1, c1>& rhs) const
+{
+  bool result = (m_index == rhs.m_index);
+
+  for (size_t i = 0; i < key_count; ++i)
+  {
+    result &= (m_key[i] == rhs.m_key[i]);
+  }
+  for (size_t i = 0; i < word_count; ++i)
+  {
+    result &= (m_counter[i] == rhs.m_counter[i]);
+  }
+
+  return result;
+}
+
+template <typename UIntType, size_t w, size_t r, UIntType m0, UIntType c0, UIntType m1, UIntType c1>
+_CCCL_HOST_DEVICE bool operator==(const philox_engine<UIntType, w, r, m0, c0, m1, c1>& lhs,
+                                  const philox_engine<UIntType, w, r, m0, c0, m1, c1>& rhs)
+{
+  return thrust::random::detail::random_core_access::equal(lhs, rhs);
+}
+
+template <typename UIntType, size_t w, size_t r, UIntType m0, UIntType c0, UIntType m1, UIntType c1>
+_CCCL_HOST_DEVICE bool operator!=(const philox_engine<UIntType, w, r, m0, c0, m1, c1>& lhs,
+                                  const philox_engine<UIntType, w, r, m0, c0, m1, c1>& rhs)
+{
+  return !(lhs == rhs);
+}
+
+template <typename UIntType,
+          size_t w,
+          size_t r,
+          UIntType m0,
+          UIntType c0,
+          UIntType m1,
+          UIntType c1,
+          typename CharT,
+          typename Traits>
+std::basic_ostream<CharT, Traits>&
+operator<<(std::basic_ostream<CharT, Traits>& os, const philox_engine<UIntType, w, r, m0, c0, m1, c1>& e)
+{
+  return thrust::random::detail::random_core_access::stream_out(os, e);
+}
+
+template <typename UIntType,
+          size_t w,
+          size_t r,
+          UIntType m0,
+          UIntType c0,
+          UIntType m1,
+          UIntType c1,
+          typename CharT,
+          typename Traits>
+std::basic_istream<CharT, Traits>&
+operator>>(std::basic_istream<CharT, Traits>& is, philox_engine<UIntType, w, r, m0, c0, m1, c1>& e)
+{
+  return thrust::random::detail::random_core_access::stream_in(is, e);
+}
+
+} // namespace random
+
+THRUST_NAMESPACE_END
@@ -0,0 +1,88 @@
+/*
+ *  Copyright 2024 NVIDIA Corporation
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+#pragma once
+
+#include <thrust/detail/config.h>
+
+#if defined(_CCCL_IMPLICIT_SYSTEM_HEADER_GCC)
+#  pragma GCC system_header
+#elif defined(_CCCL_IMPLICIT_SYSTEM_HEADER_CLANG)
+#  pragma clang system_header
+#elif defined(_CCCL_IMPLICIT_SYSTEM_HEADER_MSVC)
+#  pragma system_header
+#endif // no system header
+
+#include <thrust/detail/cstdint.h>
+
+#include <nv/target>
+
+THRUST_NAMESPACE_BEGIN
+
+namespace random
+{
+
+namespace detail
+{
+
+// the full product of two words of w bits, split into its low and high halves
+template <typename T, size_t w, bool = (w <= 32)>
+struct philox_engine_mulhilo
+{
+  _CCCL_HOST_DEVICE static T multiply(T a, T b, T& hi)
+  {
+    const thrust::detail::uint64_t product = thrust::detail::uint64_t(a) * b;
+
+    hi = static_cast<T>(product >> w);
+    return static_cast<T>(product & ((thrust::detail::uint64_t(1) << w) - 1));
+  } // end multiply()
+}; // end philox_engine_mulhilo
+
+template <typename T, size_t w>
+struct philox_engine_mulhilo<T, w, false>
+{
+  _CCCL_HOST_DEVICE static T multiply(T a, T b, T& hi)
+  {
+    typedef thrust::detail::uint64_t uint64_t;
+
+    NV_IF_TARGET(NV_IS_DEVICE,
+                 (hi = ::__umul64hi(a, b);),
+                 (const uint64_t mask = 0xffffffffu;
+
+                  // schoolbook multiplication of the 32-bit halves
+                  const uint64_t a_lo = a & mask;
+                  const uint64_t a_hi = a >> 32;
+                  const uint64_t b_lo = b & mask;
+                  const uint64_t b_hi = b >> 32;
+
+                  const uint64_t lo_lo = a_lo * b_lo;
+                  const uint64_t hi_lo = a_hi * b_lo;
+                  const uint64_t lo_hi = a_lo * b_hi;
+                  const uint64_t hi_hi = a_hi * b_hi;
+
+                  const uint64_t middle = (lo_lo >> 32) + (hi_lo & mask) + lo_hi;
+
+                  hi = static_cast<T>(hi_hi + (hi_lo >> 32) + (middle >> 32));));
+
+    return a * b;
+  } // end multiply()
+}; // end philox_engine_mulhilo
+
+} // namespace detail
+
+} // namespace random
+
+THRUST_NAMESPACE_END
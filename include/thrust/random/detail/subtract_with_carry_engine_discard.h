@@ -0,0 +1,314 @@
+/*
+ *  Copyright 2024 NVIDIA Corporation
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+#pragma once
+
+#include <thrust/detail/config.h>
+
+#if defined(_CCCL_IMPLICIT_SYSTEM_HEADER_GCC)
+#  pragma GCC system_header
+#elif defined(_CCCL_IMPLICIT_SYSTEM_HEADER_CLANG)
+#  pragma clang system_header
+#elif defined(_CCCL_IMPLICIT_SYSTEM_HEADER_MSVC)
+#  pragma system_header
+#endif // no system header
+
+#include <thrust/detail/cstdint.h>
+
+#include <cstddef> // for size_t
+
+THRUST_NAMESPACE_BEGIN
+
+namespace random
+{
+
+namespace detail
+{
+
+// the widest digit, no wider than 32 bits, which evenly divides a word of w bits
+template <size_t w, size_t h = (w < 32 ? w : 32), bool = (w % h == 0)>
+struct subtract_with_carry_digit_bits
+{
+  static const size_t value = subtract_with_carry_digit_bits<w, h - 1>::value;
+};
+
+template <size_t w, size_t h>
+struct subtract_with_carry_digit_bits<w, h, true>
+{
+  static const size_t value = h;
+};
+
+// A subtract-with-borrow generator x(n) = x(n-s) - x(n-r) - carry mod b, b = 2^w,
+// is a linear congruential generator with modulus m = b^r - b^s + 1 and
+// multiplier b^-1 in disguise (Marsaglia & Zaman 1991, Tezuka et al. 1993):
+// the outputs x(n-r), x(n-r+1), ... are the base b digits of the b-adic
+// expansion of -P/m, where
+//
+//   P = b^s * (x(n-r) + ... + x(n-s-1) b^(r-s-1)) + b^r * carry - (x(n-r) + ... + x(n-1) b^(r-1))
+//
+// and every step maps P to P * b^-1 mod m. Discarding z values thus takes a
+// modular exponentiation of numbers of w*r bits, which are stored as digits of
+// h bits, least significant first.
+template <typename UIntType, size_t w, size_t s, size_t r>
+struct subtract_with_carry_engine_jump
+{
+  typedef thrust::detail::uint32_t digit_type;
+  typedef thrust::detail::uint64_t wide_type;
+
+  static const size_t digit_bits      = subtract_with_carry_digit_bits<w>::value;
+  static const size_t digits_per_word = w / digit_bits;
+  static const size_t n               = r * digits_per_word;
+  static const size_t n_short         = s * digits_per_word;
+
+  static const wide_type digit_mask = (wide_type(1) << digit_bits) - 1;
+
+  // states which are not on the cycle of the equivalent generator leave
+  // the transient part after at most this many steps
+  static const size_t transient_length = r + 1;
+
+  // below this many steps, stepping is cheaper than the exponentiation
+  static const unsigned long long min_jump = 4096;
+
+  _CCCL_HOST_DEVICE static digit_type get_digit(const UIntType* x, unsigned int k, size_t i)
+  {
+    const UIntType word = x[(k + i / digits_per_word) % r];
+    return static_cast<digit_type>((word >> (digit_bits * (i % digits_per_word))) & digit_mask);
+  }
+
+  _CCCL_HOST_DEVICE static void set_modulus(digit_type* x)
+  {
+    for (size_t i = 0; i < n; ++i)
+    {
+      x[i] = i < n_short ? digit_type(0) : static_cast<digit_type>(digit_mask);
+    }
+    x[0] += 1;
+  }
+
+  // x[first, n) += y[0, n - first), discarding the final carry
+  _CCCL_HOST_DEVICE static void add(digit_type* x, const digit_type* y, size_t first, size_t len)
+  {
+    wide_type carry = 0;
+    for (size_t i = first; i < len; ++i)
+    {
+      const wide_type t = wide_type(x[i]) + (i - first < n ? y[i - first] : 0) + carry;
+      x[i]              = static_cast<digit_type>(t & digit_mask);
+      carry             = t >> digit_bits;
+    }
+  }
+
+  // x[0, len) -= y[0, n), discarding the final borrow
+  _CCCL_HOST_DEVICE static void subtract(digit_type* x, const digit_type* y, size_t len)
+  {
+    wide_type borrow = 0;
+    for (size_t i = 0; i < len; ++i)
+    {
+      const wide_type t = wide_type(x[i]) - (i < n ? y[i] : 0) - borrow;
+      x[i]              = static_cast<digit_type>(t & digit_mask);
+      borrow            = (t >> digit_bits) != 0;
+    }
+  }
+
+  _CCCL_HOST_DEVICE static bool less(const digit_type* x, const digit_type* y)
+  {
+    for (size_t i = n; i > 0; --i)
+    {
+      if (x[i - 1] != y[i - 1])
+      {
+        return x[i - 1] < y[i - 1];
+      }
+    }
+    return false;
+  }
+
+  // result = x * y mod m, for x, y < m
+  _CCCL_HOST_DEVICE static void multiply(const digit_type* x, const digit_type* y, digit_type* result)
+  {
+    digit_type t[2 * n];
+    for (size_t i = 0; i < 2 * n; ++i)
+    {
+      t[i] = 0;
+    }
+
+    for (size_t i = 0; i < n; ++i)
+    {
+      wide_type carry = 0;
+      for (size_t j = 0; j < n; ++j)
+      {
+        const wide_type p = wide_type(x[i]) * y[j] + t[i + j] + carry;
+        t[i + j]          = static_cast<digit_type>(p & digit_mask);
+        carry             = p >> digit_bits;
+      }
+      t[i + n] = static_cast<digit_type>(carry);
+    }
+
+    // fold the digits above b^r back in with b^r = b^s - 1 mod m, until none are left
+    for (;;)
+    {
+      digit_type hi[n];
+      bool folded = false;
+      for (size_t i = 0; i < n; ++i)
+      {
+        hi[i]    = t[n + i];
+        t[n + i] = 0;
+        folded |= (hi[i] != 0);
+      }
+
+      if (!folded)
+      {
+        break;
+      }
+
+      add(t, hi, n_short, 2 * n);
+      subtract(t, hi, 2 * n);
+    }
+
+    digit_type modulus[n];
+    set_modulus(modulus);
+    if (!less(t, modulus))
+    {
+      subtract(t, modulus, n);
+    }
+
+    for (size_t i = 0; i < n; ++i)
+    {
+      result[i] = t[i];
+    }
+  }
+
+  template <typename Engine>
+  _CCCL_HOST_DEVICE static void
+  discard(Engine& e, UIntType* x, unsigned int& k, int& carry_out, unsigned long long z)
+  {
+    if (z < min_jump)
+    {
+      for (; z > 0; --z)
+      {
+        e();
+      }
+      return;
+    }
+
+    // the jump is only valid on the cycle
+    for (size_t i = 0; i < transient_length; ++i)
+    {
+      e();
+    }
+    z -= transient_length;
+
+    // compute P from the window and the carry
+    digit_type p[n + 1];
+    for (size_t i = 0; i <= n; ++i)
+    {
+      p[i] = (i >= n_short && i < n) ? get_digit(x, k, i - n_short) : digit_type(0);
+    }
+    p[n] = static_cast<digit_type>(carry_out);
+
+    digit_type window[n];
+    for (size_t i = 0; i < n; ++i)
+    {
+      window[i] = get_digit(x, k, i);
+    }
+    subtract(p, window, n + 1);
+
+    // P == m is the fixed point with every digit equal to b - 1
+    digit_type modulus[n];
+    set_modulus(modulus);
+    if (!less(p, modulus))
+    {
+      return;
+    }
+
+    // P * (b^-1)^z, with b^-1 = m + b^(s-1) - b^(r-1) mod m
+    digit_type inverse[n];
+    set_modulus(inverse);
+    inverse[(s - 1) * digits_per_word] += 1;
+    digit_type power[n];
+    for (size_t i = 0; i < n; ++i)
+    {
+      power[i] = (i == (r - 1) * digits_per_word) ? digit_type(1) : digit_type(0);
+    }
+    subtract(inverse, power, n);
+
+    while (z > 0)
+    {
+      if (z & 1)
+      {
+        multiply(p, inverse, p);
+      }
+
+      z >>= 1;
+      if (z > 0)
+      {
+        multiply(inverse, inverse, inverse);
+      }
+    }
+
+    // the new window holds the lowest r digits of -P/m: W = -P * (1 + b^s + b^2s + ...) mod b^r
+    digit_type negated[n];
+    for (size_t i = 0; i < n; ++i)
+    {
+      negated[i] = 0;
+    }
+    subtract(negated, p, n);
+
+    wide_type carry = 0;
+    for (size_t i = 0; i < n; ++i)
+    {
+      const wide_type t = wide_type(negated[i]) + (i >= n_short ? window[i - n_short] : 0) + carry;
+      window[i]         = static_cast<digit_type>(t & digit_mask);
+      carry             = t >> digit_bits;
+    }
+
+    // and the carry is whatever P + W leaves above b^r
+    carry = 0;
+    for (size_t i = 0; i < n; ++i)
+    {
+      carry = (wide_type(p[i]) + window[i] + carry) >> digit_bits;
+    }
+
+    for (size_t i = 0; i < r; ++i)
+    {
+      UIntType word = 0;
+      for (size_t j = 0; j < digits_per_word; ++j)
+      {
+        word |= static_cast<UIntType>(window[i * digits_per_word + j]) << (digit_bits * j);
+      }
+      x[i] = word;
+    }
+    k         = 0;
+    carry_out = static_cast<int>(carry);
+  }
+}; // end subtract_with_carry_engine_jump
+
+struct subtract_with_carry_engine_discard
+{
+  template <typename SubtractWithCarryEngine>
+  _CCCL_HOST_DEVICE static void discard(SubtractWithCarryEngine& e, unsigned long long z)
+  {
+    typedef typename SubtractWithCarryEngine::result_type result_type;
+
+    subtract_with_carry_engine_jump<result_type,
+                                    SubtractWithCarryEngine::word_size,
+                                    SubtractWithCarryEngine::short_lag,
+                                    SubtractWithCarryEngine::long_lag>::discard(e, e.m_x, e.m_k, e.m_carry, z);
+  }
+}; // end subtract_with_carry_engine_discard
+
+} // namespace detail
+
+} // namespace random
+
+THRUST_NAMESPACE_END
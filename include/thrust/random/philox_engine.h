@@ -0,0 +1,423 @@
+/*
+ *  Copyright 2024 NVIDIA Corporation
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+/*! \file philox_engine.h
+ *  \brief A counter-based pseudorandom number engine
+ *         based on the Philox block function.
+ */
+
+#pragma once
+
+#include <thrust/detail/config.h>
+
+#if defined(_CCCL_IMPLICIT_SYSTEM_HEADER_GCC)
+#  pragma GCC system_header
+#elif defined(_CCCL_IMPLICIT_SYSTEM_HEADER_CLANG)
+#  pragma clang system_header
+#elif defined(_CCCL_IMPLICIT_SYSTEM_HEADER_MSVC)
+#  pragma system_header
+#endif // no system header
+#include <thrust/detail/cstdint.h>
+#include <thrust/random/detail/random_core_access.h>
+
+#include <cstddef> // for size_t
+#include <iostream>
+
+THRUST_NAMESPACE_BEGIN
+
+namespace random
+{
+
+/*! \addtogroup random_number_engine_templates
+ *  \{
+ */
+
+/*! \class philox_engine
+ *  \brief A \p philox_engine random number engine produces unsigned integer random numbers
+ *         by encrypting a counter with the Philox block function of Salmon et al. (2011).
+ *
+ *         The state of a \p philox_engine consists of a key of two words, a counter of four words
+ *         and the position in the current block of four random values, which is the Philox
+ *         function of the key and the counter. Since each block is computed from the counter
+ *         alone, \p discard takes constant time, and any number of engines which differ only in
+ *         their counters may generate independent parts of a sequence in parallel.
+ *
+ *  \tparam UIntType The type of unsigned integer to produce.
+ *  \tparam w The word size of the produced values, either \c 32 or \c 64.
+ *  \tparam r The number of rounds of the block function.
+ *  \tparam m0 The multiplier applied to the first word of the counter in every round.
+ *  \tparam c0 The increment of the first word of the key between rounds.
+ *  \tparam m1 The multiplier applied to the third word of the counter in every round.
+ *  \tparam c1 The increment of the second word of the key between rounds.
+ *
+ *  \note Inexperienced users should not use this class template directly.  Instead, use
+ *  \p philox4x32_10 or \p philox4x64_10.
+ *
+ *  To fill a range in parallel, use \p philox_block_generator, which computes one block, and
+ *  so writes \p word_count values, per call; see its documentation for an example.
+ *
+ *  \see thrust::random::philox4x32_10
+ *  \see thrust::random::philox4x64_10
+ */
+template <typename UIntType, size_t w, size_t r, UIntType m0, UIntType c0, UIntType m1, UIntType c1>
+class philox_engine
+{
+public:
+  // types
+
+  /*! \typedef result_type
+   *  \brief The type of the unsigned integer produced by this \p philox_engine.
+   */
+  typedef UIntType result_type;
+
+  // engine characteristics
+
+  /*! The word size of the produced values.
+   */
+  static const size_t word_size = w;
+
+  /*! The number of words in the counter, which is the number of values in a block.
+   */
+  static const size_t word_count = 4;
+
+  /*! The number of words in the key.
+   */
+  static const size_t key_count = 2;
+
+  /*! The number of rounds of the block function.
+   */
+  static const size_t round_count = r;
+
+  /*! The smallest value this \p philox_engine may potentially produce.
+   */
+  static const result_type min = 0;
+
+  /*! The largest value this \p philox_engine may potentially produce.
+   */
+  static const result_type max = ~result_type(0) >> (8 * sizeof(result_type) - w);
+
+  /*! The default seed of this \p philox_engine.
+   */
+  static const result_type default_seed = 20111115u;
+
+  // constructors and seeding functions
+
+  /*! This constructor, which optionally accepts a seed, initializes a new
+   *  \p philox_engine.
+   *
+   *  \param s The seed used to intialize this \p philox_engine's key. The lower \p w bits
+   *         of \p s become the first word of the key and the following \p w bits the second.
+   *         The counter starts at zero.
+   */
+  _CCCL_HOST_DEVICE explicit philox_engine(unsigned long long s = default_seed);
+
+  /*! This constructor initializes a new \p philox_engine in the same state as
+   *  cuRAND's \p curand_init does for a \p curandStatePhilox4_32_10_t.
+   *
+   *  \param s The seed used to intialize this \p philox_engine's key.
+   *  \param subsequence The subsequence to start at. Every subsequence is
+   *         <tt>word_count * 2^(2w)</tt> values long.
+   *  \param offset The number of values of the subsequence to skip.
+   */
+  _CCCL_HOST_DEVICE philox_engine(unsigned long long s, unsigned long long subsequence, unsigned long long offset = 0);
+
+  /*! This method initializes this \p philox_engine's key from a seed, and resets its counter.
+   *
+   *  \param s The seed used to initialize this \p philox_engine's key.
+   */
+  _CCCL_HOST_DEVICE void seed(unsigned long long s = default_seed);
+
+  /*! This method initializes this \p philox_engine's state like cuRAND's \p curand_init.
+   *
+   *  \param s The seed used to initialize this \p philox_engine's key.
+   *  \param subsequence The subsequence to start at.
+   *  \param offset The number of values of the subsequence to skip.
+   */
+  _CCCL_HOST_DEVICE void seed(unsigned long long s, unsigned long long subsequence, unsigned long long offset = 0);
+
+  /*! This method sets this \p philox_engine's key, and resets its counter.
+   *
+   *  \param k0 The first word of the key.
+   *  \param k1 The second word of the key.
+   */
+  _CCCL_HOST_DEVICE void set_key(result_type k0, result_type k1);
+
+  /*! This method sets this \p philox_engine's counter. The next value produced is the first
+   *  one of the block of this counter.
+   *
+   *  \param x0 The first, least significant, word of the counter.
+   *  \param x1 The second word of the counter.
+   *  \param x2 The third word of the counter.
+   *  \param x3 The fourth, most significant, word of the counter.
+   */
+  _CCCL_HOST_DEVICE void set_counter(result_type x0, result_type x1, result_type x2, result_type x3);
+
+  // generating functions
+
+  /*! This member function produces a new random value and updates this \p philox_engine's state.
+   *  \return A new random number.
+   */
+  _CCCL_HOST_DEVICE result_type operator()(void);
+
+  /*! This member function produces \p word_count new random values at once, the same ones
+   *  as \p word_count calls to <tt>operator()</tt> would, and updates this \p philox_engine's
+   *  state accordingly.
+   *
+   *  \param result The array to store the new random numbers in.
+   */
+  _CCCL_HOST_DEVICE void generate_block(result_type (&result)[word_count]);
+
+  /*! This member function produces the \p word_count random values which \p generate_block
+   *  would produce after \p i earlier calls, without changing this \p philox_engine's state.
+   *  It computes a single block when the engine is at the start of one, as after seeding.
+   *
+   *  \param i The number of blocks to skip.
+   *  \param result The array to store the random numbers in.
+   */
+  _CCCL_HOST_DEVICE void generate_block_at(unsigned long long i, result_type (&result)[word_count]) const;
+
+  /*! This member function advances this \p philox_engine's state a given number of times
+   *  and discards the results.
+   *
+   *  \param z The number of random values to discard.
+   *  \note This function takes constant time.
+   */
+  _CCCL_HOST_DEVICE void discard(unsigned long long z);
+
+  /*! \cond
+   */
+
+private:
+  result_type m_key[key_count];
+  result_type m_counter[word_count];
+  result_type m_output[word_count];
+  unsigned int m_index;
+
+  // adds z to a counter, with carries across all of its words
+  _CCCL_HOST_DEVICE static void
+  increment_counter(result_type (&counter)[word_count], unsigned long long z, size_t first_word = 0);
+
+  // computes the block of the current counter
+  _CCCL_HOST_DEVICE void generate();
+
+  // computes the block of a counter
+  _CCCL_HOST_DEVICE void block(const result_type (&counter)[word_count], result_type (&result)[word_count]) const;
+
+  friend struct thrust::random::detail::random_core_access;
+
+  _CCCL_HOST_DEVICE bool equal(const philox_engine& rhs) const;
+
+  template <typename CharT, typename Traits>
+  std::basic_ostream<CharT, Traits>& stream_out(std::basic_ostream<CharT, Traits>& os) const;
+
+  template <typename CharT, typename Traits>
+  std::basic_istream<CharT, Traits>& stream_in(std::basic_istream<CharT, Traits>& is);
+
+  /*! \endcond
+   */
+}; // end philox_engine
+
+/*! \class philox_block_generator
+ *  \brief A function object which fills a range with the values of a \p philox_engine, one
+ *         block of \p word_count values per call, which makes it the way to fill large ranges:
+ *         every Philox block computed contributes all of its values.
+ *
+ *         Call \c i writes the values at positions <tt>[word_count * i, word_count * i + word_count)</tt>
+ *         of the range, which are those the engine would return in that order, so applying it to
+ *         the block indices <tt>[0, ceil(n / word_count))</tt> in any order, or in parallel, fills
+ *         the first \c n elements.
+ *
+ *  \tparam Engine The type of \p philox_engine.
+ *  \tparam RandomAccessIterator The type of iterator to the range to fill.
+ *
+ *  The following code snippet shows how to fill a vector in parallel with the values of
+ *  \p philox4x32_10:
+ *
+ *  \code
+ *  #include <thrust/for_each.h>
+ *  #include <thrust/host_vector.h>
+ *  #include <thrust/iterator/counting_iterator.h>
+ *  #include <thrust/random/philox_engine.h>
+ *  #include <thrust/system/omp/execution_policy.h>
+ *
+ *  int main()
+ *  {
+ *    const unsigned long long n = 1 << 20;
+ *    thrust::host_vector<unsigned int> v(n);
+ *
+ *    // v[i] is the i-th value returned by thrust::philox4x32_10(13)
+ *    thrust::for_each_n(thrust::omp::par,
+ *                       thrust::counting_iterator<unsigned long long>(0),
+ *                       (n + 3) / 4,
+ *                       thrust::random::make_philox_block_generator(thrust::philox4x32_10(13), v.begin(), n));
+ *
+ *    return 0;
+ *  }
+ *  \endcode
+ */
+template <typename Engine, typename RandomAccessIterator>
+struct philox_block_generator
+{
+  /*! The engine whose values fill the range. It is not modified.
+   */
+  Engine engine;
+
+  /*! The beginning of the range to fill.
+   */
+  RandomAccessIterator result;
+
+  /*! The size of the range to fill.
+   */
+  unsigned long long n;
+
+  /*! This constructor creates a \p philox_block_generator.
+   *
+   *  \param engine The engine whose values fill the range.
+   *  \param result The beginning of the range to fill.
+   *  \param n The size of the range to fill.
+   */
+  _CCCL_HOST_DEVICE philox_block_generator(const Engine& engine, RandomAccessIterator result, unsigned long long n)
+      : engine(engine)
+      , result(result)
+      , n(n)
+  {}
+
+  /*! This operator writes the block of values at index \p i to the range.
+   *
+   *  \param i The index of the block to write.
+   */
+  _CCCL_HOST_DEVICE void operator()(unsigned long long i) const
+  {
+    typename Engine::result_type values[Engine::word_count];
+    engine.generate_block_at(i, values);
+
+    const unsigned long long first = i * Engine::word_count;
+    RandomAccessIterator out       = result + first;
+
+    for (size_t j = 0; j < Engine::word_count && first + j < n; ++j)
+    {
+      out[j] = values[j];
+    }
+  }
+}; // end philox_block_generator
+
+/*! This function creates a \p philox_block_generator.
+ *
+ *  \param engine The engine whose values fill the range.
+ *  \param result The beginning of the range to fill.
+ *  \param n The size of the range to fill.
+ *  \return A \p philox_block_generator which fills <tt>[result, result + n)</tt>.
+ */
+template <typename Engine, typename RandomAccessIterator>
+_CCCL_HOST_DEVICE philox_block_generator<Engine, RandomAccessIterator>
+make_philox_block_generator(const Engine& engine, RandomAccessIterator result, unsigned long long n)
+{
+  return philox_block_generator<Engine, RandomAccessIterator>(engine, result, n);
+}
+
+/*! This function checks two \p philox_engines for equality.
+ *  \param lhs The first \p philox_engine to test.
+ *  \param rhs The second \p philox_engine to test.
+ *  \return \c true if \p lhs is equal to \p rhs; \c false, otherwise.
+ */
+template <typename UIntType_, size_t w_, size_t r_, UIntType_ m0_, UIntType_ c0_, UIntType_ m1_, UIntType_ c1_>
+_CCCL_HOST_DEVICE bool operator==(const philox_engine<UIntType_, w_, r_, m0_, c0_, m1_, c1_>& lhs,
+                                  const philox_engine<UIntType_, w_, r_, m0_, c0_, m1_, c1_>& rhs);
+
+/*! This function checks two \p philox_engines for inequality.
+ *  \param lhs The first \p philox_engine to test.
+ *  \param rhs The second \p philox_engine to test.
+ *  \return \c true if \p lhs is not equal to \p rhs; \c false, otherwise.
+ */
+template <typename UIntType_, size_t w_, size_t r_, UIntType_ m0_, UIntType_ c0_, UIntType_ m1_, UIntType_ c1_>
+_CCCL_HOST_DEVICE bool operator!=(const philox_engine<UIntType_, w_, r_, m0_, c0_, m1_, c1_>& lhs,
+                                  const philox_engine<UIntType_, w_, r_, m0_, c0_, m1_, c1_>& rhs);
+
+/*! This function streams a philox_engine to a \p std::basic_ostream.
+ *  \param os The \p basic_ostream to stream out to.
+ *  \param e The \p philox_engine to stream out.
+ *  \return \p os
+ */
+template <typename UIntType_,
+          size_t w_,
+          size_t r_,
+          UIntType_ m0_,
+          UIntType_ c0_,
+          UIntType_ m1_,
+          UIntType_ c1_,
+          typename CharT,
+          typename Traits>
+std::basic_ostream<CharT, Traits>&
+operator<<(std::basic_ostream<CharT, Traits>& os, const philox_engine<UIntType_, w_, r_, m0_, c0_, m1_, c1_>& e);
+
+/*! This function streams a philox_engine in from a std::basic_istream.
+ *  \param is The \p basic_istream to stream from.
+ *  \param e The \p philox_engine to stream in.
+ *  \return \p is
+ */
+template <typename UIntType_,
+          size_t w_,
+          size_t r_,
+          UIntType_ m0_,
+          UIntType_ c0_,
+          UIntType_ m1_,
+          UIntType_ c1_,
+          typename CharT,
+          typename Traits>
+std::basic_istream<CharT, Traits>&
+operator>>(std::basic_istream<CharT, Traits>& is, philox_engine<UIntType_, w_, r_, m0_, c0_, m1_, c1_>& e);
+
+/*! \} // random_number_engine_templates
+ */
+
+/*! \addtogroup predefined_random
+ *  \{
+ */
+
+/*! \typedef philox4x32_10
+ *  \brief A random number engine with predefined parameters which implements the
+ *         Philox-4x32-10 generator. For the same seed, subsequence and offset it produces
+ *         the same values as cuRAND's \p curandStatePhilox4_32_10_t.
+ */
+typedef philox_engine<thrust::detail::uint32_t, 32, 10, 0xD2511F53u, 0x9E3779B9u, 0xCD9E8D57u, 0xBB67AE85u>
+  philox4x32_10;
+
+/*! \typedef philox4x64_10
+ *  \brief A random number engine with predefined parameters which implements the
+ *         Philox-4x64-10 generator.
+ */
+typedef philox_engine<thrust::detail::uint64_t,
+                      64,
+                      10,
+                      0xD2E7470EE14C6C93ull,
+                      0x9E3779B97F4A7C15ull,
+                      0xCA5A826395121157ull,
+                      0xBB67AE8584CAA73Bull>
+  philox4x64_10;
+
+/*! \} // predefined_random
+ */
+
+} // namespace random
+
+// import names into thrust::
+using random::philox4x32_10;
+using random::philox4x64_10;
+using random::philox_engine;
+
+THRUST_NAMESPACE_END
+
+#include <thrust/random/detail/philox_engine.inl>
@@ -33,6 +33,7 @@
 
 #include <thrust/detail/cstdint.h>
 #include <thrust/random/detail/random_core_access.h>
+#include <thrust/random/detail/subtract_with_carry_engine_discard.h>
 
 #include <cstddef> // for size_t
 #include <iostream>
@@ -156,6 +157,8 @@ private:
 
   friend struct thrust::random::detail::random_core_access;
 
+  friend struct thrust::random::detail::subtract_with_carry_engine_discard;
+
   _CCCL_HOST_DEVICE bool equal(const subtract_with_carry_engine& rhs) const;
 
   template <typename CharT, typename Traits>
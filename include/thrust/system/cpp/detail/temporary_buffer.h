@@ -26,4 +26,77 @@
 #  pragma system_header
 #endif // no system header
 
-// this system has no special temporary buffer functions
+#include <thrust/detail/pointer.h>
+#include <thrust/detail/raw_pointer_cast.h>
+#include <thrust/mr/scratch_arena.h>
+#include <thrust/pair.h>
+#include <thrust/system/cpp/detail/execution_policy.h>
+
+#include <cstddef>
+#include <new>
+
+// Unless THRUST_HOST_SCRATCH_ARENA is 0, the temporary buffers of the host systems, which all derive their execution
+// policies from that of this system, come from the scratch arena of the calling thread rather than from malloc.
+#ifndef THRUST_HOST_SCRATCH_ARENA
+#  define THRUST_HOST_SCRATCH_ARENA 1
+#endif // THRUST_HOST_SCRATCH_ARENA
+
+#if THRUST_HOST_SCRATCH_ARENA
+
+THRUST_NAMESPACE_BEGIN
+namespace system
+{
+namespace cpp
+{
+namespace detail
+{
+
+template <typename T>
+struct scratch_alignment
+{
+  static const std::size_t value =
+    alignof(T) > THRUST_MR_DEFAULT_ALIGNMENT ? alignof(T) : static_cast<std::size_t>(THRUST_MR_DEFAULT_ALIGNMENT);
+};
+
+template <typename T, typename DerivedPolicy>
+_CCCL_HOST
+thrust::pair<thrust::pointer<T, DerivedPolicy>, typename thrust::pointer<T, DerivedPolicy>::difference_type>
+get_temporary_buffer(execution_policy<DerivedPolicy>&, typename thrust::pointer<T, DerivedPolicy>::difference_type n)
+{
+  thrust::pointer<T, DerivedPolicy> ptr;
+
+  try
+  {
+    void* p = thrust::mr::get_thread_scratch_arena().do_allocate(n * sizeof(T), scratch_alignment<T>::value);
+
+    ptr = thrust::pointer<T, DerivedPolicy>(static_cast<T*>(p));
+  }
+  catch (const std::bad_alloc&)
+  {
+    n = 0;
+  }
+
+  return thrust::make_pair(ptr, n);
+} // end get_temporary_buffer()
+
+// the buffer must be returned by the thread which got it
+template <typename DerivedPolicy, typename Pointer>
+_CCCL_HOST void return_temporary_buffer(execution_policy<DerivedPolicy>&, Pointer p, std::ptrdiff_t n)
+{
+  typedef typename thrust::detail::pointer_traits<Pointer>::element_type T;
+
+  if (thrust::raw_pointer_cast(p) == nullptr)
+  {
+    return;
+  }
+
+  thrust::mr::get_thread_scratch_arena().do_deallocate(
+    thrust::raw_pointer_cast(p), n * sizeof(T), scratch_alignment<T>::value);
+} // end return_temporary_buffer()
+
+} // namespace detail
+} // namespace cpp
+} // namespace system
+THRUST_NAMESPACE_END
+
+#endif // THRUST_HOST_SCRATCH_ARENA
@@ -0,0 +1,198 @@
+/*
+ *  Copyright 2024 NVIDIA Corporation
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+/*! \file merge_path.h
+ *  \brief Co-ranking of two sorted ranges, used to split merge-like
+ *         algorithms and set operations into independent pieces of
+ *         equal size.
+ */
+
+#pragma once
+
+#include <thrust/detail/config.h>
+
+#if defined(_CCCL_IMPLICIT_SYSTEM_HEADER_GCC)
+#  pragma GCC system_header
+#elif defined(_CCCL_IMPLICIT_SYSTEM_HEADER_CLANG)
+#  pragma clang system_header
+#elif defined(_CCCL_IMPLICIT_SYSTEM_HEADER_MSVC)
+#  pragma system_header
+#endif // no system header
+
+#include <thrust/detail/function.h>
+#include <thrust/pair.h>
+
+THRUST_NAMESPACE_BEGIN
+namespace system
+{
+namespace detail
+{
+namespace internal
+{
+
+// Returns the number of elements of [first1, first1 + n1) which precede
+// position `diag` in the stable merge of [first1, first1 + n1) and
+// [first2, first2 + n2). The remaining `diag - result` elements come from
+// the second range. Elements of the first range win ties, so splitting a
+// merge at any set of diagonals and merging the pieces independently
+// reproduces the output of a sequential stable merge.
+_CCCL_EXEC_CHECK_DISABLE
+template <typename RandomAccessIterator1, typename RandomAccessIterator2, typename Size, typename StrictWeakOrdering>
+_CCCL_HOST_DEVICE Size merge_path(
+  RandomAccessIterator1 first1,
+  Size n1,
+  RandomAccessIterator2 first2,
+  Size n2,
+  Size diag,
+  StrictWeakOrdering comp)
+{
+  thrust::detail::wrapped_function<StrictWeakOrdering, bool> wrapped_comp(comp);
+
+  Size lo = diag > n2 ? diag - n2 : Size(0);
+  Size hi = diag < n1 ? diag : n1;
+
+  while (lo < hi)
+  {
+    Size mid = lo + (hi - lo) / 2;
+
+    if (wrapped_comp(first2[diag - 1 - mid], first1[mid]))
+    {
+      hi = mid;
+    }
+    else
+    {
+      lo = mid + 1;
+    }
+  }
+
+  return lo;
+}
+
+// Returns the number of elements of [first, first + n) ordered before *value.
+_CCCL_EXEC_CHECK_DISABLE
+template <typename RandomAccessIterator1, typename RandomAccessIterator2, typename Size, typename StrictWeakOrdering>
+_CCCL_HOST_DEVICE Size
+lower_bound_n(RandomAccessIterator1 first, Size n, RandomAccessIterator2 value, StrictWeakOrdering comp)
+{
+  thrust::detail::wrapped_function<StrictWeakOrdering, bool> wrapped_comp(comp);
+
+  Size lo = 0;
+  Size hi = n;
+
+  while (lo < hi)
+  {
+    Size mid = lo + (hi - lo) / 2;
+
+    if (wrapped_comp(first[mid], *value))
+    {
+      lo = mid + 1;
+    }
+    else
+    {
+      hi = mid;
+    }
+  }
+
+  return lo;
+}
+
+// Returns the number of elements of [first, first + n) not ordered after *value.
+_CCCL_EXEC_CHECK_DISABLE
+template <typename RandomAccessIterator1, typename RandomAccessIterator2, typename Size, typename StrictWeakOrdering>
+_CCCL_HOST_DEVICE Size
+upper_bound_n(RandomAccessIterator1 first, Size n, RandomAccessIterator2 value, StrictWeakOrdering comp)
+{
+  thrust::detail::wrapped_function<StrictWeakOrdering, bool> wrapped_comp(comp);
+
+  Size lo = 0;
+  Size hi = n;
+
+  while (lo < hi)
+  {
+    Size mid = lo + (hi - lo) / 2;
+
+    if (wrapped_comp(*value, first[mid]))
+    {
+      hi = mid;
+    }
+    else
+    {
+      lo = mid + 1;
+    }
+  }
+
+  return lo;
+}
+
+// Splits [first1, first1 + n1) and [first2, first2 + n2) near position
+// `diag` of their merge, such that a set operation may be computed
+// independently on each side of the split. Elements of different values are
+// split as in the merge. A run of equivalent elements is split by rank: the
+// k-th elements of the run in both ranges, which a set operation pairs up,
+// land on the same side, so runs of duplicates are divided among partitions
+// like any other elements. Returns the split of each range.
+_CCCL_EXEC_CHECK_DISABLE
+template <typename RandomAccessIterator1, typename RandomAccessIterator2, typename Size, typename StrictWeakOrdering>
+_CCCL_HOST_DEVICE thrust::pair<Size, Size> set_partition(
+  RandomAccessIterator1 first1,
+  Size n1,
+  RandomAccessIterator2 first2,
+  Size n2,
+  Size diag,
+  StrictWeakOrdering comp)
+{
+  thrust::detail::wrapped_function<StrictWeakOrdering, bool> wrapped_comp(comp);
+
+  const Size i = merge_path(first1, n1, first2, n2, diag, comp);
+  const Size j = diag - i;
+
+  // the run of the element which comes next in the merge
+  Size begin1, end1, begin2, end2;
+
+  if (i < n1 && (j >= n2 || !wrapped_comp(first2[j], first1[i])))
+  {
+    begin1 = lower_bound_n(first1, n1, first1 + i, comp);
+    end1   = upper_bound_n(first1, n1, first1 + i, comp);
+    begin2 = lower_bound_n(first2, n2, first1 + i, comp);
+    end2   = upper_bound_n(first2, n2, first1 + i, comp);
+  }
+  else if (j < n2)
+  {
+    begin1 = lower_bound_n(first1, n1, first2 + j, comp);
+    end1   = upper_bound_n(first1, n1, first2 + j, comp);
+    begin2 = lower_bound_n(first2, n2, first2 + j, comp);
+    end2   = upper_bound_n(first2, n2, first2 + j, comp);
+  }
+  else
+  {
+    return thrust::make_pair(n1, n2);
+  }
+
+  // take the first k elements of the run from both ranges, where k is chosen
+  // so that about `diag` elements precede the split
+  const Size count1 = end1 - begin1;
+  const Size count2 = end2 - begin2;
+  const Size shared = count1 < count2 ? count1 : count2;
+  const Size rank   = diag - begin1 - begin2;
+  const Size k      = rank <= 2 * shared ? (rank + 1) / 2 : rank - shared;
+
+  return thrust::make_pair(begin1 + (k < count1 ? k : count1), begin2 + (k < count2 ? k : count2));
+}
+
+} // end namespace internal
+} // end namespace detail
+} // end namespace system
+THRUST_NAMESPACE_END
@@ -0,0 +1,236 @@
+/*
+ *  Copyright 2024 NVIDIA Corporation
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+/*! \file parallel_binary_search.h
+ *  \brief Building blocks of the vectorized lower_bound, upper_bound and
+ *         binary_search of the host backends, which search a range of
+ *         queries in independent pieces.
+ */
+
+#pragma once
+
+#include <thrust/detail/config.h>
+
+#if defined(_CCCL_IMPLICIT_SYSTEM_HEADER_GCC)
+#  pragma GCC system_header
+#elif defined(_CCCL_IMPLICIT_SYSTEM_HEADER_CLANG)
+#  pragma clang system_header
+#elif defined(_CCCL_IMPLICIT_SYSTEM_HEADER_MSVC)
+#  pragma system_header
+#endif // no system header
+#include <thrust/detail/function.h>
+#include <thrust/iterator/iterator_traits.h>
+
+THRUST_NAMESPACE_BEGIN
+namespace system
+{
+namespace detail
+{
+namespace internal
+{
+namespace binary_search_detail
+{
+
+// Every search below looks for the bound of a value: the first element of the data which is not "before" the
+// value. The data is partitioned by before, so that the bound of a query is the point of that partition.
+
+template <typename StrictWeakOrdering>
+struct lower_bound_search
+{
+  thrust::detail::wrapped_function<StrictWeakOrdering, bool> comp;
+
+  explicit lower_bound_search(StrictWeakOrdering comp)
+      : comp(comp)
+  {}
+
+  template <typename Element, typename T>
+  bool before(const Element& element, const T& value) const
+  {
+    return comp(element, value);
+  }
+
+  template <typename RandomAccessIterator, typename Size, typename T>
+  Size result(RandomAccessIterator, Size, Size bound, const T&) const
+  {
+    return bound;
+  }
+}; // end lower_bound_search
+
+template <typename StrictWeakOrdering>
+struct upper_bound_search
+{
+  thrust::detail::wrapped_function<StrictWeakOrdering, bool> comp;
+
+  explicit upper_bound_search(StrictWeakOrdering comp)
+      : comp(comp)
+  {}
+
+  template <typename Element, typename T>
+  bool before(const Element& element, const T& value) const
+  {
+    return !comp(value, element);
+  }
+
+  template <typename RandomAccessIterator, typename Size, typename T>
+  Size result(RandomAccessIterator, Size, Size bound, const T&) const
+  {
+    return bound;
+  }
+}; // end upper_bound_search
+
+template <typename StrictWeakOrdering>
+struct binary_search_search
+{
+  thrust::detail::wrapped_function<StrictWeakOrdering, bool> comp;
+
+  explicit binary_search_search(StrictWeakOrdering comp)
+      : comp(comp)
+  {}
+
+  template <typename Element, typename T>
+  bool before(const Element& element, const T& value) const
+  {
+    return comp(element, value);
+  }
+
+  // the value is found if its lower bound is equivalent to it
+  template <typename RandomAccessIterator, typename Size, typename T>
+  bool result(RandomAccessIterator first, Size n, Size bound, const T& value) const
+  {
+    return bound != n && !comp(value, first[bound]);
+  }
+}; // end binary_search_search
+
+template <typename Iterator>
+void prefetch(Iterator)
+{}
+
+template <typename T>
+void prefetch(T* ptr)
+{
+#if defined(_CCCL_COMPILER_GCC) || defined(_CCCL_COMPILER_CLANG)
+  __builtin_prefetch(ptr);
+#else
+  (void) ptr;
+#endif
+}
+
+// Returns the bound of value in [first, first + n). The loop halves the candidates without a branch on the
+// comparison, which a compiler turns into a conditional move, so that random queries do not pay for the
+// mispredictions of a classic binary search. As in a search of an Eytzinger layout, the elements compared in the
+// next iteration are prefetched for both outcomes of this one, so that the loads of consecutive levels overlap.
+template <typename RandomAccessIterator, typename Size, typename T, typename Search>
+Size branchless_bound(RandomAccessIterator first, Size n, const T& value, const Search& search)
+{
+  if (n == 0)
+  {
+    return 0;
+  }
+
+  Size base = 0;
+
+  while (n > 1)
+  {
+    const Size half = n / 2;
+
+    prefetch(first + (base + half / 2));
+    prefetch(first + (base + half + half / 2));
+
+    base = search.before(first[base + half], value) ? base + half : base;
+    n -= half;
+  }
+
+  return base + (search.before(first[base], value) ? 1 : 0);
+}
+
+// Returns the bound of value in [first, first + n), which is known to be at least pos. The search gallops forward
+// from pos in steps of doubling size, and then searches the last step, so that its cost is logarithmic in the
+// distance between pos and the bound rather than in n. A sweep of sorted queries thus costs O(n + m) at worst, as
+// a merge of the data with the queries would, and much less when the queries are sparse in the data.
+template <typename RandomAccessIterator, typename Size, typename T, typename Search>
+Size gallop_bound(RandomAccessIterator first, Size n, Size pos, const T& value, const Search& search)
+{
+  // every element before lo is before value, and hi is the next element to probe
+  Size lo   = pos;
+  Size hi   = pos;
+  Size step = 1;
+
+  while (hi < n && search.before(first[hi], value))
+  {
+    lo = hi + 1;
+    hi = (n - lo > step) ? lo + step : n;
+    step *= 2;
+  }
+
+  return lo + branchless_bound(first + lo, hi - lo, value, search);
+}
+
+// Writes the results of the queries [begin, end) of values to output. Under the adaptive strategy, every query
+// after the first one starts from the bound of the previous query, as long as the bounds do not decrease. Once a
+// bound decreases, the queries of this range are evidently not sorted, and the rest of them are searched
+// independently. Sortedness is judged through the data alone, as the ordering need not compare two queries.
+template <typename RandomAccessIterator1,
+          typename Size,
+          typename RandomAccessIterator2,
+          typename RandomAccessIterator3,
+          typename Search>
+void search_range(
+  RandomAccessIterator1 first,
+  Size n,
+  RandomAccessIterator2 values,
+  RandomAccessIterator3 output,
+  Size begin,
+  Size end,
+  const Search& search)
+{
+  typedef typename thrust::iterator_reference<RandomAccessIterator2>::type value_reference;
+
+  bool sweep = (THRUST_HOST_BINARY_SEARCH_STRATEGY == THRUST_BINARY_SEARCH_ADAPTIVE);
+
+  // the bound of the previous query
+  Size pos = 0;
+
+  for (Size i = begin; i < end; ++i)
+  {
+    value_reference value = values[i];
+
+    Size bound;
+
+    if (!sweep || i == begin)
+    {
+      bound = branchless_bound(first, n, value, search);
+    }
+    else if (pos == 0 || search.before(first[pos - 1], value))
+    {
+      bound = gallop_bound(first, n, pos, value, search);
+    }
+    else
+    {
+      // the bound of this query is before pos
+      sweep = false;
+      bound = branchless_bound(first, pos, value, search);
+    }
+
+    output[i] = search.result(first, n, bound, value);
+    pos       = bound;
+  }
+}
+
+} // namespace binary_search_detail
+} // namespace internal
+} // namespace detail
+} // namespace system
+THRUST_NAMESPACE_END
@@ -0,0 +1,165 @@
+/*
+ *  Copyright 2024 NVIDIA Corporation
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+/*! \file parallel_find.h
+ *  \brief Building blocks of an early-exit parallel find_if, shared by the
+ *         host backends.
+ */
+
+#pragma once
+
+#include <thrust/detail/config.h>
+
+#if defined(_CCCL_IMPLICIT_SYSTEM_HEADER_GCC)
+#  pragma GCC system_header
+#elif defined(_CCCL_IMPLICIT_SYSTEM_HEADER_CLANG)
+#  pragma clang system_header
+#elif defined(_CCCL_IMPLICIT_SYSTEM_HEADER_MSVC)
+#  pragma system_header
+#endif // no system header
+#include <thrust/detail/cpp11_required.h>
+#include <thrust/detail/function.h>
+#include <thrust/iterator/iterator_traits.h>
+
+#include <atomic>
+
+THRUST_NAMESPACE_BEGIN
+namespace system
+{
+namespace detail
+{
+namespace internal
+{
+namespace find_detail
+{
+
+// A parallel find_if splits the input into cache-sized blocks, which every thread claims in increasing order
+// through a shared counter. The first match found lowers a shared result index, after which
+//   1. no thread claims a block past the result,
+//   2. threads abandon the blocks they are searching as soon as they are past the result.
+// Since blocks are claimed in order, every block before the result has been claimed when it is found, so the
+// wasted work is bounded by about one block per thread, however long the input is.
+template <typename Size>
+class find_state
+{
+public:
+  find_state(Size n, Size block_size)
+      : m_n(n)
+      , m_block_size(block_size)
+      , m_next_block(0)
+      , m_result(n)
+  {}
+
+  Size num_blocks() const
+  {
+    return (m_n + m_block_size - 1) / m_block_size;
+  }
+
+  // claims the next block [begin, end); returns false when no block before the result remains
+  bool claim(Size& begin, Size& end)
+  {
+    const Size block = m_next_block.fetch_add(1, std::memory_order_relaxed);
+
+    // a block index past the end cannot overflow, as every thread stops claiming after its first failure
+    if (block >= num_blocks())
+    {
+      return false;
+    }
+
+    begin = block * m_block_size;
+    end   = (m_n - begin < m_block_size) ? m_n : begin + m_block_size;
+
+    return begin < result();
+  }
+
+  // the smallest index of a match found so far, or n
+  Size result() const
+  {
+    return m_result.load(std::memory_order_relaxed);
+  }
+
+  void found(Size i)
+  {
+    Size current = m_result.load(std::memory_order_relaxed);
+
+    while (i < current && !m_result.compare_exchange_weak(current, i, std::memory_order_relaxed))
+    {
+    }
+  }
+
+private:
+  const Size m_n;
+  const Size m_block_size;
+  std::atomic<Size> m_next_block;
+  std::atomic<Size> m_result;
+}; // end find_state
+
+// the number of elements of a block, so that the block of every thread fits in its L1 cache
+template <typename InputIterator>
+typename thrust::iterator_difference<InputIterator>::type block_size()
+{
+  typedef typename thrust::iterator_value<InputIterator>::type InputType;
+  typedef typename thrust::iterator_difference<InputIterator>::type Size;
+
+  const Size bytes = 32 * 1024;
+
+  return (bytes / Size(sizeof(InputType)) > 1024) ? bytes / Size(sizeof(InputType)) : Size(1024);
+}
+
+// searches the blocks claimed by the calling thread for a match of pred, until no block before the result remains
+template <typename InputIterator, typename Predicate, typename Size>
+void find_if_blocks(InputIterator first, Predicate pred, find_state<Size>& state)
+{
+  // how often a thread checks whether its block is still before the result
+  const Size check_interval = 256;
+
+  thrust::detail::wrapped_function<Predicate, bool> wrapped_pred(pred);
+
+  Size begin, end;
+
+  while (state.claim(begin, end))
+  {
+    for (Size chunk_begin = begin; chunk_begin < end; chunk_begin += check_interval)
+    {
+      if (chunk_begin >= state.result())
+      {
+        // another thread found a match before the rest of this block, and thus before all later blocks
+        return;
+      }
+
+      const Size chunk_size = (end - chunk_begin < check_interval) ? end - chunk_begin : check_interval;
+
+      InputIterator chunk_first = first + chunk_begin;
+      InputIterator chunk_last  = chunk_first + chunk_size;
+
+      for (InputIterator iter = chunk_first; iter != chunk_last; ++iter)
+      {
+        if (wrapped_pred(*iter))
+        {
+          // the later blocks of this thread cannot hold an earlier match
+          state.found(chunk_begin + (iter - chunk_first));
+          return;
+        }
+      }
+    }
+  }
+}
+
+} // namespace find_detail
+} // namespace internal
+} // namespace detail
+} // namespace system
+THRUST_NAMESPACE_END
@@ -0,0 +1,365 @@
+/*
+ *  Copyright 2024 NVIDIA Corporation
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+/*! \file radix_sort.h
+ *  \brief A parallel LSD radix sort and its per-tile building blocks, shared
+ *         by the host backends.
+ */
+
+#pragma once
+
+#include <thrust/detail/config.h>
+
+#if defined(_CCCL_IMPLICIT_SYSTEM_HEADER_GCC)
+#  pragma GCC system_header
+#elif defined(_CCCL_IMPLICIT_SYSTEM_HEADER_CLANG)
+#  pragma clang system_header
+#elif defined(_CCCL_IMPLICIT_SYSTEM_HEADER_MSVC)
+#  pragma system_header
+#endif // no system header
+#include <thrust/detail/copy.h>
+#include <thrust/detail/temporary_array.h>
+#include <thrust/iterator/iterator_traits.h>
+#include <thrust/system/detail/internal/decompose.h>
+#include <thrust/system/detail/sequential/stable_radix_sort.h>
+
+#include <cstddef>
+
+THRUST_NAMESPACE_BEGIN
+namespace system
+{
+namespace detail
+{
+namespace internal
+{
+namespace radix_sort_detail
+{
+
+// A parallel LSD radix sort splits the keys into tiles and, for every digit,
+//   1. builds one histogram per tile (histogram_tile),
+//   2. turns the tile x bucket histograms into scatter offsets (scan_histograms),
+//   3. scatters every tile to its offsets (scatter_tile).
+// Steps 1 and 3 are independent across tiles; step 2 is cheap and serial.
+// The digit encoding is the same as the one used by the sequential radix sort.
+template <typename KeyType>
+struct radix_sort_traits
+{
+  typedef thrust::system::detail::sequential::radix_sort_detail::RadixEncoder<KeyType> encoder_type;
+  typedef typename encoder_type::result_type encoded_type;
+
+  static const unsigned int radix_bits  = 8;
+  static const unsigned int num_buckets = 1u << radix_bits;
+  static const unsigned int num_passes  = (8 * sizeof(encoded_type) + radix_bits - 1) / radix_bits;
+
+  static unsigned int digit(KeyType key, unsigned int pass)
+  {
+    const encoded_type x = static_cast<encoded_type>(encoder_type()(key));
+
+    return static_cast<unsigned int>((x >> (radix_bits * pass)) & (num_buckets - 1));
+  }
+};
+
+// counts the digits of keys [begin, end) into histogram[0, num_buckets)
+template <typename RandomAccessIterator, typename Size>
+void histogram_tile(RandomAccessIterator keys, Size begin, Size end, unsigned int pass, std::size_t* histogram)
+{
+  typedef typename thrust::iterator_value<RandomAccessIterator>::type KeyType;
+  typedef radix_sort_traits<KeyType> traits;
+
+  for (unsigned int b = 0; b < traits::num_buckets; ++b)
+  {
+    histogram[b] = 0;
+  }
+
+  for (Size i = begin; i < end; ++i)
+  {
+    histogram[traits::digit(keys[i], pass)]++;
+  }
+}
+
+// histograms holds num_tiles consecutive histograms of num_buckets entries.
+// Replaces every count with the position at which the tile writes its first
+// key of that bucket. Returns false, leaving the histograms untouched, when
+// every key falls in the same bucket and the pass can be skipped.
+template <typename KeyType, typename Size>
+bool scan_histograms(std::size_t* histograms, Size num_tiles, std::size_t n)
+{
+  typedef radix_sort_traits<KeyType> traits;
+
+  for (unsigned int b = 0; b < traits::num_buckets; ++b)
+  {
+    std::size_t total = 0;
+
+    for (Size t = 0; t < num_tiles; ++t)
+    {
+      total += histograms[t * traits::num_buckets + b];
+    }
+
+    if (total == n)
+    {
+      return false;
+    }
+  }
+
+  std::size_t sum = 0;
+
+  for (unsigned int b = 0; b < traits::num_buckets; ++b)
+  {
+    for (Size t = 0; t < num_tiles; ++t)
+    {
+      const std::size_t count = histograms[t * traits::num_buckets + b];
+
+      histograms[t * traits::num_buckets + b] = sum;
+
+      sum += count;
+    }
+  }
+
+  return true;
+}
+
+// moves keys (and optionally values) [begin, end) to the offsets computed by
+// scan_histograms for this tile, preserving their relative order
+template <bool HasValues,
+          typename RandomAccessIterator1,
+          typename RandomAccessIterator2,
+          typename RandomAccessIterator3,
+          typename RandomAccessIterator4,
+          typename Size>
+void scatter_tile(
+  RandomAccessIterator1 keys_in,
+  RandomAccessIterator2 values_in,
+  Size begin,
+  Size end,
+  RandomAccessIterator3 keys_out,
+  RandomAccessIterator4 values_out,
+  unsigned int pass,
+  std::size_t* offsets)
+{
+  typedef typename thrust::iterator_value<RandomAccessIterator1>::type KeyType;
+  typedef radix_sort_traits<KeyType> traits;
+
+  for (Size i = begin; i < end; ++i)
+  {
+    const KeyType key     = keys_in[i];
+    const std::size_t dst = offsets[traits::digit(key, pass)]++;
+    keys_out[dst]         = key;
+
+    if (HasValues)
+    {
+      values_out[dst] = values_in[i];
+    }
+  }
+}
+
+// keys are split into at most max_tiles tiles of at least tile_size keys
+const static int tile_size = 64 * 1024;
+const static int max_tiles = 256;
+
+template <typename RandomAccessIterator, typename Size>
+struct histogram_body
+{
+  RandomAccessIterator keys;
+  uniform_decomposition<Size> decomp;
+  unsigned int pass;
+  std::size_t* histograms;
+
+  histogram_body(
+    RandomAccessIterator keys, uniform_decomposition<Size> decomp, unsigned int pass, std::size_t* histograms)
+      : keys(keys)
+      , decomp(decomp)
+      , pass(pass)
+      , histograms(histograms)
+  {}
+
+  void operator()(Size begin, Size end) const
+  {
+    typedef typename thrust::iterator_value<RandomAccessIterator>::type KeyType;
+    typedef radix_sort_traits<KeyType> traits;
+
+    for (Size t = begin; t != end; ++t)
+    {
+      histogram_tile(keys, decomp[t].begin(), decomp[t].end(), pass, histograms + t * traits::num_buckets);
+    }
+  }
+};
+
+template <bool HasValues,
+          typename RandomAccessIterator1,
+          typename RandomAccessIterator2,
+          typename RandomAccessIterator3,
+          typename RandomAccessIterator4,
+          typename Size>
+struct scatter_body
+{
+  RandomAccessIterator1 keys_in;
+  RandomAccessIterator2 values_in;
+  RandomAccessIterator3 keys_out;
+  RandomAccessIterator4 values_out;
+  uniform_decomposition<Size> decomp;
+  unsigned int pass;
+  std::size_t* offsets;
+
+  scatter_body(RandomAccessIterator1 keys_in,
+               RandomAccessIterator2 values_in,
+               RandomAccessIterator3 keys_out,
+               RandomAccessIterator4 values_out,
+               uniform_decomposition<Size> decomp,
+               unsigned int pass,
+               std::size_t* offsets)
+      : keys_in(keys_in)
+      , values_in(values_in)
+      , keys_out(keys_out)
+      , values_out(values_out)
+      , decomp(decomp)
+      , pass(pass)
+      , offsets(offsets)
+  {}
+
+  void operator()(Size begin, Size end) const
+  {
+    typedef typename thrust::iterator_value<RandomAccessIterator1>::type KeyType;
+    typedef radix_sort_traits<KeyType> traits;
+
+    for (Size t = begin; t != end; ++t)
+    {
+      scatter_tile<HasValues>(
+        keys_in,
+        values_in,
+        decomp[t].begin(),
+        decomp[t].end(),
+        keys_out,
+        values_out,
+        pass,
+        offsets + t * traits::num_buckets);
+    }
+  }
+};
+
+// runs one pass from (keys_in, values_in) to (keys_out, values_out)
+// returns false if the pass was skipped because its digit is constant
+template <bool HasValues,
+          typename ParallelFor,
+          typename RandomAccessIterator1,
+          typename RandomAccessIterator2,
+          typename RandomAccessIterator3,
+          typename RandomAccessIterator4,
+          typename Size>
+bool radix_pass(
+  ParallelFor parallel_for,
+  RandomAccessIterator1 keys_in,
+  RandomAccessIterator2 values_in,
+  RandomAccessIterator3 keys_out,
+  RandomAccessIterator4 values_out,
+  uniform_decomposition<Size> decomp,
+  unsigned int pass,
+  std::size_t* histograms)
+{
+  typedef typename thrust::iterator_value<RandomAccessIterator1>::type KeyType;
+
+  const Size num_tiles = decomp.size();
+
+  parallel_for(num_tiles, histogram_body<RandomAccessIterator1, Size>(keys_in, decomp, pass, histograms));
+
+  if (!scan_histograms<KeyType>(histograms, num_tiles, static_cast<std::size_t>(decomp[num_tiles - 1].end())))
+  {
+    return false;
+  }
+
+  typedef scatter_body<HasValues,
+                       RandomAccessIterator1,
+                       RandomAccessIterator2,
+                       RandomAccessIterator3,
+                       RandomAccessIterator4,
+                       Size>
+    Body;
+
+  parallel_for(num_tiles, Body(keys_in, values_in, keys_out, values_out, decomp, pass, histograms));
+
+  return true;
+}
+
+// Sorts keys [0, n), and values along with them when HasValues is true.
+// parallel_for(num_tiles, body) is supplied by the backend. It must call
+// body(begin, end) on disjoint subranges of [0, num_tiles) which together
+// cover it, and return once all of them are done.
+template <bool HasValues,
+          typename DerivedPolicy,
+          typename ParallelFor,
+          typename RandomAccessIterator1,
+          typename RandomAccessIterator2,
+          typename Size>
+void radix_sort(thrust::execution_policy<DerivedPolicy>& exec,
+                ParallelFor parallel_for,
+                RandomAccessIterator1 keys,
+                RandomAccessIterator2 values,
+                Size n)
+{
+  typedef typename thrust::iterator_value<RandomAccessIterator1>::type KeyType;
+  typedef typename thrust::iterator_value<RandomAccessIterator2>::type ValueType;
+  typedef radix_sort_traits<KeyType> traits;
+
+  uniform_decomposition<Size> decomp(n, tile_size, max_tiles);
+
+  // every pass scatters between the input and a single scratch buffer
+  thrust::detail::temporary_array<KeyType, DerivedPolicy> keys_buffer(exec, n);
+  thrust::detail::temporary_array<ValueType, DerivedPolicy> values_buffer(exec, HasValues ? n : 0);
+
+  // one histogram per tile, laid out tile-major
+  thrust::detail::temporary_array<std::size_t, DerivedPolicy> histograms(
+    exec, static_cast<std::size_t>(decomp.size()) * traits::num_buckets);
+
+  std::size_t* histograms_ptr = thrust::raw_pointer_cast(histograms.data());
+
+  bool in_buffer = false;
+
+  for (unsigned int pass = 0; pass < traits::num_passes; ++pass)
+  {
+    bool scattered;
+
+    if (in_buffer)
+    {
+      scattered = radix_pass<HasValues>(
+        parallel_for, keys_buffer.begin(), values_buffer.begin(), keys, values, decomp, pass, histograms_ptr);
+    }
+    else
+    {
+      scattered = radix_pass<HasValues>(
+        parallel_for, keys, values, keys_buffer.begin(), values_buffer.begin(), decomp, pass, histograms_ptr);
+    }
+
+    if (scattered)
+    {
+      in_buffer = !in_buffer;
+    }
+  }
+
+  if (in_buffer)
+  {
+    thrust::copy(exec, keys_buffer.begin(), keys_buffer.end(), keys);
+
+    if (HasValues)
+    {
+      thrust::copy(exec, values_buffer.begin(), values_buffer.end(), values);
+    }
+  }
+}
+
+} // end namespace radix_sort_detail
+} // end namespace internal
+} // end namespace detail
+} // end namespace system
+THRUST_NAMESPACE_END
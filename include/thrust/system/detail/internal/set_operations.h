@@ -0,0 +1,205 @@
+/*
+ *  Copyright 2024 NVIDIA Corporation
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+/*! \file set_operations.h
+ *  \brief Building blocks of the partitioned set operations shared by the
+ *         host backends.
+ */
+
+#pragma once
+
+#include <thrust/detail/config.h>
+
+#if defined(_CCCL_IMPLICIT_SYSTEM_HEADER_GCC)
+#  pragma GCC system_header
+#elif defined(_CCCL_IMPLICIT_SYSTEM_HEADER_CLANG)
+#  pragma clang system_header
+#elif defined(_CCCL_IMPLICIT_SYSTEM_HEADER_MSVC)
+#  pragma system_header
+#endif // no system header
+#include <thrust/detail/seq.h>
+#include <thrust/iterator/discard_iterator.h>
+#include <thrust/pair.h>
+#include <thrust/set_operations.h>
+#include <thrust/system/detail/internal/merge_path.h>
+
+THRUST_NAMESPACE_BEGIN
+namespace system
+{
+namespace detail
+{
+namespace internal
+{
+namespace set_operations_detail
+{
+
+// A parallel set operation
+//   1. splits both inputs into partitions with set_partition, one split per
+//      partition boundary (partition_inputs),
+//   2. counts the output of every partition (count_partition),
+//   3. scans the counts into output offsets,
+//   4. writes every partition at its offset (write_partition).
+// Steps 2 and 4 are independent across partitions and run the sequential
+// set operation, so the result is identical to the sequential one.
+
+struct set_difference_op
+{
+  template <typename InputIterator1, typename InputIterator2, typename OutputIterator, typename StrictWeakOrdering>
+  OutputIterator operator()(
+    InputIterator1 first1,
+    InputIterator1 last1,
+    InputIterator2 first2,
+    InputIterator2 last2,
+    OutputIterator result,
+    StrictWeakOrdering comp) const
+  {
+    return thrust::set_difference(thrust::seq, first1, last1, first2, last2, result, comp);
+  }
+};
+
+struct set_intersection_op
+{
+  template <typename InputIterator1, typename InputIterator2, typename OutputIterator, typename StrictWeakOrdering>
+  OutputIterator operator()(
+    InputIterator1 first1,
+    InputIterator1 last1,
+    InputIterator2 first2,
+    InputIterator2 last2,
+    OutputIterator result,
+    StrictWeakOrdering comp) const
+  {
+    return thrust::set_intersection(thrust::seq, first1, last1, first2, last2, result, comp);
+  }
+};
+
+struct set_symmetric_difference_op
+{
+  template <typename InputIterator1, typename InputIterator2, typename OutputIterator, typename StrictWeakOrdering>
+  OutputIterator operator()(
+    InputIterator1 first1,
+    InputIterator1 last1,
+    InputIterator2 first2,
+    InputIterator2 last2,
+    OutputIterator result,
+    StrictWeakOrdering comp) const
+  {
+    return thrust::set_symmetric_difference(thrust::seq, first1, last1, first2, last2, result, comp);
+  }
+};
+
+struct set_union_op
+{
+  template <typename InputIterator1, typename InputIterator2, typename OutputIterator, typename StrictWeakOrdering>
+  OutputIterator operator()(
+    InputIterator1 first1,
+    InputIterator1 last1,
+    InputIterator2 first2,
+    InputIterator2 last2,
+    OutputIterator result,
+    StrictWeakOrdering comp) const
+  {
+    return thrust::set_union(thrust::seq, first1, last1, first2, last2, result, comp);
+  }
+};
+
+// fills splits1[0, num_partitions] and splits2[0, num_partitions] with the
+// partition boundaries of both inputs, each partition covering roughly
+// (n1 + n2) / num_partitions elements of the merged input
+template <typename RandomAccessIterator1,
+          typename RandomAccessIterator2,
+          typename Size,
+          typename SplitIterator,
+          typename StrictWeakOrdering>
+void partition_inputs(
+  RandomAccessIterator1 first1,
+  Size n1,
+  RandomAccessIterator2 first2,
+  Size n2,
+  Size num_partitions,
+  SplitIterator splits1,
+  SplitIterator splits2,
+  StrictWeakOrdering comp)
+{
+  splits1[0] = 0;
+  splits2[0] = 0;
+
+  for (Size p = 1; p < num_partitions; ++p)
+  {
+    const Size diag = static_cast<Size>((static_cast<double>(n1 + n2) * p) / num_partitions);
+
+    thrust::pair<Size, Size> split = set_partition(first1, n1, first2, n2, diag, comp);
+
+    splits1[p] = split.first;
+    splits2[p] = split.second;
+  }
+
+  splits1[num_partitions] = n1;
+  splits2[num_partitions] = n2;
+}
+
+template <typename SetOperation,
+          typename RandomAccessIterator1,
+          typename RandomAccessIterator2,
+          typename SplitIterator,
+          typename Size,
+          typename StrictWeakOrdering>
+Size count_partition(
+  SetOperation set_op,
+  RandomAccessIterator1 first1,
+  RandomAccessIterator2 first2,
+  SplitIterator splits1,
+  SplitIterator splits2,
+  Size p,
+  StrictWeakOrdering comp)
+{
+  thrust::discard_iterator<> discard = thrust::make_discard_iterator();
+
+  return static_cast<Size>(
+    set_op(first1 + splits1[p], first1 + splits1[p + 1], first2 + splits2[p], first2 + splits2[p + 1], discard, comp)
+    - discard);
+}
+
+template <typename SetOperation,
+          typename RandomAccessIterator1,
+          typename RandomAccessIterator2,
+          typename RandomAccessIterator3,
+          typename SplitIterator,
+          typename Size,
+          typename StrictWeakOrdering>
+void write_partition(
+  SetOperation set_op,
+  RandomAccessIterator1 first1,
+  RandomAccessIterator2 first2,
+  RandomAccessIterator3 result,
+  SplitIterator splits1,
+  SplitIterator splits2,
+  SplitIterator offsets,
+  Size p,
+  StrictWeakOrdering comp)
+{
+  set_op(first1 + splits1[p],
+         first1 + splits1[p + 1],
+         first2 + splits2[p],
+         first2 + splits2[p + 1],
+         result + offsets[p],
+         comp);
+}
+
+} // end namespace set_operations_detail
+} // end namespace internal
+} // end namespace detail
+} // end namespace system
+THRUST_NAMESPACE_END
@@ -0,0 +1,257 @@
+/*
+ *  Copyright 2024 NVIDIA Corporation
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+#pragma once
+
+#include <thrust/detail/config.h>
+
+#if defined(_CCCL_IMPLICIT_SYSTEM_HEADER_GCC)
+#  pragma GCC system_header
+#elif defined(_CCCL_IMPLICIT_SYSTEM_HEADER_CLANG)
+#  pragma clang system_header
+#elif defined(_CCCL_IMPLICIT_SYSTEM_HEADER_MSVC)
+#  pragma system_header
+#endif // no system header
+#include <thrust/detail/cstdint.h>
+#include <thrust/detail/static_assert.h> // for depend_on_instantiation
+#include <thrust/detail/type_traits/minimum_type.h>
+#include <thrust/distance.h>
+#include <thrust/iterator/iterator_traits.h>
+#include <thrust/system/detail/generic/binary_search.h>
+#include <thrust/system/detail/internal/parallel_binary_search.h>
+#include <thrust/system/omp/detail/binary_search.h>
+#include <thrust/system/omp/detail/default_decomposition.h>
+#include <thrust/system/omp/detail/pragma_omp.h>
+#include <thrust/type_traits/is_contiguous_iterator.h>
+
+THRUST_NAMESPACE_BEGIN
+namespace system
+{
+namespace omp
+{
+namespace detail
+{
+namespace binary_search_detail
+{
+
+template <typename DerivedPolicy,
+          typename ForwardIterator,
+          typename InputIterator,
+          typename OutputIterator,
+          typename StrictWeakOrdering,
+          typename Search,
+          typename BinarySearchFunction>
+OutputIterator search_queries(
+  execution_policy<DerivedPolicy>& exec,
+  ForwardIterator begin,
+  ForwardIterator end,
+  InputIterator values_begin,
+  InputIterator values_end,
+  OutputIterator output,
+  StrictWeakOrdering comp,
+  Search,
+  BinarySearchFunction func,
+  thrust::incrementable_traversal_tag)
+{
+  return thrust::system::detail::generic::detail::binary_search(
+    exec, begin, end, values_begin, values_end, output, comp, func);
+}
+
+// The queries are split into one interval per processor, each of which is searched with
+// internal::binary_search_detail::search_range.
+template <typename DerivedPolicy,
+          typename ForwardIterator,
+          typename InputIterator,
+          typename OutputIterator,
+          typename StrictWeakOrdering,
+          typename Search,
+          typename BinarySearchFunction>
+OutputIterator search_queries(
+  execution_policy<DerivedPolicy>&,
+  ForwardIterator begin,
+  ForwardIterator end,
+  InputIterator values_begin,
+  InputIterator values_end,
+  OutputIterator output,
+  StrictWeakOrdering,
+  Search search,
+  BinarySearchFunction,
+  thrust::random_access_traversal_tag)
+{
+  // we're attempting to launch an omp kernel, assert we're compiling with omp support
+  // ========================================================================
+  // X Note to the user: If you've found this line due to a compiler error, X
+  // X you need to enable OpenMP support in your compiler.                  X
+  // ========================================================================
+  THRUST_STATIC_ASSERT_MSG(
+    (thrust::detail::depend_on_instantiation<ForwardIterator,
+                                             (THRUST_DEVICE_COMPILER_IS_OMP_CAPABLE == THRUST_TRUE)>::value),
+    "OpenMP compiler support is not enabled");
+
+  typedef thrust::detail::intptr_t index_type;
+
+  const index_type n = thrust::distance(begin, end);
+  const index_type m = thrust::distance(values_begin, values_end);
+
+  // there is nothing to search, and an empty range may not be dereferenced to find its raw pointer
+  if (n == 0)
+  {
+    thrust::system::detail::internal::binary_search_detail::search_range(
+      begin, n, values_begin, output, index_type(0), m, search);
+
+    return output + m;
+  }
+
+  // search raw pointers where possible, so that the search can prefetch
+  typename thrust::try_unwrap_contiguous_iterator_t<ForwardIterator> first =
+    thrust::try_unwrap_contiguous_iterator(begin);
+
+  thrust::system::detail::internal::uniform_decomposition<index_type> decomp =
+    thrust::system::omp::detail::default_decomposition(m);
+
+  const index_type num_intervals = decomp.size();
+
+  if (num_intervals <= 1)
+  {
+    thrust::system::detail::internal::binary_search_detail::search_range(
+      first, n, values_begin, output, index_type(0), m, search);
+
+    return output + m;
+  }
+
+  THRUST_PRAGMA_OMP(parallel for)
+  for (index_type p = 0; p < num_intervals; p++)
+  {
+    thrust::system::detail::internal::binary_search_detail::search_range(
+      first, n, values_begin, output, decomp[p].begin(), decomp[p].end(), search);
+  }
+
+  return output + m;
+}
+
+template <typename DerivedPolicy,
+          typename ForwardIterator,
+          typename InputIterator,
+          typename OutputIterator,
+          typename StrictWeakOrdering,
+          typename Search,
+          typename BinarySearchFunction>
+OutputIterator search_queries(
+  execution_policy<DerivedPolicy>& exec,
+  ForwardIterator begin,
+  ForwardIterator end,
+  InputIterator values_begin,
+  InputIterator values_end,
+  OutputIterator output,
+  StrictWeakOrdering comp,
+  Search search,
+  BinarySearchFunction func)
+{
+  typedef typename thrust::iterator_traversal<ForwardIterator>::type traversal1;
+  typedef typename thrust::iterator_traversal<InputIterator>::type traversal2;
+  typedef typename thrust::iterator_traversal<OutputIterator>::type traversal3;
+
+  typedef typename thrust::detail::minimum_type<traversal1, traversal2, traversal3>::type traversal;
+
+  // dispatch on minimum traversal
+  return binary_search_detail::search_queries(
+    exec, begin, end, values_begin, values_end, output, comp, search, func, traversal());
+}
+
+} // end namespace binary_search_detail
+
+template <typename DerivedPolicy,
+          typename ForwardIterator,
+          typename InputIterator,
+          typename OutputIterator,
+          typename StrictWeakOrdering>
+OutputIterator lower_bound(
+  execution_policy<DerivedPolicy>& exec,
+  ForwardIterator begin,
+  ForwardIterator end,
+  InputIterator values_begin,
+  InputIterator values_end,
+  OutputIterator output,
+  StrictWeakOrdering comp)
+{
+  return binary_search_detail::search_queries(
+    exec,
+    begin,
+    end,
+    values_begin,
+    values_end,
+    output,
+    comp,
+    thrust::system::detail::internal::binary_search_detail::lower_bound_search<StrictWeakOrdering>(comp),
+    thrust::system::detail::generic::detail::lbf());
+} // end lower_bound()
+
+template <typename DerivedPolicy,
+          typename ForwardIterator,
+          typename InputIterator,
+          typename OutputIterator,
+          typename StrictWeakOrdering>
+OutputIterator upper_bound(
+  execution_policy<DerivedPolicy>& exec,
+  ForwardIterator begin,
+  ForwardIterator end,
+  InputIterator values_begin,
+  InputIterator values_end,
+  OutputIterator output,
+  StrictWeakOrdering comp)
+{
+  return binary_search_detail::search_queries(
+    exec,
+    begin,
+    end,
+    values_begin,
+    values_end,
+    output,
+    comp,
+    thrust::system::detail::internal::binary_search_detail::upper_bound_search<StrictWeakOrdering>(comp),
+    thrust::system::detail::generic::detail::ubf());
+} // end upper_bound()
+
+template <typename DerivedPolicy,
+          typename ForwardIterator,
+          typename InputIterator,
+          typename OutputIterator,
+          typename StrictWeakOrdering>
+OutputIterator binary_search(
+  execution_policy<DerivedPolicy>& exec,
+  ForwardIterator begin,
+  ForwardIterator end,
+  InputIterator values_begin,
+  InputIterator values_end,
+  OutputIterator output,
+  StrictWeakOrdering comp)
+{
+  return binary_search_detail::search_queries(
+    exec,
+    begin,
+    end,
+    values_begin,
+    values_end,
+    output,
+    comp,
+    thrust::system::detail::internal::binary_search_detail::binary_search_search<StrictWeakOrdering>(comp),
+    thrust::system::detail::generic::detail::bsf());
+} // end binary_search()
+
+} // end namespace detail
+} // end namespace omp
+} // end namespace system
+THRUST_NAMESPACE_END
@@ -25,8 +25,17 @@
 #elif defined(_CCCL_IMPLICIT_SYSTEM_HEADER_MSVC)
 #  pragma system_header
 #endif // no system header
-#include <thrust/system/detail/generic/copy_if.h>
+#include <thrust/copy.h>
+#include <thrust/detail/cstdint.h>
+#include <thrust/detail/function.h>
+#include <thrust/detail/seq.h>
+#include <thrust/detail/static_assert.h>
+#include <thrust/detail/temporary_array.h>
+#include <thrust/distance.h>
+#include <thrust/iterator/iterator_traits.h>
 #include <thrust/system/omp/detail/copy_if.h>
+#include <thrust/system/omp/detail/default_decomposition.h>
+#include <thrust/system/omp/detail/pragma_omp.h>
 
 THRUST_NAMESPACE_BEGIN
 namespace system
@@ -35,6 +44,112 @@ namespace omp
 {
 namespace detail
 {
+namespace copy_if_detail
+{
+
+// copy_if and stable_partition_copy make two passes over every interval of the decomposition, instead of
+// materializing a flag per element:
+//   1. count the elements of every interval which satisfy pred (count_intervals),
+//   2. scan the counts serially into output offsets (exclusive_scan_counts),
+//   3. evaluate pred again and write every interval's elements at its offsets.
+// The extra storage is one count per interval, rather than O(N).
+
+// phase 1: counts[i] = the number of elements of interval i whose stencil satisfies pred
+template <typename InputIterator, typename CountIterator, typename Predicate, typename Decomposition>
+void count_intervals(InputIterator stencil, CountIterator counts, Predicate pred, Decomposition decomp)
+{
+#if (THRUST_DEVICE_COMPILER_IS_OMP_CAPABLE == THRUST_TRUE)
+  typedef typename thrust::iterator_value<CountIterator>::type Size;
+
+  // wrap pred
+  thrust::detail::wrapped_function<Predicate, bool> wrapped_pred(pred);
+
+  typedef thrust::detail::intptr_t index_type;
+
+  index_type n = static_cast<index_type>(decomp.size());
+
+  THRUST_PRAGMA_OMP(parallel for)
+  for (index_type i = 0; i < n; i++)
+  {
+    InputIterator begin = stencil + decomp[i].begin();
+    InputIterator end   = stencil + decomp[i].end();
+
+    Size count = 0;
+
+    for (; begin != end; ++begin)
+    {
+      if (wrapped_pred(*begin))
+      {
+        ++count;
+      }
+    }
+
+    counts[i] = count;
+  }
+#endif // THRUST_DEVICE_COMPILER_IS_OMP_CAPABLE
+}
+
+// phase 2: replaces counts[0, n) by their exclusive scan, and returns their sum
+template <typename CountIterator, typename Size>
+typename thrust::iterator_value<CountIterator>::type exclusive_scan_counts(CountIterator counts, Size n)
+{
+  typedef typename thrust::iterator_value<CountIterator>::type CountType;
+
+  CountType sum = 0;
+
+  for (Size i = 0; i < n; ++i)
+  {
+    CountType count = counts[i];
+    counts[i]       = sum;
+    sum += count;
+  }
+
+  return sum;
+}
+
+// phase 3 of copy_if: interval i writes its selected elements from result + offsets[i]
+template <typename InputIterator1,
+          typename InputIterator2,
+          typename OutputIterator,
+          typename CountIterator,
+          typename Predicate,
+          typename Decomposition>
+void copy_intervals(InputIterator1 first,
+                    InputIterator2 stencil,
+                    OutputIterator result,
+                    CountIterator offsets,
+                    Predicate pred,
+                    Decomposition decomp)
+{
+#if (THRUST_DEVICE_COMPILER_IS_OMP_CAPABLE == THRUST_TRUE)
+  // wrap pred
+  thrust::detail::wrapped_function<Predicate, bool> wrapped_pred(pred);
+
+  typedef thrust::detail::intptr_t index_type;
+
+  index_type n = static_cast<index_type>(decomp.size());
+
+  THRUST_PRAGMA_OMP(parallel for)
+  for (index_type i = 0; i < n; i++)
+  {
+    InputIterator1 begin = first + decomp[i].begin();
+    InputIterator1 end   = first + decomp[i].end();
+    InputIterator2 flag  = stencil + decomp[i].begin();
+    OutputIterator out   = result + offsets[i];
+
+    for (; begin != end; ++begin, ++flag)
+    {
+      if (wrapped_pred(*flag))
+      {
+        *out = *begin;
+        ++out;
+      }
+    }
+  }
+#endif // THRUST_DEVICE_COMPILER_IS_OMP_CAPABLE
+}
+
+} // end namespace copy_if_detail
 
 template <typename DerivedPolicy,
           typename InputIterator1,
@@ -49,8 +164,44 @@ OutputIterator copy_if(
   OutputIterator result,
   Predicate pred)
 {
-  // omp prefers generic::copy_if to cpp::copy_if
-  return thrust::system::detail::generic::copy_if(exec, first, last, stencil, result, pred);
+  // we're attempting to launch an omp kernel, assert we're compiling with omp support
+  // ========================================================================
+  // X Note to the user: If you've found this line due to a compiler error, X
+  // X you need to enable OpenMP support in your compiler.                  X
+  // ========================================================================
+  THRUST_STATIC_ASSERT_MSG(
+    (thrust::detail::depend_on_instantiation<InputIterator1,
+                                             (THRUST_DEVICE_COMPILER_IS_OMP_CAPABLE == THRUST_TRUE)>::value),
+    "OpenMP compiler support is not enabled");
+
+  typedef typename thrust::iterator_difference<InputIterator1>::type Size;
+
+  const Size n = thrust::distance(first, last);
+
+  if (n == 0)
+  {
+    return result;
+  }
+
+  thrust::system::detail::internal::uniform_decomposition<Size> decomp =
+    thrust::system::omp::detail::default_decomposition(n);
+
+  // with a single interval, counting first would only add a pass
+  if (decomp.size() == 1)
+  {
+    return thrust::copy_if(thrust::seq, first, last, stencil, result, pred);
+  }
+
+  // one count, and then one output offset, per interval
+  thrust::detail::temporary_array<Size, DerivedPolicy> offsets(exec, decomp.size());
+
+  copy_if_detail::count_intervals(stencil, offsets.begin(), pred, decomp);
+
+  const Size num_selected = copy_if_detail::exclusive_scan_counts(offsets.begin(), decomp.size());
+
+  copy_if_detail::copy_intervals(first, stencil, result, offsets.begin(), pred, decomp);
+
+  return result + num_selected;
 } // end copy_if()
 
 } // namespace detail
@@ -0,0 +1,85 @@
+/*
+ *  Copyright 2024 NVIDIA Corporation
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+/*! \file first_touch.h
+ *  \brief Places the pages of fresh memory on the NUMA nodes of the threads
+ *         which will work on them.
+ */
+
+#pragma once
+
+#include <thrust/detail/config.h>
+
+#if defined(_CCCL_IMPLICIT_SYSTEM_HEADER_GCC)
+#  pragma GCC system_header
+#elif defined(_CCCL_IMPLICIT_SYSTEM_HEADER_CLANG)
+#  pragma clang system_header
+#elif defined(_CCCL_IMPLICIT_SYSTEM_HEADER_MSVC)
+#  pragma system_header
+#endif // no system header
+#include <thrust/detail/cstdint.h>
+#include <thrust/detail/static_assert.h>
+#include <thrust/system/omp/detail/default_decomposition.h>
+#include <thrust/system/omp/detail/pragma_omp.h>
+
+#include <cstddef>
+
+THRUST_NAMESPACE_BEGIN
+namespace system
+{
+namespace omp
+{
+namespace detail
+{
+
+// Writes to every page of [p, p + bytes), which must not have been written to before, so that the operating system
+// places each page on the NUMA node of the thread which writes to it. The pages are divided among the threads with
+// the default decomposition, as the parallel loops of the OpenMP system divide their ranges, so that later loops
+// over the memory mostly find their data on their own node. Without OpenMP support, this does nothing.
+template <typename Size>
+void first_touch(void* p, Size bytes, Size page_size)
+{
+#if (THRUST_DEVICE_COMPILER_IS_OMP_CAPABLE == THRUST_TRUE)
+  typedef thrust::detail::intptr_t index_type;
+
+  char* first = static_cast<char*>(p);
+
+  const index_type num_pages = static_cast<index_type>((bytes + page_size - 1) / page_size);
+
+  thrust::system::detail::internal::uniform_decomposition<index_type> decomp =
+    thrust::system::omp::detail::default_decomposition(num_pages);
+
+  index_type n = static_cast<index_type>(decomp.size());
+
+  THRUST_PRAGMA_OMP(parallel for)
+  for (index_type i = 0; i < n; i++)
+  {
+    for (index_type page = decomp[i].begin(); page != decomp[i].end(); ++page)
+    {
+      *static_cast<volatile char*>(first + page * static_cast<index_type>(page_size)) = 0;
+    }
+  }
+#else
+  (void) p;
+  (void) bytes;
+  (void) page_size;
+#endif // THRUST_DEVICE_COMPILER_IS_OMP_CAPABLE
+}
+
+} // end namespace detail
+} // end namespace omp
+} // end namespace system
+THRUST_NAMESPACE_END
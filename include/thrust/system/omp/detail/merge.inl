@@ -0,0 +1,317 @@
+/*
+ *  Copyright 2024 NVIDIA Corporation
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+#pragma once
+
+#include <thrust/detail/config.h>
+
+#if defined(_CCCL_IMPLICIT_SYSTEM_HEADER_GCC)
+#  pragma GCC system_header
+#elif defined(_CCCL_IMPLICIT_SYSTEM_HEADER_CLANG)
+#  pragma clang system_header
+#elif defined(_CCCL_IMPLICIT_SYSTEM_HEADER_MSVC)
+#  pragma system_header
+#endif // no system header
+#include <thrust/detail/cstdint.h>
+#include <thrust/detail/seq.h>
+#include <thrust/detail/static_assert.h> // for depend_on_instantiation
+#include <thrust/detail/type_traits/minimum_type.h>
+#include <thrust/distance.h>
+#include <thrust/iterator/iterator_traits.h>
+#include <thrust/merge.h>
+#include <thrust/system/detail/internal/merge_path.h>
+#include <thrust/system/omp/detail/default_decomposition.h>
+#include <thrust/system/omp/detail/merge.h>
+#include <thrust/system/omp/detail/pragma_omp.h>
+
+THRUST_NAMESPACE_BEGIN
+namespace system
+{
+namespace omp
+{
+namespace detail
+{
+namespace merge_detail
+{
+
+// The output of the merge is split into one chunk of equal size per processor. The merge path of each chunk
+// boundary co-ranks it into both inputs, and every chunk is then merged sequentially from its two input ranges.
+// Since merge_path breaks ties in favor of the first range, the chunks together are the stable merge.
+
+template <typename DerivedPolicy,
+          typename InputIterator1,
+          typename InputIterator2,
+          typename OutputIterator,
+          typename StrictWeakOrdering>
+OutputIterator merge(
+  execution_policy<DerivedPolicy>&,
+  InputIterator1 first1,
+  InputIterator1 last1,
+  InputIterator2 first2,
+  InputIterator2 last2,
+  OutputIterator result,
+  StrictWeakOrdering comp,
+  thrust::incrementable_traversal_tag)
+{
+  return thrust::merge(thrust::seq, first1, last1, first2, last2, result, comp);
+}
+
+template <typename DerivedPolicy,
+          typename InputIterator1,
+          typename InputIterator2,
+          typename OutputIterator,
+          typename StrictWeakOrdering>
+OutputIterator merge(
+  execution_policy<DerivedPolicy>&,
+  InputIterator1 first1,
+  InputIterator1 last1,
+  InputIterator2 first2,
+  InputIterator2 last2,
+  OutputIterator result,
+  StrictWeakOrdering comp,
+  thrust::random_access_traversal_tag)
+{
+  // we're attempting to launch an omp kernel, assert we're compiling with omp support
+  // ========================================================================
+  // X Note to the user: If you've found this line due to a compiler error, X
+  // X you need to enable OpenMP support in your compiler.                  X
+  // ========================================================================
+  THRUST_STATIC_ASSERT_MSG(
+    (thrust::detail::depend_on_instantiation<InputIterator1,
+                                             (THRUST_DEVICE_COMPILER_IS_OMP_CAPABLE == THRUST_TRUE)>::value),
+    "OpenMP compiler support is not enabled");
+
+  typedef thrust::detail::intptr_t index_type;
+
+  const index_type n1 = thrust::distance(first1, last1);
+  const index_type n2 = thrust::distance(first2, last2);
+
+  thrust::system::detail::internal::uniform_decomposition<index_type> decomp =
+    thrust::system::omp::detail::default_decomposition(n1 + n2);
+
+  const index_type num_chunks = decomp.size();
+
+  if (num_chunks <= 1)
+  {
+    return thrust::merge(thrust::seq, first1, last1, first2, last2, result, comp);
+  }
+
+  THRUST_PRAGMA_OMP(parallel for)
+  for (index_type p = 0; p < num_chunks; p++)
+  {
+    const index_type d0 = decomp[p].begin();
+    const index_type d1 = decomp[p].end();
+
+    const index_type i0 = thrust::system::detail::internal::merge_path(first1, n1, first2, n2, d0, comp);
+    const index_type i1 = thrust::system::detail::internal::merge_path(first1, n1, first2, n2, d1, comp);
+
+    thrust::merge(
+      thrust::seq, first1 + i0, first1 + i1, first2 + (d0 - i0), first2 + (d1 - i1), result + d0, comp);
+  }
+
+  return result + (n1 + n2);
+}
+
+template <typename DerivedPolicy,
+          typename InputIterator1,
+          typename InputIterator2,
+          typename InputIterator3,
+          typename InputIterator4,
+          typename OutputIterator1,
+          typename OutputIterator2,
+          typename StrictWeakOrdering>
+thrust::pair<OutputIterator1, OutputIterator2> merge_by_key(
+  execution_policy<DerivedPolicy>&,
+  InputIterator1 keys_first1,
+  InputIterator1 keys_last1,
+  InputIterator2 keys_first2,
+  InputIterator2 keys_last2,
+  InputIterator3 values_first3,
+  InputIterator4 values_first4,
+  OutputIterator1 keys_result,
+  OutputIterator2 values_result,
+  StrictWeakOrdering comp,
+  thrust::incrementable_traversal_tag)
+{
+  return thrust::merge_by_key(
+    thrust::seq,
+    keys_first1,
+    keys_last1,
+    keys_first2,
+    keys_last2,
+    values_first3,
+    values_first4,
+    keys_result,
+    values_result,
+    comp);
+}
+
+template <typename DerivedPolicy,
+          typename InputIterator1,
+          typename InputIterator2,
+          typename InputIterator3,
+          typename InputIterator4,
+          typename OutputIterator1,
+          typename OutputIterator2,
+          typename StrictWeakOrdering>
+thrust::pair<OutputIterator1, OutputIterator2> merge_by_key(
+  execution_policy<DerivedPolicy>&,
+  InputIterator1 keys_first1,
+  InputIterator1 keys_last1,
+  InputIterator2 keys_first2,
+  InputIterator2 keys_last2,
+  InputIterator3 values_first3,
+  InputIterator4 values_first4,
+  OutputIterator1 keys_result,
+  OutputIterator2 values_result,
+  StrictWeakOrdering comp,
+  thrust::random_access_traversal_tag)
+{
+  // we're attempting to launch an omp kernel, assert we're compiling with omp support
+  // ========================================================================
+  // X Note to the user: If you've found this line due to a compiler error, X
+  // X you need to enable OpenMP support in your compiler.                  X
+  // ========================================================================
+  THRUST_STATIC_ASSERT_MSG(
+    (thrust::detail::depend_on_instantiation<InputIterator1,
+                                             (THRUST_DEVICE_COMPILER_IS_OMP_CAPABLE == THRUST_TRUE)>::value),
+    "OpenMP compiler support is not enabled");
+
+  typedef thrust::detail::intptr_t index_type;
+
+  const index_type n1 = thrust::distance(keys_first1, keys_last1);
+  const index_type n2 = thrust::distance(keys_first2, keys_last2);
+
+  thrust::system::detail::internal::uniform_decomposition<index_type> decomp =
+    thrust::system::omp::detail::default_decomposition(n1 + n2);
+
+  const index_type num_chunks = decomp.size();
+
+  if (num_chunks <= 1)
+  {
+    return thrust::merge_by_key(
+      thrust::seq,
+      keys_first1,
+      keys_last1,
+      keys_first2,
+      keys_last2,
+      values_first3,
+      values_first4,
+      keys_result,
+      values_result,
+      comp);
+  }
+
+  THRUST_PRAGMA_OMP(parallel for)
+  for (index_type p = 0; p < num_chunks; p++)
+  {
+    const index_type d0 = decomp[p].begin();
+    const index_type d1 = decomp[p].end();
+
+    const index_type i0 = thrust::system::detail::internal::merge_path(keys_first1, n1, keys_first2, n2, d0, comp);
+    const index_type i1 = thrust::system::detail::internal::merge_path(keys_first1, n1, keys_first2, n2, d1, comp);
+
+    thrust::merge_by_key(
+      thrust::seq,
+      keys_first1 + i0,
+      keys_first1 + i1,
+      keys_first2 + (d0 - i0),
+      keys_first2 + (d1 - i1),
+      values_first3 + i0,
+      values_first4 + (d0 - i0),
+      keys_result + d0,
+      values_result + d0,
+      comp);
+  }
+
+  return thrust::make_pair(keys_result + (n1 + n2), values_result + (n1 + n2));
+}
+
+} // end namespace merge_detail
+
+template <typename DerivedPolicy,
+          typename InputIterator1,
+          typename InputIterator2,
+          typename OutputIterator,
+          typename StrictWeakOrdering>
+OutputIterator merge(
+  execution_policy<DerivedPolicy>& exec,
+  InputIterator1 first1,
+  InputIterator1 last1,
+  InputIterator2 first2,
+  InputIterator2 last2,
+  OutputIterator result,
+  StrictWeakOrdering comp)
+{
+  typedef typename thrust::iterator_traversal<InputIterator1>::type traversal1;
+  typedef typename thrust::iterator_traversal<InputIterator2>::type traversal2;
+  typedef typename thrust::iterator_traversal<OutputIterator>::type traversal3;
+
+  typedef typename thrust::detail::minimum_type<traversal1, traversal2, traversal3>::type traversal;
+
+  // dispatch on minimum traversal
+  return merge_detail::merge(exec, first1, last1, first2, last2, result, comp, traversal());
+} // end merge()
+
+template <typename DerivedPolicy,
+          typename InputIterator1,
+          typename InputIterator2,
+          typename InputIterator3,
+          typename InputIterator4,
+          typename OutputIterator1,
+          typename OutputIterator2,
+          typename StrictWeakOrdering>
+thrust::pair<OutputIterator1, OutputIterator2> merge_by_key(
+  execution_policy<DerivedPolicy>& exec,
+  InputIterator1 keys_first1,
+  InputIterator1 keys_last1,
+  InputIterator2 keys_first2,
+  InputIterator2 keys_last2,
+  InputIterator3 values_first3,
+  InputIterator4 values_first4,
+  OutputIterator1 keys_result,
+  OutputIterator2 values_result,
+  StrictWeakOrdering comp)
+{
+  typedef typename thrust::iterator_traversal<InputIterator1>::type traversal1;
+  typedef typename thrust::iterator_traversal<InputIterator2>::type traversal2;
+  typedef typename thrust::iterator_traversal<InputIterator3>::type traversal3;
+  typedef typename thrust::iterator_traversal<InputIterator4>::type traversal4;
+  typedef typename thrust::iterator_traversal<OutputIterator1>::type traversal5;
+  typedef typename thrust::iterator_traversal<OutputIterator2>::type traversal6;
+
+  typedef typename thrust::detail::minimum_type<traversal1, traversal2, traversal3, traversal4, traversal5, traversal6>::
+    type traversal;
+
+  // dispatch on minimum traversal
+  return merge_detail::merge_by_key(
+    exec,
+    keys_first1,
+    keys_last1,
+    keys_first2,
+    keys_last2,
+    values_first3,
+    values_first4,
+    keys_result,
+    values_result,
+    comp,
+    traversal());
+} // end merge_by_key()
+
+} // end namespace detail
+} // end namespace omp
+} // end namespace system
+THRUST_NAMESPACE_END
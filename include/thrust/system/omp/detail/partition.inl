@@ -29,8 +29,19 @@
 #elif defined(_CCCL_IMPLICIT_SYSTEM_HEADER_MSVC)
 #  pragma system_header
 #endif // no system header
+#include <thrust/detail/cstdint.h>
+#include <thrust/detail/function.h>
+#include <thrust/detail/seq.h>
+#include <thrust/detail/static_assert.h>
+#include <thrust/detail/temporary_array.h>
+#include <thrust/distance.h>
+#include <thrust/iterator/iterator_traits.h>
+#include <thrust/partition.h>
 #include <thrust/system/detail/generic/partition.h>
+#include <thrust/system/omp/detail/copy_if.h>
+#include <thrust/system/omp/detail/default_decomposition.h>
 #include <thrust/system/omp/detail/partition.h>
+#include <thrust/system/omp/detail/pragma_omp.h>
 
 THRUST_NAMESPACE_BEGIN
 namespace system
@@ -39,6 +50,62 @@ namespace omp
 {
 namespace detail
 {
+namespace partition_detail
+{
+
+// phase 3 of stable_partition_copy: interval i writes its true elements from out_true + true_offsets[i], and its
+// false elements from out_false at the number of false elements before it
+template <typename InputIterator1,
+          typename InputIterator2,
+          typename OutputIterator1,
+          typename OutputIterator2,
+          typename CountIterator,
+          typename Predicate,
+          typename Decomposition>
+void partition_copy_intervals(
+  InputIterator1 first,
+  InputIterator2 stencil,
+  OutputIterator1 out_true,
+  OutputIterator2 out_false,
+  CountIterator true_offsets,
+  Predicate pred,
+  Decomposition decomp)
+{
+#if (THRUST_DEVICE_COMPILER_IS_OMP_CAPABLE == THRUST_TRUE)
+  // wrap pred
+  thrust::detail::wrapped_function<Predicate, bool> wrapped_pred(pred);
+
+  typedef thrust::detail::intptr_t index_type;
+
+  index_type n = static_cast<index_type>(decomp.size());
+
+  THRUST_PRAGMA_OMP(parallel for)
+  for (index_type i = 0; i < n; i++)
+  {
+    InputIterator1 begin      = first + decomp[i].begin();
+    InputIterator1 end        = first + decomp[i].end();
+    InputIterator2 flag       = stencil + decomp[i].begin();
+    OutputIterator1 true_out  = out_true + true_offsets[i];
+    OutputIterator2 false_out = out_false + (decomp[i].begin() - true_offsets[i]);
+
+    for (; begin != end; ++begin, ++flag)
+    {
+      if (wrapped_pred(*flag))
+      {
+        *true_out = *begin;
+        ++true_out;
+      }
+      else
+      {
+        *false_out = *begin;
+        ++false_out;
+      }
+    }
+  }
+#endif // THRUST_DEVICE_COMPILER_IS_OMP_CAPABLE
+}
+
+} // end namespace partition_detail
 
 template <typename DerivedPolicy, typename ForwardIterator, typename Predicate>
 ForwardIterator
@@ -73,8 +140,8 @@ thrust::pair<OutputIterator1, OutputIterator2> stable_partition_copy(
   OutputIterator2 out_false,
   Predicate pred)
 {
-  // omp prefers generic::stable_partition_copy to cpp::stable_partition_copy
-  return thrust::system::detail::generic::stable_partition_copy(exec, first, last, out_true, out_false, pred);
+  // the input is its own stencil
+  return omp::detail::stable_partition_copy(exec, first, last, first, out_true, out_false, pred);
 } // end stable_partition_copy()
 
 template <typename DerivedPolicy,
@@ -92,8 +159,44 @@ thrust::pair<OutputIterator1, OutputIterator2> stable_partition_copy(
   OutputIterator2 out_false,
   Predicate pred)
 {
-  // omp prefers generic::stable_partition_copy to cpp::stable_partition_copy
-  return thrust::system::detail::generic::stable_partition_copy(exec, first, last, stencil, out_true, out_false, pred);
+  // we're attempting to launch an omp kernel, assert we're compiling with omp support
+  // ========================================================================
+  // X Note to the user: If you've found this line due to a compiler error, X
+  // X you need to enable OpenMP support in your compiler.                  X
+  // ========================================================================
+  THRUST_STATIC_ASSERT_MSG(
+    (thrust::detail::depend_on_instantiation<InputIterator1,
+                                             (THRUST_DEVICE_COMPILER_IS_OMP_CAPABLE == THRUST_TRUE)>::value),
+    "OpenMP compiler support is not enabled");
+
+  typedef typename thrust::iterator_difference<InputIterator1>::type Size;
+
+  const Size n = thrust::distance(first, last);
+
+  if (n == 0)
+  {
+    return thrust::make_pair(out_true, out_false);
+  }
+
+  thrust::system::detail::internal::uniform_decomposition<Size> decomp =
+    thrust::system::omp::detail::default_decomposition(n);
+
+  // with a single interval, counting first would only add a pass
+  if (decomp.size() == 1)
+  {
+    return thrust::stable_partition_copy(thrust::seq, first, last, stencil, out_true, out_false, pred);
+  }
+
+  // a single pass of stable_partition_copy writes both partitions, so it only needs to count the true elements
+  thrust::detail::temporary_array<Size, DerivedPolicy> true_offsets(exec, decomp.size());
+
+  copy_if_detail::count_intervals(stencil, true_offsets.begin(), pred, decomp);
+
+  const Size num_true = copy_if_detail::exclusive_scan_counts(true_offsets.begin(), decomp.size());
+
+  partition_detail::partition_copy_intervals(first, stencil, out_true, out_false, true_offsets.begin(), pred, decomp);
+
+  return thrust::make_pair(out_true + num_true, out_false + (n - num_true));
 } // end stable_partition_copy()
 
 } // end namespace detail
@@ -0,0 +1,234 @@
+/*
+ *  Copyright 2008-2013 NVIDIA Corporation
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+#pragma once
+
+#include <thrust/detail/config.h>
+
+#if defined(_CCCL_IMPLICIT_SYSTEM_HEADER_GCC)
+#  pragma GCC system_header
+#elif defined(_CCCL_IMPLICIT_SYSTEM_HEADER_CLANG)
+#  pragma clang system_header
+#elif defined(_CCCL_IMPLICIT_SYSTEM_HEADER_MSVC)
+#  pragma system_header
+#endif // no system header
+#include <thrust/detail/cstdint.h>
+#include <thrust/detail/function.h>
+#include <thrust/detail/seq.h>
+#include <thrust/detail/static_assert.h> // for depend_on_instantiation
+#include <thrust/detail/temporary_array.h>
+#include <thrust/distance.h>
+#include <thrust/iterator/iterator_traits.h>
+#include <thrust/scan.h>
+#include <thrust/system/omp/detail/default_decomposition.h>
+#include <thrust/system/omp/detail/pragma_omp.h>
+#include <thrust/system/omp/detail/reduce_intervals.h>
+#include <thrust/system/omp/detail/scan.h>
+
+THRUST_NAMESPACE_BEGIN
+namespace system
+{
+namespace omp
+{
+namespace detail
+{
+namespace scan_detail
+{
+
+// The scans below are a three-phase reduce-then-scan:
+//   1. every interval of the decomposition is reduced in parallel (reduce_intervals),
+//   2. the interval sums are scanned sequentially into a carry-in per interval,
+//   3. every interval is scanned in parallel, seeded with its carry-in.
+
+// phase 3 of inclusive_scan: carries[i - 1] seeds interval i, interval 0 is unseeded
+template <typename InputIterator,
+          typename OutputIterator,
+          typename CarryIterator,
+          typename BinaryFunction,
+          typename Decomposition>
+void inclusive_scan_intervals(
+  InputIterator input, OutputIterator output, CarryIterator carries, BinaryFunction binary_op, Decomposition decomp)
+{
+#if (THRUST_DEVICE_COMPILER_IS_OMP_CAPABLE == THRUST_TRUE)
+  typedef typename thrust::iterator_value<CarryIterator>::type ValueType;
+
+  // wrap binary_op
+  thrust::detail::wrapped_function<BinaryFunction, ValueType> wrapped_binary_op(binary_op);
+
+  typedef thrust::detail::intptr_t index_type;
+
+  index_type n = static_cast<index_type>(decomp.size());
+
+  THRUST_PRAGMA_OMP(parallel for)
+  for (index_type i = 0; i < n; i++)
+  {
+    InputIterator begin = input + decomp[i].begin();
+    InputIterator end   = input + decomp[i].end();
+    OutputIterator out  = output + decomp[i].begin();
+
+    if (begin != end)
+    {
+      ValueType sum = (i == 0) ? ValueType(*begin) : wrapped_binary_op(carries[i - 1], *begin);
+
+      *out = sum;
+
+      for (++begin, ++out; begin != end; ++begin, ++out)
+      {
+        *out = sum = wrapped_binary_op(sum, *begin);
+      }
+    }
+  }
+#endif // THRUST_DEVICE_COMPILER_IS_OMP_CAPABLE
+}
+
+// phase 3 of exclusive_scan: carries[i] seeds interval i
+template <typename InputIterator,
+          typename OutputIterator,
+          typename CarryIterator,
+          typename BinaryFunction,
+          typename Decomposition>
+void exclusive_scan_intervals(
+  InputIterator input, OutputIterator output, CarryIterator carries, BinaryFunction binary_op, Decomposition decomp)
+{
+#if (THRUST_DEVICE_COMPILER_IS_OMP_CAPABLE == THRUST_TRUE)
+  typedef typename thrust::iterator_value<CarryIterator>::type ValueType;
+
+  // wrap binary_op
+  thrust::detail::wrapped_function<BinaryFunction, ValueType> wrapped_binary_op(binary_op);
+
+  typedef thrust::detail::intptr_t index_type;
+
+  index_type n = static_cast<index_type>(decomp.size());
+
+  THRUST_PRAGMA_OMP(parallel for)
+  for (index_type i = 0; i < n; i++)
+  {
+    InputIterator begin = input + decomp[i].begin();
+    InputIterator end   = input + decomp[i].end();
+    OutputIterator out  = output + decomp[i].begin();
+
+    ValueType sum = carries[i];
+
+    for (; begin != end; ++begin, ++out)
+    {
+      ValueType tmp = *begin; // temporary value allows in-situ scan
+      *out          = sum;
+      sum           = wrapped_binary_op(sum, tmp);
+    }
+  }
+#endif // THRUST_DEVICE_COMPILER_IS_OMP_CAPABLE
+}
+
+} // end namespace scan_detail
+
+template <typename DerivedPolicy, typename InputIterator, typename OutputIterator, typename BinaryFunction>
+OutputIterator inclusive_scan(
+  execution_policy<DerivedPolicy>& exec,
+  InputIterator first,
+  InputIterator last,
+  OutputIterator result,
+  BinaryFunction binary_op)
+{
+  // we're attempting to launch an omp kernel, assert we're compiling with omp support
+  // ========================================================================
+  // X Note to the user: If you've found this line due to a compiler error, X
+  // X you need to enable OpenMP support in your compiler.                  X
+  // ========================================================================
+  THRUST_STATIC_ASSERT_MSG(
+    (thrust::detail::depend_on_instantiation<InputIterator,
+                                             (THRUST_DEVICE_COMPILER_IS_OMP_CAPABLE == THRUST_TRUE)>::value),
+    "OpenMP compiler support is not enabled");
+
+  // Use the input iterator's value type per https://wg21.link/P0571
+  typedef typename thrust::iterator_value<InputIterator>::type ValueType;
+  typedef typename thrust::iterator_difference<InputIterator>::type difference_type;
+
+  const difference_type n = thrust::distance(first, last);
+
+  thrust::system::detail::internal::uniform_decomposition<difference_type> decomp =
+    thrust::system::omp::detail::default_decomposition(n);
+
+  if (decomp.size() <= 1)
+  {
+    return thrust::inclusive_scan(thrust::seq, first, last, result, binary_op);
+  }
+
+  // the sum of every interval, turned into the carry-out of every interval
+  thrust::detail::temporary_array<ValueType, DerivedPolicy> carries(exec, decomp.size());
+
+  thrust::system::omp::detail::reduce_intervals(exec, first, carries.begin(), binary_op, decomp);
+
+  // the last interval's carry-out is never used
+  thrust::inclusive_scan(thrust::seq, carries.begin(), carries.end() - 1, carries.begin(), binary_op);
+
+  scan_detail::inclusive_scan_intervals(first, result, carries.begin(), binary_op, decomp);
+
+  return result + n;
+} // end inclusive_scan()
+
+template <typename DerivedPolicy,
+          typename InputIterator,
+          typename OutputIterator,
+          typename InitialValueType,
+          typename BinaryFunction>
+OutputIterator exclusive_scan(
+  execution_policy<DerivedPolicy>& exec,
+  InputIterator first,
+  InputIterator last,
+  OutputIterator result,
+  InitialValueType init,
+  BinaryFunction binary_op)
+{
+  // we're attempting to launch an omp kernel, assert we're compiling with omp support
+  // ========================================================================
+  // X Note to the user: If you've found this line due to a compiler error, X
+  // X you need to enable OpenMP support in your compiler.                  X
+  // ========================================================================
+  THRUST_STATIC_ASSERT_MSG(
+    (thrust::detail::depend_on_instantiation<InputIterator,
+                                             (THRUST_DEVICE_COMPILER_IS_OMP_CAPABLE == THRUST_TRUE)>::value),
+    "OpenMP compiler support is not enabled");
+
+  // Use the initial value type per https://wg21.link/P0571
+  typedef InitialValueType ValueType;
+  typedef typename thrust::iterator_difference<InputIterator>::type difference_type;
+
+  const difference_type n = thrust::distance(first, last);
+
+  thrust::system::detail::internal::uniform_decomposition<difference_type> decomp =
+    thrust::system::omp::detail::default_decomposition(n);
+
+  if (decomp.size() <= 1)
+  {
+    return thrust::exclusive_scan(thrust::seq, first, last, result, init, binary_op);
+  }
+
+  // the sum of every interval, turned into the carry-in of every interval
+  thrust::detail::temporary_array<ValueType, DerivedPolicy> carries(exec, decomp.size());
+
+  thrust::system::omp::detail::reduce_intervals(exec, first, carries.begin(), binary_op, decomp);
+
+  thrust::exclusive_scan(thrust::seq, carries.begin(), carries.end(), carries.begin(), init, binary_op);
+
+  scan_detail::exclusive_scan_intervals(first, result, carries.begin(), binary_op, decomp);
+
+  return result + n;
+} // end exclusive_scan()
+
+} // end namespace detail
+} // end namespace omp
+} // end namespace system
+THRUST_NAMESPACE_END
@@ -0,0 +1,444 @@
+/*
+ *  Copyright 2008-2013 NVIDIA Corporation
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+#pragma once
+
+#include <thrust/detail/config.h>
+
+#if defined(_CCCL_IMPLICIT_SYSTEM_HEADER_GCC)
+#  pragma GCC system_header
+#elif defined(_CCCL_IMPLICIT_SYSTEM_HEADER_CLANG)
+#  pragma clang system_header
+#elif defined(_CCCL_IMPLICIT_SYSTEM_HEADER_MSVC)
+#  pragma system_header
+#endif // no system header
+#include <thrust/detail/cstdint.h>
+#include <thrust/detail/function.h>
+#include <thrust/detail/seq.h>
+#include <thrust/detail/static_assert.h> // for depend_on_instantiation
+#include <thrust/detail/temporary_array.h>
+#include <thrust/iterator/iterator_traits.h>
+#include <thrust/scan.h>
+#include <thrust/system/omp/detail/default_decomposition.h>
+#include <thrust/system/omp/detail/pragma_omp.h>
+#include <thrust/system/omp/detail/scan_by_key.h>
+
+THRUST_NAMESPACE_BEGIN
+namespace system
+{
+namespace omp
+{
+namespace detail
+{
+namespace scan_by_key_detail
+{
+
+// The segmented scans below carry a (value, head flag) pair across the
+// intervals of the decomposition:
+//   1. every interval records whether its first key starts a segment, whether
+//      it contains any segment head, and the running value it would hand to
+//      the next interval,
+//   2. the per-interval values are combined sequentially, restarting at every
+//      interval that contains a head,
+//   3. every interval is scanned in parallel, seeded with the combined value
+//      of the intervals before it.
+// No per-element flags are materialized.
+
+typedef thrust::detail::uint8_t flag_type;
+
+template <typename InputIterator1,
+          typename InputIterator2,
+          typename ValueIterator,
+          typename FlagIterator,
+          typename BinaryPredicate,
+          typename BinaryFunction,
+          typename Decomposition>
+void inclusive_reduce_intervals(
+  InputIterator1 keys,
+  InputIterator2 values,
+  ValueIterator carries,
+  FlagIterator head_at_begin,
+  FlagIterator has_head,
+  BinaryPredicate binary_pred,
+  BinaryFunction binary_op,
+  Decomposition decomp)
+{
+#if (THRUST_DEVICE_COMPILER_IS_OMP_CAPABLE == THRUST_TRUE)
+  typedef typename thrust::iterator_value<InputIterator1>::type KeyType;
+  typedef typename thrust::iterator_value<ValueIterator>::type ValueType;
+
+  // wrap binary_op
+  thrust::detail::wrapped_function<BinaryFunction, ValueType> wrapped_binary_op(binary_op);
+
+  typedef thrust::detail::intptr_t index_type;
+
+  index_type n = static_cast<index_type>(decomp.size());
+
+  THRUST_PRAGMA_OMP(parallel for)
+  for (index_type i = 0; i < n; i++)
+  {
+    const index_type begin = decomp[i].begin();
+    const index_type end   = decomp[i].end();
+
+    const bool head = (i == 0) || !binary_pred(keys[begin - 1], keys[begin]);
+    bool any_head   = head;
+
+    KeyType prev_key = keys[begin];
+    ValueType sum    = values[begin];
+
+    for (index_type j = begin + 1; j < end; ++j)
+    {
+      KeyType key = keys[j];
+
+      if (binary_pred(prev_key, key))
+      {
+        sum = wrapped_binary_op(sum, values[j]);
+      }
+      else
+      {
+        sum      = values[j];
+        any_head = true;
+      }
+
+      prev_key = key;
+    }
+
+    carries[i]       = sum;
+    head_at_begin[i] = head;
+    has_head[i]      = any_head;
+  }
+#endif // THRUST_DEVICE_COMPILER_IS_OMP_CAPABLE
+}
+
+template <typename InputIterator1,
+          typename InputIterator2,
+          typename OutputIterator,
+          typename ValueIterator,
+          typename FlagIterator,
+          typename BinaryPredicate,
+          typename BinaryFunction,
+          typename Decomposition>
+void inclusive_scan_intervals(
+  InputIterator1 keys,
+  InputIterator2 values,
+  OutputIterator output,
+  ValueIterator carries,
+  FlagIterator head_at_begin,
+  BinaryPredicate binary_pred,
+  BinaryFunction binary_op,
+  Decomposition decomp)
+{
+#if (THRUST_DEVICE_COMPILER_IS_OMP_CAPABLE == THRUST_TRUE)
+  typedef typename thrust::iterator_value<InputIterator1>::type KeyType;
+  typedef typename thrust::iterator_value<ValueIterator>::type ValueType;
+
+  // wrap binary_op
+  thrust::detail::wrapped_function<BinaryFunction, ValueType> wrapped_binary_op(binary_op);
+
+  typedef thrust::detail::intptr_t index_type;
+
+  index_type n = static_cast<index_type>(decomp.size());
+
+  THRUST_PRAGMA_OMP(parallel for)
+  for (index_type i = 0; i < n; i++)
+  {
+    const index_type begin = decomp[i].begin();
+    const index_type end   = decomp[i].end();
+
+    KeyType prev_key = keys[begin];
+    ValueType sum    = head_at_begin[i] ? ValueType(values[begin]) : wrapped_binary_op(carries[i - 1], values[begin]);
+
+    output[begin] = sum;
+
+    for (index_type j = begin + 1; j < end; ++j)
+    {
+      KeyType key = keys[j];
+
+      if (binary_pred(prev_key, key))
+      {
+        output[j] = sum = wrapped_binary_op(sum, values[j]);
+      }
+      else
+      {
+        output[j] = sum = values[j];
+      }
+
+      prev_key = key;
+    }
+  }
+#endif // THRUST_DEVICE_COMPILER_IS_OMP_CAPABLE
+}
+
+template <typename InputIterator1,
+          typename InputIterator2,
+          typename ValueIterator,
+          typename FlagIterator,
+          typename T,
+          typename BinaryPredicate,
+          typename BinaryFunction,
+          typename Decomposition>
+void exclusive_reduce_intervals(
+  InputIterator1 keys,
+  InputIterator2 values,
+  ValueIterator carries,
+  FlagIterator head_at_begin,
+  FlagIterator has_head,
+  T init,
+  BinaryPredicate binary_pred,
+  BinaryFunction binary_op,
+  Decomposition decomp)
+{
+#if (THRUST_DEVICE_COMPILER_IS_OMP_CAPABLE == THRUST_TRUE)
+  typedef typename thrust::iterator_value<InputIterator1>::type KeyType;
+  typedef typename thrust::iterator_value<ValueIterator>::type ValueType;
+
+  // wrap binary_op
+  thrust::detail::wrapped_function<BinaryFunction, ValueType> wrapped_binary_op(binary_op);
+
+  typedef thrust::detail::intptr_t index_type;
+
+  index_type n = static_cast<index_type>(decomp.size());
+
+  THRUST_PRAGMA_OMP(parallel for)
+  for (index_type i = 0; i < n; i++)
+  {
+    const index_type begin = decomp[i].begin();
+    const index_type end   = decomp[i].end();
+
+    const bool head = (i == 0) || !binary_pred(keys[begin - 1], keys[begin]);
+    bool any_head   = head;
+
+    KeyType prev_key = keys[begin];
+    ValueType sum    = head ? wrapped_binary_op(init, values[begin]) : ValueType(values[begin]);
+
+    for (index_type j = begin + 1; j < end; ++j)
+    {
+      KeyType key = keys[j];
+
+      if (binary_pred(prev_key, key))
+      {
+        sum = wrapped_binary_op(sum, values[j]);
+      }
+      else
+      {
+        sum      = wrapped_binary_op(init, values[j]);
+        any_head = true;
+      }
+
+      prev_key = key;
+    }
+
+    carries[i]       = sum;
+    head_at_begin[i] = head;
+    has_head[i]      = any_head;
+  }
+#endif // THRUST_DEVICE_COMPILER_IS_OMP_CAPABLE
+}
+
+template <typename InputIterator1,
+          typename InputIterator2,
+          typename OutputIterator,
+          typename ValueIterator,
+          typename FlagIterator,
+          typename T,
+          typename BinaryPredicate,
+          typename BinaryFunction,
+          typename Decomposition>
+void exclusive_scan_intervals(
+  InputIterator1 keys,
+  InputIterator2 values,
+  OutputIterator output,
+  ValueIterator carries,
+  FlagIterator head_at_begin,
+  T init,
+  BinaryPredicate binary_pred,
+  BinaryFunction binary_op,
+  Decomposition decomp)
+{
+#if (THRUST_DEVICE_COMPILER_IS_OMP_CAPABLE == THRUST_TRUE)
+  typedef typename thrust::iterator_value<InputIterator1>::type KeyType;
+  typedef typename thrust::iterator_value<ValueIterator>::type ValueType;
+
+  // wrap binary_op
+  thrust::detail::wrapped_function<BinaryFunction, ValueType> wrapped_binary_op(binary_op);
+
+  typedef thrust::detail::intptr_t index_type;
+
+  index_type n = static_cast<index_type>(decomp.size());
+
+  THRUST_PRAGMA_OMP(parallel for)
+  for (index_type i = 0; i < n; i++)
+  {
+    const index_type begin = decomp[i].begin();
+    const index_type end   = decomp[i].end();
+
+    KeyType prev_key = keys[begin];
+    ValueType next   = head_at_begin[i] ? ValueType(init) : ValueType(carries[i - 1]);
+
+    for (index_type j = begin; j < end; ++j)
+    {
+      KeyType key = keys[j];
+
+      if (j != begin && !binary_pred(prev_key, key))
+      {
+        next = init; // reset sum
+      }
+
+      // use temp to permit in-place scans
+      ValueType temp = values[j];
+      output[j]      = next;
+      next           = wrapped_binary_op(next, temp);
+
+      prev_key = key;
+    }
+  }
+#endif // THRUST_DEVICE_COMPILER_IS_OMP_CAPABLE
+}
+
+// phase 2: carries[i] becomes the value handed to interval i + 1
+template <typename ValueIterator, typename FlagIterator, typename Size, typename BinaryFunction>
+void combine_carries(ValueIterator carries, FlagIterator has_head, Size n, BinaryFunction binary_op)
+{
+  typedef typename thrust::iterator_value<ValueIterator>::type ValueType;
+
+  // wrap binary_op
+  thrust::detail::wrapped_function<BinaryFunction, ValueType> wrapped_binary_op(binary_op);
+
+  for (Size i = 1; i < n; ++i)
+  {
+    if (!has_head[i])
+    {
+      carries[i] = wrapped_binary_op(carries[i - 1], carries[i]);
+    }
+  }
+}
+
+} // end namespace scan_by_key_detail
+
+template <typename DerivedPolicy,
+          typename InputIterator1,
+          typename InputIterator2,
+          typename OutputIterator,
+          typename BinaryPredicate,
+          typename BinaryFunction>
+OutputIterator inclusive_scan_by_key(
+  execution_policy<DerivedPolicy>& exec,
+  InputIterator1 first1,
+  InputIterator1 last1,
+  InputIterator2 first2,
+  OutputIterator result,
+  BinaryPredicate binary_pred,
+  BinaryFunction binary_op)
+{
+  // we're attempting to launch an omp kernel, assert we're compiling with omp support
+  // ========================================================================
+  // X Note to the user: If you've found this line due to a compiler error, X
+  // X you need to enable OpenMP support in your compiler.                  X
+  // ========================================================================
+  THRUST_STATIC_ASSERT_MSG(
+    (thrust::detail::depend_on_instantiation<InputIterator1,
+                                             (THRUST_DEVICE_COMPILER_IS_OMP_CAPABLE == THRUST_TRUE)>::value),
+    "OpenMP compiler support is not enabled");
+
+  typedef typename thrust::iterator_value<InputIterator2>::type ValueType;
+  typedef typename thrust::iterator_difference<InputIterator1>::type difference_type;
+  typedef scan_by_key_detail::flag_type flag_type;
+
+  const difference_type n = last1 - first1;
+
+  thrust::system::detail::internal::uniform_decomposition<difference_type> decomp =
+    thrust::system::omp::detail::default_decomposition(n);
+
+  if (decomp.size() <= 1)
+  {
+    return thrust::inclusive_scan_by_key(thrust::seq, first1, last1, first2, result, binary_pred, binary_op);
+  }
+
+  thrust::detail::temporary_array<ValueType, DerivedPolicy> carries(exec, decomp.size());
+  thrust::detail::temporary_array<flag_type, DerivedPolicy> head_at_begin(exec, decomp.size());
+  thrust::detail::temporary_array<flag_type, DerivedPolicy> has_head(exec, decomp.size());
+
+  scan_by_key_detail::inclusive_reduce_intervals(
+    first1, first2, carries.begin(), head_at_begin.begin(), has_head.begin(), binary_pred, binary_op, decomp);
+
+  scan_by_key_detail::combine_carries(carries.begin(), has_head.begin(), decomp.size(), binary_op);
+
+  scan_by_key_detail::inclusive_scan_intervals(
+    first1, first2, result, carries.begin(), head_at_begin.begin(), binary_pred, binary_op, decomp);
+
+  return result + n;
+} // end inclusive_scan_by_key()
+
+template <typename DerivedPolicy,
+          typename InputIterator1,
+          typename InputIterator2,
+          typename OutputIterator,
+          typename T,
+          typename BinaryPredicate,
+          typename BinaryFunction>
+OutputIterator exclusive_scan_by_key(
+  execution_policy<DerivedPolicy>& exec,
+  InputIterator1 first1,
+  InputIterator1 last1,
+  InputIterator2 first2,
+  OutputIterator result,
+  T init,
+  BinaryPredicate binary_pred,
+  BinaryFunction binary_op)
+{
+  // we're attempting to launch an omp kernel, assert we're compiling with omp support
+  // ========================================================================
+  // X Note to the user: If you've found this line due to a compiler error, X
+  // X you need to enable OpenMP support in your compiler.                  X
+  // ========================================================================
+  THRUST_STATIC_ASSERT_MSG(
+    (thrust::detail::depend_on_instantiation<InputIterator1,
+                                             (THRUST_DEVICE_COMPILER_IS_OMP_CAPABLE == THRUST_TRUE)>::value),
+    "OpenMP compiler support is not enabled");
+
+  typedef T ValueType;
+  typedef typename thrust::iterator_difference<InputIterator1>::type difference_type;
+  typedef scan_by_key_detail::flag_type flag_type;
+
+  const difference_type n = last1 - first1;
+
+  thrust::system::detail::internal::uniform_decomposition<difference_type> decomp =
+    thrust::system::omp::detail::default_decomposition(n);
+
+  if (decomp.size() <= 1)
+  {
+    return thrust::exclusive_scan_by_key(thrust::seq, first1, last1, first2, result, init, binary_pred, binary_op);
+  }
+
+  thrust::detail::temporary_array<ValueType, DerivedPolicy> carries(exec, decomp.size());
+  thrust::detail::temporary_array<flag_type, DerivedPolicy> head_at_begin(exec, decomp.size());
+  thrust::detail::temporary_array<flag_type, DerivedPolicy> has_head(exec, decomp.size());
+
+  scan_by_key_detail::exclusive_reduce_intervals(
+    first1, first2, carries.begin(), head_at_begin.begin(), has_head.begin(), init, binary_pred, binary_op, decomp);
+
+  scan_by_key_detail::combine_carries(carries.begin(), has_head.begin(), decomp.size(), binary_op);
+
+  scan_by_key_detail::exclusive_scan_intervals(
+    first1, first2, result, carries.begin(), head_at_begin.begin(), init, binary_pred, binary_op, decomp);
+
+  return result + n;
+} // end exclusive_scan_by_key()
+
+} // end namespace detail
+} // end namespace omp
+} // end namespace system
+THRUST_NAMESPACE_END
@@ -0,0 +1,251 @@
+/*
+ *  Copyright 2008-2013 NVIDIA Corporation
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+#pragma once
+
+#include <thrust/detail/config.h>
+
+#if defined(_CCCL_IMPLICIT_SYSTEM_HEADER_GCC)
+#  pragma GCC system_header
+#elif defined(_CCCL_IMPLICIT_SYSTEM_HEADER_CLANG)
+#  pragma clang system_header
+#elif defined(_CCCL_IMPLICIT_SYSTEM_HEADER_MSVC)
+#  pragma system_header
+#endif // no system header
+#include <thrust/detail/cstdint.h>
+#include <thrust/detail/seq.h>
+#include <thrust/detail/static_assert.h> // for depend_on_instantiation
+#include <thrust/detail/temporary_array.h>
+#include <thrust/detail/type_traits/minimum_type.h>
+#include <thrust/distance.h>
+#include <thrust/iterator/iterator_traits.h>
+#include <thrust/scan.h>
+#include <thrust/system/detail/internal/set_operations.h>
+#include <thrust/system/omp/detail/default_decomposition.h>
+#include <thrust/system/omp/detail/pragma_omp.h>
+#include <thrust/system/omp/detail/set_operations.h>
+
+THRUST_NAMESPACE_BEGIN
+namespace system
+{
+namespace omp
+{
+namespace detail
+{
+namespace set_operations_detail
+{
+
+template <typename DerivedPolicy,
+          typename InputIterator1,
+          typename InputIterator2,
+          typename OutputIterator,
+          typename StrictWeakOrdering,
+          typename SetOperation>
+OutputIterator set_operation(
+  execution_policy<DerivedPolicy>&,
+  InputIterator1 first1,
+  InputIterator1 last1,
+  InputIterator2 first2,
+  InputIterator2 last2,
+  OutputIterator result,
+  StrictWeakOrdering comp,
+  SetOperation set_op,
+  thrust::incrementable_traversal_tag)
+{
+  return set_op(first1, last1, first2, last2, result, comp);
+}
+
+template <typename DerivedPolicy,
+          typename InputIterator1,
+          typename InputIterator2,
+          typename OutputIterator,
+          typename StrictWeakOrdering,
+          typename SetOperation>
+OutputIterator set_operation(
+  execution_policy<DerivedPolicy>& exec,
+  InputIterator1 first1,
+  InputIterator1 last1,
+  InputIterator2 first2,
+  InputIterator2 last2,
+  OutputIterator result,
+  StrictWeakOrdering comp,
+  SetOperation set_op,
+  thrust::random_access_traversal_tag)
+{
+  // we're attempting to launch an omp kernel, assert we're compiling with omp support
+  // ========================================================================
+  // X Note to the user: If you've found this line due to a compiler error, X
+  // X you need to enable OpenMP support in your compiler.                  X
+  // ========================================================================
+  THRUST_STATIC_ASSERT_MSG(
+    (thrust::detail::depend_on_instantiation<InputIterator1,
+                                             (THRUST_DEVICE_COMPILER_IS_OMP_CAPABLE == THRUST_TRUE)>::value),
+    "OpenMP compiler support is not enabled");
+
+  namespace set_ops = thrust::system::detail::internal::set_operations_detail;
+
+  typedef thrust::detail::intptr_t index_type;
+
+  const index_type n1 = thrust::distance(first1, last1);
+  const index_type n2 = thrust::distance(first2, last2);
+
+  const index_type num_partitions = thrust::system::omp::detail::default_decomposition(n1 + n2).size();
+
+  if (num_partitions <= 1)
+  {
+    return set_op(first1, last1, first2, last2, result, comp);
+  }
+
+  thrust::detail::temporary_array<index_type, DerivedPolicy> splits1(exec, num_partitions + 1);
+  thrust::detail::temporary_array<index_type, DerivedPolicy> splits2(exec, num_partitions + 1);
+  thrust::detail::temporary_array<index_type, DerivedPolicy> offsets(exec, num_partitions + 1);
+
+  set_ops::partition_inputs(first1, n1, first2, n2, num_partitions, splits1.begin(), splits2.begin(), comp);
+
+  // count the output of every partition
+  THRUST_PRAGMA_OMP(parallel for)
+  for (index_type p = 0; p < num_partitions; p++)
+  {
+    offsets[p] = set_ops::count_partition(set_op, first1, first2, splits1.begin(), splits2.begin(), p, comp);
+  }
+
+  offsets[num_partitions] = 0;
+
+  thrust::exclusive_scan(thrust::seq, offsets.begin(), offsets.end(), offsets.begin());
+
+  // write every partition at its offset
+  THRUST_PRAGMA_OMP(parallel for)
+  for (index_type p = 0; p < num_partitions; p++)
+  {
+    set_ops::write_partition(
+      set_op, first1, first2, result, splits1.begin(), splits2.begin(), offsets.begin(), p, comp);
+  }
+
+  return result + offsets[num_partitions];
+}
+
+template <typename DerivedPolicy,
+          typename InputIterator1,
+          typename InputIterator2,
+          typename OutputIterator,
+          typename StrictWeakOrdering,
+          typename SetOperation>
+OutputIterator set_operation(
+  execution_policy<DerivedPolicy>& exec,
+  InputIterator1 first1,
+  InputIterator1 last1,
+  InputIterator2 first2,
+  InputIterator2 last2,
+  OutputIterator result,
+  StrictWeakOrdering comp,
+  SetOperation set_op)
+{
+  typedef typename thrust::iterator_traversal<InputIterator1>::type traversal1;
+  typedef typename thrust::iterator_traversal<InputIterator2>::type traversal2;
+  typedef typename thrust::iterator_traversal<OutputIterator>::type traversal3;
+
+  typedef typename thrust::detail::minimum_type<traversal1, traversal2, traversal3>::type traversal;
+
+  // dispatch on minimum traversal
+  return set_operations_detail::set_operation(exec, first1, last1, first2, last2, result, comp, set_op, traversal());
+}
+
+} // end namespace set_operations_detail
+
+template <typename DerivedPolicy,
+          typename InputIterator1,
+          typename InputIterator2,
+          typename OutputIterator,
+          typename StrictWeakOrdering>
+OutputIterator set_difference(
+  execution_policy<DerivedPolicy>& exec,
+  InputIterator1 first1,
+  InputIterator1 last1,
+  InputIterator2 first2,
+  InputIterator2 last2,
+  OutputIterator result,
+  StrictWeakOrdering comp)
+{
+  namespace set_ops = thrust::system::detail::internal::set_operations_detail;
+
+  return set_operations_detail::set_operation(
+    exec, first1, last1, first2, last2, result, comp, set_ops::set_difference_op());
+} // end set_difference()
+
+template <typename DerivedPolicy,
+          typename InputIterator1,
+          typename InputIterator2,
+          typename OutputIterator,
+          typename StrictWeakOrdering>
+OutputIterator set_intersection(
+  execution_policy<DerivedPolicy>& exec,
+  InputIterator1 first1,
+  InputIterator1 last1,
+  InputIterator2 first2,
+  InputIterator2 last2,
+  OutputIterator result,
+  StrictWeakOrdering comp)
+{
+  namespace set_ops = thrust::system::detail::internal::set_operations_detail;
+
+  return set_operations_detail::set_operation(
+    exec, first1, last1, first2, last2, result, comp, set_ops::set_intersection_op());
+} // end set_intersection()
+
+template <typename DerivedPolicy,
+          typename InputIterator1,
+          typename InputIterator2,
+          typename OutputIterator,
+          typename StrictWeakOrdering>
+OutputIterator set_symmetric_difference(
+  execution_policy<DerivedPolicy>& exec,
+  InputIterator1 first1,
+  InputIterator1 last1,
+  InputIterator2 first2,
+  InputIterator2 last2,
+  OutputIterator result,
+  StrictWeakOrdering comp)
+{
+  namespace set_ops = thrust::system::detail::internal::set_operations_detail;
+
+  return set_operations_detail::set_operation(
+    exec, first1, last1, first2, last2, result, comp, set_ops::set_symmetric_difference_op());
+} // end set_symmetric_difference()
+
+template <typename DerivedPolicy,
+          typename InputIterator1,
+          typename InputIterator2,
+          typename OutputIterator,
+          typename StrictWeakOrdering>
+OutputIterator set_union(
+  execution_policy<DerivedPolicy>& exec,
+  InputIterator1 first1,
+  InputIterator1 last1,
+  InputIterator2 first2,
+  InputIterator2 last2,
+  OutputIterator result,
+  StrictWeakOrdering comp)
+{
+  namespace set_ops = thrust::system::detail::internal::set_operations_detail;
+
+  return set_operations_detail::set_operation(
+    exec, first1, last1, first2, last2, result, comp, set_ops::set_union_op());
+} // end set_union()
+
+} // end namespace detail
+} // end namespace omp
+} // end namespace system
+THRUST_NAMESPACE_END
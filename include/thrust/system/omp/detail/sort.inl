@@ -31,14 +31,22 @@
 #  include <omp.h>
 #endif // omp support
 
+#include <thrust/copy.h>
 #include <thrust/detail/seq.h>
 #include <thrust/detail/temporary_array.h>
+#include <thrust/extrema.h>
 #include <thrust/iterator/iterator_traits.h>
 #include <thrust/merge.h>
+#include <thrust/reverse.h>
 #include <thrust/sort.h>
 #include <thrust/system/detail/generic/select_system.h>
+#include <thrust/system/detail/internal/merge_path.h>
+#include <thrust/system/detail/internal/radix_sort.h>
+#include <thrust/system/detail/sequential/sort.h>
 #include <thrust/system/omp/detail/default_decomposition.h>
 
+#include <cstddef>
+
 THRUST_NAMESPACE_BEGIN
 namespace system
 {
@@ -49,76 +57,298 @@ namespace detail
 namespace sort_detail
 {
 
-template <typename DerivedPolicy, typename RandomAccessIterator, typename StrictWeakOrdering>
-void inplace_merge(execution_policy<DerivedPolicy>& exec,
-                   RandomAccessIterator first,
-                   RandomAccessIterator middle,
-                   RandomAccessIterator last,
-                   StrictWeakOrdering comp)
+// Merges every pair of adjacent runs of `run_tiles` tiles of `decomp` from
+// `src` into `dst`. Rather than giving each pair to a single thread, the
+// output of the whole level is split evenly among the threads of the team,
+// and each thread locates its piece of every pair it overlaps with a merge
+// path search. Must be called by every thread of the team.
+template <typename IndexType, typename RandomAccessIterator1, typename RandomAccessIterator2, typename StrictWeakOrdering>
+void merge_level(const thrust::system::detail::internal::uniform_decomposition<IndexType>& decomp,
+                 IndexType run_tiles,
+                 RandomAccessIterator1 src,
+                 RandomAccessIterator2 dst,
+                 IndexType p_i,
+                 IndexType num_threads,
+                 StrictWeakOrdering comp)
 {
-  typedef typename thrust::iterator_value<RandomAccessIterator>::type value_type;
+  const IndexType n = decomp[decomp.size() - 1].end();
+
+  thrust::system::detail::internal::uniform_decomposition<IndexType> work(n, 1, num_threads);
+
+  if (p_i >= work.size())
+  {
+    return;
+  }
+
+  const IndexType lo = work[p_i].begin();
+  const IndexType hi = work[p_i].end();
+
+  for (IndexType tile = 0; tile < decomp.size(); tile += 2 * run_tiles)
+  {
+    const IndexType mid_tile  = thrust::min<IndexType>(tile + run_tiles, decomp.size());
+    const IndexType last_tile = thrust::min<IndexType>(tile + 2 * run_tiles, decomp.size());
 
-  thrust::detail::temporary_array<value_type, DerivedPolicy> a(exec, first, middle);
-  thrust::detail::temporary_array<value_type, DerivedPolicy> b(exec, middle, last);
+    const IndexType begin  = decomp[tile].begin();
+    const IndexType middle = decomp[mid_tile - 1].end();
+    const IndexType end    = decomp[last_tile - 1].end();
 
-  thrust::merge(thrust::seq, a.begin(), a.end(), b.begin(), b.end(), first, comp);
+    if (end <= lo)
+    {
+      continue;
+    }
+    if (begin >= hi)
+    {
+      break;
+    }
+
+    const IndexType n1 = middle - begin;
+    const IndexType n2 = end - middle;
+
+    const IndexType d0 = thrust::max<IndexType>(lo, begin) - begin;
+    const IndexType d1 = thrust::min<IndexType>(hi, end) - begin;
+
+    const IndexType i0 = thrust::system::detail::internal::merge_path(src + begin, n1, src + middle, n2, d0, comp);
+    const IndexType i1 = thrust::system::detail::internal::merge_path(src + begin, n1, src + middle, n2, d1, comp);
+
+    thrust::merge(thrust::seq,
+                  src + begin + i0,
+                  src + begin + i1,
+                  src + middle + (d0 - i0),
+                  src + middle + (d1 - i1),
+                  dst + begin + d0,
+                  comp);
+  }
 }
 
-template <typename DerivedPolicy,
+template <typename IndexType,
           typename RandomAccessIterator1,
           typename RandomAccessIterator2,
+          typename RandomAccessIterator3,
+          typename RandomAccessIterator4,
           typename StrictWeakOrdering>
-void inplace_merge_by_key(
-  execution_policy<DerivedPolicy>& exec,
-  RandomAccessIterator1 first1,
-  RandomAccessIterator1 middle1,
-  RandomAccessIterator1 last1,
-  RandomAccessIterator2 first2,
-  StrictWeakOrdering comp)
+void merge_level_by_key(const thrust::system::detail::internal::uniform_decomposition<IndexType>& decomp,
+                        IndexType run_tiles,
+                        RandomAccessIterator1 keys_src,
+                        RandomAccessIterator2 values_src,
+                        RandomAccessIterator3 keys_dst,
+                        RandomAccessIterator4 values_dst,
+                        IndexType p_i,
+                        IndexType num_threads,
+                        StrictWeakOrdering comp)
 {
-  typedef typename thrust::iterator_value<RandomAccessIterator1>::type value_type1;
-  typedef typename thrust::iterator_value<RandomAccessIterator2>::type value_type2;
+  const IndexType n = decomp[decomp.size() - 1].end();
+
+  thrust::system::detail::internal::uniform_decomposition<IndexType> work(n, 1, num_threads);
+
+  if (p_i >= work.size())
+  {
+    return;
+  }
+
+  const IndexType lo = work[p_i].begin();
+  const IndexType hi = work[p_i].end();
+
+  for (IndexType tile = 0; tile < decomp.size(); tile += 2 * run_tiles)
+  {
+    const IndexType mid_tile  = thrust::min<IndexType>(tile + run_tiles, decomp.size());
+    const IndexType last_tile = thrust::min<IndexType>(tile + 2 * run_tiles, decomp.size());
+
+    const IndexType begin  = decomp[tile].begin();
+    const IndexType middle = decomp[mid_tile - 1].end();
+    const IndexType end    = decomp[last_tile - 1].end();
+
+    if (end <= lo)
+    {
+      continue;
+    }
+    if (begin >= hi)
+    {
+      break;
+    }
+
+    const IndexType n1 = middle - begin;
+    const IndexType n2 = end - middle;
+
+    const IndexType d0 = thrust::max<IndexType>(lo, begin) - begin;
+    const IndexType d1 = thrust::min<IndexType>(hi, end) - begin;
+
+    const IndexType i0 =
+      thrust::system::detail::internal::merge_path(keys_src + begin, n1, keys_src + middle, n2, d0, comp);
+    const IndexType i1 =
+      thrust::system::detail::internal::merge_path(keys_src + begin, n1, keys_src + middle, n2, d1, comp);
+
+    thrust::merge_by_key(
+      thrust::seq,
+      keys_src + begin + i0,
+      keys_src + begin + i1,
+      keys_src + middle + (d0 - i0),
+      keys_src + middle + (d1 - i1),
+      values_src + begin + i0,
+      values_src + middle + (d0 - i0),
+      keys_dst + begin + d0,
+      values_dst + begin + d0,
+      comp);
+  }
+}
+
+// Copies [src, src + n) to dst, split evenly among the threads of the team.
+template <typename IndexType, typename RandomAccessIterator1, typename RandomAccessIterator2>
+void copy_tile(IndexType n, RandomAccessIterator1 src, RandomAccessIterator2 dst, IndexType p_i, IndexType num_threads)
+{
+  thrust::system::detail::internal::uniform_decomposition<IndexType> work(n, 1, num_threads);
+
+  if (p_i < work.size())
+  {
+    thrust::copy(thrust::seq, src + work[p_i].begin(), src + work[p_i].end(), dst + work[p_i].begin());
+  }
+}
+
+// below this size the sequential radix sort beats the parallel one
+const static int radix_sort_threshold = 128 * 1024;
+
+template <bool HasValues,
+          typename DerivedPolicy,
+          typename RandomAccessIterator1,
+          typename RandomAccessIterator2,
+          typename IndexType>
+void radix_sort(
+  execution_policy<DerivedPolicy>& exec, RandomAccessIterator1 keys, RandomAccessIterator2 values, IndexType n)
+{
+  // Avoid issues on compilers that don't provide `omp_get_num_threads()`.
+#if (THRUST_DEVICE_COMPILER_IS_OMP_CAPABLE == THRUST_TRUE)
+  typedef typename thrust::iterator_value<RandomAccessIterator1>::type KeyType;
+  typedef typename thrust::iterator_value<RandomAccessIterator2>::type ValueType;
+  typedef thrust::system::detail::internal::radix_sort_detail::radix_sort_traits<KeyType> traits;
+
+  namespace radix = thrust::system::detail::internal::radix_sort_detail;
+
+  // every pass scatters between the input and a single scratch buffer
+  thrust::detail::temporary_array<KeyType, DerivedPolicy> keys_buffer(exec, n);
+  thrust::detail::temporary_array<ValueType, DerivedPolicy> values_buffer(exec, HasValues ? n : 0);
+
+  // one histogram per thread, laid out thread-major
+  thrust::detail::temporary_array<std::size_t, DerivedPolicy> histograms(
+    exec, static_cast<std::size_t>(omp_get_max_threads()) * traits::num_buckets);
+
+  std::size_t* histograms_ptr = thrust::raw_pointer_cast(histograms.data());
+
+  // whether the current pass has more than one populated bucket
+  bool do_scatter = false;
+
+  THRUST_PRAGMA_OMP(parallel)
+  {
+    const IndexType num_threads = omp_get_num_threads();
 
-  RandomAccessIterator2 middle2 = first2 + (middle1 - first1);
-  RandomAccessIterator2 last2   = first2 + (last1 - first1);
+    thrust::system::detail::internal::uniform_decomposition<IndexType> decomp(n, 1, num_threads);
 
-  thrust::detail::temporary_array<value_type1, DerivedPolicy> lhs1(exec, first1, middle1);
-  thrust::detail::temporary_array<value_type1, DerivedPolicy> rhs1(exec, middle1, last1);
-  thrust::detail::temporary_array<value_type2, DerivedPolicy> lhs2(exec, first2, middle2);
-  thrust::detail::temporary_array<value_type2, DerivedPolicy> rhs2(exec, middle2, last2);
+    // process id
+    IndexType p_i = omp_get_thread_num();
 
-  thrust::merge_by_key(
-    thrust::seq, lhs1.begin(), lhs1.end(), rhs1.begin(), rhs1.end(), lhs2.begin(), rhs2.begin(), first1, first2, comp);
+    std::size_t* histogram = histograms_ptr + p_i * traits::num_buckets;
+
+    bool in_buffer = false;
+
+    for (unsigned int pass = 0; pass < traits::num_passes; ++pass)
+    {
+      if (p_i < decomp.size())
+      {
+        if (in_buffer)
+        {
+          radix::histogram_tile(keys_buffer.begin(), decomp[p_i].begin(), decomp[p_i].end(), pass, histogram);
+        }
+        else
+        {
+          radix::histogram_tile(keys, decomp[p_i].begin(), decomp[p_i].end(), pass, histogram);
+        }
+      }
+
+      THRUST_PRAGMA_OMP(barrier)
+
+      THRUST_PRAGMA_OMP(single)
+      do_scatter = radix::scan_histograms<KeyType>(histograms_ptr, decomp.size(), static_cast<std::size_t>(n));
+
+      // skip passes whose digit is the same for every key
+      if (do_scatter)
+      {
+        if (p_i < decomp.size())
+        {
+          if (in_buffer)
+          {
+            radix::scatter_tile<HasValues>(
+              keys_buffer.begin(),
+              values_buffer.begin(),
+              decomp[p_i].begin(),
+              decomp[p_i].end(),
+              keys,
+              values,
+              pass,
+              histogram);
+          }
+          else
+          {
+            radix::scatter_tile<HasValues>(
+              keys,
+              values,
+              decomp[p_i].begin(),
+              decomp[p_i].end(),
+              keys_buffer.begin(),
+              values_buffer.begin(),
+              pass,
+              histogram);
+          }
+        }
+
+        in_buffer = !in_buffer;
+
+        THRUST_PRAGMA_OMP(barrier)
+      }
+    }
+
+    if (in_buffer)
+    {
+      copy_tile(n, keys_buffer.begin(), keys, p_i, num_threads);
+
+      if (HasValues)
+      {
+        copy_tile(n, values_buffer.begin(), values, p_i, num_threads);
+      }
+    }
+  }
+#endif // THRUST_DEVICE_COMPILER_IS_OMP_CAPABLE
 }
 
 } // namespace sort_detail
 
-template <typename DerivedPolicy, typename RandomAccessIterator, typename StrictWeakOrdering>
-void stable_sort(
-  execution_policy<DerivedPolicy>& exec, RandomAccessIterator first, RandomAccessIterator last, StrictWeakOrdering comp)
+namespace dispatch
 {
-  // we're attempting to launch an omp kernel, assert we're compiling with omp support
-  // ========================================================================
-  // X Note to the user: If you've found this line due to a compiler error, X
-  // X you need to enable OpenMP support in your compiler.                  X
-  // ========================================================================
-  THRUST_STATIC_ASSERT_MSG(
-    (thrust::detail::depend_on_instantiation<RandomAccessIterator,
-                                             (THRUST_DEVICE_COMPILER_IS_OMP_CAPABLE == THRUST_TRUE)>::value),
-    "OpenMP compiler support is not enabled");
 
+template <typename DerivedPolicy, typename RandomAccessIterator, typename StrictWeakOrdering>
+void stable_sort(execution_policy<DerivedPolicy>& exec,
+                 RandomAccessIterator first,
+                 RandomAccessIterator last,
+                 StrictWeakOrdering comp,
+                 thrust::detail::false_type)
+{
   // Avoid issues on compilers that don't provide `omp_get_num_threads()`.
 #if (THRUST_DEVICE_COMPILER_IS_OMP_CAPABLE == THRUST_TRUE)
   typedef typename thrust::iterator_difference<RandomAccessIterator>::type IndexType;
+  typedef typename thrust::iterator_value<RandomAccessIterator>::type value_type;
 
   if (first == last)
   {
     return;
   }
 
+  const IndexType n = last - first;
+
+  // the merge levels ping-pong between the input and a single scratch buffer
+  thrust::detail::temporary_array<value_type, DerivedPolicy> buffer(exec, omp_get_max_threads() > 1 ? n : 0);
+
   THRUST_PRAGMA_OMP(parallel)
   {
-    thrust::system::detail::internal::uniform_decomposition<IndexType> decomp(last - first, 1, omp_get_num_threads());
+    const IndexType num_threads = omp_get_num_threads();
+
+    thrust::system::detail::internal::uniform_decomposition<IndexType> decomp(n, 1, num_threads);
 
     // process id
     IndexType p_i = omp_get_thread_num();
@@ -134,33 +364,28 @@ void stable_sort(
     // XXX For some reason, MSVC 2015 yields an error unless we include this meaningless semicolon here
     ;
 
-    IndexType nseg = decomp.size();
-    IndexType h    = 2;
-
-    // keep track of which sub-range we're processing
-    IndexType a = p_i, b = p_i, c = p_i + 1;
+    bool in_buffer = false;
 
-    while (nseg > 1)
+    for (IndexType run_tiles = 1; run_tiles < decomp.size(); run_tiles *= 2)
     {
-      if (c >= decomp.size())
+      if (in_buffer)
       {
-        c = decomp.size() - 1;
+        sort_detail::merge_level(decomp, run_tiles, buffer.begin(), first, p_i, num_threads, comp);
       }
-
-      if ((p_i % h) == 0 && c > b)
+      else
       {
-        sort_detail::inplace_merge(
-          exec, first + decomp[a].begin(), first + decomp[b].end(), first + decomp[c].end(), comp);
-
-        b = c;
-        c += h;
+        sort_detail::merge_level(decomp, run_tiles, first, buffer.begin(), p_i, num_threads, comp);
       }
 
-      nseg = (nseg + 1) / 2;
-      h *= 2;
+      in_buffer = !in_buffer;
 
       THRUST_PRAGMA_OMP(barrier)
     }
+
+    if (in_buffer)
+    {
+      sort_detail::copy_tile(n, buffer.begin(), first, p_i, num_threads);
+    }
   }
 #endif // THRUST_DEVICE_COMPILER_IS_OMP_CAPABLE
 }
@@ -174,31 +399,32 @@ void stable_sort_by_key(
   RandomAccessIterator1 keys_first,
   RandomAccessIterator1 keys_last,
   RandomAccessIterator2 values_first,
-  StrictWeakOrdering comp)
+  StrictWeakOrdering comp,
+  thrust::detail::false_type)
 {
-  // we're attempting to launch an omp kernel, assert we're compiling with omp support
-  // ========================================================================
-  // X Note to the user: If you've found this line due to a compiler error, X
-  // X you need to enable OpenMP support in your compiler.                  X
-  // ========================================================================
-  THRUST_STATIC_ASSERT_MSG(
-    (thrust::detail::depend_on_instantiation<RandomAccessIterator1,
-                                             (THRUST_DEVICE_COMPILER_IS_OMP_CAPABLE == THRUST_TRUE)>::value),
-    "OpenMP compiler support is not enabled");
-
   // Avoid issues on compilers that don't provide `omp_get_num_threads()`.
 #if (THRUST_DEVICE_COMPILER_IS_OMP_CAPABLE == THRUST_TRUE)
   typedef typename thrust::iterator_difference<RandomAccessIterator1>::type IndexType;
+  typedef typename thrust::iterator_value<RandomAccessIterator1>::type value_type1;
+  typedef typename thrust::iterator_value<RandomAccessIterator2>::type value_type2;
 
   if (keys_first == keys_last)
   {
     return;
   }
 
+  const IndexType n = keys_last - keys_first;
+
+  // the merge levels ping-pong between the input and a single scratch buffer
+  const IndexType buffer_size = omp_get_max_threads() > 1 ? n : 0;
+  thrust::detail::temporary_array<value_type1, DerivedPolicy> keys_buffer(exec, buffer_size);
+  thrust::detail::temporary_array<value_type2, DerivedPolicy> values_buffer(exec, buffer_size);
+
   THRUST_PRAGMA_OMP(parallel)
   {
-    thrust::system::detail::internal::uniform_decomposition<IndexType> decomp(
-      keys_last - keys_first, 1, omp_get_num_threads());
+    const IndexType num_threads = omp_get_num_threads();
+
+    thrust::system::detail::internal::uniform_decomposition<IndexType> decomp(n, 1, num_threads);
 
     // process id
     IndexType p_i = omp_get_thread_num();
@@ -219,42 +445,174 @@ void stable_sort_by_key(
     // XXX For some reason, MSVC 2015 yields an error unless we include this meaningless semicolon here
     ;
 
-    IndexType nseg = decomp.size();
-    IndexType h    = 2;
-
-    // keep track of which sub-range we're processing
-    IndexType a = p_i, b = p_i, c = p_i + 1;
+    bool in_buffer = false;
 
-    while (nseg > 1)
+    for (IndexType run_tiles = 1; run_tiles < decomp.size(); run_tiles *= 2)
     {
-      if (c >= decomp.size())
+      if (in_buffer)
       {
-        c = decomp.size() - 1;
+        sort_detail::merge_level_by_key(
+          decomp,
+          run_tiles,
+          keys_buffer.begin(),
+          values_buffer.begin(),
+          keys_first,
+          values_first,
+          p_i,
+          num_threads,
+          comp);
       }
-
-      if ((p_i % h) == 0 && c > b)
+      else
       {
-        sort_detail::inplace_merge_by_key(
-          exec,
-          keys_first + decomp[a].begin(),
-          keys_first + decomp[b].end(),
-          keys_first + decomp[c].end(),
-          values_first + decomp[a].begin(),
+        sort_detail::merge_level_by_key(
+          decomp,
+          run_tiles,
+          keys_first,
+          values_first,
+          keys_buffer.begin(),
+          values_buffer.begin(),
+          p_i,
+          num_threads,
           comp);
-
-        b = c;
-        c += h;
       }
 
-      nseg = (nseg + 1) / 2;
-      h *= 2;
+      in_buffer = !in_buffer;
 
       THRUST_PRAGMA_OMP(barrier)
     }
+
+    if (in_buffer)
+    {
+      sort_detail::copy_tile(n, keys_buffer.begin(), keys_first, p_i, num_threads);
+      sort_detail::copy_tile(n, values_buffer.begin(), values_first, p_i, num_threads);
+    }
   }
 #endif // THRUST_DEVICE_COMPILER_IS_OMP_CAPABLE
 }
 
+template <typename DerivedPolicy, typename RandomAccessIterator, typename StrictWeakOrdering>
+void stable_sort(execution_policy<DerivedPolicy>& exec,
+                 RandomAccessIterator first,
+                 RandomAccessIterator last,
+                 StrictWeakOrdering comp,
+                 thrust::detail::true_type)
+{
+  typedef typename thrust::iterator_difference<RandomAccessIterator>::type IndexType;
+  typedef typename thrust::iterator_value<RandomAccessIterator>::type KeyType;
+
+  const IndexType n = last - first;
+
+  if (n < sort_detail::radix_sort_threshold)
+  {
+    thrust::stable_sort(thrust::seq, first, last, comp);
+    return;
+  }
+
+  sort_detail::radix_sort<false>(exec, first, static_cast<int*>(0), n);
+
+  // if comp is greater<T> then reverse the keys
+  if (thrust::system::detail::sequential::sort_detail::needs_reverse<KeyType, StrictWeakOrdering>::value)
+  {
+    thrust::reverse(exec, first, last);
+  }
+}
+
+template <typename DerivedPolicy,
+          typename RandomAccessIterator1,
+          typename RandomAccessIterator2,
+          typename StrictWeakOrdering>
+void stable_sort_by_key(
+  execution_policy<DerivedPolicy>& exec,
+  RandomAccessIterator1 keys_first,
+  RandomAccessIterator1 keys_last,
+  RandomAccessIterator2 values_first,
+  StrictWeakOrdering comp,
+  thrust::detail::true_type)
+{
+  typedef typename thrust::iterator_difference<RandomAccessIterator1>::type IndexType;
+  typedef typename thrust::iterator_value<RandomAccessIterator1>::type KeyType;
+
+  const IndexType n = keys_last - keys_first;
+
+  if (n < sort_detail::radix_sort_threshold)
+  {
+    thrust::stable_sort_by_key(thrust::seq, keys_first, keys_last, values_first, comp);
+    return;
+  }
+
+  // if comp is greater<T> then reverse the keys and values
+  // note, we also have to reverse the (unordered) input to preserve stability
+  const bool reverse =
+    thrust::system::detail::sequential::sort_detail::needs_reverse<KeyType, StrictWeakOrdering>::value;
+
+  if (reverse)
+  {
+    thrust::reverse(exec, keys_first, keys_last);
+    thrust::reverse(exec, values_first, values_first + n);
+  }
+
+  sort_detail::radix_sort<true>(exec, keys_first, values_first, n);
+
+  if (reverse)
+  {
+    thrust::reverse(exec, keys_first, keys_last);
+    thrust::reverse(exec, values_first, values_first + n);
+  }
+}
+
+} // namespace dispatch
+
+template <typename DerivedPolicy, typename RandomAccessIterator, typename StrictWeakOrdering>
+void stable_sort(
+  execution_policy<DerivedPolicy>& exec, RandomAccessIterator first, RandomAccessIterator last, StrictWeakOrdering comp)
+{
+  // we're attempting to launch an omp kernel, assert we're compiling with omp support
+  // ========================================================================
+  // X Note to the user: If you've found this line due to a compiler error, X
+  // X you need to enable OpenMP support in your compiler.                  X
+  // ========================================================================
+  THRUST_STATIC_ASSERT_MSG(
+    (thrust::detail::depend_on_instantiation<RandomAccessIterator,
+                                             (THRUST_DEVICE_COMPILER_IS_OMP_CAPABLE == THRUST_TRUE)>::value),
+    "OpenMP compiler support is not enabled");
+
+  typedef typename thrust::iterator_value<RandomAccessIterator>::type KeyType;
+
+  // primitive keys compared with less or greater are radix sorted
+  thrust::system::detail::sequential::sort_detail::use_primitive_sort<KeyType, StrictWeakOrdering> use_primitive_sort;
+
+  dispatch::stable_sort(exec, first, last, comp, use_primitive_sort);
+}
+
+template <typename DerivedPolicy,
+          typename RandomAccessIterator1,
+          typename RandomAccessIterator2,
+          typename StrictWeakOrdering>
+void stable_sort_by_key(
+  execution_policy<DerivedPolicy>& exec,
+  RandomAccessIterator1 keys_first,
+  RandomAccessIterator1 keys_last,
+  RandomAccessIterator2 values_first,
+  StrictWeakOrdering comp)
+{
+  // we're attempting to launch an omp kernel, assert we're compiling with omp support
+  // ========================================================================
+  // X Note to the user: If you've found this line due to a compiler error, X
+  // X you need to enable OpenMP support in your compiler.                  X
+  // ========================================================================
+  THRUST_STATIC_ASSERT_MSG(
+    (thrust::detail::depend_on_instantiation<RandomAccessIterator1,
+                                             (THRUST_DEVICE_COMPILER_IS_OMP_CAPABLE == THRUST_TRUE)>::value),
+    "OpenMP compiler support is not enabled");
+
+  typedef typename thrust::iterator_value<RandomAccessIterator1>::type KeyType;
+
+  // primitive keys compared with less or greater are radix sorted
+  thrust::system::detail::sequential::sort_detail::use_primitive_sort<KeyType, StrictWeakOrdering> use_primitive_sort;
+
+  dispatch::stable_sort_by_key(exec, keys_first, keys_last, values_first, comp, use_primitive_sort);
+}
+
 } // end namespace detail
 } // end namespace omp
 } // end namespace system
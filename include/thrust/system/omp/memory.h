@@ -100,6 +100,8 @@ namespace omp
 using thrust::system::omp::allocator;
 using thrust::system::omp::free;
 using thrust::system::omp::malloc;
+using thrust::system::omp::numa_allocator;
+using thrust::system::omp::numa_memory_resource;
 using thrust::system::omp::universal_allocator;
 } // namespace omp
 
@@ -29,8 +29,11 @@
 #elif defined(_CCCL_IMPLICIT_SYSTEM_HEADER_MSVC)
 #  pragma system_header
 #endif // no system header
+#include <thrust/mr/allocator.h>
 #include <thrust/mr/fancy_pointer_resource.h>
 #include <thrust/mr/new.h>
+#include <thrust/mr/numa.h>
+#include <thrust/system/omp/detail/first_touch.h>
 #include <thrust/system/omp/pointer.h>
 
 THRUST_NAMESPACE_BEGIN
@@ -65,6 +68,83 @@ typedef detail::universal_native_resource universal_memory_resource;
 /*! An alias for \p omp::universal_memory_resource. */
 typedef detail::native_resource universal_host_pinned_memory_resource;
 
+/*! A memory resource for the OpenMP system which places its allocations on NUMA nodes with
+ *  \p mr::numa_memory_resource, and tags them with \p omp::pointer.
+ *
+ *  Under \p mr::numa_policy::local, every allocation is first touched by the threads of the OpenMP system, with the
+ *  decomposition of its parallel loops, so that each page lives on the node of the thread which later works on it.
+ *  This holds even for vectors whose elements are left uninitialized with \p thrust::no_init. Under the other
+ *  policies, the operating system places the pages as they are touched.
+ *
+ *  \code
+ *  #include <thrust/system/omp/memory_resource.h>
+ *  #include <thrust/system/omp/vector.h>
+ *  ...
+ *  thrust::omp::numa_memory_resource resource(thrust::mr::numa_policy::interleave);
+ *  thrust::omp::vector<float, thrust::omp::numa_allocator<float>> v(&resource);
+ *  v.resize(n, thrust::no_init);
+ *  \endcode
+ */
+class numa_memory_resource final : public thrust::mr::memory_resource<thrust::omp::pointer<void>>
+{
+public:
+  /*! Creates a resource which places pages on the node of the thread which touches them first.
+   */
+  numa_memory_resource() = default;
+
+  /*! Creates a resource with the given policy over all nodes which this process may use.
+   *
+   *  \param policy the placement policy.
+   */
+  explicit numa_memory_resource(thrust::mr::numa_policy policy)
+      : m_upstream(policy)
+  {}
+
+  /*! Creates a resource with the given policy over the given nodes.
+   *
+   *  \param policy the placement policy.
+   *  \param nodes the nodes on which to place pages.
+   *  \throw std::invalid_argument if \p nodes is empty or contains a node which this process may not use.
+   */
+  numa_memory_resource(thrust::mr::numa_policy policy, const std::vector<int>& nodes)
+      : m_upstream(policy, nodes)
+  {}
+
+  /*! Returns the placement policy of this resource.
+   */
+  thrust::mr::numa_policy policy() const
+  {
+    return m_upstream.policy();
+  }
+
+  _CCCL_NODISCARD virtual thrust::omp::pointer<void>
+  do_allocate(std::size_t bytes, std::size_t alignment = THRUST_MR_DEFAULT_ALIGNMENT) override
+  {
+    void* p = m_upstream.do_allocate(bytes, alignment);
+
+    if (m_upstream.policy() == thrust::mr::numa_policy::local)
+    {
+      detail::first_touch(p, bytes, thrust::mr::numa_memory_resource::page_size());
+    }
+
+    return thrust::omp::pointer<void>(p);
+  }
+
+  virtual void do_deallocate(thrust::omp::pointer<void> p, std::size_t bytes, std::size_t alignment) override
+  {
+    m_upstream.do_deallocate(p.get(), bytes, alignment);
+  }
+
+private:
+  thrust::mr::numa_memory_resource m_upstream;
+};
+
+/*! An allocator for the containers of the OpenMP system, such as \p omp::vector, which allocates from a
+ *  \p omp::numa_memory_resource and thus selects the NUMA placement of every container which uses it.
+ */
+template <typename T>
+using numa_allocator = thrust::mr::allocator<T, numa_memory_resource>;
+
 /*! \}
  */
 
@@ -0,0 +1,257 @@
+/*
+ *  Copyright 2024 NVIDIA Corporation
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+#pragma once
+
+#include <thrust/detail/config.h>
+
+#if defined(_CCCL_IMPLICIT_SYSTEM_HEADER_GCC)
+#  pragma GCC system_header
+#elif defined(_CCCL_IMPLICIT_SYSTEM_HEADER_CLANG)
+#  pragma clang system_header
+#elif defined(_CCCL_IMPLICIT_SYSTEM_HEADER_MSVC)
+#  pragma system_header
+#endif // no system header
+#include <thrust/detail/type_traits/minimum_type.h>
+#include <thrust/distance.h>
+#include <thrust/iterator/iterator_traits.h>
+#include <thrust/system/detail/generic/binary_search.h>
+#include <thrust/system/detail/internal/parallel_binary_search.h>
+#include <thrust/system/tbb/detail/binary_search.h>
+#include <thrust/type_traits/is_contiguous_iterator.h>
+
+#include <tbb/blocked_range.h>
+#include <tbb/parallel_for.h>
+
+THRUST_NAMESPACE_BEGIN
+namespace system
+{
+namespace tbb
+{
+namespace detail
+{
+namespace binary_search_detail
+{
+
+template <typename DerivedPolicy,
+          typename ForwardIterator,
+          typename InputIterator,
+          typename OutputIterator,
+          typename StrictWeakOrdering,
+          typename Search,
+          typename BinarySearchFunction>
+OutputIterator search_queries(
+  execution_policy<DerivedPolicy>& exec,
+  ForwardIterator begin,
+  ForwardIterator end,
+  InputIterator values_begin,
+  InputIterator values_end,
+  OutputIterator output,
+  StrictWeakOrdering comp,
+  Search,
+  BinarySearchFunction func,
+  thrust::incrementable_traversal_tag)
+{
+  return thrust::system::detail::generic::detail::binary_search(
+    exec, begin, end, values_begin, values_end, output, comp, func);
+}
+
+template <typename RandomAccessIterator1,
+          typename Size,
+          typename RandomAccessIterator2,
+          typename RandomAccessIterator3,
+          typename Search>
+struct body
+{
+  RandomAccessIterator1 first;
+  Size n;
+  RandomAccessIterator2 values;
+  RandomAccessIterator3 output;
+  Search search;
+
+  body(RandomAccessIterator1 first, Size n, RandomAccessIterator2 values, RandomAccessIterator3 output, Search search)
+      : first(first)
+      , n(n)
+      , values(values)
+      , output(output)
+      , search(search)
+  {}
+
+  void operator()(const ::tbb::blocked_range<Size>& r) const
+  {
+    thrust::system::detail::internal::binary_search_detail::search_range(
+      first, n, values, output, r.begin(), r.end(), search);
+  }
+}; // end body
+
+// every subrange of the queries which tbb makes is searched with internal::binary_search_detail::search_range
+template <typename DerivedPolicy,
+          typename ForwardIterator,
+          typename InputIterator,
+          typename OutputIterator,
+          typename StrictWeakOrdering,
+          typename Search,
+          typename BinarySearchFunction>
+OutputIterator search_queries(
+  execution_policy<DerivedPolicy>&,
+  ForwardIterator begin,
+  ForwardIterator end,
+  InputIterator values_begin,
+  InputIterator values_end,
+  OutputIterator output,
+  StrictWeakOrdering,
+  Search search,
+  BinarySearchFunction,
+  thrust::random_access_traversal_tag)
+{
+  typedef typename thrust::iterator_difference<InputIterator>::type Size;
+  typedef typename thrust::try_unwrap_contiguous_iterator_t<ForwardIterator> DataIterator;
+
+  const Size n = thrust::distance(begin, end);
+  const Size m = thrust::distance(values_begin, values_end);
+
+  // there is nothing to search, and an empty range may not be dereferenced to find its raw pointer
+  if (n == 0)
+  {
+    thrust::system::detail::internal::binary_search_detail::search_range(
+      begin, n, values_begin, output, Size(0), m, search);
+
+    return output + m;
+  }
+
+  // search raw pointers where possible, so that the search can prefetch
+  DataIterator first = thrust::try_unwrap_contiguous_iterator(begin);
+
+  ::tbb::parallel_for(::tbb::blocked_range<Size>(0, m),
+                      body<DataIterator, Size, InputIterator, OutputIterator, Search>(
+                        first, n, values_begin, output, search));
+
+  return output + m;
+}
+
+template <typename DerivedPolicy,
+          typename ForwardIterator,
+          typename InputIterator,
+          typename OutputIterator,
+          typename StrictWeakOrdering,
+          typename Search,
+          typename BinarySearchFunction>
+OutputIterator search_queries(
+  execution_policy<DerivedPolicy>& exec,
+  ForwardIterator begin,
+  ForwardIterator end,
+  InputIterator values_begin,
+  InputIterator values_end,
+  OutputIterator output,
+  StrictWeakOrdering comp,
+  Search search,
+  BinarySearchFunction func)
+{
+  typedef typename thrust::iterator_traversal<ForwardIterator>::type traversal1;
+  typedef typename thrust::iterator_traversal<InputIterator>::type traversal2;
+  typedef typename thrust::iterator_traversal<OutputIterator>::type traversal3;
+
+  typedef typename thrust::detail::minimum_type<traversal1, traversal2, traversal3>::type traversal;
+
+  // dispatch on minimum traversal
+  return binary_search_detail::search_queries(
+    exec, begin, end, values_begin, values_end, output, comp, search, func, traversal());
+}
+
+} // end namespace binary_search_detail
+
+template <typename DerivedPolicy,
+          typename ForwardIterator,
+          typename InputIterator,
+          typename OutputIterator,
+          typename StrictWeakOrdering>
+OutputIterator lower_bound(
+  execution_policy<DerivedPolicy>& exec,
+  ForwardIterator begin,
+  ForwardIterator end,
+  InputIterator values_begin,
+  InputIterator values_end,
+  OutputIterator output,
+  StrictWeakOrdering comp)
+{
+  return binary_search_detail::search_queries(
+    exec,
+    begin,
+    end,
+    values_begin,
+    values_end,
+    output,
+    comp,
+    thrust::system::detail::internal::binary_search_detail::lower_bound_search<StrictWeakOrdering>(comp),
+    thrust::system::detail::generic::detail::lbf());
+} // end lower_bound()
+
+template <typename DerivedPolicy,
+          typename ForwardIterator,
+          typename InputIterator,
+          typename OutputIterator,
+          typename StrictWeakOrdering>
+OutputIterator upper_bound(
+  execution_policy<DerivedPolicy>& exec,
+  ForwardIterator begin,
+  ForwardIterator end,
+  InputIterator values_begin,
+  InputIterator values_end,
+  OutputIterator output,
+  StrictWeakOrdering comp)
+{
+  return binary_search_detail::search_queries(
+    exec,
+    begin,
+    end,
+    values_begin,
+    values_end,
+    output,
+    comp,
+    thrust::system::detail::internal::binary_search_detail::upper_bound_search<StrictWeakOrdering>(comp),
+    thrust::system::detail::generic::detail::ubf());
+} // end upper_bound()
+
+template <typename DerivedPolicy,
+          typename ForwardIterator,
+          typename InputIterator,
+          typename OutputIterator,
+          typename StrictWeakOrdering>
+OutputIterator binary_search(
+  execution_policy<DerivedPolicy>& exec,
+  ForwardIterator begin,
+  ForwardIterator end,
+  InputIterator values_begin,
+  InputIterator values_end,
+  OutputIterator output,
+  StrictWeakOrdering comp)
+{
+  return binary_search_detail::search_queries(
+    exec,
+    begin,
+    end,
+    values_begin,
+    values_end,
+    output,
+    comp,
+    thrust::system::detail::internal::binary_search_detail::binary_search_search<StrictWeakOrdering>(comp),
+    thrust::system::detail::generic::detail::bsf());
+} // end binary_search()
+
+} // end namespace detail
+} // end namespace tbb
+} // end namespace system
+THRUST_NAMESPACE_END
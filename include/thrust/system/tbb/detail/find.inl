@@ -0,0 +1,99 @@
+/*
+ *  Copyright 2024 NVIDIA Corporation
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+#pragma once
+
+#include <thrust/detail/config.h>
+
+#if defined(_CCCL_IMPLICIT_SYSTEM_HEADER_GCC)
+#  pragma GCC system_header
+#elif defined(_CCCL_IMPLICIT_SYSTEM_HEADER_CLANG)
+#  pragma clang system_header
+#elif defined(_CCCL_IMPLICIT_SYSTEM_HEADER_MSVC)
+#  pragma system_header
+#endif // no system header
+#include <thrust/detail/seq.h>
+#include <thrust/distance.h>
+#include <thrust/find.h>
+#include <thrust/iterator/iterator_traits.h>
+#include <thrust/system/detail/internal/parallel_find.h>
+#include <thrust/system/tbb/detail/find.h>
+
+#include <tbb/blocked_range.h>
+#include <tbb/parallel_for.h>
+#include <tbb/task_arena.h>
+
+THRUST_NAMESPACE_BEGIN
+namespace system
+{
+namespace tbb
+{
+namespace detail
+{
+namespace find_detail
+{
+
+template <typename InputIterator, typename Predicate, typename Size>
+struct body
+{
+  InputIterator first;
+  Predicate pred;
+  thrust::system::detail::internal::find_detail::find_state<Size>& state;
+
+  body(InputIterator first, Predicate pred, thrust::system::detail::internal::find_detail::find_state<Size>& state)
+      : first(first)
+      , pred(pred)
+      , state(state)
+  {}
+
+  void operator()(const ::tbb::blocked_range<int>&) const
+  {
+    thrust::system::detail::internal::find_detail::find_if_blocks(first, pred, state);
+  }
+}; // end body
+
+} // namespace find_detail
+
+template <typename DerivedPolicy, typename InputIterator, typename Predicate>
+InputIterator find_if(execution_policy<DerivedPolicy>&, InputIterator first, InputIterator last, Predicate pred)
+{
+  typedef typename thrust::iterator_difference<InputIterator>::type Size;
+
+  const Size n = thrust::distance(first, last);
+
+  thrust::system::detail::internal::find_detail::find_state<Size> state(
+    n, thrust::system::detail::internal::find_detail::block_size<InputIterator>());
+
+  // a single block is not worth a parallel loop
+  if (state.num_blocks() < 2)
+  {
+    return thrust::find_if(thrust::seq, first, last, pred);
+  }
+
+  // one searcher per thread, each of which claims blocks until no block before the result remains
+  const int num_searchers = ::tbb::this_task_arena::max_concurrency();
+
+  ::tbb::parallel_for(::tbb::blocked_range<int>(0, num_searchers, 1),
+                      find_detail::body<InputIterator, Predicate, Size>(first, pred, state),
+                      ::tbb::simple_partitioner());
+
+  return first + state.result();
+} // end find_if()
+
+} // end namespace detail
+} // end namespace tbb
+} // end namespace system
+THRUST_NAMESPACE_END
@@ -0,0 +1,351 @@
+/*
+ *  Copyright 2024 NVIDIA Corporation
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+#pragma once
+
+#include <thrust/detail/config.h>
+
+#if defined(_CCCL_IMPLICIT_SYSTEM_HEADER_GCC)
+#  pragma GCC system_header
+#elif defined(_CCCL_IMPLICIT_SYSTEM_HEADER_CLANG)
+#  pragma clang system_header
+#elif defined(_CCCL_IMPLICIT_SYSTEM_HEADER_MSVC)
+#  pragma system_header
+#endif // no system header
+#include <thrust/detail/function.h>
+#include <thrust/distance.h>
+#include <thrust/iterator/iterator_traits.h>
+#include <thrust/system/tbb/detail/scan_by_key.h>
+
+#include <tbb/blocked_range.h>
+#include <tbb/parallel_scan.h>
+
+THRUST_NAMESPACE_BEGIN
+namespace system
+{
+namespace tbb
+{
+namespace detail
+{
+namespace scan_by_key_detail
+{
+
+// A segmented scan is the plain scan of (head, value) pairs, where head marks the first element of a segment:
+//   (head1, value1) + (head2, value2) = head2 ? (true, value2) : (head1, value1 + value2)
+// This operator is associative, so parallel_scan may carry the pair of a range to the next one. A body holds the
+// pair of the elements it has seen: sum is the scan of their last segment, and has_head tells whether they contain
+// the head of a segment, in which case nothing before them contributes to sum.
+//
+// Whether the first element of a range is a head depends on the key before it, which the body of the previous range
+// may already have overwritten when the keys are scanned in place, whatever the iterator types. So a body never reads
+// outside of its ranges: it keeps the first and last of the keys it has seen, and settles whether its first element
+// is a head with the last key of the body to its left, either carried into it or passed to reverse_join.
+template <bool Inclusive,
+          typename InputIterator1,
+          typename InputIterator2,
+          typename OutputIterator,
+          typename BinaryPredicate,
+          typename BinaryFunction,
+          typename ValueType>
+struct body
+{
+  typedef typename thrust::iterator_traits<InputIterator1>::value_type KeyType;
+
+  InputIterator1 keys;
+  InputIterator2 values;
+  OutputIterator output;
+  thrust::detail::wrapped_function<BinaryPredicate, bool> binary_pred;
+  thrust::detail::wrapped_function<BinaryFunction, ValueType> binary_op;
+  ValueType init;
+  ValueType sum;
+  KeyType first_key;
+  KeyType last_key;
+  bool has_head;
+  bool first_call;
+
+  body(InputIterator1 keys,
+       InputIterator2 values,
+       OutputIterator output,
+       BinaryPredicate binary_pred,
+       BinaryFunction binary_op,
+       ValueType init)
+      : keys(keys)
+      , values(values)
+      , output(output)
+      , binary_pred(binary_pred)
+      , binary_op(binary_op)
+      , init(init)
+      , sum(init)
+      , first_key(*keys)
+      , last_key(*keys)
+      , has_head(false)
+      , first_call(true)
+  {}
+
+  body(body& b, ::tbb::split)
+      : keys(b.keys)
+      , values(b.values)
+      , output(b.output)
+      , binary_pred(b.binary_pred)
+      , binary_op(b.binary_op)
+      , init(b.init)
+      , sum(b.sum)
+      , first_key(b.first_key)
+      , last_key(b.last_key)
+      , has_head(false)
+      , first_call(true)
+  {}
+
+  // Whether the first element of r, with the given key, is a head. Without a carry this is only known for the first
+  // element of the input; for other ranges it is left open, and reverse_join settles it.
+  template <typename Size>
+  bool is_head(const ::tbb::blocked_range<Size>& r, const KeyType& key) const
+  {
+    return r.begin() == 0 || (!first_call && !binary_pred(last_key, key));
+  }
+
+  // the scan of a segment starts over at its head, which an exclusive scan combines with init
+  template <typename T>
+  ValueType start(const T& value) const
+  {
+    return Inclusive ? ValueType(value) : binary_op(init, value);
+  }
+
+  template <typename Size>
+  void operator()(const ::tbb::blocked_range<Size>& r, ::tbb::pre_scan_tag)
+  {
+    InputIterator1 key_iter   = keys + r.begin();
+    InputIterator2 value_iter = values + r.begin();
+
+    KeyType prev_key = *key_iter;
+    bool found_head  = is_head(r, prev_key);
+    ValueType temp   = found_head ? start(*value_iter) : ValueType(*value_iter);
+
+    if (first_call)
+    {
+      first_key = prev_key;
+    }
+
+    for (Size i = r.begin() + 1; i != r.end(); ++i)
+    {
+      ++key_iter;
+      ++value_iter;
+
+      KeyType key = *key_iter;
+
+      if (binary_pred(prev_key, key))
+      {
+        temp = binary_op(temp, *value_iter);
+      }
+      else
+      {
+        temp       = start(*value_iter);
+        found_head = true;
+      }
+
+      prev_key = key;
+    }
+
+    if (first_call)
+    {
+      sum      = temp;
+      has_head = found_head;
+    }
+    else if (found_head)
+    {
+      sum      = temp;
+      has_head = true;
+    }
+    else
+    {
+      sum = binary_op(sum, temp);
+    }
+
+    last_key   = prev_key;
+    first_call = false;
+  }
+
+  template <typename Size>
+  void operator()(const ::tbb::blocked_range<Size>& r, ::tbb::final_scan_tag)
+  {
+    InputIterator1 key_iter   = keys + r.begin();
+    InputIterator2 value_iter = values + r.begin();
+    OutputIterator out_iter   = output + r.begin();
+
+    // without a carry, this is the first range, whose first element is a head
+    KeyType prev_key = *key_iter;
+    bool head        = first_call || is_head(r, prev_key);
+    bool found_head  = head;
+
+    if (first_call)
+    {
+      first_key = prev_key;
+    }
+
+    for (Size i = r.begin(); i != r.end(); ++i, ++key_iter, ++value_iter, ++out_iter)
+    {
+      // read the key and the value before writing the result, which may alias either of them
+      KeyType key     = *key_iter;
+      ValueType value = *value_iter;
+
+      if (i != r.begin())
+      {
+        head       = !binary_pred(prev_key, key);
+        found_head = found_head || head;
+      }
+
+      if (Inclusive)
+      {
+        sum       = head ? value : binary_op(sum, value);
+        *out_iter = sum;
+      }
+      else
+      {
+        if (head)
+        {
+          sum = init;
+        }
+
+        *out_iter = sum;
+        sum       = binary_op(sum, value);
+      }
+
+      prev_key = key;
+    }
+
+    has_head   = first_call ? found_head : (has_head || found_head);
+    last_key   = prev_key;
+    first_call = false;
+  }
+
+  // b holds the pair of the elements just before those of this body
+  void reverse_join(body& b)
+  {
+    if (b.first_call)
+    {
+      return;
+    }
+
+    if (first_call)
+    {
+      assign(b);
+      return;
+    }
+
+    if (!has_head)
+    {
+      if (!binary_pred(b.last_key, first_key))
+      {
+        // the first element of this body is a head, whose scan was taken without init
+        sum      = Inclusive ? sum : binary_op(init, sum);
+        has_head = true;
+      }
+      else
+      {
+        sum      = binary_op(b.sum, sum);
+        has_head = b.has_head;
+      }
+    }
+
+    first_key = b.first_key;
+  }
+
+  void assign(body& b)
+  {
+    sum        = b.sum;
+    first_key  = b.first_key;
+    last_key   = b.last_key;
+    has_head   = b.has_head;
+    first_call = b.first_call;
+  }
+}; // end body
+
+} // namespace scan_by_key_detail
+
+template <typename DerivedPolicy,
+          typename InputIterator1,
+          typename InputIterator2,
+          typename OutputIterator,
+          typename BinaryPredicate,
+          typename BinaryFunction>
+OutputIterator inclusive_scan_by_key(
+  execution_policy<DerivedPolicy>&,
+  InputIterator1 first1,
+  InputIterator1 last1,
+  InputIterator2 first2,
+  OutputIterator result,
+  BinaryPredicate binary_pred,
+  BinaryFunction binary_op)
+{
+  typedef typename thrust::iterator_traits<InputIterator2>::value_type ValueType;
+  typedef typename thrust::iterator_difference<InputIterator1>::type Size;
+
+  const Size n = thrust::distance(first1, last1);
+
+  if (n == 0)
+  {
+    return result;
+  }
+
+  typedef scan_by_key_detail::
+    body<true, InputIterator1, InputIterator2, OutputIterator, BinaryPredicate, BinaryFunction, ValueType>
+      Body;
+  Body scan_body(first1, first2, result, binary_pred, binary_op, *first2);
+  ::tbb::parallel_scan(::tbb::blocked_range<Size>(0, n), scan_body);
+
+  return result + n;
+} // end inclusive_scan_by_key()
+
+template <typename DerivedPolicy,
+          typename InputIterator1,
+          typename InputIterator2,
+          typename OutputIterator,
+          typename T,
+          typename BinaryPredicate,
+          typename BinaryFunction>
+OutputIterator exclusive_scan_by_key(
+  execution_policy<DerivedPolicy>&,
+  InputIterator1 first1,
+  InputIterator1 last1,
+  InputIterator2 first2,
+  OutputIterator result,
+  T init,
+  BinaryPredicate binary_pred,
+  BinaryFunction binary_op)
+{
+  typedef T ValueType;
+  typedef typename thrust::iterator_difference<InputIterator1>::type Size;
+
+  const Size n = thrust::distance(first1, last1);
+
+  if (n == 0)
+  {
+    return result;
+  }
+
+  typedef scan_by_key_detail::
+    body<false, InputIterator1, InputIterator2, OutputIterator, BinaryPredicate, BinaryFunction, ValueType>
+      Body;
+  Body scan_body(first1, first2, result, binary_pred, binary_op, init);
+  ::tbb::parallel_scan(::tbb::blocked_range<Size>(0, n), scan_body);
+
+  return result + n;
+} // end exclusive_scan_by_key()
+
+} // end namespace detail
+} // end namespace tbb
+} // end namespace system
+THRUST_NAMESPACE_END
@@ -0,0 +1,335 @@
+/*
+ *  Copyright 2008-2013 NVIDIA Corporation
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+#pragma once
+
+#include <thrust/detail/config.h>
+
+#if defined(_CCCL_IMPLICIT_SYSTEM_HEADER_GCC)
+#  pragma GCC system_header
+#elif defined(_CCCL_IMPLICIT_SYSTEM_HEADER_CLANG)
+#  pragma clang system_header
+#elif defined(_CCCL_IMPLICIT_SYSTEM_HEADER_MSVC)
+#  pragma system_header
+#endif // no system header
+#include <thrust/detail/seq.h>
+#include <thrust/detail/temporary_array.h>
+#include <thrust/detail/type_traits/minimum_type.h>
+#include <thrust/distance.h>
+#include <thrust/iterator/iterator_traits.h>
+#include <thrust/scan.h>
+#include <thrust/system/detail/internal/decompose.h>
+#include <thrust/system/detail/internal/set_operations.h>
+#include <thrust/system/tbb/detail/set_operations.h>
+
+#include <cstddef>
+
+#include <tbb/blocked_range.h>
+#include <tbb/parallel_for.h>
+
+THRUST_NAMESPACE_BEGIN
+namespace system
+{
+namespace tbb
+{
+namespace detail
+{
+namespace set_operations_detail
+{
+
+// the merged inputs are split into at most max_partitions partitions of at
+// least partition_size elements
+const static int partition_size = 64 * 1024;
+const static int max_partitions = 256;
+
+template <typename SetOperation,
+          typename RandomAccessIterator1,
+          typename RandomAccessIterator2,
+          typename SplitIterator,
+          typename StrictWeakOrdering>
+struct count_body
+{
+  SetOperation set_op;
+  RandomAccessIterator1 first1;
+  RandomAccessIterator2 first2;
+  SplitIterator splits1, splits2, counts;
+  StrictWeakOrdering comp;
+
+  count_body(SetOperation set_op,
+             RandomAccessIterator1 first1,
+             RandomAccessIterator2 first2,
+             SplitIterator splits1,
+             SplitIterator splits2,
+             SplitIterator counts,
+             StrictWeakOrdering comp)
+      : set_op(set_op)
+      , first1(first1)
+      , first2(first2)
+      , splits1(splits1)
+      , splits2(splits2)
+      , counts(counts)
+      , comp(comp)
+  {}
+
+  template <typename Size>
+  void operator()(const ::tbb::blocked_range<Size>& r) const
+  {
+    namespace set_ops = thrust::system::detail::internal::set_operations_detail;
+
+    for (Size p = r.begin(); p != r.end(); ++p)
+    {
+      counts[p] = set_ops::count_partition(set_op, first1, first2, splits1, splits2, p, comp);
+    }
+  }
+};
+
+template <typename SetOperation,
+          typename RandomAccessIterator1,
+          typename RandomAccessIterator2,
+          typename RandomAccessIterator3,
+          typename SplitIterator,
+          typename StrictWeakOrdering>
+struct write_body
+{
+  SetOperation set_op;
+  RandomAccessIterator1 first1;
+  RandomAccessIterator2 first2;
+  RandomAccessIterator3 result;
+  SplitIterator splits1, splits2, offsets;
+  StrictWeakOrdering comp;
+
+  write_body(SetOperation set_op,
+             RandomAccessIterator1 first1,
+             RandomAccessIterator2 first2,
+             RandomAccessIterator3 result,
+             SplitIterator splits1,
+             SplitIterator splits2,
+             SplitIterator offsets,
+             StrictWeakOrdering comp)
+      : set_op(set_op)
+      , first1(first1)
+      , first2(first2)
+      , result(result)
+      , splits1(splits1)
+      , splits2(splits2)
+      , offsets(offsets)
+      , comp(comp)
+  {}
+
+  template <typename Size>
+  void operator()(const ::tbb::blocked_range<Size>& r) const
+  {
+    namespace set_ops = thrust::system::detail::internal::set_operations_detail;
+
+    for (Size p = r.begin(); p != r.end(); ++p)
+    {
+      set_ops::write_partition(set_op, first1, first2, result, splits1, splits2, offsets, p, comp);
+    }
+  }
+};
+
+template <typename DerivedPolicy,
+          typename InputIterator1,
+          typename InputIterator2,
+          typename OutputIterator,
+          typename StrictWeakOrdering,
+          typename SetOperation>
+OutputIterator set_operation(
+  execution_policy<DerivedPolicy>&,
+  InputIterator1 first1,
+  InputIterator1 last1,
+  InputIterator2 first2,
+  InputIterator2 last2,
+  OutputIterator result,
+  StrictWeakOrdering comp,
+  SetOperation set_op,
+  thrust::incrementable_traversal_tag)
+{
+  return set_op(first1, last1, first2, last2, result, comp);
+}
+
+template <typename DerivedPolicy,
+          typename InputIterator1,
+          typename InputIterator2,
+          typename OutputIterator,
+          typename StrictWeakOrdering,
+          typename SetOperation>
+OutputIterator set_operation(
+  execution_policy<DerivedPolicy>& exec,
+  InputIterator1 first1,
+  InputIterator1 last1,
+  InputIterator2 first2,
+  InputIterator2 last2,
+  OutputIterator result,
+  StrictWeakOrdering comp,
+  SetOperation set_op,
+  thrust::random_access_traversal_tag)
+{
+  namespace set_ops = thrust::system::detail::internal::set_operations_detail;
+
+  typedef std::ptrdiff_t Size;
+
+  const Size n1 = thrust::distance(first1, last1);
+  const Size n2 = thrust::distance(first2, last2);
+
+  const Size num_partitions =
+    thrust::system::detail::internal::uniform_decomposition<Size>(n1 + n2, partition_size, max_partitions).size();
+
+  if (num_partitions <= 1)
+  {
+    return set_op(first1, last1, first2, last2, result, comp);
+  }
+
+  typedef thrust::detail::temporary_array<Size, DerivedPolicy> split_array;
+  typedef typename split_array::iterator SplitIterator;
+
+  split_array splits1(exec, num_partitions + 1);
+  split_array splits2(exec, num_partitions + 1);
+  split_array offsets(exec, num_partitions + 1);
+
+  set_ops::partition_inputs(first1, n1, first2, n2, num_partitions, splits1.begin(), splits2.begin(), comp);
+
+  // count the output of every partition
+  ::tbb::parallel_for(
+    ::tbb::blocked_range<Size>(0, num_partitions, 1),
+    count_body<SetOperation, InputIterator1, InputIterator2, SplitIterator, StrictWeakOrdering>(
+      set_op, first1, first2, splits1.begin(), splits2.begin(), offsets.begin(), comp));
+
+  offsets[num_partitions] = 0;
+
+  thrust::exclusive_scan(thrust::seq, offsets.begin(), offsets.end(), offsets.begin());
+
+  // write every partition at its offset
+  ::tbb::parallel_for(
+    ::tbb::blocked_range<Size>(0, num_partitions, 1),
+    write_body<SetOperation, InputIterator1, InputIterator2, OutputIterator, SplitIterator, StrictWeakOrdering>(
+      set_op, first1, first2, result, splits1.begin(), splits2.begin(), offsets.begin(), comp));
+
+  return result + offsets[num_partitions];
+}
+
+template <typename DerivedPolicy,
+          typename InputIterator1,
+          typename InputIterator2,
+          typename OutputIterator,
+          typename StrictWeakOrdering,
+          typename SetOperation>
+OutputIterator set_operation(
+  execution_policy<DerivedPolicy>& exec,
+  InputIterator1 first1,
+  InputIterator1 last1,
+  InputIterator2 first2,
+  InputIterator2 last2,
+  OutputIterator result,
+  StrictWeakOrdering comp,
+  SetOperation set_op)
+{
+  typedef typename thrust::iterator_traversal<InputIterator1>::type traversal1;
+  typedef typename thrust::iterator_traversal<InputIterator2>::type traversal2;
+  typedef typename thrust::iterator_traversal<OutputIterator>::type traversal3;
+
+  typedef typename thrust::detail::minimum_type<traversal1, traversal2, traversal3>::type traversal;
+
+  // dispatch on minimum traversal
+  return set_operations_detail::set_operation(exec, first1, last1, first2, last2, result, comp, set_op, traversal());
+}
+
+} // end namespace set_operations_detail
+
+template <typename DerivedPolicy,
+          typename InputIterator1,
+          typename InputIterator2,
+          typename OutputIterator,
+          typename StrictWeakOrdering>
+OutputIterator set_difference(
+  execution_policy<DerivedPolicy>& exec,
+  InputIterator1 first1,
+  InputIterator1 last1,
+  InputIterator2 first2,
+  InputIterator2 last2,
+  OutputIterator result,
+  StrictWeakOrdering comp)
+{
+  namespace set_ops = thrust::system::detail::internal::set_operations_detail;
+
+  return set_operations_detail::set_operation(
+    exec, first1, last1, first2, last2, result, comp, set_ops::set_difference_op());
+} // end set_difference()
+
+template <typename DerivedPolicy,
+          typename InputIterator1,
+          typename InputIterator2,
+          typename OutputIterator,
+          typename StrictWeakOrdering>
+OutputIterator set_intersection(
+  execution_policy<DerivedPolicy>& exec,
+  InputIterator1 first1,
+  InputIterator1 last1,
+  InputIterator2 first2,
+  InputIterator2 last2,
+  OutputIterator result,
+  StrictWeakOrdering comp)
+{
+  namespace set_ops = thrust::system::detail::internal::set_operations_detail;
+
+  return set_operations_detail::set_operation(
+    exec, first1, last1, first2, last2, result, comp, set_ops::set_intersection_op());
+} // end set_intersection()
+
+template <typename DerivedPolicy,
+          typename InputIterator1,
+          typename InputIterator2,
+          typename OutputIterator,
+          typename StrictWeakOrdering>
+OutputIterator set_symmetric_difference(
+  execution_policy<DerivedPolicy>& exec,
+  InputIterator1 first1,
+  InputIterator1 last1,
+  InputIterator2 first2,
+  InputIterator2 last2,
+  OutputIterator result,
+  StrictWeakOrdering comp)
+{
+  namespace set_ops = thrust::system::detail::internal::set_operations_detail;
+
+  return set_operations_detail::set_operation(
+    exec, first1, last1, first2, last2, result, comp, set_ops::set_symmetric_difference_op());
+} // end set_symmetric_difference()
+
+template <typename DerivedPolicy,
+          typename InputIterator1,
+          typename InputIterator2,
+          typename OutputIterator,
+          typename StrictWeakOrdering>
+OutputIterator set_union(
+  execution_policy<DerivedPolicy>& exec,
+  InputIterator1 first1,
+  InputIterator1 last1,
+  InputIterator2 first2,
+  InputIterator2 last2,
+  OutputIterator result,
+  StrictWeakOrdering comp)
+{
+  namespace set_ops = thrust::system::detail::internal::set_operations_detail;
+
+  return set_operations_detail::set_operation(
+    exec, first1, last1, first2, last2, result, comp, set_ops::set_union_op());
+} // end set_union()
+
+} // end namespace detail
+} // end namespace tbb
+} // end namespace system
+THRUST_NAMESPACE_END
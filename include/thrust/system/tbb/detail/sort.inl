@@ -31,8 +31,13 @@
 #include <thrust/distance.h>
 #include <thrust/iterator/iterator_traits.h>
 #include <thrust/merge.h>
+#include <thrust/reverse.h>
 #include <thrust/sort.h>
+#include <thrust/system/detail/internal/radix_sort.h>
+#include <thrust/system/detail/sequential/sort.h>
 
+#include <tbb/blocked_range.h>
+#include <tbb/parallel_for.h>
 #include <tbb/parallel_invoke.h>
 
 THRUST_NAMESPACE_BEGIN
@@ -256,9 +261,48 @@ void merge_sort_by_key(
 
 } // namespace sort_by_key_detail
 
+namespace radix_sort_detail
+{
+
+// below this size the sequential radix sort beats the parallel one
+const static int threshold = 128 * 1024;
+
+template <typename Size, typename Body>
+struct blocked_range_body
+{
+  const Body& body;
+
+  blocked_range_body(const Body& body)
+      : body(body)
+  {}
+
+  void operator()(const ::tbb::blocked_range<Size>& r) const
+  {
+    body(r.begin(), r.end());
+  }
+};
+
+// runs the tiles of the shared radix sort with tbb::parallel_for
+struct parallel_for_tiles
+{
+  template <typename Size, typename Body>
+  void operator()(Size num_tiles, const Body& body) const
+  {
+    ::tbb::parallel_for(::tbb::blocked_range<Size>(0, num_tiles, 1), blocked_range_body<Size, Body>(body));
+  }
+};
+
+} // namespace radix_sort_detail
+
+namespace dispatch
+{
+
 template <typename DerivedPolicy, typename RandomAccessIterator, typename StrictWeakOrdering>
-void stable_sort(
-  execution_policy<DerivedPolicy>& exec, RandomAccessIterator first, RandomAccessIterator last, StrictWeakOrdering comp)
+void stable_sort(execution_policy<DerivedPolicy>& exec,
+                 RandomAccessIterator first,
+                 RandomAccessIterator last,
+                 StrictWeakOrdering comp,
+                 thrust::detail::false_type)
 {
   typedef typename thrust::iterator_value<RandomAccessIterator>::type key_type;
 
@@ -267,6 +311,34 @@ void stable_sort(
   sort_detail::merge_sort(exec, first, last, temp.begin(), comp, true);
 }
 
+template <typename DerivedPolicy, typename RandomAccessIterator, typename StrictWeakOrdering>
+void stable_sort(execution_policy<DerivedPolicy>& exec,
+                 RandomAccessIterator first,
+                 RandomAccessIterator last,
+                 StrictWeakOrdering comp,
+                 thrust::detail::true_type)
+{
+  typedef typename thrust::iterator_difference<RandomAccessIterator>::type difference_type;
+  typedef typename thrust::iterator_value<RandomAccessIterator>::type key_type;
+
+  difference_type n = thrust::distance(first, last);
+
+  if (n < radix_sort_detail::threshold)
+  {
+    thrust::stable_sort(thrust::seq, first, last, comp);
+    return;
+  }
+
+  thrust::system::detail::internal::radix_sort_detail::radix_sort<false>(
+    exec, radix_sort_detail::parallel_for_tiles(), first, static_cast<int*>(0), n);
+
+  // if comp is greater<T> then reverse the keys
+  if (thrust::system::detail::sequential::sort_detail::needs_reverse<key_type, StrictWeakOrdering>::value)
+  {
+    thrust::reverse(exec, first, last);
+  }
+}
+
 template <typename DerivedPolicy,
           typename RandomAccessIterator1,
           typename RandomAccessIterator2,
@@ -276,7 +348,8 @@ void stable_sort_by_key(
   RandomAccessIterator1 first1,
   RandomAccessIterator1 last1,
   RandomAccessIterator2 first2,
-  StrictWeakOrdering comp)
+  StrictWeakOrdering comp,
+  thrust::detail::false_type)
 {
   typedef typename thrust::iterator_value<RandomAccessIterator1>::type key_type;
   typedef typename thrust::iterator_value<RandomAccessIterator2>::type val_type;
@@ -289,6 +362,85 @@ void stable_sort_by_key(
   sort_by_key_detail::merge_sort_by_key(exec, first1, last1, first2, temp1.begin(), temp2.begin(), comp, true);
 }
 
+template <typename DerivedPolicy,
+          typename RandomAccessIterator1,
+          typename RandomAccessIterator2,
+          typename StrictWeakOrdering>
+void stable_sort_by_key(
+  execution_policy<DerivedPolicy>& exec,
+  RandomAccessIterator1 first1,
+  RandomAccessIterator1 last1,
+  RandomAccessIterator2 first2,
+  StrictWeakOrdering comp,
+  thrust::detail::true_type)
+{
+  typedef typename thrust::iterator_difference<RandomAccessIterator1>::type difference_type;
+  typedef typename thrust::iterator_value<RandomAccessIterator1>::type key_type;
+
+  difference_type n = thrust::distance(first1, last1);
+
+  if (n < radix_sort_detail::threshold)
+  {
+    thrust::stable_sort_by_key(thrust::seq, first1, last1, first2, comp);
+    return;
+  }
+
+  RandomAccessIterator2 last2 = first2 + n;
+
+  // if comp is greater<T> then reverse the keys and values
+  // note, we also have to reverse the (unordered) input to preserve stability
+  const bool reverse =
+    thrust::system::detail::sequential::sort_detail::needs_reverse<key_type, StrictWeakOrdering>::value;
+
+  if (reverse)
+  {
+    thrust::reverse(exec, first1, last1);
+    thrust::reverse(exec, first2, last2);
+  }
+
+  thrust::system::detail::internal::radix_sort_detail::radix_sort<true>(
+    exec, radix_sort_detail::parallel_for_tiles(), first1, first2, n);
+
+  if (reverse)
+  {
+    thrust::reverse(exec, first1, last1);
+    thrust::reverse(exec, first2, last2);
+  }
+}
+
+} // namespace dispatch
+
+template <typename DerivedPolicy, typename RandomAccessIterator, typename StrictWeakOrdering>
+void stable_sort(
+  execution_policy<DerivedPolicy>& exec, RandomAccessIterator first, RandomAccessIterator last, StrictWeakOrdering comp)
+{
+  typedef typename thrust::iterator_value<RandomAccessIterator>::type key_type;
+
+  // primitive keys compared with less or greater are radix sorted
+  thrust::system::detail::sequential::sort_detail::use_primitive_sort<key_type, StrictWeakOrdering> use_primitive_sort;
+
+  dispatch::stable_sort(exec, first, last, comp, use_primitive_sort);
+}
+
+template <typename DerivedPolicy,
+          typename RandomAccessIterator1,
+          typename RandomAccessIterator2,
+          typename StrictWeakOrdering>
+void stable_sort_by_key(
+  execution_policy<DerivedPolicy>& exec,
+  RandomAccessIterator1 first1,
+  RandomAccessIterator1 last1,
+  RandomAccessIterator2 first2,
+  StrictWeakOrdering comp)
+{
+  typedef typename thrust::iterator_value<RandomAccessIterator1>::type key_type;
+
+  // primitive keys compared with less or greater are radix sorted
+  thrust::system::detail::sequential::sort_detail::use_primitive_sort<key_type, StrictWeakOrdering> use_primitive_sort;
+
+  dispatch::stable_sort_by_key(exec, first1, last1, first2, comp, use_primitive_sort);
+}
+
 } // end namespace detail
 } // end namespace tbb
 } // end namespace system
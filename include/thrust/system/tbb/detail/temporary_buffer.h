@@ -26,4 +26,5 @@
 #  pragma system_header
 #endif // no system header
 
-// this system has no special temporary buffer functions
+// this system inherits get_temporary_buffer and return_temporary_buffer
+#include <thrust/system/cpp/detail/temporary_buffer.h>
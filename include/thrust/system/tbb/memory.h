@@ -100,6 +100,8 @@ namespace tbb
 using thrust::system::tbb::allocator;
 using thrust::system::tbb::free;
 using thrust::system::tbb::malloc;
+using thrust::system::tbb::numa_allocator;
+using thrust::system::tbb::numa_memory_resource;
 using thrust::system::tbb::universal_allocator;
 } // namespace tbb
 
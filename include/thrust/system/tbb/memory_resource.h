@@ -29,8 +29,10 @@
 #elif defined(_CCCL_IMPLICIT_SYSTEM_HEADER_MSVC)
 #  pragma system_header
 #endif // no system header
+#include <thrust/mr/allocator.h>
 #include <thrust/mr/fancy_pointer_resource.h>
 #include <thrust/mr/new.h>
+#include <thrust/mr/numa.h>
 #include <thrust/system/tbb/pointer.h>
 
 THRUST_NAMESPACE_BEGIN
@@ -46,6 +48,8 @@ typedef thrust::mr::fancy_pointer_resource<thrust::mr::new_delete_resource, thru
 
 typedef thrust::mr::fancy_pointer_resource<thrust::mr::new_delete_resource, thrust::tbb::universal_pointer<void>>
   universal_native_resource;
+
+typedef thrust::mr::fancy_pointer_resource<thrust::mr::numa_memory_resource, thrust::tbb::pointer<void>> numa_resource;
 } // namespace detail
 //! \endcond
 
@@ -64,6 +68,18 @@ typedef detail::native_resource memory_resource;
 typedef detail::universal_native_resource universal_memory_resource;
 /*! An alias for \p tbb::universal_memory_resource. */
 typedef detail::native_resource universal_host_pinned_memory_resource;
+/*! A memory resource for the TBB system which places its allocations on NUMA nodes with
+ *  \p mr::numa_memory_resource, and tags them with \p tbb::pointer. It is constructed from a pointer to the
+ *  \p mr::numa_memory_resource which selects the placement. As TBB does not divide ranges among its threads in a
+ *  fixed way, there is no first touch by the threads which will work on the memory; \p mr::numa_policy::interleave
+ *  is the policy of choice for data which all threads share.
+ */
+typedef detail::numa_resource numa_memory_resource;
+/*! An allocator for the containers of the TBB system, such as \p tbb::vector, which allocates from a
+ *  \p tbb::numa_memory_resource.
+ */
+template <typename T>
+using numa_allocator = thrust::mr::allocator<T, numa_memory_resource>;
 
 /*! \} // memory_resources
  */
@@ -0,0 +1,167 @@
+/*
+ *  Copyright 2024 NVIDIA Corporation
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+#pragma once
+
+#include <thrust/detail/config.h>
+
+#if defined(_CCCL_IMPLICIT_SYSTEM_HEADER_GCC)
+#  pragma GCC system_header
+#elif defined(_CCCL_IMPLICIT_SYSTEM_HEADER_CLANG)
+#  pragma clang system_header
+#elif defined(_CCCL_IMPLICIT_SYSTEM_HEADER_MSVC)
+#  pragma system_header
+#endif // no system header
+#include <thrust/detail/function.h>
+#include <thrust/detail/temporary_array.h>
+#include <thrust/distance.h>
+#include <thrust/iterator/iterator_traits.h>
+#include <thrust/system/threads/detail/copy_if.h>
+#include <thrust/system/threads/detail/parallel_for.h>
+
+THRUST_NAMESPACE_BEGIN
+namespace system
+{
+namespace threads
+{
+namespace detail
+{
+namespace copy_if_detail
+{
+
+// counts the selected elements of every interval of the decomposition
+template <typename InputIterator, typename Predicate, typename CountIterator, typename Decomposition>
+struct count_body
+{
+  InputIterator stencil;
+  Predicate pred;
+  CountIterator counts;
+  Decomposition decomp;
+
+  template <typename Size>
+  void operator()(Size begin, Size end) const
+  {
+    thrust::detail::wrapped_function<Predicate, bool> wrapped_pred(pred);
+
+    for (Size i = begin; i != end; ++i)
+    {
+      InputIterator iter = stencil + decomp[i].begin();
+      InputIterator last = stencil + decomp[i].end();
+
+      Size count = 0;
+
+      for (; iter != last; ++iter)
+      {
+        if (wrapped_pred(*iter))
+        {
+          ++count;
+        }
+      }
+
+      counts[i] = count;
+    }
+  }
+}; // end count_body
+
+// copies the selected elements of every interval of the decomposition, starting from the interval's offset
+template <typename InputIterator1,
+          typename InputIterator2,
+          typename OutputIterator,
+          typename Predicate,
+          typename CountIterator,
+          typename Decomposition>
+struct copy_body
+{
+  InputIterator1 first;
+  InputIterator2 stencil;
+  OutputIterator result;
+  Predicate pred;
+  CountIterator offsets;
+  Decomposition decomp;
+
+  template <typename Size>
+  void operator()(Size begin, Size end) const
+  {
+    thrust::detail::wrapped_function<Predicate, bool> wrapped_pred(pred);
+
+    for (Size i = begin; i != end; ++i)
+    {
+      InputIterator1 iter1 = first + decomp[i].begin();
+      InputIterator1 last  = first + decomp[i].end();
+      InputIterator2 iter2 = stencil + decomp[i].begin();
+      OutputIterator iter3 = result + offsets[i];
+
+      for (; iter1 != last; ++iter1, ++iter2)
+      {
+        if (wrapped_pred(*iter2))
+        {
+          *iter3 = *iter1;
+          ++iter3;
+        }
+      }
+    }
+  }
+}; // end copy_body
+
+} // namespace copy_if_detail
+
+template <typename InputIterator1, typename InputIterator2, typename OutputIterator, typename Predicate>
+OutputIterator copy_if(
+  tag exec, InputIterator1 first, InputIterator1 last, InputIterator2 stencil, OutputIterator result, Predicate pred)
+{
+  typedef typename thrust::iterator_difference<InputIterator1>::type Size;
+  typedef thrust::system::detail::internal::uniform_decomposition<Size> Decomposition;
+  typedef thrust::detail::temporary_array<Size, tag> CountArray;
+  typedef typename CountArray::iterator CountIterator;
+
+  Size n = thrust::distance(first, last);
+
+  if (n != 0)
+  {
+    Decomposition decomp = threads::detail::default_decomposition(n);
+
+    // count the selected elements of every interval, in parallel
+    CountArray offsets(exec, decomp.size());
+
+    copy_if_detail::count_body<InputIterator2, Predicate, CountIterator, Decomposition> count = {
+      stencil, pred, offsets.begin(), decomp};
+    threads::detail::parallel_for(decomp.size(), Size(1), count);
+
+    // scan the counts to find where each interval's output starts
+    Size sum = 0;
+
+    for (Size i = 0; i < decomp.size(); ++i)
+    {
+      Size count_i = offsets[i];
+      offsets[i]   = sum;
+      sum += count_i;
+    }
+
+    // copy the selected elements of every interval, in parallel
+    copy_if_detail::copy_body<InputIterator1, InputIterator2, OutputIterator, Predicate, CountIterator, Decomposition>
+      copy = {first, stencil, result, pred, offsets.begin(), decomp};
+    threads::detail::parallel_for(decomp.size(), Size(1), copy);
+
+    thrust::advance(result, sum);
+  }
+
+  return result;
+} // end copy_if()
+
+} // namespace detail
+} // namespace threads
+} // namespace system
+THRUST_NAMESPACE_END
@@ -0,0 +1,238 @@
+/*
+ *  Copyright 2024 NVIDIA Corporation
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+/*! \file parallel_for.h
+ *  \brief Fork-join primitives of the threads system, built on its thread pool.
+ */
+
+#pragma once
+
+#include <thrust/detail/config.h>
+
+#if defined(_CCCL_IMPLICIT_SYSTEM_HEADER_GCC)
+#  pragma GCC system_header
+#elif defined(_CCCL_IMPLICIT_SYSTEM_HEADER_CLANG)
+#  pragma clang system_header
+#elif defined(_CCCL_IMPLICIT_SYSTEM_HEADER_MSVC)
+#  pragma system_header
+#endif // no system header
+#include <thrust/system/detail/internal/decompose.h>
+#include <thrust/system/threads/detail/thread_pool.h>
+
+THRUST_NAMESPACE_BEGIN
+namespace system
+{
+namespace threads
+{
+namespace detail
+{
+namespace parallel_for_detail
+{
+
+template <typename Function>
+class function_task : public task
+{
+public:
+  explicit function_task(Function& f)
+      : m_f(f)
+  {}
+
+protected:
+  void execute()
+  {
+    m_f();
+  }
+
+private:
+  Function& m_f;
+}; // end function_task
+
+template <typename Size, typename Body>
+struct range_function
+{
+  Size begin, end, grain;
+  const Body& body;
+
+  void operator()() const;
+}; // end range_function
+
+template <typename Size, typename Body>
+void parallel_for_range(Size begin, Size end, Size grain, const Body& body)
+{
+  thread_pool& pool = thread_pool::instance();
+
+  // split the range in halves until they are small enough, leaving the second halves for idle workers to steal
+  while (end - begin > grain)
+  {
+    const Size mid = begin + (end - begin) / 2;
+
+    range_function<Size, Body> second = {mid, end, grain, body};
+    function_task<range_function<Size, Body>> t(second);
+    pool.spawn(t);
+
+    try
+    {
+      parallel_for_range(begin, mid, grain, body);
+    }
+    catch (...)
+    {
+      // t refers to our stack frame, so it must finish before we unwind
+      pool.wait(t);
+      throw;
+    }
+
+    pool.wait(t);
+    t.rethrow();
+    return;
+  }
+
+  body(begin, end);
+} // end parallel_for_range()
+
+template <typename Size, typename Body>
+void range_function<Size, Body>::operator()() const
+{
+  parallel_for_range(begin, end, grain, body);
+} // end range_function::operator()()
+
+} // namespace parallel_for_detail
+
+// the number of workers of the threads system
+inline std::size_t num_workers()
+{
+  return thread_pool::instance().size();
+} // end num_workers()
+
+// runs f on a worker of the pool, and returns once it is done
+template <typename Function>
+void run_on_pool(Function f)
+{
+  thread_pool& pool = thread_pool::instance();
+
+  if (pool.on_worker())
+  {
+    f();
+  }
+  else
+  {
+    parallel_for_detail::function_task<Function> t(f);
+    pool.run(t);
+    t.rethrow();
+  }
+} // end run_on_pool()
+
+namespace parallel_for_detail
+{
+
+template <typename Function1, typename Function2>
+struct invoke_function
+{
+  Function1& f1;
+  Function2& f2;
+
+  void operator()() const
+  {
+    thread_pool& pool = thread_pool::instance();
+
+    function_task<Function2> t(f2);
+    pool.spawn(t);
+
+    try
+    {
+      f1();
+    }
+    catch (...)
+    {
+      pool.wait(t);
+      throw;
+    }
+
+    pool.wait(t);
+    t.rethrow();
+  }
+}; // end invoke_function
+
+template <typename Size, typename Body>
+struct for_function
+{
+  Size n, grain;
+  const Body& body;
+
+  void operator()() const
+  {
+    parallel_for_range(Size(0), n, grain, body);
+  }
+}; // end for_function
+
+} // namespace parallel_for_detail
+
+// runs f1 and f2, possibly in parallel, and returns once both are done
+template <typename Function1, typename Function2>
+void parallel_invoke(Function1 f1, Function2 f2)
+{
+  if (num_workers() == 1)
+  {
+    f1();
+    f2();
+    return;
+  }
+
+  parallel_for_detail::invoke_function<Function1, Function2> f = {f1, f2};
+  run_on_pool(f);
+} // end parallel_invoke()
+
+// calls body(begin, end) on disjoint subranges of [0, n) which together cover it, in parallel. Subranges are no
+// larger than grain, unless there is only a single worker, in which case body is called once on the whole range.
+template <typename Size, typename Body>
+void parallel_for(Size n, Size grain, const Body& body)
+{
+  if (n <= 0)
+  {
+    return;
+  }
+
+  if (n <= grain || num_workers() == 1)
+  {
+    body(Size(0), n);
+    return;
+  }
+
+  parallel_for_detail::for_function<Size, Body> f = {n, grain, body};
+  run_on_pool(f);
+} // end parallel_for()
+
+// a grain which splits n into a few subranges per worker, so that stealing can balance uneven work
+template <typename Size>
+Size default_grain(Size n)
+{
+  const Size num_ranges = static_cast<Size>(8 * num_workers());
+
+  return (n / num_ranges > 0) ? n / num_ranges : Size(1);
+} // end default_grain()
+
+// a decomposition of n into a few intervals per worker, for algorithms which combine the results of intervals
+template <typename IndexType>
+thrust::system::detail::internal::uniform_decomposition<IndexType> default_decomposition(IndexType n)
+{
+  const IndexType p = static_cast<IndexType>(num_workers());
+
+  return thrust::system::detail::internal::uniform_decomposition<IndexType>(n, 1, (p == 1) ? 1 : 4 * p);
+} // end default_decomposition()
+
+} // namespace detail
+} // namespace threads
+} // namespace system
+THRUST_NAMESPACE_END
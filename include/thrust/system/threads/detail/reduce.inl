@@ -0,0 +1,122 @@
+/*
+ *  Copyright 2024 NVIDIA Corporation
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+#pragma once
+
+#include <thrust/detail/config.h>
+
+#if defined(_CCCL_IMPLICIT_SYSTEM_HEADER_GCC)
+#  pragma GCC system_header
+#elif defined(_CCCL_IMPLICIT_SYSTEM_HEADER_CLANG)
+#  pragma clang system_header
+#elif defined(_CCCL_IMPLICIT_SYSTEM_HEADER_MSVC)
+#  pragma system_header
+#endif // no system header
+#include <thrust/detail/function.h>
+#include <thrust/detail/temporary_array.h>
+#include <thrust/distance.h>
+#include <thrust/iterator/iterator_traits.h>
+#include <thrust/system/threads/detail/parallel_for.h>
+
+THRUST_NAMESPACE_BEGIN
+namespace system
+{
+namespace threads
+{
+namespace detail
+{
+namespace reduce_detail
+{
+
+template <typename RandomAccessIterator, typename OutputIterator, typename BinaryFunction, typename Decomposition>
+struct body
+{
+  RandomAccessIterator first;
+  OutputIterator partial_sums;
+  BinaryFunction binary_op;
+  Decomposition decomp;
+
+  template <typename Size>
+  void operator()(Size begin, Size end) const
+  {
+    typedef typename thrust::iterator_value<OutputIterator>::type OutputType;
+
+    thrust::detail::wrapped_function<BinaryFunction, OutputType> wrapped_binary_op(binary_op);
+
+    for (Size i = begin; i != end; ++i)
+    {
+      RandomAccessIterator iter = first + decomp[i].begin();
+      RandomAccessIterator last = first + decomp[i].end();
+
+      // decompositions have no empty intervals
+      OutputType sum = thrust::raw_reference_cast(*iter);
+
+      for (++iter; iter != last; ++iter)
+      {
+        sum = wrapped_binary_op(sum, *iter);
+      }
+
+      partial_sums[i] = sum;
+    }
+  } // end operator()()
+}; // end body
+
+} // namespace reduce_detail
+
+template <typename DerivedPolicy, typename InputIterator, typename OutputType, typename BinaryFunction>
+OutputType reduce(execution_policy<DerivedPolicy>& exec,
+                  InputIterator first,
+                  InputIterator last,
+                  OutputType init,
+                  BinaryFunction binary_op)
+{
+  typedef typename thrust::iterator_difference<InputIterator>::type Size;
+  typedef thrust::system::detail::internal::uniform_decomposition<Size> Decomposition;
+  typedef typename thrust::detail::temporary_array<OutputType, DerivedPolicy>::iterator OutputIterator;
+
+  const Size n = thrust::distance(first, last);
+
+  if (n == 0)
+  {
+    return init;
+  }
+
+  Decomposition decomp = threads::detail::default_decomposition(n);
+
+  // reduce every interval to a partial sum, in parallel
+  thrust::detail::temporary_array<OutputType, DerivedPolicy> partial_sums(exec, decomp.size());
+
+  reduce_detail::body<InputIterator, OutputIterator, BinaryFunction, Decomposition> reduce_body = {
+    first, partial_sums.begin(), binary_op, decomp};
+  threads::detail::parallel_for(decomp.size(), Size(1), reduce_body);
+
+  // reduce the partial sums in order, as binary_op need not commute
+  thrust::detail::wrapped_function<BinaryFunction, OutputType> wrapped_binary_op(binary_op);
+
+  OutputType result = init;
+
+  for (Size i = 0; i < decomp.size(); ++i)
+  {
+    result = wrapped_binary_op(result, partial_sums[i]);
+  }
+
+  return result;
+} // end reduce()
+
+} // end namespace detail
+} // end namespace threads
+} // end namespace system
+THRUST_NAMESPACE_END
@@ -0,0 +1,223 @@
+/*
+ *  Copyright 2024 NVIDIA Corporation
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+#pragma once
+
+#include <thrust/detail/config.h>
+
+#if defined(_CCCL_IMPLICIT_SYSTEM_HEADER_GCC)
+#  pragma GCC system_header
+#elif defined(_CCCL_IMPLICIT_SYSTEM_HEADER_CLANG)
+#  pragma clang system_header
+#elif defined(_CCCL_IMPLICIT_SYSTEM_HEADER_MSVC)
+#  pragma system_header
+#endif // no system header
+#include <thrust/advance.h>
+#include <thrust/detail/function.h>
+#include <thrust/detail/temporary_array.h>
+#include <thrust/distance.h>
+#include <thrust/iterator/constant_iterator.h>
+#include <thrust/iterator/iterator_traits.h>
+#include <thrust/system/threads/detail/parallel_for.h>
+#include <thrust/system/threads/detail/scan.h>
+
+THRUST_NAMESPACE_BEGIN
+namespace system
+{
+namespace threads
+{
+namespace detail
+{
+namespace scan_detail
+{
+
+// reduces every interval of the decomposition but the last to a partial sum
+template <typename InputIterator, typename SumIterator, typename BinaryFunction, typename ValueType, typename Decomposition>
+struct upsweep_body
+{
+  InputIterator input;
+  SumIterator sums;
+  BinaryFunction binary_op;
+  Decomposition decomp;
+
+  template <typename Size>
+  void operator()(Size begin, Size end) const
+  {
+    thrust::detail::wrapped_function<BinaryFunction, ValueType> wrapped_binary_op(binary_op);
+
+    for (Size i = begin; i != end; ++i)
+    {
+      InputIterator iter = input + decomp[i].begin();
+      InputIterator last = input + decomp[i].end();
+
+      ValueType sum = *iter;
+
+      for (++iter; iter != last; ++iter)
+      {
+        sum = wrapped_binary_op(sum, *iter);
+      }
+
+      sums[i] = sum;
+    }
+  } // end operator()()
+}; // end upsweep_body
+
+// scans every interval of the decomposition, starting from the carry of the intervals before it
+template <bool Inclusive,
+          typename InputIterator,
+          typename OutputIterator,
+          typename SumIterator,
+          typename BinaryFunction,
+          typename ValueType,
+          typename Decomposition>
+struct downsweep_body
+{
+  InputIterator input;
+  OutputIterator output;
+  SumIterator carries;
+  BinaryFunction binary_op;
+  Decomposition decomp;
+
+  template <typename Size>
+  void operator()(Size begin, Size end) const
+  {
+    thrust::detail::wrapped_function<BinaryFunction, ValueType> wrapped_binary_op(binary_op);
+
+    for (Size i = begin; i != end; ++i)
+    {
+      InputIterator iter1  = input + decomp[i].begin();
+      InputIterator last   = input + decomp[i].end();
+      OutputIterator iter2 = output + decomp[i].begin();
+
+      if (Inclusive)
+      {
+        // the first interval of an inclusive scan has no carry
+        ValueType sum = (i == 0) ? ValueType(*iter1) : wrapped_binary_op(carries[i], *iter1);
+        *iter2        = sum;
+
+        for (++iter1, ++iter2; iter1 != last; ++iter1, ++iter2)
+        {
+          *iter2 = sum = wrapped_binary_op(sum, *iter1);
+        }
+      }
+      else
+      {
+        ValueType sum = carries[i];
+
+        for (; iter1 != last; ++iter1, ++iter2)
+        {
+          // read the input before writing the output, which may alias it
+          ValueType temp = wrapped_binary_op(sum, *iter1);
+          *iter2         = sum;
+          sum            = temp;
+        }
+      }
+    }
+  } // end operator()()
+}; // end downsweep_body
+
+template <bool Inclusive, typename ValueType, typename InputIterator, typename OutputIterator, typename BinaryFunction>
+void scan(tag exec, InputIterator first, InputIterator last, OutputIterator result, ValueType init, BinaryFunction binary_op)
+{
+  typedef typename thrust::iterator_difference<InputIterator>::type Size;
+  typedef thrust::system::detail::internal::uniform_decomposition<Size> Decomposition;
+  typedef thrust::detail::temporary_array<ValueType, tag> SumArray;
+  typedef typename SumArray::iterator SumIterator;
+
+  const Size n = thrust::distance(first, last);
+
+  if (n == 0)
+  {
+    return;
+  }
+
+  Decomposition decomp = threads::detail::default_decomposition(n);
+
+  // carries[i] ends up as the scan of the intervals before interval i
+  SumArray carries(exec, thrust::make_constant_iterator(init), decomp.size());
+
+  // the last interval contributes to no carry
+  upsweep_body<InputIterator, SumIterator, BinaryFunction, ValueType, Decomposition> upsweep = {
+    first, carries.begin(), binary_op, decomp};
+  threads::detail::parallel_for(decomp.size() - 1, Size(1), upsweep);
+
+  thrust::detail::wrapped_function<BinaryFunction, ValueType> wrapped_binary_op(binary_op);
+
+  ValueType carry = init;
+
+  for (Size i = 0; i < decomp.size(); ++i)
+  {
+    ValueType sum = carries[i];
+    carries[i]    = carry;
+
+    if (i + 1 < decomp.size())
+    {
+      carry = (Inclusive && i == 0) ? sum : wrapped_binary_op(carry, sum);
+    }
+  }
+
+  downsweep_body<Inclusive, InputIterator, OutputIterator, SumIterator, BinaryFunction, ValueType, Decomposition>
+    downsweep = {first, result, carries.begin(), binary_op, decomp};
+  threads::detail::parallel_for(decomp.size(), Size(1), downsweep);
+} // end scan()
+
+} // namespace scan_detail
+
+template <typename InputIterator, typename OutputIterator, typename BinaryFunction>
+OutputIterator
+inclusive_scan(tag exec, InputIterator first, InputIterator last, OutputIterator result, BinaryFunction binary_op)
+{
+  // Use the input iterator's value type per https://wg21.link/P0571
+  using ValueType = typename thrust::iterator_value<InputIterator>::type;
+
+  using Size = typename thrust::iterator_difference<InputIterator>::type;
+  Size n     = thrust::distance(first, last);
+
+  if (n != 0)
+  {
+    // an inclusive scan has no initial value, so the first element stands in for it
+    scan_detail::scan<true>(exec, first, last, result, ValueType(*first), binary_op);
+  }
+
+  thrust::advance(result, n);
+
+  return result;
+}
+
+template <typename InputIterator, typename OutputIterator, typename InitialValueType, typename BinaryFunction>
+OutputIterator exclusive_scan(
+  tag exec, InputIterator first, InputIterator last, OutputIterator result, InitialValueType init, BinaryFunction binary_op)
+{
+  // Use the initial value type per https://wg21.link/P0571
+  using ValueType = InitialValueType;
+
+  using Size = typename thrust::iterator_difference<InputIterator>::type;
+  Size n     = thrust::distance(first, last);
+
+  if (n != 0)
+  {
+    scan_detail::scan<false>(exec, first, last, result, ValueType(init), binary_op);
+  }
+
+  thrust::advance(result, n);
+
+  return result;
+}
+
+} // end namespace detail
+} // end namespace threads
+} // end namespace system
+THRUST_NAMESPACE_END
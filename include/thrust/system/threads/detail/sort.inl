@@ -0,0 +1,429 @@
+/*
+ *  Copyright 2024 NVIDIA Corporation
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+#pragma once
+
+#include <thrust/detail/config.h>
+
+#if defined(_CCCL_IMPLICIT_SYSTEM_HEADER_GCC)
+#  pragma GCC system_header
+#elif defined(_CCCL_IMPLICIT_SYSTEM_HEADER_CLANG)
+#  pragma clang system_header
+#elif defined(_CCCL_IMPLICIT_SYSTEM_HEADER_MSVC)
+#  pragma system_header
+#endif // no system header
+#include <thrust/detail/copy.h>
+#include <thrust/detail/seq.h>
+#include <thrust/detail/temporary_array.h>
+#include <thrust/distance.h>
+#include <thrust/iterator/iterator_traits.h>
+#include <thrust/merge.h>
+#include <thrust/reverse.h>
+#include <thrust/sort.h>
+#include <thrust/system/detail/internal/radix_sort.h>
+#include <thrust/system/detail/sequential/sort.h>
+#include <thrust/system/threads/detail/parallel_for.h>
+
+THRUST_NAMESPACE_BEGIN
+namespace system
+{
+namespace threads
+{
+namespace detail
+{
+namespace sort_detail
+{
+
+// TODO tune this based on data type and comp
+const static int threshold = 128 * 1024;
+
+template <typename DerivedPolicy, typename Iterator1, typename Iterator2, typename StrictWeakOrdering>
+void merge_sort(execution_policy<DerivedPolicy>& exec,
+                Iterator1 first1,
+                Iterator1 last1,
+                Iterator2 first2,
+                StrictWeakOrdering comp,
+                bool inplace);
+
+template <typename DerivedPolicy, typename Iterator1, typename Iterator2, typename StrictWeakOrdering>
+struct merge_sort_closure
+{
+  execution_policy<DerivedPolicy>& exec;
+  Iterator1 first1, last1;
+  Iterator2 first2;
+  StrictWeakOrdering comp;
+  bool inplace;
+
+  merge_sort_closure(
+    execution_policy<DerivedPolicy>& exec,
+    Iterator1 first1,
+    Iterator1 last1,
+    Iterator2 first2,
+    StrictWeakOrdering comp,
+    bool inplace)
+      : exec(exec)
+      , first1(first1)
+      , last1(last1)
+      , first2(first2)
+      , comp(comp)
+      , inplace(inplace)
+  {}
+
+  void operator()(void) const
+  {
+    merge_sort(exec, first1, last1, first2, comp, inplace);
+  }
+};
+
+template <typename DerivedPolicy, typename Iterator1, typename Iterator2, typename StrictWeakOrdering>
+void merge_sort(execution_policy<DerivedPolicy>& exec,
+                Iterator1 first1,
+                Iterator1 last1,
+                Iterator2 first2,
+                StrictWeakOrdering comp,
+                bool inplace)
+{
+  typedef typename thrust::iterator_difference<Iterator1>::type difference_type;
+
+  difference_type n = thrust::distance(first1, last1);
+
+  if (n < threshold)
+  {
+    thrust::stable_sort(thrust::seq, first1, last1, comp);
+
+    if (!inplace)
+    {
+      thrust::copy(thrust::seq, first1, last1, first2);
+    }
+
+    return;
+  }
+
+  Iterator1 mid1  = first1 + (n / 2);
+  Iterator2 mid2  = first2 + (n / 2);
+  Iterator2 last2 = first2 + n;
+
+  typedef merge_sort_closure<DerivedPolicy, Iterator1, Iterator2, StrictWeakOrdering> Closure;
+
+  Closure left(exec, first1, mid1, first2, comp, !inplace);
+  Closure right(exec, mid1, last1, mid2, comp, !inplace);
+
+  threads::detail::parallel_invoke(left, right);
+
+  if (inplace)
+  {
+    thrust::merge(exec, first2, mid2, mid2, last2, first1, comp);
+  }
+  else
+  {
+    thrust::merge(exec, first1, mid1, mid1, last1, first2, comp);
+  }
+}
+
+} // end namespace sort_detail
+
+namespace sort_by_key_detail
+{
+
+// TODO tune this based on data type and comp
+const static int threshold = 128 * 1024;
+
+template <typename DerivedPolicy,
+          typename Iterator1,
+          typename Iterator2,
+          typename Iterator3,
+          typename Iterator4,
+          typename StrictWeakOrdering>
+void merge_sort_by_key(
+  execution_policy<DerivedPolicy>& exec,
+  Iterator1 first1,
+  Iterator1 last1,
+  Iterator2 first2,
+  Iterator3 first3,
+  Iterator4 first4,
+  StrictWeakOrdering comp,
+  bool inplace);
+
+template <typename DerivedPolicy,
+          typename Iterator1,
+          typename Iterator2,
+          typename Iterator3,
+          typename Iterator4,
+          typename StrictWeakOrdering>
+struct merge_sort_by_key_closure
+{
+  execution_policy<DerivedPolicy>& exec;
+  Iterator1 first1, last1;
+  Iterator2 first2;
+  Iterator3 first3;
+  Iterator4 first4;
+  StrictWeakOrdering comp;
+  bool inplace;
+
+  merge_sort_by_key_closure(
+    execution_policy<DerivedPolicy>& exec,
+    Iterator1 first1,
+    Iterator1 last1,
+    Iterator2 first2,
+    Iterator3 first3,
+    Iterator4 first4,
+    StrictWeakOrdering comp,
+    bool inplace)
+      : exec(exec)
+      , first1(first1)
+      , last1(last1)
+      , first2(first2)
+      , first3(first3)
+      , first4(first4)
+      , comp(comp)
+      , inplace(inplace)
+  {}
+
+  void operator()(void) const
+  {
+    merge_sort_by_key(exec, first1, last1, first2, first3, first4, comp, inplace);
+  }
+};
+
+template <typename DerivedPolicy,
+          typename Iterator1,
+          typename Iterator2,
+          typename Iterator3,
+          typename Iterator4,
+          typename StrictWeakOrdering>
+void merge_sort_by_key(
+  execution_policy<DerivedPolicy>& exec,
+  Iterator1 first1,
+  Iterator1 last1,
+  Iterator2 first2,
+  Iterator3 first3,
+  Iterator4 first4,
+  StrictWeakOrdering comp,
+  bool inplace)
+{
+  typedef typename thrust::iterator_difference<Iterator1>::type difference_type;
+
+  difference_type n = thrust::distance(first1, last1);
+
+  Iterator1 mid1  = first1 + (n / 2);
+  Iterator2 mid2  = first2 + (n / 2);
+  Iterator3 mid3  = first3 + (n / 2);
+  Iterator4 mid4  = first4 + (n / 2);
+  Iterator2 last2 = first2 + n;
+  Iterator3 last3 = first3 + n;
+
+  if (n < threshold)
+  {
+    thrust::stable_sort_by_key(thrust::seq, first1, last1, first2, comp);
+
+    if (!inplace)
+    {
+      thrust::copy(thrust::seq, first1, last1, first3);
+      thrust::copy(thrust::seq, first2, last2, first4);
+    }
+
+    return;
+  }
+
+  typedef merge_sort_by_key_closure<DerivedPolicy, Iterator1, Iterator2, Iterator3, Iterator4, StrictWeakOrdering>
+    Closure;
+
+  Closure left(exec, first1, mid1, first2, first3, first4, comp, !inplace);
+  Closure right(exec, mid1, last1, mid2, mid3, mid4, comp, !inplace);
+
+  threads::detail::parallel_invoke(left, right);
+
+  if (inplace)
+  {
+    thrust::merge_by_key(exec, first3, mid3, mid3, last3, first4, mid4, first1, first2, comp);
+  }
+  else
+  {
+    thrust::merge_by_key(exec, first1, mid1, mid1, last1, first2, mid2, first3, first4, comp);
+  }
+}
+
+} // namespace sort_by_key_detail
+
+namespace radix_sort_detail
+{
+
+// below this size the sequential radix sort beats the parallel one
+const static int threshold = 128 * 1024;
+
+// runs the tiles of the shared radix sort on the thread pool
+struct parallel_for_tiles
+{
+  template <typename Size, typename Body>
+  void operator()(Size num_tiles, const Body& body) const
+  {
+    threads::detail::parallel_for(num_tiles, Size(1), body);
+  }
+};
+
+} // namespace radix_sort_detail
+
+namespace dispatch
+{
+
+template <typename DerivedPolicy, typename RandomAccessIterator, typename StrictWeakOrdering>
+void stable_sort(execution_policy<DerivedPolicy>& exec,
+                 RandomAccessIterator first,
+                 RandomAccessIterator last,
+                 StrictWeakOrdering comp,
+                 thrust::detail::false_type)
+{
+  typedef typename thrust::iterator_value<RandomAccessIterator>::type key_type;
+
+  thrust::detail::temporary_array<key_type, DerivedPolicy> temp(exec, first, last);
+
+  sort_detail::merge_sort(exec, first, last, temp.begin(), comp, true);
+}
+
+template <typename DerivedPolicy, typename RandomAccessIterator, typename StrictWeakOrdering>
+void stable_sort(execution_policy<DerivedPolicy>& exec,
+                 RandomAccessIterator first,
+                 RandomAccessIterator last,
+                 StrictWeakOrdering comp,
+                 thrust::detail::true_type)
+{
+  typedef typename thrust::iterator_difference<RandomAccessIterator>::type difference_type;
+  typedef typename thrust::iterator_value<RandomAccessIterator>::type key_type;
+
+  difference_type n = thrust::distance(first, last);
+
+  if (n < radix_sort_detail::threshold)
+  {
+    thrust::stable_sort(thrust::seq, first, last, comp);
+    return;
+  }
+
+  thrust::system::detail::internal::radix_sort_detail::radix_sort<false>(
+    exec, radix_sort_detail::parallel_for_tiles(), first, static_cast<int*>(0), n);
+
+  // if comp is greater<T> then reverse the keys
+  if (thrust::system::detail::sequential::sort_detail::needs_reverse<key_type, StrictWeakOrdering>::value)
+  {
+    thrust::reverse(exec, first, last);
+  }
+}
+
+template <typename DerivedPolicy,
+          typename RandomAccessIterator1,
+          typename RandomAccessIterator2,
+          typename StrictWeakOrdering>
+void stable_sort_by_key(
+  execution_policy<DerivedPolicy>& exec,
+  RandomAccessIterator1 first1,
+  RandomAccessIterator1 last1,
+  RandomAccessIterator2 first2,
+  StrictWeakOrdering comp,
+  thrust::detail::false_type)
+{
+  typedef typename thrust::iterator_value<RandomAccessIterator1>::type key_type;
+  typedef typename thrust::iterator_value<RandomAccessIterator2>::type val_type;
+
+  RandomAccessIterator2 last2 = first2 + thrust::distance(first1, last1);
+
+  thrust::detail::temporary_array<key_type, DerivedPolicy> temp1(exec, first1, last1);
+  thrust::detail::temporary_array<val_type, DerivedPolicy> temp2(exec, first2, last2);
+
+  sort_by_key_detail::merge_sort_by_key(exec, first1, last1, first2, temp1.begin(), temp2.begin(), comp, true);
+}
+
+template <typename DerivedPolicy,
+          typename RandomAccessIterator1,
+          typename RandomAccessIterator2,
+          typename StrictWeakOrdering>
+void stable_sort_by_key(
+  execution_policy<DerivedPolicy>& exec,
+  RandomAccessIterator1 first1,
+  RandomAccessIterator1 last1,
+  RandomAccessIterator2 first2,
+  StrictWeakOrdering comp,
+  thrust::detail::true_type)
+{
+  typedef typename thrust::iterator_difference<RandomAccessIterator1>::type difference_type;
+  typedef typename thrust::iterator_value<RandomAccessIterator1>::type key_type;
+
+  difference_type n = thrust::distance(first1, last1);
+
+  if (n < radix_sort_detail::threshold)
+  {
+    thrust::stable_sort_by_key(thrust::seq, first1, last1, first2, comp);
+    return;
+  }
+
+  RandomAccessIterator2 last2 = first2 + n;
+
+  // if comp is greater<T> then reverse the keys and values
+  // note, we also have to reverse the (unordered) input to preserve stability
+  const bool reverse =
+    thrust::system::detail::sequential::sort_detail::needs_reverse<key_type, StrictWeakOrdering>::value;
+
+  if (reverse)
+  {
+    thrust::reverse(exec, first1, last1);
+    thrust::reverse(exec, first2, last2);
+  }
+
+  thrust::system::detail::internal::radix_sort_detail::radix_sort<true>(
+    exec, radix_sort_detail::parallel_for_tiles(), first1, first2, n);
+
+  if (reverse)
+  {
+    thrust::reverse(exec, first1, last1);
+    thrust::reverse(exec, first2, last2);
+  }
+}
+
+} // namespace dispatch
+
+template <typename DerivedPolicy, typename RandomAccessIterator, typename StrictWeakOrdering>
+void stable_sort(
+  execution_policy<DerivedPolicy>& exec, RandomAccessIterator first, RandomAccessIterator last, StrictWeakOrdering comp)
+{
+  typedef typename thrust::iterator_value<RandomAccessIterator>::type key_type;
+
+  // primitive keys compared with less or greater are radix sorted
+  thrust::system::detail::sequential::sort_detail::use_primitive_sort<key_type, StrictWeakOrdering> use_primitive_sort;
+
+  dispatch::stable_sort(exec, first, last, comp, use_primitive_sort);
+}
+
+template <typename DerivedPolicy,
+          typename RandomAccessIterator1,
+          typename RandomAccessIterator2,
+          typename StrictWeakOrdering>
+void stable_sort_by_key(
+  execution_policy<DerivedPolicy>& exec,
+  RandomAccessIterator1 first1,
+  RandomAccessIterator1 last1,
+  RandomAccessIterator2 first2,
+  StrictWeakOrdering comp)
+{
+  typedef typename thrust::iterator_value<RandomAccessIterator1>::type key_type;
+
+  // primitive keys compared with less or greater are radix sorted
+  thrust::system::detail::sequential::sort_detail::use_primitive_sort<key_type, StrictWeakOrdering> use_primitive_sort;
+
+  dispatch::stable_sort_by_key(exec, first1, last1, first2, comp, use_primitive_sort);
+}
+
+} // end namespace detail
+} // end namespace threads
+} // end namespace system
+THRUST_NAMESPACE_END
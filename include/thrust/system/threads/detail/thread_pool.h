@@ -0,0 +1,213 @@
+/*
+ *  Copyright 2024 NVIDIA Corporation
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+/*! \file thread_pool.h
+ *  \brief The work-stealing thread pool which runs the algorithms of the threads system.
+ */
+
+#pragma once
+
+#include <thrust/detail/config.h>
+
+#if defined(_CCCL_IMPLICIT_SYSTEM_HEADER_GCC)
+#  pragma GCC system_header
+#elif defined(_CCCL_IMPLICIT_SYSTEM_HEADER_CLANG)
+#  pragma clang system_header
+#elif defined(_CCCL_IMPLICIT_SYSTEM_HEADER_MSVC)
+#  pragma system_header
+#endif // no system header
+#include <thrust/detail/cpp11_required.h>
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <exception>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+THRUST_NAMESPACE_BEGIN
+namespace system
+{
+namespace threads
+{
+namespace detail
+{
+
+// A unit of work which runs exactly once, either on the thread which spawned it or on a thread which stole it.
+// Tasks are owned by their spawner, which must wait for them before destroying them.
+class task
+{
+public:
+  task()
+      : m_done(false)
+  {}
+
+  virtual ~task() {}
+
+  // runs the task, and captures the exception it throws, if any
+  void run();
+
+  bool done() const
+  {
+    return m_done.load(std::memory_order_acquire);
+  }
+
+  // rethrows the exception captured by run, if any
+  void rethrow() const;
+
+protected:
+  virtual void execute() = 0;
+
+private:
+  task(const task&);
+  task& operator=(const task&);
+
+  std::atomic<bool> m_done;
+  std::exception_ptr m_exception;
+}; // end task
+
+// The deque of Chase & Lev, "Dynamic Circular Work-Stealing Deque" (SPAA 2005), with the memory orderings of
+// Le et al., "Correct and Efficient Work-Stealing for Weak Memory Models" (PPoPP 2013). Its owner pushes and pops
+// tasks at the bottom, while any other thread may steal them from the top.
+class work_stealing_deque
+{
+public:
+  work_stealing_deque();
+
+  // only the owner may push and pop
+  void push(task* t);
+  task* pop();
+
+  // any thread may steal; returns null when the deque is empty or the steal lost a race
+  task* steal();
+
+  bool empty() const;
+
+private:
+  struct ring
+  {
+    explicit ring(std::ptrdiff_t capacity)
+        : mask(capacity - 1)
+        , slots(new std::atomic<task*>[capacity])
+    {}
+
+    task* get(std::ptrdiff_t i) const
+    {
+      return slots[i & mask].load(std::memory_order_relaxed);
+    }
+
+    void put(std::ptrdiff_t i, task* t)
+    {
+      slots[i & mask].store(t, std::memory_order_relaxed);
+    }
+
+    std::ptrdiff_t capacity() const
+    {
+      return mask + 1;
+    }
+
+    std::ptrdiff_t mask;
+    std::unique_ptr<std::atomic<task*>[]> slots;
+  };
+
+  ring* grow(ring* old, std::ptrdiff_t top, std::ptrdiff_t bottom);
+
+  std::atomic<std::ptrdiff_t> m_top;
+  std::atomic<std::ptrdiff_t> m_bottom;
+  std::atomic<ring*> m_ring;
+
+  // thieves may still read a ring which was outgrown, so rings are only freed with the deque
+  std::vector<std::unique_ptr<ring>> m_rings;
+}; // end work_stealing_deque
+
+// A fixed set of worker threads, one per hardware thread, created on first use. Every worker owns a
+// work_stealing_deque. A worker pushes the tasks it spawns onto its own deque, and pops them back unless an idle
+// worker stole them first. A worker which waits for a stolen task runs other tasks in the meantime, so nested
+// parallel algorithms reuse the same workers instead of creating more threads. Threads outside the pool submit
+// their work through a shared queue, and sleep until it is done.
+class thread_pool
+{
+public:
+  explicit thread_pool(std::size_t num_threads);
+
+  ~thread_pool();
+
+  // the pool used by the threads system
+  static thread_pool& instance();
+
+  // the number of worker threads
+  std::size_t size() const
+  {
+    return m_workers.size();
+  }
+
+  // whether the calling thread is a worker of this pool
+  bool on_worker() const;
+
+  // runs t on a worker and returns once it is done; t runs on the calling thread if that is a worker
+  void run(task& t);
+
+  // makes t available to idle workers; the calling thread must be a worker, and must wait for t later
+  void spawn(task& t);
+
+  // returns once t is done, running t or other tasks on the calling worker in the meantime
+  void wait(task& t);
+
+private:
+  struct worker
+  {
+    work_stealing_deque deque;
+    std::size_t index;
+    unsigned int seed;
+    std::thread thread;
+  };
+
+  static worker*& current_worker();
+
+  void worker_loop(worker& self);
+
+  // returns a task of the calling worker's own deque, or one stolen from another worker
+  task* find_task(worker& self);
+
+  task* take_submitted();
+
+  void notify();
+
+  std::vector<std::unique_ptr<worker>> m_workers;
+
+  // threads outside the pool submit their tasks here
+  std::mutex m_submitted_mutex;
+  std::deque<task*> m_submitted;
+  std::atomic<std::size_t> m_num_submitted;
+
+  // idle workers sleep until the epoch changes, and submitters sleep until their task is done
+  std::mutex m_sleep_mutex;
+  std::condition_variable m_sleep;
+  std::condition_variable m_done;
+  std::atomic<unsigned int> m_epoch;
+  std::atomic<int> m_sleepers;
+  std::atomic<bool> m_stop;
+}; // end thread_pool
+
+} // namespace detail
+} // namespace threads
+} // namespace system
+THRUST_NAMESPACE_END
+
+#include <thrust/system/threads/detail/thread_pool.inl>
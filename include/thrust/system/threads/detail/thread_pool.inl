@@ -0,0 +1,391 @@
+/*
+ *  Copyright 2024 NVIDIA Corporation
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+#pragma once
+
+#include <thrust/detail/config.h>
+
+#if defined(_CCCL_IMPLICIT_SYSTEM_HEADER_GCC)
+#  pragma GCC system_header
+#elif defined(_CCCL_IMPLICIT_SYSTEM_HEADER_CLANG)
+#  pragma clang system_header
+#elif defined(_CCCL_IMPLICIT_SYSTEM_HEADER_MSVC)
+#  pragma system_header
+#endif // no system header
+#include <thrust/system/threads/detail/thread_pool.h>
+
+#include <algorithm>
+#include <functional>
+
+THRUST_NAMESPACE_BEGIN
+namespace system
+{
+namespace threads
+{
+namespace detail
+{
+
+inline void task::run()
+{
+  try
+  {
+    execute();
+  }
+  catch (...)
+  {
+    m_exception = std::current_exception();
+  }
+
+  // the spawner may destroy the task as soon as it sees this
+  m_done.store(true, std::memory_order_release);
+} // end task::run()
+
+inline void task::rethrow() const
+{
+  if (m_exception)
+  {
+    std::rethrow_exception(m_exception);
+  }
+} // end task::rethrow()
+
+inline work_stealing_deque::work_stealing_deque()
+    : m_top(0)
+    , m_bottom(0)
+    , m_ring(nullptr)
+{
+  m_rings.emplace_back(new ring(64));
+  m_ring.store(m_rings.back().get(), std::memory_order_relaxed);
+} // end work_stealing_deque::work_stealing_deque()
+
+inline void work_stealing_deque::push(task* t)
+{
+  const std::ptrdiff_t bottom = m_bottom.load(std::memory_order_relaxed);
+  const std::ptrdiff_t top    = m_top.load(std::memory_order_acquire);
+  ring* r                     = m_ring.load(std::memory_order_relaxed);
+
+  if (bottom - top > r->capacity() - 1)
+  {
+    r = grow(r, top, bottom);
+  }
+
+  r->put(bottom, t);
+
+  // a release store rather than a release fence, which is equivalent here, but which race detectors understand
+  m_bottom.store(bottom + 1, std::memory_order_release);
+} // end work_stealing_deque::push()
+
+inline task* work_stealing_deque::pop()
+{
+  const std::ptrdiff_t bottom = m_bottom.load(std::memory_order_relaxed) - 1;
+  ring* r                     = m_ring.load(std::memory_order_relaxed);
+
+  m_bottom.store(bottom, std::memory_order_relaxed);
+  std::atomic_thread_fence(std::memory_order_seq_cst);
+  std::ptrdiff_t top = m_top.load(std::memory_order_relaxed);
+
+  task* result = nullptr;
+
+  if (top <= bottom)
+  {
+    result = r->get(bottom);
+
+    if (top == bottom)
+    {
+      // this is the last task, which a thief may be stealing right now
+      if (!m_top.compare_exchange_strong(top, top + 1, std::memory_order_seq_cst, std::memory_order_relaxed))
+      {
+        result = nullptr;
+      }
+
+      m_bottom.store(bottom + 1, std::memory_order_relaxed);
+    }
+  }
+  else
+  {
+    m_bottom.store(bottom + 1, std::memory_order_relaxed);
+  }
+
+  return result;
+} // end work_stealing_deque::pop()
+
+inline task* work_stealing_deque::steal()
+{
+  std::ptrdiff_t top = m_top.load(std::memory_order_acquire);
+  std::atomic_thread_fence(std::memory_order_seq_cst);
+  const std::ptrdiff_t bottom = m_bottom.load(std::memory_order_acquire);
+
+  if (top < bottom)
+  {
+    task* result = m_ring.load(std::memory_order_acquire)->get(top);
+
+    if (m_top.compare_exchange_strong(top, top + 1, std::memory_order_seq_cst, std::memory_order_relaxed))
+    {
+      return result;
+    }
+  }
+
+  return nullptr;
+} // end work_stealing_deque::steal()
+
+inline bool work_stealing_deque::empty() const
+{
+  return m_bottom.load(std::memory_order_relaxed) <= m_top.load(std::memory_order_relaxed);
+} // end work_stealing_deque::empty()
+
+inline work_stealing_deque::ring* work_stealing_deque::grow(ring* old, std::ptrdiff_t top, std::ptrdiff_t bottom)
+{
+  ring* bigger = new ring(2 * old->capacity());
+  m_rings.emplace_back(bigger);
+
+  for (std::ptrdiff_t i = top; i < bottom; ++i)
+  {
+    bigger->put(i, old->get(i));
+  }
+
+  m_ring.store(bigger, std::memory_order_release);
+
+  return bigger;
+} // end work_stealing_deque::grow()
+
+inline thread_pool::thread_pool(std::size_t num_threads)
+    : m_num_submitted(0)
+    , m_epoch(0)
+    , m_sleepers(0)
+    , m_stop(false)
+{
+  for (std::size_t i = 0; i < num_threads; ++i)
+  {
+    m_workers.emplace_back(new worker);
+    m_workers.back()->index = i;
+    m_workers.back()->seed  = static_cast<unsigned int>(i) + 1;
+  }
+
+  // workers steal from each other, so every deque must exist before the first worker starts
+  for (std::size_t i = 0; i < num_threads; ++i)
+  {
+    m_workers[i]->thread = std::thread(&thread_pool::worker_loop, this, std::ref(*m_workers[i]));
+  }
+} // end thread_pool::thread_pool()
+
+inline thread_pool::~thread_pool()
+{
+  {
+    std::lock_guard<std::mutex> lock(m_sleep_mutex);
+    m_stop.store(true, std::memory_order_relaxed);
+  }
+  m_sleep.notify_all();
+
+  for (std::size_t i = 0; i < m_workers.size(); ++i)
+  {
+    m_workers[i]->thread.join();
+  }
+} // end thread_pool::~thread_pool()
+
+inline thread_pool& thread_pool::instance()
+{
+  static thread_pool pool((std::max)(std::thread::hardware_concurrency(), 1u));
+  return pool;
+} // end thread_pool::instance()
+
+inline thread_pool::worker*& thread_pool::current_worker()
+{
+  static thread_local worker* current = nullptr;
+  return current;
+} // end thread_pool::current_worker()
+
+inline bool thread_pool::on_worker() const
+{
+  const worker* w = current_worker();
+  return w != nullptr && w->index < m_workers.size() && m_workers[w->index].get() == w;
+} // end thread_pool::on_worker()
+
+inline void thread_pool::run(task& t)
+{
+  if (on_worker())
+  {
+    t.run();
+    return;
+  }
+
+  {
+    std::lock_guard<std::mutex> lock(m_submitted_mutex);
+    m_submitted.push_back(&t);
+    m_num_submitted.fetch_add(1, std::memory_order_relaxed);
+  }
+  notify();
+
+  std::unique_lock<std::mutex> lock(m_sleep_mutex);
+  while (!t.done())
+  {
+    m_done.wait(lock);
+  }
+} // end thread_pool::run()
+
+inline void thread_pool::spawn(task& t)
+{
+  current_worker()->deque.push(&t);
+  notify();
+} // end thread_pool::spawn()
+
+inline void thread_pool::wait(task& t)
+{
+  worker& self = *current_worker();
+
+  // unless t was stolen, it is at the bottom of our deque
+  while (!t.done())
+  {
+    if (task* other = find_task(self))
+    {
+      other->run();
+    }
+    else
+    {
+      std::this_thread::yield();
+    }
+  }
+} // end thread_pool::wait()
+
+inline void thread_pool::worker_loop(worker& self)
+{
+  current_worker() = &self;
+
+  // idle workers yield this many times before they go to sleep, as more work often follows soon
+  const int spin_limit = 64;
+
+  for (;;)
+  {
+    const unsigned int epoch = m_epoch.load(std::memory_order_seq_cst);
+
+    if (task* t = find_task(self))
+    {
+      t->run();
+      continue;
+    }
+
+    if (task* t = take_submitted())
+    {
+      t->run();
+
+      // the submitter checks t.done() under the lock, so this notification cannot be lost
+      {
+        std::lock_guard<std::mutex> lock(m_sleep_mutex);
+      }
+      m_done.notify_all();
+      continue;
+    }
+
+    int spins = 0;
+    while (spins < spin_limit && m_epoch.load(std::memory_order_relaxed) == epoch
+           && !m_stop.load(std::memory_order_relaxed))
+    {
+      std::this_thread::yield();
+      ++spins;
+    }
+
+    if (spins < spin_limit)
+    {
+      if (m_stop.load(std::memory_order_relaxed))
+      {
+        return;
+      }
+      continue;
+    }
+
+    std::unique_lock<std::mutex> lock(m_sleep_mutex);
+
+    // pairs with notify(): either we see the new epoch, or the notifier sees us sleeping
+    m_sleepers.fetch_add(1, std::memory_order_seq_cst);
+    while (!m_stop.load(std::memory_order_relaxed) && m_epoch.load(std::memory_order_seq_cst) == epoch)
+    {
+      m_sleep.wait(lock);
+    }
+    m_sleepers.fetch_sub(1, std::memory_order_seq_cst);
+
+    if (m_stop.load(std::memory_order_relaxed))
+    {
+      return;
+    }
+  }
+} // end thread_pool::worker_loop()
+
+inline task* thread_pool::find_task(worker& self)
+{
+  if (task* t = self.deque.pop())
+  {
+    return t;
+  }
+
+  const std::size_t n = m_workers.size();
+
+  // start at a random victim, so that thieves spread over the pool
+  self.seed ^= self.seed << 13;
+  self.seed ^= self.seed >> 17;
+  self.seed ^= self.seed << 5;
+
+  const std::size_t first_victim = self.seed % n;
+
+  for (std::size_t i = 0; i < n; ++i)
+  {
+    worker& victim = *m_workers[(first_victim + i) % n];
+
+    if (&victim != &self)
+    {
+      if (task* t = victim.deque.steal())
+      {
+        return t;
+      }
+    }
+  }
+
+  return nullptr;
+} // end thread_pool::find_task()
+
+inline task* thread_pool::take_submitted()
+{
+  if (m_num_submitted.load(std::memory_order_relaxed) == 0)
+  {
+    return nullptr;
+  }
+
+  std::lock_guard<std::mutex> lock(m_submitted_mutex);
+
+  if (m_submitted.empty())
+  {
+    return nullptr;
+  }
+
+  task* t = m_submitted.front();
+  m_submitted.pop_front();
+  m_num_submitted.fetch_sub(1, std::memory_order_relaxed);
+
+  return t;
+} // end thread_pool::take_submitted()
+
+inline void thread_pool::notify()
+{
+  m_epoch.fetch_add(1, std::memory_order_seq_cst);
+
+  if (m_sleepers.load(std::memory_order_seq_cst) > 0)
+  {
+    std::lock_guard<std::mutex> lock(m_sleep_mutex);
+    m_sleep.notify_one();
+  }
+} // end thread_pool::notify()
+
+} // namespace detail
+} // namespace threads
+} // namespace system
+THRUST_NAMESPACE_END
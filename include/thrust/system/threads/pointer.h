@@ -0,0 +1,120 @@
+/*
+ *  Copyright 2024 NVIDIA Corporation
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+/*! \file thrust/system/threads/memory.h
+ *  \brief Managing memory associated with Thrust's threads system.
+ */
+
+#pragma once
+
+#include <thrust/detail/config.h>
+
+#if defined(_CCCL_IMPLICIT_SYSTEM_HEADER_GCC)
+#  pragma GCC system_header
+#elif defined(_CCCL_IMPLICIT_SYSTEM_HEADER_CLANG)
+#  pragma clang system_header
+#elif defined(_CCCL_IMPLICIT_SYSTEM_HEADER_MSVC)
+#  pragma system_header
+#endif // no system header
+#include <thrust/detail/pointer.h>
+#include <thrust/detail/reference.h>
+#include <thrust/system/threads/detail/execution_policy.h>
+
+#include <type_traits>
+
+THRUST_NAMESPACE_BEGIN
+namespace system
+{
+namespace threads
+{
+
+/*! \p threads::pointer stores a pointer to an object allocated in memory accessible
+ *  by the \p threads system. This type provides type safety when dispatching
+ *  algorithms on ranges resident in \p threads memory.
+ *
+ *  \p threads::pointer has pointer semantics: it may be dereferenced and
+ *  manipulated with pointer arithmetic.
+ *
+ *  \p threads::pointer can be created with the function \p threads::malloc, or by
+ *  explicitly calling its constructor with a raw pointer.
+ *
+ *  The raw pointer encapsulated by a \p threads::pointer may be obtained by eiter its
+ *  <tt>get</tt> member function or the \p raw_pointer_cast function.
+ *
+ *  \note \p threads::pointer is not a "smart" pointer; it is the programmer's
+ *        responsibility to deallocate memory pointed to by \p threads::pointer.
+ *
+ *  \tparam T specifies the type of the pointee.
+ *
+ *  \see threads::malloc
+ *  \see threads::free
+ *  \see raw_pointer_cast
+ */
+template <typename T>
+using pointer = thrust::pointer<T, thrust::system::threads::tag, thrust::tagged_reference<T, thrust::system::threads::tag>>;
+
+/*! \p threads::universal_pointer stores a pointer to an object allocated in memory
+ * accessible by the \p threads system and host systems.
+ *
+ *  \p threads::universal_pointer has pointer semantics: it may be dereferenced and
+ *  manipulated with pointer arithmetic.
+ *
+ *  \p threads::universal_pointer can be created with \p threads::universal_allocator
+ *  or by explicitly calling its constructor with a raw pointer.
+ *
+ *  The raw pointer encapsulated by a \p threads::universal_pointer may be obtained
+ *  by eiter its <tt>get</tt> member function or the \p raw_pointer_cast
+ *  function.
+ *
+ *  \note \p threads::universal_pointer is not a "smart" pointer; it is the
+ *        programmer's responsibility to deallocate memory pointed to by
+ *        \p threads::universal_pointer.
+ *
+ *  \tparam T specifies the type of the pointee.
+ *
+ *  \see threads::universal_allocator
+ *  \see raw_pointer_cast
+ */
+template <typename T>
+using universal_pointer = thrust::pointer<T, thrust::system::threads::tag, typename std::add_lvalue_reference<T>::type>;
+
+/*! \p reference is a wrapped reference to an object stored in memory available
+ *  to the \p threads system. \p reference is the type of the result of
+ *  dereferencing a \p threads::pointer.
+ *
+ *  \tparam T Specifies the type of the referenced object.
+ */
+template <typename T>
+using reference = thrust::tagged_reference<T, thrust::system::threads::tag>;
+
+} // namespace threads
+} // namespace system
+
+/*! \addtogroup system_backends Systems
+ *  \ingroup system
+ *  \{
+ */
+
+/*! \namespace thrust::threads
+ *  \brief \p thrust::threads is a top-level alias for \p thrust::system::threads. */
+namespace threads
+{
+using thrust::system::threads::pointer;
+using thrust::system::threads::reference;
+using thrust::system::threads::universal_pointer;
+} // namespace threads
+
+THRUST_NAMESPACE_END